@@ -10,6 +10,7 @@
 #include <GPBoost/type_defs.h>
 #include <GPBoost/re_comp.h>
 #include <LightGBM/utils/log.h>
+#include <LightGBM/utils/openmp_wrapper.h>
 
 #include <chrono>
 #include <thread> //temp
@@ -317,6 +318,284 @@ namespace GPBoost {
 		}
 	} // end CGVecchiaLaplaceVecWinvplusSigma_FITC_P
 
+	/*!
+	* \brief X = L^(-1) X (transpose == false) or X = L^(-T) X (transpose == true) for a row-major sparse lower triangular matrix L
+	*		 and a block of right-hand sides X. All columns of a row are updated jointly such that L is streamed only once per group of columns.
+	*		 The columns are split into one group per thread.
+	*/
+	void SolveLowerTriangularBlock(const sp_mat_rm_t& L,
+		bool unit_diag,
+		bool transpose,
+		den_mat_rm_t& X) {
+		const int n = (int)L.rows();
+		const int num_cols = (int)X.cols();
+		int num_threads;
+#ifdef _OPENMP
+		num_threads = omp_get_max_threads();
+#else
+		num_threads = 1;
+#endif
+		const int num_groups = std::max(1, std::min(num_threads, num_cols));
+#pragma omp parallel for schedule(static)
+		for (int g = 0; g < num_groups; ++g) {
+			const int col_start = (int)(((int64_t)num_cols * g) / num_groups);
+			const int num_cols_g = (int)(((int64_t)num_cols * (g + 1)) / num_groups) - col_start;
+			if (!transpose) {
+				for (int i = 0; i < n; ++i) {
+					double diag = 1.;
+					for (sp_mat_rm_t::InnerIterator it(L, i); it; ++it) {
+						if (it.col() < i) {
+							X.row(i).segment(col_start, num_cols_g) -= it.value() * X.row(it.col()).segment(col_start, num_cols_g);
+						}
+						else if (it.col() == i) {
+							diag = it.value();
+						}
+					}
+					if (!unit_diag) {
+						X.row(i).segment(col_start, num_cols_g) /= diag;
+					}
+				}
+			}
+			else {
+				for (int i = n - 1; i >= 0; --i) {
+					if (!unit_diag) {
+						double diag = 1.;
+						for (sp_mat_rm_t::InnerIterator it(L, i); it; ++it) {
+							if (it.col() == i) {
+								diag = it.value();
+							}
+						}
+						X.row(i).segment(col_start, num_cols_g) /= diag;
+					}
+					for (sp_mat_rm_t::InnerIterator it(L, i); it; ++it) {
+						if (it.col() < i) {
+							X.row(it.col()).segment(col_start, num_cols_g) -= it.value() * X.row(i).segment(col_start, num_cols_g);
+						}
+					}
+				}
+			}
+		}
+	} // end SolveLowerTriangularBlock
+
+	/*!
+	* \brief Preconditioned conjugate gradient iterations for a block of right-hand sides with U = 0 initially.
+	*		 apply_A(H, V) calculates V = A H and apply_P_inv(R, Z) calculates Z = P^(-1) R for the entire block.
+	*		 Every column has its own step sizes. Columns that have converged are frozen by setting their residual and search direction to 0.
+	* \param[in,out] R Initial residuals (on input)
+	* \param[out] U Approximative solution (must have been initialized with 0's)
+	* \param[in,out] active Columns that are iterated (0 = column is not iterated)
+	*/
+	template <typename T_apply_A, typename T_apply_P_inv>
+	void PCGBlock(den_mat_rm_t& R,
+		den_mat_rm_t& U,
+		std::vector<char>& active,
+		bool& NA_or_Inf_found,
+		const int p,
+		const double delta_conv,
+		T_apply_A apply_A,
+		T_apply_P_inv apply_P_inv) {
+		const int t = (int)R.cols();
+		int num_active = 0;
+		for (int i = 0; i < t; ++i) {
+			if (active[i]) {
+				num_active++;
+			}
+		}
+		if (num_active == 0) {
+			return;
+		}
+		den_mat_rm_t Z(R.rows(), t), V(R.rows(), t), H;
+		vec_t a(t), b(t), r_Z_old, h_V, r_norm;
+		apply_P_inv(R, Z);
+		H = Z;
+		vec_t r_Z = R.cwiseProduct(Z).colwise().sum().transpose();
+		for (int j = 0; j < p; ++j) {
+			apply_A(H, V);
+			h_V = H.cwiseProduct(V).colwise().sum().transpose();
+			for (int i = 0; i < t; ++i) {
+				a[i] = active[i] ? r_Z[i] / h_V[i] : 0.;
+			}
+			U += H * a.asDiagonal();
+			R -= V * a.asDiagonal();
+			r_norm = R.colwise().norm().transpose();
+			for (int i = 0; i < t; ++i) {
+				if (!active[i]) {
+					continue;
+				}
+				if (std::isnan(r_norm[i]) || std::isinf(r_norm[i])) {
+					NA_or_Inf_found = true;
+					return;
+				}
+				if (r_norm[i] < delta_conv) {
+					active[i] = 0;
+					num_active--;
+					R.col(i).setZero();
+					H.col(i).setZero();
+				}
+			}
+			if (num_active == 0) {
+				//Log::REInfo("Number CG iterations: %i", j + 1);//for debugging
+				return;
+			}
+			apply_P_inv(R, Z);
+			r_Z_old = r_Z;
+			r_Z = R.cwiseProduct(Z).colwise().sum().transpose();
+			for (int i = 0; i < t; ++i) {
+				b[i] = active[i] ? r_Z[i] / r_Z_old[i] : 0.;
+			}
+			H = Z + H * b.asDiagonal();
+		}
+		Log::REInfo("Conjugate gradient algorithm has not converged after the maximal number of iterations (%i) for %i of %i right-hand sides. "
+			"Consider increasing 'cg_max_num_it'.", p, num_active, t);
+	} // end PCGBlock
+
+	void CGVecchiaLaplaceBlock(const vec_t& diag_W,
+		const sp_mat_rm_t& B_rm,
+		const sp_mat_rm_t& B_t_D_inv_rm,
+		const den_mat_t& rhs,
+		den_mat_t& U,
+		bool& NA_or_Inf_found,
+		int p,
+		const double delta_conv,
+		const double THRESHOLD_ZERO_RHS_CG,
+		const string_t cg_preconditioner_type,
+		const sp_mat_rm_t& D_inv_plus_W_B_rm,
+		const sp_mat_rm_t& L_SigmaI_plus_W_rm) {
+		if (cg_preconditioner_type != "vadu" && cg_preconditioner_type != "incomplete_cholesky") {
+			Log::REFatal("CGVecchiaLaplaceBlock: Preconditioner type '%s' is not supported ", cg_preconditioner_type.c_str());
+		}
+		p = std::min(p, (int)B_rm.cols());
+		const int t = (int)rhs.cols();
+		den_mat_rm_t R = rhs;
+		den_mat_rm_t U_rm = den_mat_rm_t::Zero(rhs.rows(), t);
+		std::vector<char> active(t, 1);
+		//Avoid numerical instabilites when rhs is de facto 0
+		for (int i = 0; i < t; ++i) {
+			if (rhs.col(i).cwiseAbs().sum() < THRESHOLD_ZERO_RHS_CG) {
+				active[i] = 0;
+				R.col(i).setZero();
+			}
+		}
+		//V = (Sigma^(-1) + W) H
+		auto apply_A = [&](const den_mat_rm_t& H, den_mat_rm_t& V) {
+			den_mat_rm_t B_H = B_rm * H;
+			V = B_t_D_inv_rm * B_H;
+			V += diag_W.asDiagonal() * H;
+		};
+		//Z = P^(-1) R
+		auto apply_P_inv = [&](const den_mat_rm_t& R_in, den_mat_rm_t& Z) {
+			Z = R_in;
+			if (cg_preconditioner_type == "vadu") {
+				//P^(-1) = B^(-1) (D^(-1) + W)^(-1) B^(-T)
+				SolveLowerTriangularBlock(B_rm, true, true, Z);
+				SolveLowerTriangularBlock(D_inv_plus_W_B_rm, false, false, Z);
+			}
+			else {
+				//P^(-1) = L^(-1) L^(-T)
+				SolveLowerTriangularBlock(L_SigmaI_plus_W_rm, false, true, Z);
+				SolveLowerTriangularBlock(L_SigmaI_plus_W_rm, false, false, Z);
+			}
+		};
+		PCGBlock(R, U_rm, active, NA_or_Inf_found, p, delta_conv, apply_A, apply_P_inv);
+		U = U_rm;
+	} // end CGVecchiaLaplaceBlock
+
+	void CGVecchiaLaplaceBlockWinvplusSigma(const vec_t& diag_W,
+		const sp_mat_rm_t& B_rm,
+		const sp_mat_rm_t& D_inv_B_rm,
+		const den_mat_t& rhs,
+		den_mat_t& U,
+		bool& NA_or_Inf_found,
+		int p,
+		const double delta_conv,
+		const double THRESHOLD_ZERO_RHS_CG,
+		const chol_den_mat_t& chol_fact_I_k_plus_Sigma_L_kt_W_Sigma_L_k_vecchia,
+		const den_mat_t& Sigma_L_k) {
+		p = std::min(p, (int)B_rm.cols());
+		CHECK(Sigma_L_k.rows() == B_rm.cols());
+		CHECK(Sigma_L_k.rows() == diag_W.size());
+		const int t = (int)rhs.cols();
+		vec_t diag_W_inv = diag_W.cwiseInverse();
+		den_mat_rm_t R = rhs;
+		den_mat_rm_t U_rm = den_mat_rm_t::Zero(rhs.rows(), t);
+		std::vector<char> active(t, 1);
+		//Avoid numerical instabilites when rhs is de facto 0
+		for (int i = 0; i < t; ++i) {
+			if (rhs.col(i).cwiseAbs().sum() < THRESHOLD_ZERO_RHS_CG) {
+				active[i] = 0;
+				R.col(i).setZero();
+			}
+		}
+		//R = Sigma * rhs, where Sigma = B^(-1) D B^(-T)
+		SolveLowerTriangularBlock(B_rm, true, true, R);
+		SolveLowerTriangularBlock(D_inv_B_rm, false, false, R);
+		//V = (W^(-1) + Sigma) H
+		auto apply_A = [&](const den_mat_rm_t& H, den_mat_rm_t& V) {
+			V = H;
+			SolveLowerTriangularBlock(B_rm, true, true, V);
+			SolveLowerTriangularBlock(D_inv_B_rm, false, false, V);
+			V += diag_W_inv.asDiagonal() * H;
+		};
+		//Z = P^(-1) R
+		//P^(-1) = (W^(-1) + Sigma_L_k Sigma_L_k^T)^(-1) = W - W Sigma_L_k (I_k + Sigma_L_k^T W Sigma_L_k)^(-1) Sigma_L_k^T W
+		auto apply_P_inv = [&](const den_mat_rm_t& R_in, den_mat_rm_t& Z) {
+			den_mat_t W_R = diag_W.asDiagonal() * R_in;
+			den_mat_t Sigma_Lkt_W_R = Sigma_L_k.transpose() * W_R;
+			Z = W_R - diag_W.asDiagonal() * (Sigma_L_k * chol_fact_I_k_plus_Sigma_L_kt_W_Sigma_L_k_vecchia.solve(Sigma_Lkt_W_R));
+		};
+		PCGBlock(R, U_rm, active, NA_or_Inf_found, p, delta_conv, apply_A, apply_P_inv);
+		//U = W^(-1) U
+		U = diag_W_inv.asDiagonal() * U_rm;
+	} // end CGVecchiaLaplaceBlockWinvplusSigma
+
+	void CGVecchiaLaplaceBlockWinvplusSigma_FITC_P(const vec_t& diag_W,
+		const sp_mat_rm_t& B_rm,
+		const sp_mat_rm_t& D_inv_B_rm,
+		const den_mat_t& rhs,
+		den_mat_t& U,
+		bool& NA_or_Inf_found,
+		int p,
+		const double delta_conv,
+		const double THRESHOLD_ZERO_RHS_CG,
+		const chol_den_mat_t& chol_fact_woodbury_preconditioner,
+		const den_mat_t& cross_cov,
+		const vec_t& diagonal_approx_inv_preconditioner) {
+		p = std::min(p, (int)B_rm.cols());
+		CHECK(cross_cov.rows() == B_rm.cols());
+		CHECK(cross_cov.rows() == diag_W.size());
+		const int t = (int)rhs.cols();
+		vec_t diag_W_inv = diag_W.cwiseInverse();
+		den_mat_rm_t R = rhs;
+		den_mat_rm_t U_rm = den_mat_rm_t::Zero(rhs.rows(), t);
+		std::vector<char> active(t, 1);
+		//Avoid numerical instabilites when rhs is de facto 0
+		for (int i = 0; i < t; ++i) {
+			if (rhs.col(i).cwiseAbs().sum() < THRESHOLD_ZERO_RHS_CG) {
+				active[i] = 0;
+				R.col(i).setZero();
+			}
+		}
+		//R = Sigma * rhs, where Sigma = B^(-1) D B^(-T)
+		SolveLowerTriangularBlock(B_rm, true, true, R);
+		SolveLowerTriangularBlock(D_inv_B_rm, false, false, R);
+		//V = (W^(-1) + Sigma) H
+		auto apply_A = [&](const den_mat_rm_t& H, den_mat_rm_t& V) {
+			V = H;
+			SolveLowerTriangularBlock(B_rm, true, true, V);
+			SolveLowerTriangularBlock(D_inv_B_rm, false, false, V);
+			V += diag_W_inv.asDiagonal() * H;
+		};
+		//Z = P^(-1) R
+		auto apply_P_inv = [&](const den_mat_rm_t& R_in, den_mat_rm_t& Z) {
+			den_mat_t W_R = diagonal_approx_inv_preconditioner.asDiagonal() * R_in;
+			den_mat_t cross_covt_W_R = cross_cov.transpose() * W_R;
+			Z = W_R - diagonal_approx_inv_preconditioner.asDiagonal() * (cross_cov * chol_fact_woodbury_preconditioner.solve(cross_covt_W_R));
+		};
+		PCGBlock(R, U_rm, active, NA_or_Inf_found, p, delta_conv, apply_A, apply_P_inv);
+		//U = W^(-1) U
+		U = diag_W_inv.asDiagonal() * U_rm;
+	} // end CGVecchiaLaplaceBlockWinvplusSigma_FITC_P
+
 	void CGTridiagVecchiaLaplace(const vec_t& diag_W,
 		const sp_mat_rm_t& B_rm,
 		const sp_mat_rm_t& B_t_D_inv_rm,
@@ -734,6 +1013,20 @@ namespace GPBoost {
 		}
 	}
 
+	void GenRandVecNormalParallel(const std::vector<int>& seeds,
+		den_mat_t& R) {
+		CHECK((int)seeds.size() == (int)R.cols());
+		//Every column has its own generator: deterministic independently of the number of threads
+#pragma omp parallel for schedule(static)
+		for (int j = 0; j < (int)R.cols(); ++j) {
+			RNG_t generator(seeds[j]);
+			std::normal_distribution<double> ndist(0.0, 1.0);
+			for (int i = 0; i < (int)R.rows(); ++i) {
+				R(i, j) = ndist(generator);
+			}
+		}
+	}
+
 	void LogDetStochTridiag(const std::vector<vec_t>& Tdiags,
 		const  std::vector<vec_t>& Tsubdiags,
 		double& ldet,
@@ -843,4 +1136,200 @@ namespace GPBoost {
 
 		L_rm = sp_mat_rm_t(L); //Convert to row-major
 	} // end ReverseIncompleteCholeskyFactorization
+
+	void CGFITC(const vec_t& fitc_resid_diag,
+		const den_mat_t& cross_cov,
+		const chol_den_mat_t& chol_fact_sigma_ip,
+		const vec_t& rhs,
+		vec_t& u,
+		bool& NaN_found,
+		int p,
+		const double delta_conv,
+		const double THRESHOLD_ZERO_RHS_CG,
+		const string_t cg_preconditioner_type,
+		const den_mat_t& cross_cov_preconditioner,
+		const chol_den_mat_t& chol_fact_woodbury_preconditioner,
+		const vec_t& diagonal_approx_inv_preconditioner) {
+
+		p = std::min(p, (int)rhs.size());
+
+		vec_t r, r_old;
+		vec_t z, z_old;
+		vec_t h;
+		vec_t v;
+
+		vec_t diag_sigma_resid_inv_r;
+		bool early_stop_alg = false;
+		double a = 0;
+		double b = 1;
+		double r_norm;
+
+		//Avoid numerical instabilites when rhs is de facto 0
+		if (rhs.cwiseAbs().sum() < THRESHOLD_ZERO_RHS_CG) {
+			u.setZero();
+			return;
+		}
+		bool is_zero = u.isZero(0);
+
+		if (is_zero) {
+			r = rhs;
+		}
+		else {
+			r = rhs - fitc_resid_diag.cwiseProduct(u) - cross_cov * chol_fact_sigma_ip.solve(cross_cov.transpose() * u);//r = rhs - A * u
+		}
+
+		//z = P^(-1) r
+		if (cg_preconditioner_type == "fitc") {
+			diag_sigma_resid_inv_r = diagonal_approx_inv_preconditioner.cwiseProduct(r);
+			z = diag_sigma_resid_inv_r - diagonal_approx_inv_preconditioner.cwiseProduct(cross_cov_preconditioner * chol_fact_woodbury_preconditioner.solve(cross_cov_preconditioner.transpose() * diag_sigma_resid_inv_r));
+		}
+		else if (cg_preconditioner_type == "none") {
+			z = r;
+		}
+		else {
+			Log::REFatal("CGFITC: Preconditioner type '%s' is not supported ", cg_preconditioner_type.c_str());
+		}
+		h = z;
+
+		for (int j = 0; j < p; ++j) {
+
+			v = fitc_resid_diag.cwiseProduct(h) + cross_cov * chol_fact_sigma_ip.solve(cross_cov.transpose() * h);
+
+			a = r.transpose() * z;
+			a /= h.transpose() * v;
+
+			u += a * h;
+			r_old = r;
+			r -= a * v;
+
+			r_norm = r.norm();
+			if (std::isnan(r_norm) || std::isinf(r_norm)) {
+				NaN_found = true;
+				return;
+			}
+			if (r_norm < delta_conv) {
+				early_stop_alg = true;
+			}
+
+			z_old = z;
+
+			//z = P^(-1) r 
+			if (cg_preconditioner_type == "fitc") {
+				diag_sigma_resid_inv_r = diagonal_approx_inv_preconditioner.cwiseProduct(r);
+				z = diag_sigma_resid_inv_r - diagonal_approx_inv_preconditioner.cwiseProduct(cross_cov_preconditioner * chol_fact_woodbury_preconditioner.solve(cross_cov_preconditioner.transpose() * diag_sigma_resid_inv_r));
+			}
+			else if (cg_preconditioner_type == "none") {
+				z = r;
+			}
+
+			b = r.transpose() * z;
+			b /= r_old.transpose() * z_old;
+
+			h = z + b * h;
+
+			if (early_stop_alg) {
+				return;
+			}
+		}
+		Log::REInfo("Conjugate gradient algorithm has not converged after the maximal number of iterations (%i). "
+			"This could happen if the initial learning rate is too large. Otherwise increase 'cg_max_num_it'.", p);
+	} // end CGFITC
+
+	void CGTridiagFITC(const vec_t& fitc_resid_diag,
+		const den_mat_t& cross_cov,
+		const chol_den_mat_t& chol_fact_sigma_ip,
+		const den_mat_t& rhs,
+		std::vector<vec_t>& Tdiags,
+		std::vector<vec_t>& Tsubdiags,
+		den_mat_t& U,
+		bool& NaN_found,
+		const data_size_t num_data,
+		const int t,
+		int p,
+		const double delta_conv,
+		const string_t cg_preconditioner_type,
+		const den_mat_t& cross_cov_preconditioner,
+		const chol_den_mat_t& chol_fact_woodbury_preconditioner,
+		const vec_t& diagonal_approx_inv_preconditioner) {
+		p = std::min(p, (int)num_data);
+
+		den_mat_t R(num_data, t), R_old, Z(num_data, t), Z_old, H, V(num_data, t), diag_sigma_resid_inv_R;
+		vec_t v1(num_data);
+		vec_t a(t), a_old(t);
+		vec_t b(t), b_old(t);
+		bool early_stop_alg = false;
+		double mean_R_norm;
+
+		U.setZero();
+		v1.setOnes();
+		a.setOnes();
+		b.setZero();
+
+		R = rhs;
+		//Z = P^(-1) R 
+		if (cg_preconditioner_type == "fitc") {
+			diag_sigma_resid_inv_R = diagonal_approx_inv_preconditioner.asDiagonal() * R;
+			Z = diag_sigma_resid_inv_R - (diagonal_approx_inv_preconditioner.asDiagonal() * (cross_cov_preconditioner * chol_fact_woodbury_preconditioner.solve(cross_cov_preconditioner.transpose() * diag_sigma_resid_inv_R)));
+		}
+		else if (cg_preconditioner_type == "none") {
+			Z = R;
+		}
+		else {
+			Log::REFatal("CGTridiagFITC: Preconditioner type '%s' is not supported ", cg_preconditioner_type.c_str());
+		}
+
+		H = Z;
+		for (int j = 0; j < p; ++j) {
+
+			V = fitc_resid_diag.asDiagonal() * H;
+			V += cross_cov * chol_fact_sigma_ip.solve(cross_cov.transpose() * H);
+
+			a_old = a;
+			a = (R.cwiseProduct(Z).transpose() * v1).array() * (H.cwiseProduct(V).transpose() * v1).array().inverse(); //cheap
+
+			U += H * a.asDiagonal();
+			R_old = R;
+			R -= V * a.asDiagonal();
+
+			mean_R_norm = R.colwise().norm().mean();
+			if (std::isnan(mean_R_norm) || std::isinf(mean_R_norm)) {
+				NaN_found = true;
+				return;
+			}
+			if (mean_R_norm < delta_conv) {
+				early_stop_alg = true;
+			}
+
+			Z_old = Z;
+
+			if (cg_preconditioner_type == "fitc") {
+				diag_sigma_resid_inv_R = diagonal_approx_inv_preconditioner.asDiagonal() * R;
+				Z = diag_sigma_resid_inv_R - (diagonal_approx_inv_preconditioner.asDiagonal() * (cross_cov_preconditioner * chol_fact_woodbury_preconditioner.solve(cross_cov_preconditioner.transpose() * diag_sigma_resid_inv_R)));
+			}
+			else if (cg_preconditioner_type == "none") {
+				Z = R;
+			}
+
+			b_old = b;
+			b = (R.cwiseProduct(Z).transpose() * v1).array() * (R_old.cwiseProduct(Z_old).transpose() * v1).array().inverse();
+
+			H = Z + H * b.asDiagonal();
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < t; ++i) {
+				Tdiags[i][j] = 1 / a(i) + b_old(i) / a_old(i);
+				if (j > 0) {
+					Tsubdiags[i][j - 1] = sqrt(b_old(i)) / a_old(i);
+				}
+			}
+			if (early_stop_alg) {
+				for (int i = 0; i < t; ++i) {
+					Tdiags[i].conservativeResize(j + 1, 1);
+					Tsubdiags[i].conservativeResize(j, 1);
+				}
+				return;
+			}
+		}
+		Log::REInfo("Conjugate gradient algorithm has not converged after the maximal number of iterations (%i). "
+			"This could happen if the initial learning rate is too large. Otherwise increase 'cg_max_num_it_tridiag'.", p);
+	} // end CGTridiagFITC
 }
@@ -497,6 +497,95 @@ namespace GPBoost {
 		}
 	}//end UpdateNearestNeighbors
 
+	/*! \brief Number of covariance matrices among neighbors that are factorized jointly in CalcCovFactorGradientVecchia */
+	const int NUM_LANES_BATCHED_CHOL = 8;
+
+	/*!
+	* \brief Cholesky factorizations of NUM_LANES_BATCHED_CHOL symmetric positive definite m x m matrices that are stored interleaved, i.e.,
+	*		entry (r, c) of matrix l is S[(c * m + r) * NUM_LANES_BATCHED_CHOL + l]. The loops over the matrices are innermost such that they are vectorized.
+	*		The lower triangular Cholesky factors are written on the lower triangular parts
+	* \param m Dimension of the matrices
+	* \param[out] S Interleaved matrices
+	* \return false if some matrix is not numerically positive definite
+	*/
+	bool BatchedCholeskyInterleaved(int m,
+		double* S) {
+		const int L = NUM_LANES_BATCHED_CHOL;
+		for (int k = 0; k < m; ++k) {
+			double* S_kk = S + ((size_t)k * m + k) * L;
+			for (int l = 0; l < L; ++l) {
+				if (!(S_kk[l] > 0.)) {
+					return false;
+				}
+			}
+			for (int l = 0; l < L; ++l) {
+				S_kk[l] = std::sqrt(S_kk[l]);
+			}
+			for (int r = k + 1; r < m; ++r) {
+				double* S_rk = S + ((size_t)k * m + r) * L;
+				for (int l = 0; l < L; ++l) {
+					S_rk[l] /= S_kk[l];
+				}
+			}
+			for (int c = k + 1; c < m; ++c) {
+				const double* S_ck = S + ((size_t)k * m + c) * L;
+				for (int r = c; r < m; ++r) {
+					const double* S_rk = S + ((size_t)k * m + r) * L;
+					double* S_rc = S + ((size_t)c * m + r) * L;
+					for (int l = 0; l < L; ++l) {
+						S_rc[l] -= S_rk[l] * S_ck[l];
+					}
+				}
+			}
+		}
+		return true;
+	}//end BatchedCholeskyInterleaved
+
+	/*!
+	* \brief Solve (L * L^T) X = R for interleaved Cholesky factors L calculated with BatchedCholeskyInterleaved
+	* \param m Dimension of the matrices
+	* \param num_rhs Number of right-hand sides per matrix
+	* \param S Interleaved Cholesky factors
+	* \param[out] X Right-hand sides (entry r of right-hand side j of matrix l is X[(j * m + r) * NUM_LANES_BATCHED_CHOL + l]), solution written on input
+	*/
+	void BatchedCholeskySolveInterleaved(int m,
+		int num_rhs,
+		const double* S,
+		double* X) {
+		const int L = NUM_LANES_BATCHED_CHOL;
+		for (int j = 0; j < num_rhs; ++j) {
+			double* x = X + (size_t)j * m * L;
+			for (int k = 0; k < m; ++k) {
+				const double* S_kk = S + ((size_t)k * m + k) * L;
+				double* x_k = x + (size_t)k * L;
+				for (int l = 0; l < L; ++l) {
+					x_k[l] /= S_kk[l];
+				}
+				for (int r = k + 1; r < m; ++r) {
+					const double* S_rk = S + ((size_t)k * m + r) * L;
+					double* x_r = x + (size_t)r * L;
+					for (int l = 0; l < L; ++l) {
+						x_r[l] -= S_rk[l] * x_k[l];
+					}
+				}
+			}
+			for (int k = m - 1; k >= 0; --k) {
+				double* x_k = x + (size_t)k * L;
+				for (int r = k + 1; r < m; ++r) {
+					const double* S_rk = S + ((size_t)k * m + r) * L;
+					const double* x_r = x + (size_t)r * L;
+					for (int l = 0; l < L; ++l) {
+						x_k[l] -= S_rk[l] * x_r[l];
+					}
+				}
+				const double* S_kk = S + ((size_t)k * m + k) * L;
+				for (int l = 0; l < L; ++l) {
+					x_k[l] /= S_kk[l];
+				}
+			}
+		}
+	}//end BatchedCholeskySolveInterleaved
+
 	void CalcCovFactorGradientVecchia(data_size_t num_re_cluster_i,
 		bool calc_cov_factor,
 		bool calc_gradient,
@@ -516,7 +605,8 @@ namespace GPBoost {
 		int num_gp_total,
 		int ind_intercept_gp,
 		bool gauss_likelihood,
-		bool save_distances_isotropic_cov_fct) {
+		bool save_distances_isotropic_cov_fct,
+		const VecchiaDistanceCache* dist_cache) {
 		int num_par_comp = re_comps_vecchia_cluster_i[ind_intercept_gp]->NumCovPar();
 		int num_par_gp = num_par_comp * num_gp_total + calc_gradient_nugget;
 		//Initialize matrices B = I - A and D^-1 as well as their derivatives (in order that the code below can be run in parallel)
@@ -548,147 +638,263 @@ namespace GPBoost {
 			}
 		}//end initialization
 		std::shared_ptr<RECompGP<den_mat_t>> re_comp = re_comps_vecchia_cluster_i[ind_intercept_gp];
-		bool distances_saved = re_comp->HasIsotropicCovFct() && save_distances_isotropic_cov_fct;
-#pragma omp parallel for schedule(static)
+		bool distances_saved = re_comp->HasIsotropicCovFct() && (save_distances_isotropic_cov_fct || dist_cache != nullptr);
+		//Group consecutive data points with the same number of neighbors into batches. The linear systems of a batch are solved jointly
+		const int num_lanes = NUM_LANES_BATCHED_CHOL;
+		std::vector<data_size_t> batch_start;
+		batch_start.reserve(num_re_cluster_i / num_lanes + 2);
 		for (data_size_t i = 0; i < num_re_cluster_i; ++i) {
-			int num_nn = (int)nearest_neighbors_cluster_i[i].size();
+			if (batch_start.empty() || i - batch_start.back() == num_lanes ||
+				nearest_neighbors_cluster_i[i].size() != nearest_neighbors_cluster_i[batch_start.back()].size()) {
+				batch_start.push_back(i);
+			}
+		}
+		batch_start.push_back(num_re_cluster_i);
+		const int num_batches = (int)batch_start.size() - 1;
+#pragma omp parallel for schedule(static)
+		for (int b = 0; b < num_batches; ++b) {
+			const data_size_t i_start = batch_start[b];
+			const int batch_size = (int)(batch_start[b + 1] - i_start);
+			const int num_nn = (int)nearest_neighbors_cluster_i[i_start].size();
 			//calculate covariance matrices between observations and neighbors and among neighbors as well as their derivatives
-			den_mat_t cov_mat_obs_neighbors;
-			den_mat_t cov_mat_between_neighbors;
-			std::vector<den_mat_t> cov_grad_mats_obs_neighbors(num_par_gp);//covariance matrix plus derivative wrt to every parameter
-			std::vector<den_mat_t> cov_grad_mats_between_neighbors(num_par_gp);
-			den_mat_t coords_i, coords_nn_i;
-			if (i > 0) {
-				for (int j = 0; j < num_gp_total; ++j) {
-					int ind_first_par = j * num_par_comp;//index of first parameter (variance) of component j in gradient vectors
-					if (j == 0) {
-						if (!distances_saved) {
-							std::vector<int> ind{ i };
-							re_comp->GetSubSetCoords(ind, coords_i);
-							re_comp->GetSubSetCoords(nearest_neighbors_cluster_i[i], coords_nn_i);
+			std::vector<den_mat_t> cov_mat_obs_neighbors_batch(batch_size);
+			std::vector<den_mat_t> cov_mat_between_neighbors_batch(batch_size);
+			std::vector<std::vector<den_mat_t>> cov_grad_mats_obs_neighbors_batch(batch_size, std::vector<den_mat_t>(num_par_gp));//covariance matrix plus derivative wrt to every parameter
+			std::vector<std::vector<den_mat_t>> cov_grad_mats_between_neighbors_batch(batch_size, std::vector<den_mat_t>(num_par_gp));
+			for (int lane = 0; lane < batch_size; ++lane) {
+				const data_size_t i = i_start + lane;
+				den_mat_t& cov_mat_obs_neighbors = cov_mat_obs_neighbors_batch[lane];
+				den_mat_t& cov_mat_between_neighbors = cov_mat_between_neighbors_batch[lane];
+				std::vector<den_mat_t>& cov_grad_mats_obs_neighbors = cov_grad_mats_obs_neighbors_batch[lane];
+				std::vector<den_mat_t>& cov_grad_mats_between_neighbors = cov_grad_mats_between_neighbors_batch[lane];
+				den_mat_t coords_i, coords_nn_i;
+				den_mat_t dist_obs_neighbors_i, dist_between_neighbors_i;//distances restored from 'dist_cache'
+				if (i > 0) {
+					const den_mat_t* dist_obs_i = &dist_obs_neighbors_i;
+					const den_mat_t* dist_between_i = &dist_between_neighbors_i;
+					if (dist_cache != nullptr) {
+						dist_cache->GetDistances(i, dist_obs_neighbors_i, dist_between_neighbors_i);
+					}
+					else if (distances_saved) {
+						dist_obs_i = &dist_obs_neighbors_cluster_i[i];
+						dist_between_i = &dist_between_neighbors_cluster_i[i];
+					}
+					for (int j = 0; j < num_gp_total; ++j) {
+						int ind_first_par = j * num_par_comp;//index of first parameter (variance) of component j in gradient vectors
+						if (j == 0) {
+							if (!distances_saved) {
+								std::vector<int> ind{ i };
+								re_comp->GetSubSetCoords(ind, coords_i);
+								re_comp->GetSubSetCoords(nearest_neighbors_cluster_i[i], coords_nn_i);
+							}
+							re_comps_vecchia_cluster_i[ind_intercept_gp + j]->CalcSigmaAndSigmaGradVecchia(*dist_obs_i, coords_i, coords_nn_i,
+								cov_mat_obs_neighbors, cov_grad_mats_obs_neighbors.data() + ind_first_par,
+								calc_gradient, transf_scale, nugget_var, false);//write on matrices directly for first GP component
+							re_comps_vecchia_cluster_i[ind_intercept_gp + j]->CalcSigmaAndSigmaGradVecchia(*dist_between_i, coords_nn_i, coords_nn_i,
+								cov_mat_between_neighbors, cov_grad_mats_between_neighbors.data() + ind_first_par,
+								calc_gradient, transf_scale, nugget_var, true);
+						}
+						else {//random coefficient GPs
+							den_mat_t cov_mat_obs_neighbors_j;
+							den_mat_t cov_mat_between_neighbors_j;
+							re_comps_vecchia_cluster_i[ind_intercept_gp + j]->CalcSigmaAndSigmaGradVecchia(*dist_obs_i, coords_i, coords_nn_i,
+								cov_mat_obs_neighbors_j, cov_grad_mats_obs_neighbors.data() + ind_first_par,
+								calc_gradient, transf_scale, nugget_var, false);
+							re_comps_vecchia_cluster_i[ind_intercept_gp + j]->CalcSigmaAndSigmaGradVecchia(*dist_between_i, coords_nn_i, coords_nn_i,
+								cov_mat_between_neighbors_j, cov_grad_mats_between_neighbors.data() + ind_first_par,
+								calc_gradient, transf_scale, nugget_var, true);
+							//multiply by coefficient matrix
+							cov_mat_obs_neighbors_j.array() *= (z_outer_z_obs_neighbors_cluster_i[i][j - 1].block(1, 0, num_nn, 1)).array();//cov_mat_obs_neighbors_j.cwiseProduct()
+							cov_mat_between_neighbors_j.array() *= (z_outer_z_obs_neighbors_cluster_i[i][j - 1].block(1, 1, num_nn, num_nn)).array();
+							cov_mat_obs_neighbors += cov_mat_obs_neighbors_j;
+							cov_mat_between_neighbors += cov_mat_between_neighbors_j;
+							if (calc_gradient) {
+								for (int ipar = 0; ipar < (int)num_par_comp; ++ipar) {
+									cov_grad_mats_obs_neighbors[ind_first_par + ipar].array() *= (z_outer_z_obs_neighbors_cluster_i[i][j - 1].block(1, 0, num_nn, 1)).array();
+									cov_grad_mats_between_neighbors[ind_first_par + ipar].array() *= (z_outer_z_obs_neighbors_cluster_i[i][j - 1].block(1, 1, num_nn, num_nn)).array();
+								}
+							}
 						}
-						re_comps_vecchia_cluster_i[ind_intercept_gp + j]->CalcSigmaAndSigmaGradVecchia(dist_obs_neighbors_cluster_i[i], coords_i, coords_nn_i,
-							cov_mat_obs_neighbors, cov_grad_mats_obs_neighbors.data() + ind_first_par,
-							calc_gradient, transf_scale, nugget_var, false);//write on matrices directly for first GP component
-						re_comps_vecchia_cluster_i[ind_intercept_gp + j]->CalcSigmaAndSigmaGradVecchia(dist_between_neighbors_cluster_i[i], coords_nn_i, coords_nn_i,
-							cov_mat_between_neighbors, cov_grad_mats_between_neighbors.data() + ind_first_par,
-							calc_gradient, transf_scale, nugget_var, true);
+					}//end loop over components j
+				}//end if(i>1)
+				//Calculate matrices B and D as well as their derivatives
+				//1. add first summand of matrix D (ZCZ^T_{ii}) and its derivatives
+				for (int j = 0; j < num_gp_total; ++j) {
+					double d_comp_j = re_comps_vecchia_cluster_i[ind_intercept_gp + j]->CovPars()[0];
+					if (!transf_scale && gauss_likelihood) {
+						d_comp_j *= nugget_var;
 					}
-					else {//random coefficient GPs
-						den_mat_t cov_mat_obs_neighbors_j;
-						den_mat_t cov_mat_between_neighbors_j;
-						re_comps_vecchia_cluster_i[ind_intercept_gp + j]->CalcSigmaAndSigmaGradVecchia(dist_obs_neighbors_cluster_i[i], coords_i, coords_nn_i,
-							cov_mat_obs_neighbors_j, cov_grad_mats_obs_neighbors.data() + ind_first_par,
-							calc_gradient, transf_scale, nugget_var, false);
-						re_comps_vecchia_cluster_i[ind_intercept_gp + j]->CalcSigmaAndSigmaGradVecchia(dist_between_neighbors_cluster_i[i], coords_nn_i, coords_nn_i,
-							cov_mat_between_neighbors_j, cov_grad_mats_between_neighbors.data() + ind_first_par,
-							calc_gradient, transf_scale, nugget_var, true);
-						//multiply by coefficient matrix
-						cov_mat_obs_neighbors_j.array() *= (z_outer_z_obs_neighbors_cluster_i[i][j - 1].block(1, 0, num_nn, 1)).array();//cov_mat_obs_neighbors_j.cwiseProduct()
-						cov_mat_between_neighbors_j.array() *= (z_outer_z_obs_neighbors_cluster_i[i][j - 1].block(1, 1, num_nn, num_nn)).array();
-						cov_mat_obs_neighbors += cov_mat_obs_neighbors_j;
-						cov_mat_between_neighbors += cov_mat_between_neighbors_j;
-						if (calc_gradient) {
-							for (int ipar = 0; ipar < (int)num_par_comp; ++ipar) {
-								cov_grad_mats_obs_neighbors[ind_first_par + ipar].array() *= (z_outer_z_obs_neighbors_cluster_i[i][j - 1].block(1, 0, num_nn, 1)).array();
-								cov_grad_mats_between_neighbors[ind_first_par + ipar].array() *= (z_outer_z_obs_neighbors_cluster_i[i][j - 1].block(1, 1, num_nn, num_nn)).array();
+					if (j > 0) {//random coefficient
+						d_comp_j *= z_outer_z_obs_neighbors_cluster_i[i][j - 1](0, 0);
+					}
+					if (calc_cov_factor) {
+						D_inv_cluster_i.coeffRef(i, i) += d_comp_j;
+					}
+					if (calc_gradient) {
+						if (!(exclude_marg_var_grad && j == 0)) {
+							if (transf_scale) {
+								D_grad_cluster_i[j * num_par_comp].coeffRef(i, i) = d_comp_j;//derivative of the covariance function wrt the variance. derivative of the covariance function wrt to range is zero on the diagonal
+							}
+							else {
+								if (j == 0) {
+									D_grad_cluster_i[j * num_par_comp].coeffRef(i, i) = 1.;//1's on the diagonal on the orignal scale
+								}
+								else {
+									D_grad_cluster_i[j * num_par_comp].coeffRef(i, i) = z_outer_z_obs_neighbors_cluster_i[i][j - 1](0, 0);
+								}
 							}
 						}
 					}
-				}//end loop over components j
-			}//end if(i>1)
-			//Calculate matrices B and D as well as their derivatives
-			//1. add first summand of matrix D (ZCZ^T_{ii}) and its derivatives
-			for (int j = 0; j < num_gp_total; ++j) {
-				double d_comp_j = re_comps_vecchia_cluster_i[ind_intercept_gp + j]->CovPars()[0];
-				if (!transf_scale && gauss_likelihood) {
-					d_comp_j *= nugget_var;
 				}
-				if (j > 0) {//random coefficient
-					d_comp_j *= z_outer_z_obs_neighbors_cluster_i[i][j - 1](0, 0);
-				}
-				if (calc_cov_factor) {
-					D_inv_cluster_i.coeffRef(i, i) += d_comp_j;
+				if (calc_gradient && calc_gradient_nugget) {
+					D_grad_cluster_i[num_par_gp - 1].coeffRef(i, i) = 1.;
 				}
-				if (calc_gradient) {
-					if (!(exclude_marg_var_grad && j == 0)) {
+				if (i > 0) {
+					if (gauss_likelihood) {
 						if (transf_scale) {
-							D_grad_cluster_i[j * num_par_comp].coeffRef(i, i) = d_comp_j;//derivative of the covariance function wrt the variance. derivative of the covariance function wrt to range is zero on the diagonal
+							cov_mat_between_neighbors.diagonal().array() += 1.;//add nugget effect
 						}
 						else {
-							if (j == 0) {
-								D_grad_cluster_i[j * num_par_comp].coeffRef(i, i) = 1.;//1's on the diagonal on the orignal scale
-							}
-							else {
-								D_grad_cluster_i[j * num_par_comp].coeffRef(i, i) = z_outer_z_obs_neighbors_cluster_i[i][j - 1](0, 0);
-							}
+							cov_mat_between_neighbors.diagonal().array() += nugget_var;
 						}
 					}
+					else {
+						cov_mat_between_neighbors.diagonal().array() *= JITTER_MULT_VECCHIA;//Avoid numerical problems when there is no nugget effect
+					}
 				}
-			}
-			if (calc_gradient && calc_gradient_nugget) {
-				D_grad_cluster_i[num_par_gp - 1].coeffRef(i, i) = 1.;
-			}
+			}//end loop over data points in batch
 			//2. remaining terms
-			if (i > 0) {
-				if (gauss_likelihood) {
-					if (transf_scale) {
-						cov_mat_between_neighbors.diagonal().array() += 1.;//add nugget effect
-					}
-					else {
-						cov_mat_between_neighbors.diagonal().array() += nugget_var;
+			if (num_nn > 0) {
+				//Factorize the covariance matrices among neighbors jointly and calculate A_i^T = cov_mat_between_neighbors^-1 * cov_mat_obs_neighbors
+				//Unused lanes contain identity matrices
+				std::vector<double> chol_batch((size_t)num_nn * num_nn * num_lanes, 0.);
+				std::vector<double> A_t_batch((size_t)num_nn * num_lanes, 0.);
+				for (int lane = 0; lane < num_lanes; ++lane) {
+					for (int c = 0; c < num_nn; ++c) {
+						for (int r = c; r < num_nn; ++r) {
+							if (lane < batch_size) {
+								chol_batch[((size_t)c * num_nn + r) * num_lanes + lane] = cov_mat_between_neighbors_batch[lane](r, c);
+							}
+							else if (r == c) {
+								chol_batch[((size_t)c * num_nn + r) * num_lanes + lane] = 1.;
+							}
+						}
+						if (lane < batch_size) {
+							A_t_batch[(size_t)c * num_lanes + lane] = cov_mat_obs_neighbors_batch[lane](c, 0);
+						}
 					}
 				}
-				else {
-					cov_mat_between_neighbors.diagonal().array() *= JITTER_MULT_VECCHIA;//Avoid numerical problems when there is no nugget effect
+				bool chol_batch_ok = BatchedCholeskyInterleaved(num_nn, chol_batch.data());
+				std::vector<Eigen::LLT<den_mat_t>> chol_facts_between_neighbors;
+				if (chol_batch_ok) {
+					BatchedCholeskySolveInterleaved(num_nn, 1, chol_batch.data(), A_t_batch.data());
 				}
-				den_mat_t A_i(1, num_nn);
-				den_mat_t A_i_grad_sigma2;
-				Eigen::LLT<den_mat_t> chol_fact_between_neighbors = cov_mat_between_neighbors.llt();
-				A_i = (chol_fact_between_neighbors.solve(cov_mat_obs_neighbors)).transpose();
-				if (calc_cov_factor) {
+				else {//some matrix is not numerically positive definite -> factorize the matrices separately with Eigen as in the non-batched version
+					chol_facts_between_neighbors.resize(batch_size);
+					for (int lane = 0; lane < batch_size; ++lane) {
+						chol_facts_between_neighbors[lane].compute(cov_mat_between_neighbors_batch[lane]);
+						vec_t A_i_t = chol_facts_between_neighbors[lane].solve(cov_mat_obs_neighbors_batch[lane].col(0));
+						for (int inn = 0; inn < num_nn; ++inn) {
+							A_t_batch[(size_t)inn * num_lanes + lane] = A_i_t[inn];
+						}
+					}
+				}
+				std::vector<vec_t> A_i_t_batch(batch_size, vec_t(num_nn));
+				for (int lane = 0; lane < batch_size; ++lane) {
+					const data_size_t i = i_start + lane;
+					vec_t& A_i_t = A_i_t_batch[lane];
 					for (int inn = 0; inn < num_nn; ++inn) {
-						B_cluster_i.coeffRef(i, nearest_neighbors_cluster_i[i][inn]) = -A_i(0, inn);
+						A_i_t[inn] = A_t_batch[(size_t)inn * num_lanes + lane];
+					}
+					if (calc_cov_factor) {
+						for (int inn = 0; inn < num_nn; ++inn) {
+							B_cluster_i.coeffRef(i, nearest_neighbors_cluster_i[i][inn]) = -A_i_t[inn];
+						}
+						D_inv_cluster_i.coeffRef(i, i) -= A_i_t.dot(cov_mat_obs_neighbors_batch[lane].col(0));
 					}
-					D_inv_cluster_i.coeffRef(i, i) -= (A_i * cov_mat_obs_neighbors)(0, 0);
 				}
 				if (calc_gradient) {
-					if (calc_gradient_nugget) {
-						A_i_grad_sigma2 = -(chol_fact_between_neighbors.solve(A_i.transpose())).transpose();
+					//Since cov_mat_between_neighbors and its derivatives are symmetric, the derivative of A_i is
+					//	A_i_grad^T = cov_mat_between_neighbors^-1 * (cov_grad_mats_obs_neighbors - cov_grad_mats_between_neighbors * A_i^T),
+					//i.e., only one right-hand side per parameter is required. The last right-hand side is A_i^T for the derivative wrt the nugget variance
+					std::vector<double> rhs_batch((size_t)num_par_gp * num_nn * num_lanes, 0.);
+					for (int lane = 0; lane < batch_size; ++lane) {
+						const vec_t& A_i_t = A_i_t_batch[lane];
+						for (int j = 0; j < num_gp_total; ++j) {
+							int ind_first_par = j * num_par_comp;
+							for (int ipar = 0; ipar < num_par_comp; ++ipar) {
+								if (!(exclude_marg_var_grad && ipar == 0)) {
+									vec_t rhs = cov_grad_mats_obs_neighbors_batch[lane][ind_first_par + ipar].col(0);
+									rhs.noalias() -= cov_grad_mats_between_neighbors_batch[lane][ind_first_par + ipar] * A_i_t;
+									for (int inn = 0; inn < num_nn; ++inn) {
+										rhs_batch[((size_t)(ind_first_par + ipar) * num_nn + inn) * num_lanes + lane] = rhs[inn];
+									}
+								}
+							}
+						}
+						if (calc_gradient_nugget) {
+							for (int inn = 0; inn < num_nn; ++inn) {
+								rhs_batch[((size_t)(num_par_gp - 1) * num_nn + inn) * num_lanes + lane] = A_i_t[inn];
+							}
+						}
 					}
-					den_mat_t A_i_grad(1, num_nn);
-					for (int j = 0; j < num_gp_total; ++j) {
-						int ind_first_par = j * num_par_comp;
-						for (int ipar = 0; ipar < num_par_comp; ++ipar) {
-							if (!(exclude_marg_var_grad && ipar == 0)) {
-								A_i_grad = (chol_fact_between_neighbors.solve(cov_grad_mats_obs_neighbors[ind_first_par + ipar])).transpose() -
-									A_i * ((chol_fact_between_neighbors.solve(cov_grad_mats_between_neighbors[ind_first_par + ipar])).transpose());
+					if (chol_batch_ok) {
+						BatchedCholeskySolveInterleaved(num_nn, num_par_gp, chol_batch.data(), rhs_batch.data());
+					}
+					else {
+						for (int lane = 0; lane < batch_size; ++lane) {
+							vec_t rhs(num_nn);
+							for (int ipar = 0; ipar < num_par_gp; ++ipar) {
 								for (int inn = 0; inn < num_nn; ++inn) {
-									B_grad_cluster_i[ind_first_par + ipar].coeffRef(i, nearest_neighbors_cluster_i[i][inn]) = -A_i_grad(0, inn);
-								}
-								if (ipar == 0) {
-									D_grad_cluster_i[ind_first_par + ipar].coeffRef(i, i) -= ((A_i_grad * cov_mat_obs_neighbors)(0, 0) +
-										(A_i * cov_grad_mats_obs_neighbors[ind_first_par + ipar])(0, 0));//add to derivative of diagonal elements for marginal variance 
+									rhs[inn] = rhs_batch[((size_t)ipar * num_nn + inn) * num_lanes + lane];
 								}
-								else {
-									D_grad_cluster_i[ind_first_par + ipar].coeffRef(i, i) = -((A_i_grad * cov_mat_obs_neighbors)(0, 0) +
-										(A_i * cov_grad_mats_obs_neighbors[ind_first_par + ipar])(0, 0));//don't add to existing values since derivative of diagonal is zero for range
+								rhs = chol_facts_between_neighbors[lane].solve(rhs);
+								for (int inn = 0; inn < num_nn; ++inn) {
+									rhs_batch[((size_t)ipar * num_nn + inn) * num_lanes + lane] = rhs[inn];
 								}
 							}
 						}
 					}
-					if (calc_gradient_nugget) {
-						for (int inn = 0; inn < num_nn; ++inn) {
-							B_grad_cluster_i[num_par_gp - 1].coeffRef(i, nearest_neighbors_cluster_i[i][inn]) = -A_i_grad_sigma2(0, inn);
+					for (int lane = 0; lane < batch_size; ++lane) {
+						const data_size_t i = i_start + lane;
+						const vec_t& A_i_t = A_i_t_batch[lane];
+						const den_mat_t& cov_mat_obs_neighbors = cov_mat_obs_neighbors_batch[lane];
+						vec_t A_i_grad_t(num_nn);
+						for (int j = 0; j < num_gp_total; ++j) {
+							int ind_first_par = j * num_par_comp;
+							for (int ipar = 0; ipar < num_par_comp; ++ipar) {
+								if (!(exclude_marg_var_grad && ipar == 0)) {
+									for (int inn = 0; inn < num_nn; ++inn) {
+										A_i_grad_t[inn] = rhs_batch[((size_t)(ind_first_par + ipar) * num_nn + inn) * num_lanes + lane];
+										B_grad_cluster_i[ind_first_par + ipar].coeffRef(i, nearest_neighbors_cluster_i[i][inn]) = -A_i_grad_t[inn];
+									}
+									if (ipar == 0) {
+										D_grad_cluster_i[ind_first_par + ipar].coeffRef(i, i) -= (A_i_grad_t.dot(cov_mat_obs_neighbors.col(0)) +
+											A_i_t.dot(cov_grad_mats_obs_neighbors_batch[lane][ind_first_par + ipar].col(0)));//add to derivative of diagonal elements for marginal variance 
+									}
+									else {
+										D_grad_cluster_i[ind_first_par + ipar].coeffRef(i, i) = -(A_i_grad_t.dot(cov_mat_obs_neighbors.col(0)) +
+											A_i_t.dot(cov_grad_mats_obs_neighbors_batch[lane][ind_first_par + ipar].col(0)));//don't add to existing values since derivative of diagonal is zero for range
+									}
+								}
+							}
+						}
+						if (calc_gradient_nugget) {
+							for (int inn = 0; inn < num_nn; ++inn) {
+								A_i_grad_t[inn] = -rhs_batch[((size_t)(num_par_gp - 1) * num_nn + inn) * num_lanes + lane];
+								B_grad_cluster_i[num_par_gp - 1].coeffRef(i, nearest_neighbors_cluster_i[i][inn]) = -A_i_grad_t[inn];
+							}
+							D_grad_cluster_i[num_par_gp - 1].coeffRef(i, i) -= A_i_grad_t.dot(cov_mat_obs_neighbors.col(0));
 						}
-						D_grad_cluster_i[num_par_gp - 1].coeffRef(i, i) -= (A_i_grad_sigma2 * cov_mat_obs_neighbors)(0, 0);
 					}
 				}//end calc_gradient
-			}//end if i > 0
+			}//end if num_nn > 0
 			if (calc_cov_factor) {
-				D_inv_cluster_i.coeffRef(i, i) = 1. / D_inv_cluster_i.coeffRef(i, i);
+				for (data_size_t i = i_start; i < i_start + batch_size; ++i) {
+					D_inv_cluster_i.coeffRef(i, i) = 1. / D_inv_cluster_i.coeffRef(i, i);
+				}
 			}
-		}//end loop over data i
+		}//end loop over batches
 		if (calc_cov_factor) {
 			Eigen::Index minRow, minCol;
 			double min_D_inv = D_inv_cluster_i.diagonal().minCoeff(&minRow, &minCol);
@@ -8,6 +8,7 @@
 #include <LightGBM/boosting.h>
 #include <LightGBM/dataset.h>
 #include <LightGBM/meta.h>
+#include <LightGBM/tree.h>
 #include <LightGBM/utils/openmp_wrapper.h>
 #include <LightGBM/utils/text_reader.h>
 
@@ -58,7 +59,13 @@ class Predictor {
     }
 
     boosting->InitPredict(start_iteration, num_iteration, predict_contrib);
+    if (predict_contrib) {
+      boosting->InitContribPaths(start_iteration, num_iteration, &contrib_paths_);
+    }
     boosting_ = boosting;
+    is_raw_score_ = is_raw_score;
+    predict_leaf_index_ = predict_leaf_index;
+    predict_contrib_ = predict_contrib;
     num_pred_one_row_ = boosting_->NumPredictOneRow(start_iteration,
         num_iteration, predict_leaf_index, predict_contrib);
     num_feature_ = boosting_->MaxFeatureIdx() + 1;
@@ -152,6 +159,45 @@ class Predictor {
     return predict_sparse_fun_;
   }
 
+  /*!
+  * \brief Predict one row that is already in a dense buffer of size MaxFeatureIdx() + 1,
+  *        the buffer is owned by the caller, so this can be called from any thread
+  * \param features Dense feature values
+  * \param output Prediction result, num_pred_one_row values
+  */
+  inline void PredictDense(const double* features, double* output) const {
+    if (predict_leaf_index_) {
+      boosting_->PredictLeafIndex(features, output);
+    } else if (predict_contrib_) {
+      boosting_->PredictContrib(features, output);
+    } else if (is_raw_score_) {
+      boosting_->PredictRaw(features, output, &early_stop_);
+    } else {
+      boosting_->Predict(features, output, &early_stop_);
+    }
+  }
+
+  /*!
+  * \brief Feature contributions for a block of rows (only if the predictor has been created with predict_contrib),
+  *        the trees are evaluated for all rows of the block at once (see Tree::PredictContribBlock).
+  *        This can be called from any thread
+  * \param rows Feature values of the rows
+  * \param output Prediction results of the rows, num_pred_one_row values per row
+  */
+  void PredictContribBlock(const std::vector<std::vector<std::pair<int, double>>>& rows, double* output) const {
+    CHECK(predict_contrib_);
+    std::vector<double> buf(rows.size() * num_feature_, 0.0f);
+    for (size_t i = 0; i < rows.size(); ++i) {
+      double* row_buf = buf.data() + i * num_feature_;
+      for (const auto &feature : rows[i]) {
+        if (feature.first < num_feature_) {
+          row_buf[feature.first] = feature.second;
+        }
+      }
+    }
+    boosting_->PredictContribBlock(contrib_paths_, buf.data(), static_cast<int>(rows.size()), output);
+  }
+
   /*!
   * \brief predicting on data, then saving result to disk
   * \param data_filename Filename of data
@@ -289,6 +335,11 @@ class Predictor {
   int num_feature_;
   int num_pred_one_row_;
   std::vector<std::vector<double, Common::AlignmentAllocator<double, kAlignedSize>>> predict_buf_;
+  bool is_raw_score_;
+  bool predict_leaf_index_;
+  bool predict_contrib_;
+  /*! \brief Paths of the trees for PredictContribBlock, owned by the predictor such that concurrent predictions do not change the trees */
+  std::vector<TreeContribPaths> contrib_paths_;
 };
 
 }  // namespace LightGBM
@@ -4,6 +4,9 @@
  */
 #include <LightGBM/boosting.h>
 
+#include <LightGBM/shared_model.h>
+#include <LightGBM/utils/file_io.h>
+
 #include "dart.hpp"
 #include "gbdt.h"
 #include "goss.hpp"
@@ -11,7 +14,19 @@
 
 namespace LightGBM {
 
+bool IsSharedModelFile(const char* filename) {
+  auto reader = VirtualFileReader::Make(filename);
+  char magic[sizeof(kSharedModelMagic)];
+  if (!reader->Init() || reader->Read(magic, sizeof(magic)) != sizeof(magic)) {
+    return false;
+  }
+  return IsSharedModel(magic, sizeof(magic));
+}
+
 std::string GetBoostingTypeFromModelFile(const char* filename) {
+  if (IsSharedModelFile(filename)) {
+    return "tree";
+  }
   TextReader<size_t> model_reader(filename, true);
   std::string type = model_reader.first_line();
   return type;
@@ -19,7 +34,13 @@ std::string GetBoostingTypeFromModelFile(const char* filename) {
 
 bool Boosting::LoadFileToBoosting(Boosting* boosting, const char* filename) {
   auto start_time = std::chrono::steady_clock::now();
-  if (boosting != nullptr) {
+  if (boosting != nullptr && IsSharedModelFile(filename)) {
+    // the trees are copied directly from the mapped file
+    MappedFile model_file(filename);
+    if (!boosting->LoadModelFromSharedModel(model_file.data(), model_file.size())) {
+      return false;
+    }
+  } else if (boosting != nullptr) {
     TextReader<size_t> model_reader(filename, true);
     size_t buffer_len = 0;
     auto buffer = model_reader.ReadContent(&buffer_len);
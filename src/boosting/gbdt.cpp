@@ -119,6 +119,7 @@ namespace LightGBM {
 			size_t total_size = static_cast<size_t>(num_data_)* num_tree_per_iteration_;
 			gradients_.resize(total_size);
 			hessians_.resize(total_size);
+			objective_function_->ResetConstantHessians();
 		}
 		// get max feature index
 		max_feature_idx_ = train_data_->num_total_features() - 1;
@@ -419,6 +420,11 @@ namespace LightGBM {
 		// bagging logic
 		Bagging(iter_);
 
+		// the lagged estimation of the covariance parameters of the GPBoost algorithm runs while the tree is grown
+		const bool lagged_cov_pars = objective_function_ != nullptr && objective_function_->HasGPModel();
+		if (lagged_cov_pars) {
+			objective_function_->StartLaggedCovParEstimation();
+		}
 		bool should_continue = false;
 		for (int cur_tree_id = 0; cur_tree_id < num_tree_per_iteration_; ++cur_tree_id) {
 			const size_t offset = static_cast<size_t>(cur_tree_id)* num_data_;
@@ -428,9 +434,15 @@ namespace LightGBM {
 				auto hess = hessians + offset;
 				// need to copy gradients for bagging subset.
 				if (is_use_subset_ && bag_data_cnt_ < num_data_) {
+					// constant hessians in the own buffer are the same at every position and are not copied
+					const bool copy_hessians = !is_constant_hessian_ || hess != hessians_.data() + offset;
 					for (int i = 0; i < bag_data_cnt_; ++i) {
 						gradients_[offset + i] = grad[bag_data_indices_[i]];
-						hessians_[offset + i] = hess[bag_data_indices_[i]];
+					}
+					if (copy_hessians) {
+						for (int i = 0; i < bag_data_cnt_; ++i) {
+							hessians_[offset + i] = hess[bag_data_indices_[i]];
+						}
 					}
 					grad = gradients_.data() + offset;
 					hess = hessians_.data() + offset;
@@ -438,6 +450,12 @@ namespace LightGBM {
 				bool is_first_tree = models_.size() < static_cast<size_t>(num_tree_per_iteration_);
 				new_tree.reset(tree_learner_->Train(grad, hess, is_first_tree));
 			}
+			if (lagged_cov_pars) {
+				// Note: the tree has been fitted to gradients calculated with the previous covariance parameters, but the line search
+				//	and the Newton updates of the leaves below already use the parameters of the estimation that has just finished.
+				//	The step length is thus chosen for the model that the next gradients are calculated with
+				objective_function_->FinishLaggedCovParEstimation();
+			}
 
 			if (new_tree->num_leaves() > 1) {
 				should_continue = true;
@@ -719,6 +737,34 @@ namespace LightGBM {
 		}
 	}
 
+	void GBDT::InitContribPaths(int start_iteration, int num_iteration, std::vector<TreeContribPaths>* paths) const {
+		int start_iteration_for_pred, num_iteration_for_pred;
+		PredictIterationRange(start_iteration, num_iteration, &start_iteration_for_pred, &num_iteration_for_pred);
+		paths->clear();
+		paths->resize(models_.size());
+		const int start_tree = start_iteration_for_pred * num_tree_per_iteration_;
+		const int end_tree = (start_iteration_for_pred + num_iteration_for_pred) * num_tree_per_iteration_;
+#pragma omp parallel for schedule(static)
+		for (int i = start_tree; i < end_tree; ++i) {
+			models_[i]->InitContribPaths(&((*paths)[i]));
+		}
+	}
+
+	void GBDT::PredictContribBlock(const std::vector<TreeContribPaths>& paths, const double* features, int num_rows, double* output) const {
+		// set zero
+		const int num_features = max_feature_idx_ + 1;
+		const int64_t num_pred_one_row = static_cast<int64_t>(num_tree_per_iteration_) * (num_features + 1);
+		std::memset(output, 0, sizeof(double) * num_pred_one_row * num_rows);
+		// the trees used for the prediction are those with initialized paths
+		for (int i = 0; i < static_cast<int>(paths.size()); ++i) {
+			if (!paths[i].begin.empty()) {
+				const int k = i % num_tree_per_iteration_;
+				models_[i]->PredictContribBlock(paths[i], features, num_rows, num_features,
+					output + k * (num_features + 1), num_pred_one_row);
+			}
+		}
+	}
+
 	void GBDT::GetPredictAt(int data_idx, double* out_result, int64_t* out_len) {
 		CHECK(data_idx >= 0 && data_idx <= static_cast<int>(valid_score_updater_.size()));
 
@@ -818,6 +864,7 @@ namespace LightGBM {
 				size_t total_size = static_cast<size_t>(num_data_)* num_tree_per_iteration_;
 				gradients_.resize(total_size);
 				hessians_.resize(total_size);
+				objective_function_->ResetConstantHessians();
 			}
 
 			max_feature_idx_ = train_data_->num_total_features() - 1;
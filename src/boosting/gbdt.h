@@ -251,6 +251,11 @@ class GBDT : public GBDTBase {
   void PredictContribByMap(const std::unordered_map<int, double>& features,
                            std::vector<std::unordered_map<int, double>>* output) const override;
 
+  void InitContribPaths(int start_iteration, int num_iteration, std::vector<TreeContribPaths>* paths) const override;
+
+  void PredictContribBlock(const std::vector<TreeContribPaths>& paths, const double* features, int num_rows,
+                           double* output) const override;
+
   /*!
   * \brief Dump model to json format string
   * \param start_iteration The model will be saved start from
@@ -297,11 +302,25 @@ class GBDT : public GBDTBase {
   */
   std::string SaveModelToString(int start_iteration, int num_iterations, int feature_importance_type) const override;
 
+  /*!
+  * \brief Save model to a file in the shared model format
+  * \param start_iteration The model will be saved start from
+  * \param num_iterations Number of model that want to save, -1 means save all
+  * \param filename Filename that want to save to
+  * \return true if succeeded
+  */
+  bool SaveSharedModelToFile(int start_iteration, int num_iterations, const char* filename) const override;
+
   /*!
   * \brief Restore from a serialized buffer
   */
   bool LoadModelFromString(const char* buffer, size_t len) override;
 
+  /*!
+  * \brief Restore from a buffer in the shared model format
+  */
+  bool LoadModelFromSharedModel(const char* buffer, size_t len) override;
+
   /*!
   * \brief Calculate feature importances
   * \param num_iteration Number of model that want to use for feature importance, -1 means use all
@@ -358,16 +377,28 @@ class GBDT : public GBDTBase {
   */
   inline int NumberOfClasses() const override { return num_class_; }
 
-  inline void InitPredict(int start_iteration, int num_iteration, bool is_pred_contrib) override {
-    num_iteration_for_pred_ = static_cast<int>(models_.size()) / num_tree_per_iteration_;
+  /*!
+  * \brief Range of the iterations used for prediction (see InitPredict)
+  * \param start_iteration Start index of the iteration to predict
+  * \param num_iteration Number of used iterations, <= 0 means all remaining iterations
+  * \param[out] start_iteration_for_pred Start index after clipping to the number of iterations of the model
+  * \param[out] num_iteration_for_pred Number of used iterations after clipping to the number of iterations of the model
+  */
+  inline void PredictIterationRange(int start_iteration, int num_iteration,
+                                    int* start_iteration_for_pred, int* num_iteration_for_pred) const {
+    const int num_total_iteration = static_cast<int>(models_.size()) / num_tree_per_iteration_;
     start_iteration = std::max(start_iteration, 0);
-    start_iteration = std::min(start_iteration, num_iteration_for_pred_);
+    start_iteration = std::min(start_iteration, num_total_iteration);
     if (num_iteration > 0) {
-      num_iteration_for_pred_ = std::min(num_iteration, num_iteration_for_pred_ - start_iteration);
+      *num_iteration_for_pred = std::min(num_iteration, num_total_iteration - start_iteration);
     } else {
-      num_iteration_for_pred_ = num_iteration_for_pred_ - start_iteration;
+      *num_iteration_for_pred = num_total_iteration - start_iteration;
     }
-    start_iteration_for_pred_ = start_iteration;
+    *start_iteration_for_pred = start_iteration;
+  }
+
+  inline void InitPredict(int start_iteration, int num_iteration, bool is_pred_contrib) override {
+    PredictIterationRange(start_iteration, num_iteration, &start_iteration_for_pred_, &num_iteration_for_pred_);
     if (is_pred_contrib) {
       #pragma omp parallel for schedule(static)
       for (int i = 0; i < static_cast<int>(models_.size()); ++i) {
@@ -395,25 +426,6 @@ class GBDT : public GBDTBase {
 
   bool IsLinear() const override { return linear_tree_; }
 
-  /*! \brief Nesterov schedule */
-  inline double NesterovSchedule(int iter, int momentum_schedule_version = 0,
-      double nesterov_acc_rate = 0.5, int momentum_offset = 0) const {
-      if (iter < momentum_offset) {
-          return(0.);
-      }
-      else {
-          if (momentum_schedule_version == 0) {
-              return(nesterov_acc_rate);
-          }
-          else if (momentum_schedule_version == 1) {
-              return(1. - (3. / (6. + iter)));
-          }
-          else {
-              return(0.);
-          }
-      }
-  }
-
  protected:
   virtual bool GetIsConstHessian(const ObjectiveFunction* objective_function) {
     if (objective_function != nullptr) {
@@ -422,6 +434,12 @@ class GBDT : public GBDTBase {
       return false;
     }
   }
+  /*!
+  * \brief Save model to string in the text model format
+  * \param save_trees If false, the trees are omitted (used for the meta section of a shared model)
+  */
+  std::string ModelToString(int start_iteration, int num_iterations, int feature_importance_type, bool save_trees) const;
+
   /*!
   * \brief Print eval result and check early stopping
   */
@@ -5,9 +5,11 @@
 #include <LightGBM/config.h>
 #include <LightGBM/metric.h>
 #include <LightGBM/objective_function.h>
+#include <LightGBM/shared_model.h>
 #include <LightGBM/utils/array_args.h>
 #include <LightGBM/utils/common.h>
 
+#include <cstring>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -312,6 +314,10 @@ namespace LightGBM {
 	}
 
 	std::string GBDT::SaveModelToString(int start_iteration, int num_iteration, int feature_importance_type) const {
+		return ModelToString(start_iteration, num_iteration, feature_importance_type, true);
+	}
+
+	std::string GBDT::ModelToString(int start_iteration, int num_iteration, int feature_importance_type, bool save_trees) const {
 		std::stringstream ss;
 		Common::C_stringstream(ss);
 
@@ -354,23 +360,25 @@ namespace LightGBM {
 
 		int start_model = start_iteration * num_tree_per_iteration_;
 
-		std::vector<std::string> tree_strs(num_used_model - start_model);
-		std::vector<size_t> tree_sizes(num_used_model - start_model);
-		// output tree models
+		if (save_trees) {
+			std::vector<std::string> tree_strs(num_used_model - start_model);
+			std::vector<size_t> tree_sizes(num_used_model - start_model);
+			// output tree models
 #pragma omp parallel for schedule(static)
-		for (int i = start_model; i < num_used_model; ++i) {
-			const int idx = i - start_model;
-			tree_strs[idx] = "Tree=" + std::to_string(idx) + '\n';
-			tree_strs[idx] += models_[i]->ToString() + '\n';
-			tree_sizes[idx] = tree_strs[idx].size();
-		}
+			for (int i = start_model; i < num_used_model; ++i) {
+				const int idx = i - start_model;
+				tree_strs[idx] = "Tree=" + std::to_string(idx) + '\n';
+				tree_strs[idx] += models_[i]->ToString() + '\n';
+				tree_sizes[idx] = tree_strs[idx].size();
+			}
 
-		ss << "tree_sizes=" << CommonC::Join(tree_sizes, " ") << '\n';
-		ss << '\n';
+			ss << "tree_sizes=" << CommonC::Join(tree_sizes, " ") << '\n';
+			ss << '\n';
 
-		for (int i = 0; i < num_used_model - start_model; ++i) {
-			ss << tree_strs[i];
-			tree_strs[i].clear();
+			for (int i = 0; i < num_used_model - start_model; ++i) {
+				ss << tree_strs[i];
+				tree_strs[i].clear();
+			}
 		}
 		ss << "end of trees" << "\n";
 		std::vector<double> feature_importances = FeatureImportance(
@@ -417,6 +425,106 @@ namespace LightGBM {
 		return size > 0;
 	}
 
+	bool GBDT::SaveSharedModelToFile(int start_iteration, int num_iteration, const char* filename) const {
+		int num_used_model = static_cast<int>(models_.size());
+		int total_iteration = num_used_model / num_tree_per_iteration_;
+		start_iteration = std::max(start_iteration, 0);
+		start_iteration = std::min(start_iteration, total_iteration);
+		if (num_iteration > 0) {
+			int end_iteration = start_iteration + num_iteration;
+			num_used_model = std::min(end_iteration * num_tree_per_iteration_, num_used_model);
+		}
+		int start_model = start_iteration * num_tree_per_iteration_;
+		const int num_trees = num_used_model - start_model;
+		// serialize the trees in parallel and concatenate them
+		std::vector<std::string> tree_buffers(num_trees);
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < num_trees; ++i) {
+			models_[start_model + i]->AppendToSharedModel(&tree_buffers[i]);
+		}
+		std::vector<int64_t> tree_offsets(num_trees + 1, 0);
+		for (int i = 0; i < num_trees; ++i) {
+			tree_offsets[i + 1] = tree_offsets[i] + static_cast<int64_t>(tree_buffers[i].size());
+		}
+		// the meta section is the text model without trees (with split feature importances)
+		std::string meta = ModelToString(start_iteration, num_iteration, 0, false);
+		std::string objective = objective_function_ != nullptr ? objective_function_->ToString() : std::string();
+		SharedModelHeader header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, kSharedModelMagic, sizeof(kSharedModelMagic));
+		header.version = kSharedModelVersion;
+		header.num_sections = kNumSharedModelSections;
+		header.num_trees = num_trees;
+		header.num_tree_per_iteration = num_tree_per_iteration_;
+		header.max_feature_idx = max_feature_idx_;
+		header.average_output = average_output_ ? 1 : 0;
+		header.use_nesterov_acc = use_nesterov_acc_ ? 1 : 0;
+		header.momentum_schedule_version = momentum_schedule_version_;
+		header.momentum_offset = momentum_offset_;
+		header.nesterov_acc_rate = nesterov_acc_rate_;
+		std::string buffer;
+		AppendToSharedModelBuffer(&buffer, &header, sizeof(header));
+		SharedModelSectionEntry& meta_section = header.sections[kSharedModelMetaSection];
+		meta_section.offset = AppendToSharedModelBuffer(&buffer, meta.c_str(), meta.size() + 1);
+		meta_section.size = static_cast<int64_t>(meta.size() + 1);
+		SharedModelSectionEntry& objective_section = header.sections[kSharedModelObjectiveSection];
+		objective_section.offset = AppendToSharedModelBuffer(&buffer, objective.data(), objective.size());
+		objective_section.size = static_cast<int64_t>(objective.size());
+		SharedModelSectionEntry& offsets_section = header.sections[kSharedModelTreeOffsetsSection];
+		offsets_section.offset = AppendToSharedModelBuffer(&buffer, tree_offsets.data(), tree_offsets.size() * sizeof(int64_t));
+		offsets_section.size = static_cast<int64_t>(tree_offsets.size() * sizeof(int64_t));
+		SharedModelSectionEntry& trees_section = header.sections[kSharedModelTreesSection];
+		trees_section.offset = AppendToSharedModelBuffer(&buffer, nullptr, 0);
+		buffer.reserve(buffer.size() + static_cast<size_t>(tree_offsets.back()));
+		for (int i = 0; i < num_trees; ++i) {
+			buffer.append(tree_buffers[i]);
+			std::string().swap(tree_buffers[i]);
+		}
+		trees_section.size = tree_offsets.back();
+		for (int i = 0; i < kNumSharedModelSections; ++i) {
+			header.sections[i].checksum = SharedModelChecksum(buffer.data() + header.sections[i].offset,
+				static_cast<size_t>(header.sections[i].size));
+		}
+		header.file_size = static_cast<int64_t>(buffer.size());
+		std::memcpy(&buffer[0], &header, sizeof(header));
+		auto writer = VirtualFileWriter::Make(filename);
+		if (!writer->Init()) {
+			Log::Fatal("Model file %s is not available for writes", filename);
+		}
+		auto size = writer->Write(buffer.data(), buffer.size());
+		return size > 0;
+	}
+
+	bool GBDT::LoadModelFromSharedModel(const char* buffer, size_t len) {
+		const SharedModelHeader* header = CheckSharedModel(buffer, len);
+		// header, feature information, objective and parameters
+		const SharedModelSectionEntry& meta_section = header->sections[kSharedModelMetaSection];
+		if (!LoadModelFromString(buffer + meta_section.offset, static_cast<size_t>(meta_section.size - 1))) {
+			return false;
+		}
+		if (header->num_tree_per_iteration != num_tree_per_iteration_ || header->max_feature_idx != max_feature_idx_) {
+			Log::Fatal("Shared model is truncated or corrupted");
+		}
+		// trees
+		const int64_t* tree_offsets = SharedModelTreeOffsets(buffer, header);
+		const char* trees = buffer + header->sections[kSharedModelTreesSection].offset;
+		const int num_trees = header->num_trees;
+		models_.resize(num_trees);
+		OMP_INIT_EX();
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < num_trees; ++i) {
+			OMP_LOOP_EX_BEGIN();
+			models_[i].reset(new Tree(reinterpret_cast<const SharedTreeHeader*>(trees + tree_offsets[i]),
+				static_cast<size_t>(tree_offsets[i + 1] - tree_offsets[i])));
+			OMP_LOOP_EX_END();
+		}
+		OMP_THROW_EX();
+		num_iteration_for_pred_ = static_cast<int>(models_.size()) / num_tree_per_iteration_;
+		num_init_iteration_ = num_iteration_for_pred_;
+		iter_ = 0;
+		return true;
+	}
+
 	bool GBDT::LoadModelFromString(const char* buffer, size_t len) {
 		// use serialized string to restore this object
 		models_.clear();
@@ -428,7 +536,8 @@ namespace LightGBM {
 			auto line_len = Common::GetLine(p);
 			if (line_len > 0) {
 				std::string cur_line(p, line_len);
-				if (!Common::StartsWith(cur_line, "Tree=")) {
+				// models without trees (e.g., the meta section of a shared model) continue with "end of trees"
+				if (!Common::StartsWith(cur_line, "Tree=") && cur_line != std::string("end of trees")) {
 					auto strs = Common::Split(cur_line.c_str(), '=');
 					if (strs.size() == 1) {
 						key_vals[strs[0]] = "";
@@ -20,17 +20,9 @@ namespace LightGBM {
 		const int end_iteration_for_pred = start_iteration_for_pred_ + num_iteration_for_pred_;
 		for (int i = start_iteration_for_pred_; i < end_iteration_for_pred; ++i) {
 			// apply momentum step
-			if (use_nesterov_acc_ && i > 0) {
-				if (i == 1) {//// initialize lag1 for momentum step
-					pred_lag1 = std::vector<double>(num_tree_per_iteration_);
-					for (int j = 0; j < num_tree_per_iteration_; ++j) {
-						pred_lag1[j] = output[j];
-					}
-				}
-				else {
-					double mu = NesterovSchedule(i, momentum_schedule_version_, nesterov_acc_rate_, momentum_offset_);
-					DoOneMomentumStep(output, pred_lag1.data(), (int64_t)num_tree_per_iteration_, mu);
-				}
+			if (use_nesterov_acc_) {
+				PredictionMomentumStep(i, num_tree_per_iteration_, momentum_schedule_version_, nesterov_acc_rate_, momentum_offset_,
+					output, &pred_lag1);
 			}
 			// predict all the trees for one iteration
 			for (int k = 0; k < num_tree_per_iteration_; ++k) {
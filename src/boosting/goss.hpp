@@ -165,6 +165,10 @@ class GOSS: public GBDT {
         },
         bag_data_indices_.data());
     bag_data_cnt_ = left_cnt;
+    // hessians of the sampled small-gradient data have been rescaled
+    if (objective_function_ != nullptr) {
+      objective_function_->ResetConstantHessians();
+    }
     // set bagging data to tree learner
     if (!is_use_subset_) {
       tree_learner_->SetBaggingData(nullptr, bag_data_indices_.data(), bag_data_cnt_);
@@ -10,6 +10,7 @@
 #include <LightGBM/c_api.h>
 
 #include <GPBoost/re_model.h>
+#include <GPBoost/re_model_folds.h>
 
 #include <LightGBM/boosting.h>
 #include <LightGBM/config.h>
@@ -19,6 +20,7 @@
 #include <LightGBM/network.h>
 #include <LightGBM/objective_function.h>
 #include <LightGBM/prediction_early_stop.h>
+#include <LightGBM/shared_model.h>
 #include <LightGBM/utils/common.h>
 #include <LightGBM/utils/log.h>
 #include <LightGBM/utils/openmp_wrapper.h>
@@ -39,6 +41,7 @@
 #include <LightGBM/utils/yamc/yamc_shared_lock.hpp>
 
 using GPBoost::REModel;
+using GPBoost::REModelFolds;
 
 namespace LightGBM {
 
@@ -65,6 +68,8 @@ std::unique_lock<yamc::alternate::shared_mutex> lock(mtx);
 yamc::shared_lock<yamc::alternate::shared_mutex> lock(&mtx);
 
 	const int PREDICTOR_TYPES = 4;
+	// number of rows for which feature contributions are calculated at once
+	const int kPredictContribBlockRows = 64;
 
 	// Single row predictor to abstract away caching logic
 	class SingleRowPredictor {
@@ -94,10 +99,30 @@ yamc::shared_lock<yamc::alternate::shared_mutex> lock(&mtx);
 			num_pred_in_one_row = boosting->NumPredictOneRow(start_iter, iter_, is_predict_leaf, predict_contrib);
 			predict_function = predictor_->GetPredictFunction();
 			num_total_model_ = boosting->NumberOfTotalModel();
+			num_feature_ = boosting->MaxFeatureIdx() + 1;
 		}
 
 		~SingleRowPredictor() {}
 
+		/*!
+		* \brief Predict rows of a row-major dense matrix, every row is copied straight into
+		*        the caller owned feature buffer instead of going through (index, value) pairs
+		*/
+		template<typename T>
+		void PredictDenseRows(const T* data, int32_t nrow, int32_t ncol, double* feature_buf, double* out_result) const {
+			const int num_copy = std::min(ncol, num_feature_);
+			for (int32_t i = 0; i < nrow; ++i) {
+				const T* row = data + static_cast<size_t>(ncol) * i;
+				for (int j = 0; j < num_copy; ++j) {
+					const double val = static_cast<double>(row[j]);
+					feature_buf[j] = (std::fabs(val) > kZeroThreshold || std::isnan(val)) ? val : 0.0;
+				}
+				predictor_->PredictDense(feature_buf, out_result + num_pred_in_one_row * i);
+			}
+		}
+
+		int num_feature() const { return num_feature_; }
+
 		bool IsPredictorEqual(const Config& config, int iter, Boosting* boosting) {
 			return early_stop_ == config.pred_early_stop &&
 				early_stop_freq_ == config.pred_early_stop_freq &&
@@ -113,6 +138,7 @@ yamc::shared_lock<yamc::alternate::shared_mutex> lock(&mtx);
 		double early_stop_margin_;
 		int iter_;
 		int num_total_model_;
+		int num_feature_;
 	};
 
 	class Booster {
@@ -493,6 +519,32 @@ yamc::shared_lock<yamc::alternate::shared_mutex> lock(&mtx);
 			*out_len = single_row_predictor->num_pred_in_one_row;
 		}
 
+		void PredictDenseRows(int predict_type, const void* data, int data_type, int32_t nrow, int32_t ncol,
+			const Config& config, std::vector<double>* feature_buf,
+			double* out_result, int64_t* out_len) const {
+			if (!config.predict_disable_shape_check && ncol != boosting_->MaxFeatureIdx() + 1) {
+				Log::Fatal("The number of features in data (%d) is not the same as it was in training data (%d).\n"\
+					"You can set ``predict_disable_shape_check=true`` to discard this error, but please be aware what you are doing.", ncol, boosting_->MaxFeatureIdx() + 1);
+			}
+			SHARED_LOCK(mutex_);
+			const auto& single_row_predictor = single_row_predictor_[predict_type];
+			if (feature_buf->size() != static_cast<size_t>(single_row_predictor->num_feature())) {
+				feature_buf->assign(single_row_predictor->num_feature(), 0.0);
+			}
+			if (data_type == C_API_DTYPE_FLOAT32) {
+				single_row_predictor->PredictDenseRows(reinterpret_cast<const float*>(data), nrow, ncol,
+					feature_buf->data(), out_result);
+			}
+			else if (data_type == C_API_DTYPE_FLOAT64) {
+				single_row_predictor->PredictDenseRows(reinterpret_cast<const double*>(data), nrow, ncol,
+					feature_buf->data(), out_result);
+			}
+			else {
+				Log::Fatal("Unknown data type in PredictDenseRows");
+			}
+			*out_len = single_row_predictor->num_pred_in_one_row * nrow;
+		}
+
 		Predictor CreatePredictor(int start_iteration, int num_iteration, int predict_type, int ncol, const Config& config) const {
 			if (!config.predict_disable_shape_check && ncol != boosting_->MaxFeatureIdx() + 1) {
 				Log::Fatal("The number of features in data (%d) is not the same as it was in training data (%d).\n" \
@@ -534,6 +586,27 @@ yamc::shared_lock<yamc::alternate::shared_mutex> lock(&mtx);
 				predict_contrib = true;
 			}
 			int64_t num_pred_in_one_row = boosting_->NumPredictOneRow(start_iteration, num_iteration, is_predict_leaf, predict_contrib);
+			if (predict_contrib) {
+				// feature contributions are calculated for blocks of rows
+				const int num_blocks = (nrow + kPredictContribBlockRows - 1) / kPredictContribBlockRows;
+				OMP_INIT_EX();
+#pragma omp parallel for schedule(static)
+				for (int block = 0; block < num_blocks; ++block) {
+					OMP_LOOP_EX_BEGIN();
+					const int row_begin = block * kPredictContribBlockRows;
+					const int row_end = std::min(row_begin + kPredictContribBlockRows, nrow);
+					std::vector<std::vector<std::pair<int, double>>> rows;
+					rows.reserve(row_end - row_begin);
+					for (int i = row_begin; i < row_end; ++i) {
+						rows.push_back(get_row_fun(i));
+					}
+					predictor.PredictContribBlock(rows, out_result + static_cast<size_t>(num_pred_in_one_row) * row_begin);
+					OMP_LOOP_EX_END();
+				}
+				OMP_THROW_EX();
+				*out_len = num_pred_in_one_row * nrow;
+				return;
+			}
 			auto pred_fun = predictor.GetPredictFunction();
 			OMP_INIT_EX();
 #pragma omp parallel for schedule(static)
@@ -842,6 +915,10 @@ yamc::shared_lock<yamc::alternate::shared_mutex> lock(&mtx);
 			boosting_->LoadModelFromString(model_str, len);
 		}
 
+		void SaveSharedModelToFile(int start_iteration, int num_iteration, const char* filename) const {
+			boosting_->SaveSharedModelToFile(start_iteration, num_iteration, filename);
+		}
+
 		std::string SaveModelToString(int start_iteration, int num_iteration,
 			int feature_importance_type) const {
 			return boosting_->SaveModelToString(start_iteration,
@@ -962,6 +1039,7 @@ using LightGBM::Log;
 using LightGBM::Network;
 using LightGBM::Random;
 using LightGBM::ReduceScatterFunction;
+using LightGBM::SharedModel;
 
 // some help functions used to convert data
 
@@ -1010,6 +1088,12 @@ int LGBM_RegisterLogCallback(void (*callback)(const char*)) {
 	API_END();
 }
 
+int LGBM_GetMaxThreads(int* out) {
+	API_BEGIN();
+	*out = omp_get_max_threads();
+	API_END();
+}
+
 int LGBM_DatasetCreateFromFile(const char* filename,
 	const char* parameters,
 	const DatasetHandle reference,
@@ -1965,6 +2049,8 @@ struct FastConfig {
 	const int predict_type;
 	const int data_type;
 	const int32_t ncol;
+	/*! \brief Dense feature buffer of this handle, used by LGBM_BoosterPredictForMatRowsFast */
+	std::vector<double> feature_buffer;
 };
 
 int LGBM_FastConfigFree(FastConfigHandle fastConfig) {
@@ -2328,6 +2414,19 @@ int LGBM_BoosterPredictForMatSingleRowFast(FastConfigHandle fastConfig_handle,
 	API_END();
 }
 
+int LGBM_BoosterPredictForMatRowsFast(FastConfigHandle fastConfig_handle,
+	const void* data,
+	const int32_t nrow,
+	int64_t* out_len,
+	double* out_result) {
+	API_BEGIN();
+	FastConfig* fastConfig = reinterpret_cast<FastConfig*>(fastConfig_handle);
+	fastConfig->booster->PredictDenseRows(fastConfig->predict_type, data, fastConfig->data_type,
+		nrow, fastConfig->ncol, fastConfig->config, &fastConfig->feature_buffer,
+		out_result, out_len);
+	API_END();
+}
+
 
 int LGBM_BoosterPredictForMats(BoosterHandle handle,
 	const void** data,
@@ -2365,6 +2464,79 @@ int LGBM_BoosterSaveModel(BoosterHandle handle,
 	API_END();
 }
 
+int LGBM_BoosterSaveSharedModel(BoosterHandle handle,
+	int start_iteration,
+	int num_iteration,
+	const char* filename) {
+	API_BEGIN();
+	Booster* ref_booster = reinterpret_cast<Booster*>(handle);
+	ref_booster->SaveSharedModelToFile(start_iteration, num_iteration, filename);
+	API_END();
+}
+
+int LGBM_SharedModelCreateFromFile(const char* filename,
+	SharedModelHandle* out) {
+	API_BEGIN();
+	auto ret = std::unique_ptr<SharedModel>(new SharedModel(filename));
+	*out = ret.release();
+	API_END();
+}
+
+int LGBM_SharedModelGetNumClasses(SharedModelHandle handle,
+	int* out_len) {
+	API_BEGIN();
+	SharedModel* ref_model = reinterpret_cast<SharedModel*>(handle);
+	*out_len = ref_model->NumberOfClasses();
+	API_END();
+}
+
+int LGBM_SharedModelPredictForMat(SharedModelHandle handle,
+	const void* data,
+	int data_type,
+	int32_t nrow,
+	int32_t ncol,
+	int is_row_major,
+	int predict_type,
+	int start_iteration,
+	int num_iteration,
+	int64_t* out_len,
+	double* out_result) {
+	API_BEGIN();
+	if (predict_type != C_API_PREDICT_NORMAL && predict_type != C_API_PREDICT_RAW_SCORE) {
+		Log::Fatal("Only normal and raw score predictions are supported for shared models");
+	}
+	const SharedModel* ref_model = reinterpret_cast<SharedModel*>(handle);
+	const int num_features = ref_model->NumFeatures();
+	if (ncol != num_features) {
+		Log::Fatal("The number of features in data (%d) is not the same as it was in training data (%d).", ncol, num_features);
+	}
+	const int num_class = ref_model->NumberOfClasses();
+	const bool is_raw_score = predict_type == C_API_PREDICT_RAW_SCORE;
+	auto get_row_fun = RowPairFunctionFromDenseMatric(data, nrow, ncol, data_type, is_row_major);
+	std::vector<std::vector<double>> features_buf(OMP_NUM_THREADS(), std::vector<double>(num_features, 0.));
+	OMP_INIT_EX();
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nrow; ++i) {
+		OMP_LOOP_EX_BEGIN();
+		std::vector<double>& features = features_buf[omp_get_thread_num()];
+		std::fill(features.begin(), features.end(), 0.);
+		for (const auto& feature : get_row_fun(i)) {
+			features[feature.first] = feature.second;
+		}
+		ref_model->Predict(features.data(), start_iteration, num_iteration, is_raw_score, out_result + static_cast<size_t>(num_class) * i);
+		OMP_LOOP_EX_END();
+	}
+	OMP_THROW_EX();
+	*out_len = static_cast<int64_t>(num_class) * nrow;
+	API_END();
+}
+
+int LGBM_SharedModelFree(SharedModelHandle handle) {
+	API_BEGIN();
+	delete reinterpret_cast<SharedModel*>(handle);
+	API_END();
+}
+
 int LGBM_BoosterSaveModelToString(BoosterHandle handle,
 	int start_iteration,
 	int num_iteration,
@@ -2754,6 +2926,186 @@ int GPB_REModelFree(REModelHandle handle) {
 	API_END();
 }
 
+int GPB_CreateREModelFolds(int32_t num_data,
+	const int32_t* cluster_ids_data,
+	const char* re_group_data,
+	int32_t num_re_group,
+	const double* re_group_rand_coef_data,
+	const int32_t* ind_effect_group_rand_coef,
+	int32_t num_re_group_rand_coef,
+	const int* drop_intercept_group_rand_effect,
+	int32_t num_gp,
+	const double* gp_coords_data,
+	const int dim_gp_coords,
+	const double* gp_rand_coef_data,
+	int32_t num_gp_rand_coef,
+	const char* cov_fct,
+	double cov_fct_shape,
+	const char* gp_approx,
+	double cov_fct_taper_range,
+	double cov_fct_taper_shape,
+	int num_neighbors,
+	const char* vecchia_ordering,
+	int num_ind_points,
+	double cover_tree_radius,
+	const char* ind_points_selection,
+	const char* likelihood,
+	double likelihood_additional_param,
+	const char* matrix_inversion_method,
+	int seed,
+	int num_parallel_threads,
+	int num_folds,
+	const int32_t* fold_ids,
+	REModelFoldsHandle* out) {
+	API_BEGIN();
+	std::unique_ptr<REModelFolds> ret;
+	ret.reset(new REModelFolds(num_data,
+		cluster_ids_data,
+		re_group_data,
+		num_re_group,
+		re_group_rand_coef_data,
+		ind_effect_group_rand_coef,
+		num_re_group_rand_coef,
+		drop_intercept_group_rand_effect,
+		num_gp,
+		gp_coords_data,
+		dim_gp_coords,
+		gp_rand_coef_data,
+		num_gp_rand_coef,
+		cov_fct,
+		cov_fct_shape,
+		gp_approx,
+		cov_fct_taper_range,
+		cov_fct_taper_shape,
+		num_neighbors,
+		vecchia_ordering,
+		num_ind_points,
+		cover_tree_radius,
+		ind_points_selection,
+		likelihood,
+		likelihood_additional_param,
+		matrix_inversion_method,
+		seed,
+		num_parallel_threads,
+		num_folds,
+		fold_ids));
+	*out = ret.release();
+	API_END();
+}
+
+int GPB_REModelFoldsGetTrainModel(REModelFoldsHandle handle,
+	int fold,
+	REModelHandle* out,
+	int32_t* out_num_data) {
+	API_BEGIN();
+	REModelFolds* ref_remodel_folds = reinterpret_cast<REModelFolds*>(handle);
+	*out = ref_remodel_folds->GetTrainModel(fold);
+	*out_num_data = ref_remodel_folds->NumData(fold, false);
+	API_END();
+}
+
+int GPB_REModelFoldsSetHeldOutPredictionData(REModelFoldsHandle handle,
+	int fold,
+	const char* vecchia_pred_type,
+	int num_neighbors_pred,
+	double cg_delta_conv_pred,
+	int nsim_var_pred,
+	int rank_pred_approx_matrix_lanczos,
+	int32_t* out_num_data_pred) {
+	API_BEGIN();
+	REModelFolds* ref_remodel_folds = reinterpret_cast<REModelFolds*>(handle);
+	ref_remodel_folds->SetHeldOutPredictionData(fold, vecchia_pred_type, num_neighbors_pred,
+		cg_delta_conv_pred, nsim_var_pred, rank_pred_approx_matrix_lanczos);
+	*out_num_data_pred = ref_remodel_folds->NumData(fold, true);
+	API_END();
+}
+
+int GPB_REModelFoldsFree(REModelFoldsHandle handle) {
+	API_BEGIN();
+	delete reinterpret_cast<REModelFolds*>(handle);
+	API_END();
+}
+
+int GPB_EstimateMemory(int32_t num_data,
+	int32_t num_re_group,
+	int32_t num_re_group_rand_coef,
+	int32_t num_gp,
+	int dim_gp_coords,
+	int32_t num_gp_rand_coef,
+	const char* gp_approx,
+	int num_neighbors,
+	int num_neighbors_pred,
+	int num_ind_points,
+	const char* likelihood,
+	const char* matrix_inversion_method,
+	int num_rand_vec_trace,
+	int32_t num_data_pred,
+	bool predict_cov_mat,
+	double* out_bytes) {
+	API_BEGIN();
+	std::string gp_approx_str = (gp_approx == nullptr) ? "none" : std::string(gp_approx);
+	std::string likelihood_str = (likelihood == nullptr) ? "gaussian" : std::string(likelihood);
+	bool gauss_likelihood = GPBoost::Likelihood<GPBoost::den_mat_t, GPBoost::chol_den_mat_t>::ParseLikelihoodAlias(likelihood_str) == "gaussian";
+	bool iterative = (matrix_inversion_method != nullptr) && std::string(matrix_inversion_method) == "iterative";
+	int num_re_group_total = num_re_group + num_re_group_rand_coef;
+	int num_gp_total = num_gp + num_gp_rand_coef;
+	// one variance per grouped random effect, a variance and a range per GP, and a nugget for Gaussian likelihoods
+	int num_cov_par = num_re_group_total + 2 * num_gp_total + (gauss_likelihood ? 1 : 0);
+	// same defaults as in a REModel
+	if (num_neighbors_pred <= 0) {
+		num_neighbors_pred = 2 * num_neighbors;
+	}
+	if (num_rand_vec_trace <= 0) {
+		num_rand_vec_trace = 50;
+	}
+	GPBoost::MemoryEstimate mem = GPBoost::EstimateMemoryREModel(num_data, num_re_group_total, num_gp_total, dim_gp_coords, gp_approx_str,
+		num_neighbors, num_neighbors_pred, num_ind_points, gauss_likelihood, iterative, num_rand_vec_trace, num_cov_par, num_data_pred, predict_cov_mat);
+	out_bytes[0] = mem.construction;
+	out_bytes[1] = mem.estimation;
+	out_bytes[2] = mem.prediction;
+	API_END();
+}
+
+int GPB_EstimateMemoryREModel(REModelHandle handle,
+	int32_t num_data_pred,
+	bool predict_cov_mat,
+	double* out_bytes) {
+	API_BEGIN();
+	REModel* ref_remodel = reinterpret_cast<REModel*>(handle);
+	GPBoost::MemoryEstimate mem = ref_remodel->EstimateMemory(num_data_pred, predict_cov_mat);
+	out_bytes[0] = mem.construction;
+	out_bytes[1] = mem.estimation;
+	out_bytes[2] = mem.prediction;
+	API_END();
+}
+
+int GPB_SetMemoryCap(REModelHandle handle,
+	double max_bytes) {
+	API_BEGIN();
+	REModel* ref_remodel = reinterpret_cast<REModel*>(handle);
+	ref_remodel->SetMemoryCap(max_bytes);
+	API_END();
+}
+
+int GPB_SetVecchiaDistanceCache(REModelHandle handle,
+	const char* policy,
+	double budget_bytes) {
+	API_BEGIN();
+	REModel* ref_remodel = reinterpret_cast<REModel*>(handle);
+	ref_remodel->SetVecchiaDistanceCache(policy, budget_bytes);
+	API_END();
+}
+
+int GPB_SetThreadBudget(REModelHandle handle,
+	int num_threads,
+	const int* cpu_ids,
+	int num_cpu_ids) {
+	API_BEGIN();
+	REModel* ref_remodel = reinterpret_cast<REModel*>(handle);
+	ref_remodel->SetThreadBudget(num_threads, cpu_ids, num_cpu_ids);
+	API_END();
+}
+
 int GPB_SetOptimConfig(REModelHandle handle,
 	double* init_cov_pars,
 	double lr,
@@ -2781,7 +3133,8 @@ int GPB_SetOptimConfig(REModelHandle handle,
 	int seed_rand_vec_trace,
 	int piv_chol_rank,
 	double* init_aux_pars,
-	bool estimate_aux_pars) {
+	bool estimate_aux_pars,
+	int fitc_streaming_block_size) {
 	API_BEGIN();
 	REModel* ref_remodel = reinterpret_cast<REModel*>(handle);
 	ref_remodel->SetOptimConfig(init_cov_pars,
@@ -2810,7 +3163,8 @@ int GPB_SetOptimConfig(REModelHandle handle,
 		seed_rand_vec_trace,
 		piv_chol_rank,
 		init_aux_pars,
-		estimate_aux_pars);
+		estimate_aux_pars,
+		fitc_streaming_block_size);
 	API_END();
 }
 
@@ -53,6 +53,15 @@ SEXP LGBM_HandleIsNull_R(SEXP handle) {
 	return Rf_ScalarLogical(R_ExternalPtrAddr(handle) == NULL);
 }
 
+SEXP LGBM_GetMaxThreads_R(SEXP out) {
+	int num_threads;
+	R_API_BEGIN();
+	CHECK_CALL(LGBM_GetMaxThreads(&num_threads));
+	INTEGER(out)[0] = num_threads;
+	R_API_END();
+	return R_NilValue;
+}
+
 void _DatasetFinalizer(SEXP handle) {
 	LGBM_DatasetFree_R(handle);
 }
@@ -361,6 +370,28 @@ SEXP LGBM_DatasetGetNumFeature_R(SEXP handle,
 	return R_NilValue;
 }
 
+// --- start Network interfaces
+
+SEXP LGBM_NetworkInit_R(SEXP machines,
+	SEXP local_listen_port,
+	SEXP listen_time_out,
+	SEXP num_machines) {
+	const char* machines_ptr = CHAR(PROTECT(Rf_asChar(machines)));
+	R_API_BEGIN();
+	CHECK_CALL(LGBM_NetworkInit(machines_ptr, Rf_asInteger(local_listen_port),
+		Rf_asInteger(listen_time_out), Rf_asInteger(num_machines)));
+	R_API_END();
+	UNPROTECT(1);
+	return R_NilValue;
+}
+
+SEXP LGBM_NetworkFree_R() {
+	R_API_BEGIN();
+	CHECK_CALL(LGBM_NetworkFree());
+	R_API_END();
+	return R_NilValue;
+}
+
 // --- start Booster interfaces
 
 void _BoosterFinalizer(SEXP handle) {
@@ -742,6 +773,61 @@ SEXP LGBM_BoosterPredictForMat_R(SEXP handle,
 	return R_NilValue;
 }
 
+template<typename T>
+std::vector<T> RowMajorFromColMajor(const double* p_mat, int32_t nrow, int32_t ncol) {
+	std::vector<T> row_major(static_cast<size_t>(nrow) * ncol);
+	for (int32_t i = 0; i < nrow; ++i) {
+		for (int32_t j = 0; j < ncol; ++j) {
+			row_major[static_cast<size_t>(i) * ncol + j] = static_cast<T>(p_mat[static_cast<size_t>(j) * nrow + i]);
+		}
+	}
+	return row_major;
+}
+
+SEXP LGBM_BoosterPredictForMatRowsFast_R(SEXP handle,
+	SEXP data,
+	SEXP num_row,
+	SEXP num_col,
+	SEXP is_float32,
+	SEXP is_rawscore,
+	SEXP is_leafidx,
+	SEXP is_predcontrib,
+	SEXP start_iteration,
+	SEXP num_iteration,
+	SEXP parameter,
+	SEXP out_result) {
+	int pred_type = GetPredictType(is_rawscore, is_leafidx, is_predcontrib);
+	int32_t nrow = static_cast<int32_t>(Rf_asInteger(num_row));
+	int32_t ncol = static_cast<int32_t>(Rf_asInteger(num_col));
+	const double* p_mat = REAL(data);
+	double* ptr_ret = REAL(out_result);
+	const char* parameter_ptr = CHAR(PROTECT(Rf_asChar(parameter)));
+	const bool use_float32 = Rf_asLogical(is_float32) == TRUE;
+	int64_t out_len;
+	FastConfigHandle fast_config = nullptr;
+	int ret = 0;
+	R_API_BEGIN();
+	std::vector<float> data_float32;
+	std::vector<double> data_float64;
+	const void* p_data;
+	if (use_float32) {
+		data_float32 = RowMajorFromColMajor<float>(p_mat, nrow, ncol);
+		p_data = data_float32.data();
+	} else {
+		data_float64 = RowMajorFromColMajor<double>(p_mat, nrow, ncol);
+		p_data = data_float64.data();
+	}
+	CHECK_CALL(LGBM_BoosterPredictForMatSingleRowFastInit(R_ExternalPtrAddr(handle), pred_type,
+		Rf_asInteger(start_iteration), Rf_asInteger(num_iteration),
+		use_float32 ? C_API_DTYPE_FLOAT32 : C_API_DTYPE_FLOAT64, ncol, parameter_ptr, &fast_config));
+	ret = LGBM_BoosterPredictForMatRowsFast(fast_config, p_data, nrow, &out_len, ptr_ret);
+	CHECK_CALL(LGBM_FastConfigFree(fast_config));
+	CHECK_CALL(ret);
+	R_API_END();
+	UNPROTECT(1);
+	return R_NilValue;
+}
+
 SEXP LGBM_BoosterSaveModel_R(SEXP handle,
 	SEXP num_iteration,
 	SEXP feature_importance_type,
@@ -806,6 +892,78 @@ SEXP LGBM_BoosterDumpModel_R(SEXP handle,
 	return model_str;
 }
 
+// --- start SharedModel interfaces
+
+void _SharedModelFinalizer(SEXP handle) {
+	LGBM_SharedModelFree_R(handle);
+}
+
+SEXP LGBM_BoosterSaveSharedModel_R(SEXP handle,
+	SEXP num_iteration,
+	SEXP filename) {
+	const char* filename_ptr = CHAR(PROTECT(Rf_asChar(filename)));
+	R_API_BEGIN();
+	CHECK_CALL(LGBM_BoosterSaveSharedModel(R_ExternalPtrAddr(handle), 0, Rf_asInteger(num_iteration), filename_ptr));
+	R_API_END();
+	UNPROTECT(1);
+	return R_NilValue;
+}
+
+SEXP LGBM_SharedModelCreateFromFile_R(SEXP filename) {
+	SEXP ret;
+	const char* filename_ptr = CHAR(PROTECT(Rf_asChar(filename)));
+	SharedModelHandle handle = nullptr;
+	R_API_BEGIN();
+	CHECK_CALL(LGBM_SharedModelCreateFromFile(filename_ptr, &handle));
+	R_API_END();
+	ret = PROTECT(R_MakeExternalPtr(handle, R_NilValue, R_NilValue));
+	R_RegisterCFinalizerEx(ret, _SharedModelFinalizer, TRUE);
+	UNPROTECT(2);
+	return ret;
+}
+
+SEXP LGBM_SharedModelGetNumClasses_R(SEXP handle,
+	SEXP out) {
+	int num_class;
+	R_API_BEGIN();
+	CHECK_CALL(LGBM_SharedModelGetNumClasses(R_ExternalPtrAddr(handle), &num_class));
+	INTEGER(out)[0] = num_class;
+	R_API_END();
+	return R_NilValue;
+}
+
+SEXP LGBM_SharedModelPredictForMat_R(SEXP handle,
+	SEXP data,
+	SEXP num_row,
+	SEXP num_col,
+	SEXP is_rawscore,
+	SEXP start_iteration,
+	SEXP num_iteration,
+	SEXP out_result) {
+	int pred_type = Rf_asInteger(is_rawscore) ? C_API_PREDICT_RAW_SCORE : C_API_PREDICT_NORMAL;
+	int32_t nrow = static_cast<int32_t>(Rf_asInteger(num_row));
+	int32_t ncol = static_cast<int32_t>(Rf_asInteger(num_col));
+	const double* p_mat = REAL(data);
+	double* ptr_ret = REAL(out_result);
+	int64_t out_len;
+	R_API_BEGIN();
+	CHECK_CALL(LGBM_SharedModelPredictForMat(R_ExternalPtrAddr(handle),
+		p_mat, C_API_DTYPE_FLOAT64, nrow, ncol, COL_MAJOR,
+		pred_type, Rf_asInteger(start_iteration), Rf_asInteger(num_iteration), &out_len, ptr_ret));
+	R_API_END();
+	return R_NilValue;
+}
+
+SEXP LGBM_SharedModelFree_R(SEXP handle) {
+	R_API_BEGIN();
+	if (!Rf_isNull(handle) && R_ExternalPtrAddr(handle)) {
+		CHECK_CALL(LGBM_SharedModelFree(R_ExternalPtrAddr(handle)));
+		R_ClearExternalPtr(handle);
+	}
+	R_API_END();
+	return R_NilValue;
+}
+
 // Below here are REModel / GPModel related functions
 
 void _REModelFinalizer(SEXP handle) {
@@ -908,6 +1066,121 @@ SEXP GPB_REModelFree_R(SEXP handle) {
 	return R_NilValue;
 }
 
+void _REModelFoldsFinalizer(SEXP handle) {
+	GPB_REModelFoldsFree_R(handle);
+}
+
+SEXP GPB_CreateREModelFolds_R(SEXP ndata,
+	SEXP cluster_ids_data,
+	SEXP re_group_data,
+	SEXP num_re_group,
+	SEXP re_group_rand_coef_data,
+	SEXP ind_effect_group_rand_coef,
+	SEXP num_re_group_rand_coef,
+	SEXP drop_intercept_group_rand_effect,
+	SEXP num_gp,
+	SEXP gp_coords_data,
+	SEXP dim_gp_coords,
+	SEXP gp_rand_coef_data,
+	SEXP num_gp_rand_coef,
+	SEXP cov_fct,
+	SEXP cov_fct_shape,
+	SEXP gp_approx,
+	SEXP cov_fct_taper_range,
+	SEXP cov_fct_taper_shape,
+	SEXP num_neighbors,
+	SEXP vecchia_ordering,
+	SEXP num_ind_points,
+	SEXP cover_tree_radius,
+	SEXP ind_points_selection,
+	SEXP likelihood,
+	SEXP likelihood_additional_param,
+	SEXP matrix_inversion_method,
+	SEXP seed,
+	SEXP num_parallel_threads,
+	SEXP num_folds,
+	SEXP fold_ids) {
+	SEXP ret;
+	REModelFoldsHandle handle = nullptr;
+	SEXP cov_fct_aux = PROTECT(Rf_asChar(cov_fct));
+	SEXP vecchia_ordering_aux = PROTECT(Rf_asChar(vecchia_ordering));
+	SEXP likelihood_aux = PROTECT(Rf_asChar(likelihood));
+	SEXP gp_approx_aux = PROTECT(Rf_asChar(gp_approx));
+	SEXP matrix_inversion_method_aux = PROTECT(Rf_asChar(matrix_inversion_method));
+	SEXP ind_points_selection_aux = PROTECT(Rf_asChar(ind_points_selection));
+	const char* cov_fct_ptr = (Rf_isNull(cov_fct)) ? nullptr : CHAR(cov_fct_aux);
+	const char* vecchia_ordering_ptr = (Rf_isNull(vecchia_ordering)) ? nullptr : CHAR(vecchia_ordering_aux);
+	const char* likelihood_ptr = (Rf_isNull(likelihood)) ? nullptr : CHAR(likelihood_aux);
+	const char* gp_approx_ptr = (Rf_isNull(gp_approx)) ? nullptr : CHAR(gp_approx_aux);
+	const char* matrix_inversion_method_ptr = (Rf_isNull(matrix_inversion_method)) ? nullptr : CHAR(matrix_inversion_method_aux);
+	const char* ind_points_selection_ptr = (Rf_isNull(ind_points_selection)) ? nullptr : CHAR(ind_points_selection_aux);
+	R_API_BEGIN();
+	CHECK_CALL(GPB_CreateREModelFolds(static_cast<int32_t>(Rf_asInteger(ndata)),
+		static_cast<int32_t*>(R_INT_PTR(cluster_ids_data)),
+		R_CHAR_PTR_FROM_RAW(re_group_data),
+		static_cast<int32_t>(Rf_asInteger(num_re_group)),
+		R_REAL_PTR(re_group_rand_coef_data),
+		static_cast<int32_t*>(R_INT_PTR(ind_effect_group_rand_coef)),
+		static_cast<int32_t>(Rf_asInteger(num_re_group_rand_coef)),
+		R_INT_PTR(drop_intercept_group_rand_effect),
+		static_cast<int32_t>(Rf_asInteger(num_gp)),
+		R_REAL_PTR(gp_coords_data),
+		Rf_asInteger(dim_gp_coords),
+		R_REAL_PTR(gp_rand_coef_data),
+		static_cast<int32_t>(Rf_asInteger(num_gp_rand_coef)),
+		cov_fct_ptr,
+		Rf_asReal(cov_fct_shape),
+		gp_approx_ptr,
+		Rf_asReal(cov_fct_taper_range),
+		Rf_asReal(cov_fct_taper_shape),
+		Rf_asInteger(num_neighbors),
+		vecchia_ordering_ptr,
+		Rf_asInteger(num_ind_points),
+		Rf_asReal(cover_tree_radius),
+		ind_points_selection_ptr,
+		likelihood_ptr,
+		Rf_asReal(likelihood_additional_param),
+		matrix_inversion_method_ptr,
+		Rf_asInteger(seed),
+		Rf_asInteger(num_parallel_threads),
+		Rf_asInteger(num_folds),
+		static_cast<int32_t*>(R_INT_PTR(fold_ids)),
+		&handle));
+	R_API_END();
+	ret = PROTECT(R_MakeExternalPtr(handle, R_NilValue, R_NilValue));
+	R_RegisterCFinalizerEx(ret, _REModelFoldsFinalizer, TRUE);
+	UNPROTECT(7);
+	return ret;
+}
+
+SEXP GPB_REModelFoldsGetTrainModel_R(SEXP handle,
+	SEXP fold) {
+	SEXP ret;
+	REModelHandle model_handle = nullptr;
+	int32_t num_data;
+	R_API_BEGIN();
+	CHECK_CALL(GPB_REModelFoldsGetTrainModel(R_ExternalPtrAddr(handle),
+		Rf_asInteger(fold),
+		&model_handle,
+		&num_data));
+	R_API_END();
+	// The model is owned by the REModelFolds. It is not freed by a finalizer, and the REModelFolds is kept alive
+	// (protected) as long as the returned handle is used
+	ret = PROTECT(R_MakeExternalPtr(model_handle, R_NilValue, handle));
+	UNPROTECT(1);
+	return ret;
+}
+
+SEXP GPB_REModelFoldsFree_R(SEXP handle) {
+	R_API_BEGIN();
+	if (R_ExternalPtrAddr(handle) != nullptr) {
+		CHECK_CALL(GPB_REModelFoldsFree(R_ExternalPtrAddr(handle)));
+		R_ClearExternalPtr(handle);
+	}
+	R_API_END();
+	return R_NilValue;
+}
+
 SEXP GPB_SetOptimConfig_R(SEXP handle,
 	SEXP init_cov_pars,
 	SEXP lr,
@@ -935,7 +1208,8 @@ SEXP GPB_SetOptimConfig_R(SEXP handle,
 	SEXP seed_rand_vec_trace,
 	SEXP piv_chol_rank,
 	SEXP init_aux_pars,
-	SEXP estimate_aux_pars) {
+	SEXP estimate_aux_pars,
+	SEXP fitc_streaming_block_size) {
 	SEXP optimizer_aux = PROTECT(Rf_asChar(optimizer));
 	SEXP convergence_criterion_aux = PROTECT(Rf_asChar(convergence_criterion));
 	SEXP optimizer_coef_aux = PROTECT(Rf_asChar(optimizer_coef));
@@ -972,12 +1246,25 @@ SEXP GPB_SetOptimConfig_R(SEXP handle,
 		Rf_asInteger(seed_rand_vec_trace),
 		Rf_asInteger(piv_chol_rank),
 		R_REAL_PTR(init_aux_pars),
-		Rf_asLogical(estimate_aux_pars)));
+		Rf_asLogical(estimate_aux_pars),
+		Rf_asInteger(fitc_streaming_block_size)));
 	R_API_END();
 	UNPROTECT(4);
 	return R_NilValue;
 }
 
+SEXP GPB_SetVecchiaDistanceCache_R(SEXP handle,
+	SEXP policy) {
+	SEXP policy_aux = PROTECT(Rf_asChar(policy));
+	R_API_BEGIN();
+	CHECK_CALL(GPB_SetVecchiaDistanceCache(R_ExternalPtrAddr(handle),
+		CHAR(policy_aux),
+		0.));
+	R_API_END();
+	UNPROTECT(1);
+	return R_NilValue;
+}
+
 SEXP GPB_OptimCovPar_R(SEXP handle,
 	SEXP y_data,
 	SEXP fixed_effects) {
@@ -1283,9 +1570,32 @@ SEXP GPB_GetInitAuxPars_R(SEXP handle,
 	return R_NilValue;
 }
 
+SEXP GPB_SetMemoryCap_R(SEXP handle,
+	SEXP max_bytes) {
+	R_API_BEGIN();
+	CHECK_CALL(GPB_SetMemoryCap(R_ExternalPtrAddr(handle),
+		Rf_asReal(max_bytes)));
+	R_API_END();
+	return R_NilValue;
+}
+
+SEXP GPB_EstimateMemoryREModel_R(SEXP handle,
+	SEXP num_data_pred,
+	SEXP predict_cov_mat,
+	SEXP out_bytes) {
+	R_API_BEGIN();
+	CHECK_CALL(GPB_EstimateMemoryREModel(R_ExternalPtrAddr(handle),
+		static_cast<int32_t>(Rf_asInteger(num_data_pred)),
+		Rf_asLogical(predict_cov_mat),
+		R_REAL_PTR(out_bytes)));
+	R_API_END();
+	return R_NilValue;
+}
+
 // .Call() calls
 static const R_CallMethodDef CallEntries[] = {
   {"LGBM_HandleIsNull_R"              , (DL_FUNC)&LGBM_HandleIsNull_R              , 1},
+  {"LGBM_GetMaxThreads_R"             , (DL_FUNC)&LGBM_GetMaxThreads_R             , 1},
   {"LGBM_DatasetCreateFromFile_R"     , (DL_FUNC)&LGBM_DatasetCreateFromFile_R     , 3},
   {"LGBM_DatasetCreateFromCSC_R"      , (DL_FUNC)&LGBM_DatasetCreateFromCSC_R      , 8},
   {"LGBM_DatasetCreateFromMat_R"      , (DL_FUNC)&LGBM_DatasetCreateFromMat_R      , 5},
@@ -1300,6 +1610,8 @@ static const R_CallMethodDef CallEntries[] = {
   {"LGBM_DatasetUpdateParamChecking_R", (DL_FUNC)&LGBM_DatasetUpdateParamChecking_R, 2},
   {"LGBM_DatasetGetNumData_R"         , (DL_FUNC)&LGBM_DatasetGetNumData_R         , 2},
   {"LGBM_DatasetGetNumFeature_R"      , (DL_FUNC)&LGBM_DatasetGetNumFeature_R      , 2},
+  {"LGBM_NetworkInit_R"               , (DL_FUNC)&LGBM_NetworkInit_R               , 4},
+  {"LGBM_NetworkFree_R"               , (DL_FUNC)&LGBM_NetworkFree_R               , 0},
   {"LGBM_BoosterCreate_R"             , (DL_FUNC)&LGBM_BoosterCreate_R             , 2},
   {"LGBM_GPBoosterCreate_R"           , (DL_FUNC)&LGBM_GPBoosterCreate_R           , 3},
   {"LGBM_BoosterFree_R"               , (DL_FUNC)&LGBM_BoosterFree_R               , 1},
@@ -1324,12 +1636,22 @@ static const R_CallMethodDef CallEntries[] = {
   {"LGBM_BoosterCalcNumPredict_R"     , (DL_FUNC)&LGBM_BoosterCalcNumPredict_R     , 8},
   {"LGBM_BoosterPredictForCSC_R"      , (DL_FUNC)&LGBM_BoosterPredictForCSC_R      , 14},
   {"LGBM_BoosterPredictForMat_R"      , (DL_FUNC)&LGBM_BoosterPredictForMat_R      , 11},
+  {"LGBM_BoosterPredictForMatRowsFast_R", (DL_FUNC)&LGBM_BoosterPredictForMatRowsFast_R, 12},
   {"LGBM_BoosterSaveModel_R"          , (DL_FUNC)&LGBM_BoosterSaveModel_R          , 4},
   {"LGBM_BoosterSaveModelToString_R"  , (DL_FUNC)&LGBM_BoosterSaveModelToString_R  , 4},
   {"LGBM_BoosterDumpModel_R"          , (DL_FUNC)&LGBM_BoosterDumpModel_R          , 3},
+  {"LGBM_BoosterSaveSharedModel_R"    , (DL_FUNC)&LGBM_BoosterSaveSharedModel_R    , 3},
+  {"LGBM_SharedModelCreateFromFile_R" , (DL_FUNC)&LGBM_SharedModelCreateFromFile_R , 1},
+  {"LGBM_SharedModelGetNumClasses_R"  , (DL_FUNC)&LGBM_SharedModelGetNumClasses_R  , 2},
+  {"LGBM_SharedModelPredictForMat_R"  , (DL_FUNC)&LGBM_SharedModelPredictForMat_R  , 8},
+  {"LGBM_SharedModelFree_R"           , (DL_FUNC)&LGBM_SharedModelFree_R           , 1},
   {"GPB_CreateREModel_R"              , (DL_FUNC)&GPB_CreateREModel_R              , 28},
   {"GPB_REModelFree_R"                , (DL_FUNC)&GPB_REModelFree_R                , 1},
-  {"GPB_SetOptimConfig_R"             , (DL_FUNC)&GPB_SetOptimConfig_R             , 28},
+  {"GPB_CreateREModelFolds_R"         , (DL_FUNC)&GPB_CreateREModelFolds_R         , 30},
+  {"GPB_REModelFoldsGetTrainModel_R"  , (DL_FUNC)&GPB_REModelFoldsGetTrainModel_R  , 2},
+  {"GPB_REModelFoldsFree_R"           , (DL_FUNC)&GPB_REModelFoldsFree_R           , 1},
+  {"GPB_SetOptimConfig_R"             , (DL_FUNC)&GPB_SetOptimConfig_R             , 29},
+  {"GPB_SetVecchiaDistanceCache_R"    , (DL_FUNC)&GPB_SetVecchiaDistanceCache_R    , 2},
   {"GPB_OptimCovPar_R"                , (DL_FUNC)&GPB_OptimCovPar_R                , 3},
   {"GPB_OptimLinRegrCoefCovPar_R"     , (DL_FUNC)&GPB_OptimLinRegrCoefCovPar_R     , 5},
   {"GPB_EvalNegLogLikelihood_R"       , (DL_FUNC)&GPB_EvalNegLogLikelihood_R       , 5},
@@ -1351,6 +1673,8 @@ static const R_CallMethodDef CallEntries[] = {
   {"GPB_GetAuxPars_R"                 , (DL_FUNC)&GPB_GetAuxPars_R                 , 2},
   {"GPB_GetNumAuxPars_R"              , (DL_FUNC)&GPB_GetNumAuxPars_R              , 2},
   {"GPB_GetInitAuxPars_R"             , (DL_FUNC)&GPB_GetInitAuxPars_R             , 2},
+  {"GPB_SetMemoryCap_R"               , (DL_FUNC)&GPB_SetMemoryCap_R               , 2},
+  {"GPB_EstimateMemoryREModel_R"      , (DL_FUNC)&GPB_EstimateMemoryREModel_R      , 4},
   {NULL, NULL, 0}
 };
 
@@ -56,6 +56,15 @@ GPBOOST_C_EXPORT SEXP LGBM_HandleIsNull_R(
 	SEXP handle
 );
 
+/*!
+* \brief Get the maximal number of OpenMP threads of the calling thread
+* \param out maximal number of OpenMP threads
+* \return R NULL value
+*/
+GPBOOST_C_EXPORT SEXP LGBM_GetMaxThreads_R(
+	SEXP out
+);
+
 // --- start Dataset interface
 
 /*!
@@ -242,6 +251,29 @@ GPBOOST_C_EXPORT SEXP LGBM_DatasetGetNumFeature_R(
 	SEXP out
 );
 
+// --- start Network interfaces
+
+/*!
+* \brief initialize the network for distributed learning
+* \param machines list of machines in format 'ip1:port1,ip2:port2'
+* \param local_listen_port TCP listen port for the local machine
+* \param listen_time_out socket time-out in minutes
+* \param num_machines total number of machines
+* \return R NULL value
+*/
+GPBOOST_C_EXPORT SEXP LGBM_NetworkInit_R(
+	SEXP machines,
+	SEXP local_listen_port,
+	SEXP listen_time_out,
+	SEXP num_machines
+);
+
+/*!
+* \brief finalize the network
+* \return R NULL value
+*/
+GPBOOST_C_EXPORT SEXP LGBM_NetworkFree_R();
+
 // --- start Booster interfaces
 
 /*!
@@ -574,6 +606,39 @@ GPBOOST_C_EXPORT SEXP LGBM_BoosterPredictForMat_R(
 	SEXP out_result
 );
 
+/*!
+* \brief make prediction for a new data set with LGBM_BoosterPredictForMatRowsFast, i.e.,
+*        the rows are copied into a dense feature buffer without building (index, value) pairs.
+*        The (column-major) R matrix is converted to a row-major matrix of type float or double
+* \param handle handle
+* \param data pointer to the data space
+* \param num_row number of rows
+* \param ncol number columns
+* \param is_float32 if true, the rows are passed to the C API as float, otherwise as double
+* \param is_rawscore
+* \param is_leafidx
+* \param is_predcontrib
+* \param start_iteration Start index of the iteration to predict
+* \param num_iteration number of iteration for prediction, <= 0 means no limit
+* \param parameter additional parameters
+* \param out prediction result
+* \return R NULL value
+*/
+GPBOOST_C_EXPORT SEXP LGBM_BoosterPredictForMatRowsFast_R(
+	SEXP handle,
+	SEXP data,
+	SEXP num_row,
+	SEXP ncol,
+	SEXP is_float32,
+	SEXP is_rawscore,
+	SEXP is_leafidx,
+	SEXP is_predcontrib,
+	SEXP start_iteration,
+	SEXP num_iteration,
+	SEXP parameter,
+	SEXP out_result
+);
+
 /*!
 * \brief save model into file
 * \param handle handle
@@ -616,6 +681,73 @@ GPBOOST_C_EXPORT SEXP LGBM_BoosterDumpModel_R(
 	SEXP feature_importance_type
 );
 
+// --- start SharedModel interfaces
+
+/*!
+* \brief save model into file in the shared model format
+* \param handle Booster handle
+* \param num_iteration, <= 0 means save all
+* \param filename file name
+* \return R_NilValue
+*/
+GPBOOST_C_EXPORT SEXP LGBM_BoosterSaveSharedModel_R(
+	SEXP handle,
+	SEXP num_iteration,
+	SEXP filename
+);
+
+/*!
+* \brief map a shared model file read-only into memory
+* \param filename file name
+* \return SharedModel handle
+*/
+GPBOOST_C_EXPORT SEXP LGBM_SharedModelCreateFromFile_R(
+	SEXP filename
+);
+
+/*!
+* \brief get number of classes of a shared model
+* \param handle SharedModel handle
+* \param[out] out number of classes
+* \return R_NilValue
+*/
+GPBOOST_C_EXPORT SEXP LGBM_SharedModelGetNumClasses_R(
+	SEXP handle,
+	SEXP out
+);
+
+/*!
+* \brief make prediction for a new data set with a shared model
+* \param handle SharedModel handle
+* \param data R matrix (column-major)
+* \param num_row number of rows
+* \param num_col number of columns
+* \param is_rawscore 1 to get raw predictions, before transformations like converting to probabilities, 0 otherwise
+* \param start_iteration Start index of the iteration to predict
+* \param num_iteration number of iteration for prediction, <= 0 means no limit
+* \param out_result prediction result
+* \return R_NilValue
+*/
+GPBOOST_C_EXPORT SEXP LGBM_SharedModelPredictForMat_R(
+	SEXP handle,
+	SEXP data,
+	SEXP num_row,
+	SEXP num_col,
+	SEXP is_rawscore,
+	SEXP start_iteration,
+	SEXP num_iteration,
+	SEXP out_result
+);
+
+/*!
+* \brief unmap a shared model
+* \param handle SharedModel handle
+* \return R_NilValue
+*/
+GPBOOST_C_EXPORT SEXP LGBM_SharedModelFree_R(
+	SEXP handle
+);
+
 // Below here are REModel / GPModel related functions
 
 /*!
@@ -690,6 +822,66 @@ GPBOOST_C_EXPORT SEXP GPB_REModelFree_R(
 	SEXP handle
 );
 
+/*!
+* \brief Create REModelFolds for the folds of a cross-validation (see GPB_CreateREModelFolds). The data and model parameters are the same as for GPB_CreateREModel_R
+* \param num_folds Number of folds
+* \param fold_ids Fold of every data point (counting starts at 0). Data points with fold_ids[i] == k are held out for fold k
+* \return REModelFolds handle
+*/
+GPBOOST_C_EXPORT SEXP GPB_CreateREModelFolds_R(
+	SEXP ndata,
+	SEXP cluster_ids_data,
+	SEXP re_group_data,
+	SEXP num_re_group,
+	SEXP re_group_rand_coef_data,
+	SEXP ind_effect_group_rand_coef,
+	SEXP num_re_group_rand_coef,
+	SEXP drop_intercept_group_rand_effect,
+	SEXP num_gp,
+	SEXP gp_coords_data,
+	SEXP dim_gp_coords,
+	SEXP gp_rand_coef_data,
+	SEXP num_gp_rand_coef,
+	SEXP cov_fct,
+	SEXP cov_fct_shape,
+	SEXP gp_approx,
+	SEXP cov_fct_taper_range,
+	SEXP cov_fct_taper_shape,
+	SEXP num_neighbors,
+	SEXP vecchia_ordering,
+	SEXP num_ind_points,
+	SEXP cover_tree_radius,
+	SEXP ind_points_selection,
+	SEXP likelihood,
+	SEXP likelihood_additional_param,
+	SEXP matrix_inversion_method,
+	SEXP seed,
+	SEXP num_parallel_threads,
+	SEXP num_folds,
+	SEXP fold_ids
+);
+
+/*!
+* \brief Get the REModel for the training data of a fold (see GPB_REModelFoldsGetTrainModel).
+*        The returned handle must not be freed, it keeps the REModelFolds alive
+* \param handle Handle of REModelFolds
+* \param fold Index of the fold (counting starts at 0)
+* \return REModel handle
+*/
+GPBOOST_C_EXPORT SEXP GPB_REModelFoldsGetTrainModel_R(
+	SEXP handle,
+	SEXP fold
+);
+
+/*!
+* \brief Free REModelFolds (including the REModels of the folds)
+* \param handle Handle of REModelFolds
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT SEXP GPB_REModelFoldsFree_R(
+	SEXP handle
+);
+
 /*!
 * \brief Set configuration parameters for the optimizer
 * \param handle Handle of REModel
@@ -720,6 +912,7 @@ GPBOOST_C_EXPORT SEXP GPB_REModelFree_R(
 * \param piv_chol_rank Rank of the pivoted cholseky decomposition used as preconditioner of the conjugate gradient algorithm
 * \param init_aux_pars Initial values for values for aux_pars_ (e.g., shape parameter of gamma likelihood)
 * \param estimate_aux_pars If true, any additional parameters for non-Gaussian likelihoods are also estimated (e.g., shape parameter of gamma likelihood)
+* \param fitc_streaming_block_size If > 0, the cross-covariance matrix for the FITC approximation is not stored but calculated in blocks of this many rows
 * \return 0 when succeed, -1 when failure happens
 */
 GPBOOST_C_EXPORT SEXP GPB_SetOptimConfig_R(
@@ -750,7 +943,19 @@ GPBOOST_C_EXPORT SEXP GPB_SetOptimConfig_R(
 	SEXP seed_rand_vec_trace,
 	SEXP piv_chol_rank,
 	SEXP init_aux_pars,
-	SEXP estimate_aux_pars
+	SEXP estimate_aux_pars,
+	SEXP fitc_streaming_block_size
+);
+
+/*!
+* \brief Set the policy for caching the distances among locations and their nearest neighbors for the Vecchia approximation
+* \param handle Handle of REModel
+* \param policy "auto" (cache in double precision if this fits into the default memory budget), "none", "double", or "float"
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT SEXP GPB_SetVecchiaDistanceCache_R(
+	SEXP handle,
+	SEXP policy
 );
 
 /*!
@@ -1058,4 +1263,30 @@ GPBOOST_C_EXPORT SEXP GPB_GetInitAuxPars_R(
 	SEXP aux_pars
 );
 
+/*!
+* \brief Set a hard memory cap for a REModel
+* \param handle Handle of REModel
+* \param max_bytes Maximal memory in bytes. If <= 0, there is no cap
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT SEXP GPB_SetMemoryCap_R(
+	SEXP handle,
+	SEXP max_bytes
+);
+
+/*!
+* \brief Rough estimate of the peak memory of a REModel using its settings
+* \param handle Handle of REModel
+* \param num_data_pred Number of prediction points
+* \param predict_cov_mat If true, the memory for calculating the predictive covariance matrix is included
+* \param[out] out_bytes Estimated peak memory in bytes for the construction, the parameter estimation, and the prediction phase (length 3)
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT SEXP GPB_EstimateMemoryREModel_R(
+	SEXP handle,
+	SEXP num_data_pred,
+	SEXP predict_cov_mat,
+	SEXP out_bytes
+);
+
 #endif  // GPBOOST_R_H_
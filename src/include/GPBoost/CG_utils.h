@@ -115,6 +115,90 @@ namespace GPBoost {
 		const den_mat_t cross_cov,
 		const vec_t& diagonal_approx_inv_preconditioner);
 
+	/*!
+	* \brief Block version of CGVecchiaLaplaceVec() that solves (Sigma^-1 + W) U = rhs for a matrix rhs of dimension nxt (cold-start, U = 0 initially).
+	*		 All columns are iterated jointly such that the sparse matrix products and the preconditioner solves stream the matrices only once per iteration
+	*		 for the entire block. Every column has its own step sizes and stops when its residual norm is below delta_conv.
+	* \param diag_W Diagonal of matrix W
+	* \param B_rm Row-major matrix B in Vecchia approximation Sigma^-1 = B^T D^(-1) B ("=" Cholesky factor)
+	* \param B_t_D_inv_rm Row-major matrix that contains the product B^T D^-1. Outsourced in order to reduce the overhead of the function.
+	* \param rhs Matrix of dimension nxt on the rhs
+	* \param[out] U Approximative solution of the linear system (solution written on input)
+	* \param[out] NA_or_Inf_found Is set to true, if NA or Inf is found in the residual of conjugate gradient algorithm.
+	* \param p Maximal number of conjugate gradient steps
+	* \param delta_conv Tolerance for checking convergence of the algorithm
+	* \param THRESHOLD_ZERO_RHS_CG If the L1-norm of a column of rhs is below this threshold the corresponding column of U is set to 0
+	* \param cg_preconditioner_type Type of preconditioner used.
+	* \param D_inv_plus_W_B_rm Row-major matrix that contains the product (D^(-1) + W) B used for the preconditioner "Sigma_inv_plus_BtWB".
+	* \param L_SigmaI_plus_W_rm Row-major matrix that contains sparse cholesky factor L of matrix L^T L =  B^T D^(-1) B + W used for the preconditioner "zero_infill_incomplete_cholesky".
+	*/
+	void CGVecchiaLaplaceBlock(const vec_t& diag_W,
+		const sp_mat_rm_t& B_rm,
+		const sp_mat_rm_t& B_t_D_inv_rm,
+		const den_mat_t& rhs,
+		den_mat_t& U,
+		bool& NA_or_Inf_found,
+		int p,
+		const double delta_conv,
+		const double THRESHOLD_ZERO_RHS_CG,
+		const string_t cg_preconditioner_type,
+		const sp_mat_rm_t& D_inv_plus_W_B_rm,
+		const sp_mat_rm_t& L_SigmaI_plus_W_rm);
+
+	/*!
+	* \brief Block version of CGVecchiaLaplaceVecWinvplusSigma() for a matrix rhs of dimension nxt (cold-start, U = 0 initially)
+	* \param diag_W Diagonal of matrix W
+	* \param B_rm Row-major matrix B in Vecchia approximation Sigma^-1 = B^T D^-1 B ("=" Cholesky factor)
+	* \param D_inv_B_rm Row-major matrix that contains the product D^-1 B. Outsourced in order to reduce the overhead of the function.
+	* \param rhs Matrix of dimension nxt on the rhs
+	* \param[out] U Approximative solution of the linear system (solution written on input)
+	* \param[out] NA_or_Inf_found Is set to true, if NA or Inf is found in the residual of conjugate gradient algorithm.
+	* \param p Maximal number of conjugate gradient steps
+	* \param delta_conv Tolerance for checking convergence of the algorithm
+	* \param THRESHOLD_ZERO_RHS_CG If the L1-norm of a column of rhs is below this threshold the corresponding column of U is set to 0
+	* \param chol_fact_I_k_plus_Sigma_L_kt_W_Sigma_L_k_vecchia Cholesky factor E of matrix EE^T = (I_k + Sigma_L_k^T W^(-1) Sigma_L_k)
+	* \param Sigma_L_k Matrix of dimension nxk: Pivoted Cholseky decomposition of the nonapproximated covariance matrix, generated in re_model_template.h
+	*/
+	void CGVecchiaLaplaceBlockWinvplusSigma(const vec_t& diag_W,
+		const sp_mat_rm_t& B_rm,
+		const sp_mat_rm_t& D_inv_B_rm,
+		const den_mat_t& rhs,
+		den_mat_t& U,
+		bool& NA_or_Inf_found,
+		int p,
+		const double delta_conv,
+		const double THRESHOLD_ZERO_RHS_CG,
+		const chol_den_mat_t& chol_fact_I_k_plus_Sigma_L_kt_W_Sigma_L_k_vecchia,
+		const den_mat_t& Sigma_L_k);
+
+	/*!
+	* \brief Block version of CGVecchiaLaplaceVecWinvplusSigma_FITC_P() for a matrix rhs of dimension nxt (cold-start, U = 0 initially)
+	* \param diag_W Diagonal of matrix W
+	* \param B_rm Row-major matrix B in Vecchia approximation Sigma^-1 = B^T D^-1 B ("=" Cholesky factor)
+	* \param D_inv_B_rm Row-major matrix that contains the product D^-1 B. Outsourced in order to reduce the overhead of the function.
+	* \param rhs Matrix of dimension nxt on the rhs
+	* \param[out] U Approximative solution of the linear system (solution written on input)
+	* \param[out] NA_or_Inf_found Is set to true, if NA or Inf is found in the residual of conjugate gradient algorithm.
+	* \param p Maximal number of conjugate gradient steps
+	* \param delta_conv Tolerance for checking convergence of the algorithm
+	* \param THRESHOLD_ZERO_RHS_CG If the L1-norm of a column of rhs is below this threshold the corresponding column of U is set to 0
+	* \param chol_fact_woodbury_preconditioner Cholesky factor of Matrix C_m + C_mn*D^(-1)*C_nm
+	* \param cross_cov Cross-covariance between inducing points and observations
+	* \param diagonal_approx_inv_preconditioner Diagonal D of residual Matrix C_s
+	*/
+	void CGVecchiaLaplaceBlockWinvplusSigma_FITC_P(const vec_t& diag_W,
+		const sp_mat_rm_t& B_rm,
+		const sp_mat_rm_t& D_inv_B_rm,
+		const den_mat_t& rhs,
+		den_mat_t& U,
+		bool& NA_or_Inf_found,
+		int p,
+		const double delta_conv,
+		const double THRESHOLD_ZERO_RHS_CG,
+		const chol_den_mat_t& chol_fact_woodbury_preconditioner,
+		const den_mat_t& cross_cov,
+		const vec_t& diagonal_approx_inv_preconditioner);
+
 
 	/*!
 	* \brief Preconditioned conjugate gradient descent in combination with the Lanczos algorithm.
@@ -241,6 +325,15 @@ namespace GPBoost {
 	void GenRandVecRademacher(RNG_t& generator,
 		den_mat_t& R);
 
+	/*!
+	* \brief Fills a given matrix with standard normal RV's in parallel. Column j is drawn with its own generator seeded with seeds[j],
+	*		 the result thus does not depend on the number of threads
+	* \param seeds Seeds for the columns of R
+	* \param[out] R Matrix of random vectors (r_1, r_2, r_3, ...), where r_i is of dimension n & Cov(r_i) = I (must have been declared with the correct dimensions)
+	*/
+	void GenRandVecNormalParallel(const std::vector<int>& seeds,
+		den_mat_t& R);
+
 	/*!
 	* \brief Stochastic estimation of log(det(A)) given t approximative Lanczos tridiagonalizations T of a symmetric matrix A = Q T Q^T of dimension nxn,
 	*		 where T is given in vector form (diagonal + subdiagonal of T).
@@ -899,5 +992,287 @@ namespace GPBoost {
 			"This could happen if the initial learning rate is too large. Otherwise increase 'cg_max_num_it_tridiag'.", p);
 	} // end CGFSA_RESID
 
+	/*!
+	* \brief Preconditioned conjugate gradient descent to solve Au=rhs when rhs is a vector
+	*		 A = (D + C_nm*(C_m)^(-1)*C_mn) is the FITC approximation for Sigma with diagonal D. A is not formed explicitly,
+	*		 matrix-vector products are calculated using C_nm and the Cholesky factor of C_m.
+	*		 P = D_k + C_nk*(C_k)^(-1)*C_kn, a FITC approximation with fewer inducing points, or no preconditioner is used.
+	* \param fitc_resid_diag Diagonal D of the FITC approximation
+	* \param cross_cov Cross-covariance matrix C_nm between the data and the inducing points
+	* \param chol_fact_sigma_ip Cholesky factor of the covariance matrix C_m of the inducing points
+	* \param rhs Vector of dimension nx1 on the rhs
+	* \param[out] u Approximative solution of the linear system (solution written on input) (must have been declared with the correct n-dimension)
+	* \param[out] NaN_found Is set to true, if NaN is found in the residual of conjugate gradient algorithm
+	* \param p Number of conjugate gradient steps
+	* \param delta_conv tolerance for checking convergence
+	* \param THRESHOLD_ZERO_RHS_CG If the L1-norm of the rhs is below this threshold the CG is not executed and a vector u of 0's is returned
+	* \param cg_preconditioner_type Type of preconditoner used for the conjugate gradient algorithm
+	* \param cross_cov_preconditioner Cross-covariance matrix C_nk between the data and the inducing points of the preconditioner
+	* \param chol_fact_woodbury_preconditioner Cholesky factor of Matrix C_k + C_kn*D_k^(-1)*C_nk
+	* \param diagonal_approx_inv_preconditioner Inverse of the diagonal D_k of the preconditioner
+	*/
+	void CGFITC(const vec_t& fitc_resid_diag,
+		const den_mat_t& cross_cov,
+		const chol_den_mat_t& chol_fact_sigma_ip,
+		const vec_t& rhs,
+		vec_t& u,
+		bool& NaN_found,
+		int p,
+		const double delta_conv,
+		const double THRESHOLD_ZERO_RHS_CG,
+		const string_t cg_preconditioner_type,
+		const den_mat_t& cross_cov_preconditioner,
+		const chol_den_mat_t& chol_fact_woodbury_preconditioner,
+		const vec_t& diagonal_approx_inv_preconditioner);
+
+	/*!
+	* \brief Preconditioned conjugate gradient descent in combination with the Lanczos algorithm
+	*		 Given the linear system AU=rhs where rhs is a matrix of dimension nxt of t probe column-vectors and
+	*		 A = (D + C_nm*(C_m)^(-1)*C_mn) is the FITC approximation for Sigma with diagonal D.
+	*		 A is not formed explicitly, matrix-vector products are calculated using C_nm and the Cholesky factor of C_m.
+	*		 The function returns t approximative tridiagonalizations T of the symmetric matrix A=QTQ' in vector form (diagonal + subdiagonal of T).
+	* \param fitc_resid_diag Diagonal D of the FITC approximation
+	* \param cross_cov Cross-covariance matrix C_nm between the data and the inducing points
+	* \param chol_fact_sigma_ip Cholesky factor of the covariance matrix C_m of the inducing points
+	* \param rhs Matrix of dimension nxt that contains (column-)probe vectors z_1,...,z_t with Cov[z_i] = P
+	* \param[out] Tdiags The diagonals of the t approximative tridiagonalizations of A in vector form (solution written on input)
+	* \param[out] Tsubdiags The subdiagonals of the t approximative tridiagonalizations of A in vector form (solution written on input)
+	* \param[out] U Approximative solution of the linear system (solution written on input) (must have been declared with the correct nxt dimensions)
+	* \param[out] NaN_found Is set to true, if NaN is found in the residual of conjugate gradient algorithm
+	* \param num_data n-Dimension of the linear system
+	* \param t t-Dimension of the linear system
+	* \param p Number of conjugate gradient steps
+	* \param delta_conv Tolerance for checking convergence of the algorithm
+	* \param cg_preconditioner_type Type of preconditoner used for the conjugate gradient algorithm
+	* \param cross_cov_preconditioner Cross-covariance matrix C_nk between the data and the inducing points of the preconditioner
+	* \param chol_fact_woodbury_preconditioner Cholesky factor of Matrix C_k + C_kn*D_k^(-1)*C_nk
+	* \param diagonal_approx_inv_preconditioner Inverse of the diagonal D_k of the preconditioner
+	*/
+	void CGTridiagFITC(const vec_t& fitc_resid_diag,
+		const den_mat_t& cross_cov,
+		const chol_den_mat_t& chol_fact_sigma_ip,
+		const den_mat_t& rhs,
+		std::vector<vec_t>& Tdiags,
+		std::vector<vec_t>& Tsubdiags,
+		den_mat_t& U,
+		bool& NaN_found,
+		const data_size_t num_data,
+		const int t,
+		int p,
+		const double delta_conv,
+		const string_t cg_preconditioner_type,
+		const den_mat_t& cross_cov_preconditioner,
+		const chol_den_mat_t& chol_fact_woodbury_preconditioner,
+		const vec_t& diagonal_approx_inv_preconditioner);
+
+	/*!
+	* \brief Apply the preconditioner for M = Sigma^-1 + Z^T Z when having only grouped random effects, i.e., calculate Z = P^(-1) R.
+	*		 Note: this and the following solvers for grouped random effects are also used for the Laplace approximation for
+	*			non-Gaussian likelihoods with M = Sigma^-1 + Z^T W Z. The preconditioners are then calculated from this M and thus include W
+	*		 "ssor": P = (D + L) D^(-1) (D + L)^T, symmetric Gauss-Seidel with M = L + D + L^T, L = strictly lower triangular part, D = diagonal
+	*		 "diagonal": P = D. Note that this is the block-Jacobi preconditioner with one block per random effect component since
+	*			the diagonal blocks of M are diagonal matrices for grouped random effects
+	* \param SigmaI_plus_ZtZ Matrix M = Sigma^-1 + Z^T Z (only the lower and upper triangular parts are accessed for "ssor")
+	* \param diag_SigmaI_plus_ZtZ Diagonal D of M
+	* \param cg_preconditioner_type Type of preconditoner used for the conjugate gradient algorithm
+	* \param R Vector or matrix on the rhs
+	* \param[out] Z P^(-1) R
+	*/
+	template <class T_mat, class T_dense>
+	void PreconditionerSolveGroupedRE(const T_mat& SigmaI_plus_ZtZ,
+		const vec_t& diag_SigmaI_plus_ZtZ,
+		const string_t& cg_preconditioner_type,
+		const T_dense& R,
+		T_dense& Z) {
+		if (cg_preconditioner_type == "ssor") {
+			T_dense W = SigmaI_plus_ZtZ.template triangularView<Eigen::Lower>().solve(R);
+			W = diag_SigmaI_plus_ZtZ.asDiagonal() * W;
+			Z = SigmaI_plus_ZtZ.template triangularView<Eigen::Upper>().solve(W);
+		}
+		else if (cg_preconditioner_type == "diagonal") {
+			Z = diag_SigmaI_plus_ZtZ.cwiseInverse().asDiagonal() * R;
+		}
+		else if (cg_preconditioner_type == "none") {
+			Z = R;
+		}
+		else {
+			Log::REFatal("PreconditionerSolveGroupedRE: Preconditioner type '%s' is not supported ", cg_preconditioner_type.c_str());
+		}
+	}//end PreconditionerSolveGroupedRE
+
+	/*!
+	* \brief Preconditioned conjugate gradient descent to solve M U = rhs when having only grouped random effects
+	*		 M = Sigma^-1 + Z^T Z is a sparse symmetric matrix whose dimension equals the total number of random effects.
+	*		 The columns of rhs are solved jointly, i.e., this can also be used for a single vector
+	* \param SigmaI_plus_ZtZ Matrix M = Sigma^-1 + Z^T Z
+	* \param diag_SigmaI_plus_ZtZ Diagonal of M
+	* \param rhs Vector or matrix on the rhs
+	* \param[out] U Approximative solution of the linear system (solution written on input). If non-zero, U is used as initial value
+	* \param[out] NaN_found Is set to true, if NaN is found in the residual of conjugate gradient algorithm
+	* \param p Maximal number of conjugate gradient steps
+	* \param delta_conv Tolerance for checking convergence (mean over the columns of the norms of the residuals)
+	* \param THRESHOLD_ZERO_RHS_CG If the L1-norm of the rhs is below this threshold the CG is not executed and U = 0 is returned
+	* \param cg_preconditioner_type Type of preconditoner used for the conjugate gradient algorithm ("ssor", "diagonal", or "none")
+	*/
+	template <class T_mat>
+	void CGGroupedRE(const T_mat& SigmaI_plus_ZtZ,
+		const vec_t& diag_SigmaI_plus_ZtZ,
+		const den_mat_t& rhs,
+		den_mat_t& U,
+		bool& NaN_found,
+		int p,
+		const double delta_conv,
+		const double THRESHOLD_ZERO_RHS_CG,
+		const string_t cg_preconditioner_type) {
+
+		p = std::min(p, (int)rhs.rows());
+		const int t = (int)rhs.cols();
+
+		den_mat_t R, R_old, Z, Z_old, H, V;
+		vec_t a(t), b(t);
+		bool early_stop_alg = false;
+		double mean_R_norm;
+
+		//Avoid numerical instabilites when rhs is de facto 0
+		if (rhs.cwiseAbs().sum() < THRESHOLD_ZERO_RHS_CG) {
+			U.setZero();
+			return;
+		}
+		if (U.isZero(0)) {
+			R = rhs;
+		}
+		else {
+			R = rhs - SigmaI_plus_ZtZ * U;
+		}
+		PreconditionerSolveGroupedRE<T_mat, den_mat_t>(SigmaI_plus_ZtZ, diag_SigmaI_plus_ZtZ, cg_preconditioner_type, R, Z);
+		H = Z;
+
+		for (int j = 0; j < p; ++j) {
+
+			V = SigmaI_plus_ZtZ * H;
+
+			a = R.cwiseProduct(Z).colwise().sum().transpose().array() / H.cwiseProduct(V).colwise().sum().transpose().array();
+
+			U += H * a.asDiagonal();
+			R_old = R;
+			R -= V * a.asDiagonal();
+
+			mean_R_norm = R.colwise().norm().mean();
+			if (std::isnan(mean_R_norm) || std::isinf(mean_R_norm)) {
+				NaN_found = true;
+				return;
+			}
+			if (mean_R_norm < delta_conv) {
+				early_stop_alg = true;
+			}
+
+			Z_old = Z;
+			PreconditionerSolveGroupedRE<T_mat, den_mat_t>(SigmaI_plus_ZtZ, diag_SigmaI_plus_ZtZ, cg_preconditioner_type, R, Z);
+
+			b = R.cwiseProduct(Z).colwise().sum().transpose().array() / R_old.cwiseProduct(Z_old).colwise().sum().transpose().array();
+
+			H = Z + H * b.asDiagonal();
+
+			if (early_stop_alg) {
+				return;
+			}
+		}
+		Log::REInfo("Conjugate gradient algorithm has not converged after the maximal number of iterations (%i). "
+			"This could happen if the initial learning rate is too large. Otherwise increase 'cg_max_num_it'.", p);
+	} // end CGGroupedRE
+
+	/*!
+	* \brief Preconditioned conjugate gradient descent in combination with the Lanczos algorithm when having only grouped random effects
+	*		 Given the linear system M U = rhs where rhs is a matrix of dimension nxt of t probe column-vectors and
+	*		 M = Sigma^-1 + Z^T Z is a sparse symmetric matrix whose dimension n equals the total number of random effects.
+	*		 The function returns t approximative tridiagonalizations T of the preconditioned matrix in vector form (diagonal + subdiagonal of T).
+	* \param SigmaI_plus_ZtZ Matrix M = Sigma^-1 + Z^T Z
+	* \param diag_SigmaI_plus_ZtZ Diagonal of M
+	* \param rhs Matrix of dimension nxt that contains (column-)probe vectors z_1,...,z_t with Cov[z_i] = P
+	* \param[out] Tdiags The diagonals of the t approximative tridiagonalizations of P^(-1) M in vector form (solution written on input)
+	* \param[out] Tsubdiags The subdiagonals of the t approximative tridiagonalizations of P^(-1) M in vector form (solution written on input)
+	* \param[out] U Approximative solution of the linear system (solution written on input) (must have been declared with the correct nxt dimensions)
+	* \param[out] NaN_found Is set to true, if NaN is found in the residual of conjugate gradient algorithm
+	* \param num_data n-Dimension of the linear system
+	* \param t t-Dimension of the linear system
+	* \param p Number of conjugate gradient steps
+	* \param delta_conv Tolerance for checking convergence of the algorithm
+	* \param cg_preconditioner_type Type of preconditoner used for the conjugate gradient algorithm ("ssor", "diagonal", or "none")
+	*/
+	template <class T_mat>
+	void CGTridiagGroupedRE(const T_mat& SigmaI_plus_ZtZ,
+		const vec_t& diag_SigmaI_plus_ZtZ,
+		const den_mat_t& rhs,
+		std::vector<vec_t>& Tdiags,
+		std::vector<vec_t>& Tsubdiags,
+		den_mat_t& U,
+		bool& NaN_found,
+		const data_size_t num_data,
+		const int t,
+		int p,
+		const double delta_conv,
+		const string_t cg_preconditioner_type) {
+		p = std::min(p, (int)num_data);
+
+		den_mat_t R(num_data, t), R_old, Z(num_data, t), Z_old, H, V(num_data, t);
+		vec_t a(t), a_old(t);
+		vec_t b(t), b_old(t);
+		bool early_stop_alg = false;
+		double mean_R_norm;
+
+		U.setZero();
+		a.setOnes();
+		b.setZero();
+
+		R = rhs;
+		PreconditionerSolveGroupedRE<T_mat, den_mat_t>(SigmaI_plus_ZtZ, diag_SigmaI_plus_ZtZ, cg_preconditioner_type, R, Z);
+		H = Z;
+
+		for (int j = 0; j < p; ++j) {
+
+			V = SigmaI_plus_ZtZ * H;
+
+			a_old = a;
+			a = R.cwiseProduct(Z).colwise().sum().transpose().array() / H.cwiseProduct(V).colwise().sum().transpose().array();
+
+			U += H * a.asDiagonal();
+			R_old = R;
+			R -= V * a.asDiagonal();
+
+			mean_R_norm = R.colwise().norm().mean();
+			if (std::isnan(mean_R_norm) || std::isinf(mean_R_norm)) {
+				NaN_found = true;
+				return;
+			}
+			if (mean_R_norm < delta_conv) {
+				early_stop_alg = true;
+			}
+
+			Z_old = Z;
+			PreconditionerSolveGroupedRE<T_mat, den_mat_t>(SigmaI_plus_ZtZ, diag_SigmaI_plus_ZtZ, cg_preconditioner_type, R, Z);
+
+			b_old = b;
+			b = R.cwiseProduct(Z).colwise().sum().transpose().array() / R_old.cwiseProduct(Z_old).colwise().sum().transpose().array();
+
+			H = Z + H * b.asDiagonal();
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < t; ++i) {
+				Tdiags[i][j] = 1 / a(i) + b_old(i) / a_old(i);
+				if (j > 0) {
+					Tsubdiags[i][j - 1] = sqrt(b_old(i)) / a_old(i);
+				}
+			}
+			if (early_stop_alg) {
+				for (int i = 0; i < t; ++i) {
+					Tdiags[i].conservativeResize(j + 1, 1);
+					Tsubdiags[i].conservativeResize(j, 1);
+				}
+				return;
+			}
+		}
+		Log::REInfo("Conjugate gradient algorithm has not converged after the maximal number of iterations (%i). "
+			"This could happen if the initial learning rate is too large. Otherwise increase 'cg_max_num_it_tridiag'.", p);
+	} // end CGTridiagGroupedRE
+
 }
 #endif   // GPB_CG_UTILS_
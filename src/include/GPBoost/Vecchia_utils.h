@@ -11,6 +11,7 @@
 #include <memory>
 #include <GPBoost/type_defs.h>
 #include <GPBoost/re_comp.h>
+#include <GPBoost/vecchia_distance_cache.h>
 #include <GPBoost/utils.h>
 
 namespace GPBoost {
@@ -177,6 +178,7 @@ namespace GPBoost {
 	* \param ind_intercept_gp Index in the vector of random effect components (in the values of 're_comps_vecchia') of the intercept GP associated with the random coefficient GPs
 	* \param gauss_likelihood If true, the response variables have a Gaussian likelihood, otherwise not
 	* \param save_distances_isotropic_cov_fct If true, distances among points and neighbors are saved for Vecchia approximations for isotropic covariance functions
+	* \param dist_cache Compact cache of the distances. If not nullptr, the distances are taken from this cache instead of 'dist_obs_neighbors_cluster_i' and 'dist_between_neighbors_cluster_i'
 	*/
 	void CalcCovFactorGradientVecchia(data_size_t num_re_cluster_i,
 		bool calc_cov_factor,
@@ -197,7 +199,8 @@ namespace GPBoost {
 		int num_gp_total,
 		int ind_intercept_gp,
 		bool gauss_likelihood,
-		bool save_distances_isotropic_cov_fct);
+		bool save_distances_isotropic_cov_fct,
+		const VecchiaDistanceCache* dist_cache = nullptr);
 
 	/*!
 	* \brief Calculate predictions (conditional mean and covariance matrix) using the Vecchia approximation for the covariance matrix of the observable process when observed locations appear first in the ordering
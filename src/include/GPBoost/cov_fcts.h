@@ -159,6 +159,16 @@ namespace GPBoost {
 			return(is_isotropic_);
 		}
 
+		/*!
+		* \brief Set whether precomputed distances ('dist') or the coordinates are used for calculating covariances (only possible for isotropic covariance functions)
+		* \param use_precomputed_dist_for_calc_cov If true, precomputed distances are used
+		*/
+		void SetUsePrecomputedDistForCalcCov(bool use_precomputed_dist_for_calc_cov) {
+			use_precomputed_dist_for_calc_cov_ = use_precomputed_dist_for_calc_cov && is_isotropic_;
+			InitializeGetDistanceForCovFct();
+			InitializeGetDistanceForGradientCovFct();
+		}
+
 		bool IsSpaceTimeModel() const {
 			return(cov_fct_type_ == "matern_space_time");
 		}
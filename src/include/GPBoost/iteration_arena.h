@@ -0,0 +1,140 @@
+/*!
+* This file is part of GPBoost a C++ library for combining
+*	boosting with Gaussian process and mixed effects models
+*
+* Copyright (c) 2020 Fabio Sigrist. All rights reserved.
+*
+* Licensed under the Apache License Version 2.0. See LICENSE file in the project root for license information.
+*/
+#ifndef GPB_ITERATION_ARENA_H_
+#define GPB_ITERATION_ARENA_H_
+
+#include <GPBoost/type_defs.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace GPBoost {
+
+	/*! \brief Eigen views on memory of an IterationArena */
+	typedef Eigen::Map<vec_t, Eigen::AlignedMax> arena_vec_t;
+	typedef Eigen::Map<den_mat_t, Eigen::AlignedMax> arena_den_mat_t;
+
+	/*!
+	* \brief Bump allocator for short-lived buffers such as temporaries in every iteration of an optimization.
+	*		Memory is handed out in a stack-like manner and given back when the Scope in which it was allocated ends.
+	*		The memory blocks are kept, i.e., once the arena has reached its peak size, no further heap allocations are done.
+	*		Note: an arena is not thread-safe and must be used outside of parallel regions only
+	*/
+	class IterationArena {
+	public:
+		/*!
+		* \brief All memory that is allocated during the lifetime of a Scope is given back to the arena when the Scope ends
+		*/
+		class Scope {
+		public:
+			explicit Scope(IterationArena& arena) : arena_(arena), block_(arena.cur_block_), offset_(arena.cur_offset_) {
+				arena_.num_open_scopes_++;
+			}
+			~Scope() {
+				arena_.cur_block_ = block_;
+				arena_.cur_offset_ = offset_;
+				arena_.num_open_scopes_--;
+			}
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+		private:
+			IterationArena& arena_;
+			size_t block_;
+			size_t offset_;
+		};
+
+		IterationArena() = default;
+
+		~IterationArena() {
+			FreeBlocks();
+		}
+
+		IterationArena(const IterationArena&) = delete;
+		IterationArena& operator=(const IterationArena&) = delete;
+
+		/*! \brief Uninitialized vector of length n */
+		arena_vec_t Vec(Eigen::Index n) {
+			return(arena_vec_t(Alloc((size_t)n), n));
+		}
+
+		/*! \brief Uninitialized matrix of dimension rows x cols */
+		arena_den_mat_t Mat(Eigen::Index rows,
+			Eigen::Index cols) {
+			return(arena_den_mat_t(Alloc((size_t)rows * (size_t)cols), rows, cols));
+		}
+
+		/*!
+		* \brief Replace several memory blocks by one block that can hold all of them. This is done at iteration boundaries
+		*		(when no memory is in use) such that later iterations use a single contiguous block
+		*/
+		void Consolidate() {
+			if (num_open_scopes_ > 0 || blocks_.size() <= 1) {
+				return;
+			}
+			size_t capacity = 0;
+			for (const auto& block : blocks_) {
+				capacity += block.capacity;
+			}
+			FreeBlocks();
+			blocks_.push_back(Block{ static_cast<double*>(Eigen::internal::aligned_malloc(capacity * sizeof(double))), capacity });
+		}
+
+	private:
+		struct Block {
+			double* data;
+			size_t capacity;//in number of doubles
+		};
+
+		/*! \brief Minimal size of a new block (number of doubles) */
+		static const size_t MIN_BLOCK_SIZE_ = 1 << 16;
+		/*! \brief Sizes are rounded up to a multiple of this number of doubles (64 bytes) */
+		static const size_t ALIGNMENT_DOUBLES_ = 8;
+
+		std::vector<Block> blocks_;
+		size_t cur_block_ = 0;
+		size_t cur_offset_ = 0;
+		int num_open_scopes_ = 0;
+
+		double* Alloc(size_t n) {
+			n = (n + ALIGNMENT_DOUBLES_ - 1) / ALIGNMENT_DOUBLES_ * ALIGNMENT_DOUBLES_;
+			if (cur_block_ < blocks_.size() && cur_offset_ + n <= blocks_[cur_block_].capacity) {
+				double* ptr = blocks_[cur_block_].data + cur_offset_;
+				cur_offset_ += n;
+				return(ptr);
+			}
+			// use the next block that is large enough, or add a new one
+			size_t next = cur_block_ < blocks_.size() ? cur_block_ + 1 : blocks_.size();
+			while (next < blocks_.size() && blocks_[next].capacity < n) {
+				next++;
+			}
+			if (next == blocks_.size()) {
+				size_t capacity = n > MIN_BLOCK_SIZE_ ? n : MIN_BLOCK_SIZE_;
+				if (!blocks_.empty()) {
+					capacity = std::max(capacity, 2 * blocks_.back().capacity);
+				}
+				blocks_.push_back(Block{ static_cast<double*>(Eigen::internal::aligned_malloc(capacity * sizeof(double))), capacity });
+			}
+			cur_block_ = next;
+			cur_offset_ = n;
+			return(blocks_[next].data);
+		}
+
+		void FreeBlocks() {
+			for (auto& block : blocks_) {
+				Eigen::internal::aligned_free(block.data);
+			}
+			blocks_.clear();
+			cur_block_ = 0;
+			cur_offset_ = 0;
+		}
+	};
+
+}  // namespace GPBoost
+
+#endif   // GPB_ITERATION_ARENA_H_
@@ -30,6 +30,7 @@
 #define GPB_LIKELIHOODS_
 
 #define _USE_MATH_DEFINES // for M_SQRT1_2 and M_PI
+#include <algorithm>
 #include <cmath>
 
 #include <GPBoost/type_defs.h>
@@ -37,7 +38,9 @@
 #include <GPBoost/DF_utils.h>
 #include <GPBoost/utils.h>
 #include <GPBoost/CG_utils.h>
+#include <GPBoost/iteration_arena.h>
 
+#include <cstdint>
 #include <string>
 #include <set>
 #include <vector>
@@ -267,6 +270,14 @@ namespace GPBoost {
 		*/
 		void SetCholFactPatternAnalyzedFalse() {
 			chol_fact_pattern_analyzed_ = false;
+			ZtWZ_plan_built_ = false;
+		}
+
+		/*!
+		* \brief Discard the plan for calculating SigmaI + Zt * W * Z (see BuildZtWZPlanGroupedRE). This needs to be called whenever Zt is (re)built
+		*/
+		void InvalidateZtWZPlanGroupedRE() {
+			ZtWZ_plan_built_ = false;
 		}
 
 		/*!
@@ -2138,6 +2149,8 @@ namespace GPBoost {
 			const double* fixed_effects,
 			const std::shared_ptr<T_mat> Sigma,
 			double& approx_marginal_ll) {
+			arena_.Consolidate();
+			IterationArena::Scope arena_scope(arena_);
 			// Initialize variables
 			if (!mode_initialized_) {//Better (numerically more stable) to re-initialize mode to zero in every call
 				InitializeModeAvec();
@@ -2160,8 +2173,11 @@ namespace GPBoost {
 			// Initialize objective function (LA approx. marginal likelihood) for use as convergence criterion
 			approx_marginal_ll = -0.5 * (a_vec_.dot(mode_)) + LogLikelihood(y_data, y_data_int, location_par_ptr, num_data_);
 			double approx_marginal_ll_new = approx_marginal_ll;
-			vec_t rhs(dim_mode_), rhs2(dim_mode_), mode_new, a_vec_new, mode_update, a_vec_update;//auxiliary variables for updating mode
-			vec_t diag_Wsqrt(dim_mode_);//diagonal of matrix sqrt(ZtWZ) if use_Z_for_duplicates_ or sqrt(W) if !use_Z_for_duplicates_ with square root of negative second derivatives of log-likelihood
+			//auxiliary variables for updating mode
+			arena_vec_t rhs = arena_.Vec(dim_mode_), rhs2 = arena_.Vec(dim_mode_), a_vec_new = arena_.Vec(dim_mode_);
+			arena_vec_t mode_update = arena_.Vec(dim_mode_), a_vec_update = arena_.Vec(dim_mode_);
+			vec_t mode_new;
+			arena_vec_t diag_Wsqrt = arena_.Vec(dim_mode_);//diagonal of matrix sqrt(ZtWZ) if use_Z_for_duplicates_ or sqrt(W) if !use_Z_for_duplicates_ with square root of negative second derivatives of log-likelihood
 			T_mat Id_plus_Wsqrt_Sigma_Wsqrt(dim_mode_, dim_mode_);// = Id_plus_ZtWZsqrt_Sigma_ZtWZsqrt if use_Z_for_duplicates_ or Id_plus_Wsqrt_ZSigmaZt_Wsqrt if !use_Z_for_duplicates_
 			// Start finding mode 
 			int it;
@@ -2181,13 +2197,12 @@ namespace GPBoost {
 				// Calculate right hand side for mode update
 				rhs.array() = information_ll_.array() * mode_.array() + first_deriv_ll_.array();
 				// Update mode and a_vec_
-				rhs2 = (*Sigma) * rhs;//rhs2 = sqrt(W) * Sigma * rhs
+				rhs2.noalias() = (*Sigma) * rhs;//rhs2 = sqrt(W) * Sigma * rhs
 				rhs2.array() *= diag_Wsqrt.array();
 				// Backtracking line search
-				a_vec_update = -chol_fact_Id_plus_Wsqrt_Sigma_Wsqrt_.solve(rhs2);//a_vec_ = rhs - sqrt(W) * Id_plus_Wsqrt_Sigma_Wsqrt^-1 * rhs2
-				a_vec_update.array() *= diag_Wsqrt.array();
-				a_vec_update.array() += rhs.array();
-				mode_update = (*Sigma) * a_vec_update;
+				a_vec_update = chol_fact_Id_plus_Wsqrt_Sigma_Wsqrt_.solve(rhs2);//a_vec_ = rhs - sqrt(W) * Id_plus_Wsqrt_Sigma_Wsqrt^-1 * rhs2
+				a_vec_update.array() = rhs.array() - diag_Wsqrt.array() * a_vec_update.array();
+				mode_update.noalias() = (*Sigma) * a_vec_update;
 				double lr_mode = 1.;
 				for (int ih = 0; ih < max_number_lr_shrinkage_steps_newton_; ++ih) {
 					if (ih == 0) {
@@ -2236,6 +2251,8 @@ namespace GPBoost {
 		/*!
 		* \brief Find the mode of the posterior of the latent random effects using Newton's method and calculate the approximative marginal log-likelihood.
 		*		Calculations are done by directly factorizing ("inverting) (Sigma^-1 + Zt*W*Z).
+		*		If matrix_inversion_method_ == "iterative", the linear systems in Newton's method are solved with the conjugate gradient method
+		*		and log|Sigma^-1 + Zt*W*Z| is approximated with stochastic Lanczos quadrature (see 'CalcLogDetStochGroupedRE')
 		*		NOTE: IT IS ASSUMED THAT SIGMA IS A DIAGONAL MATRIX
 		*		This version is used for the Laplace approximation when there are only grouped random effects.
 		* \param y_data Response variable data if response variable is continuous
@@ -2253,6 +2270,8 @@ namespace GPBoost {
 			const sp_mat_t& SigmaI,
 			const sp_mat_t& Zt,
 			double& approx_marginal_ll) {
+			arena_.Consolidate();
+			IterationArena::Scope arena_scope(arena_);
 			// Initialize variables
 			if (!mode_initialized_) {//Better (numerically more stable) to re-initialize mode to zero in every call
 				InitializeModeAvec();
@@ -2261,8 +2280,8 @@ namespace GPBoost {
 				mode_previous_value_ = mode_;
 				na_or_inf_during_second_last_call_to_find_mode_ = na_or_inf_during_last_call_to_find_mode_;
 			}			
-			sp_mat_t Z = Zt.transpose();
-			vec_t location_par = Z * mode_;//location parameter = mode of random effects + fixed effects
+			arena_vec_t location_par = arena_.Vec(num_data);
+			location_par.noalias() = Zt.transpose() * mode_;//location parameter = mode of random effects + fixed effects
 			if (fixed_effects != nullptr) {
 #pragma omp parallel for schedule(static)
 				for (data_size_t i = 0; i < num_data; ++i) {
@@ -2270,10 +2289,15 @@ namespace GPBoost {
 				}
 			}
 			// Initialize objective function (LA approx. marginal likelihood) for use as convergence criterion
-			approx_marginal_ll = -0.5 * (mode_.dot(SigmaI * mode_)) + LogLikelihood(y_data, y_data_int, location_par.data(), num_data);
+			// (the quadratic form is calculated in the same way for the initial value and in the line search)
+			arena_vec_t SigmaI_mode = arena_.Vec(mode_.size());
+			SigmaI_mode.noalias() = SigmaI * mode_;
+			approx_marginal_ll = -0.5 * (mode_.dot(SigmaI_mode)) + LogLikelihood(y_data, y_data_int, location_par.data(), num_data);
 			double approx_marginal_ll_new = approx_marginal_ll;
-			sp_mat_t SigmaI_plus_ZtWZ;
-			vec_t rhs, mode_update, mode_new;
+			BuildZtWZPlanGroupedRE(SigmaI, Zt);
+			const vec_t SigmaI_diag = SigmaI.diagonal();
+			const bool use_iterative = matrix_inversion_method_ == "iterative";
+			arena_vec_t rhs = arena_.Vec(mode_.size()), mode_update = arena_.Vec(mode_.size()), mode_new = arena_.Vec(mode_.size());
 			// Start finding mode 
 			int it;
 			bool terminate_optim = false;
@@ -2281,32 +2305,52 @@ namespace GPBoost {
 			for (it = 0; it < maxit_mode_newton_; ++it) {
 				// Calculate first and second derivative of log-likelihood
 				CalcFirstDerivLogLik(y_data, y_data_int, location_par.data());
-				rhs = Zt * first_deriv_ll_ - SigmaI * mode_;//right hand side for updating mode
+				rhs.noalias() = Zt * first_deriv_ll_;//right hand side for updating mode
+				rhs.noalias() -= SigmaI * mode_;
 				// Calculate Cholesky factor
 				if (it == 0 || grad_information_wrt_mode_non_zero_) {
 					CalcDiagInformationLogLik(y_data, y_data_int, location_par.data());
-					SigmaI_plus_ZtWZ = SigmaI + Zt * information_ll_.asDiagonal() * Z;
-					SigmaI_plus_ZtWZ.makeCompressed();
-					if (!chol_fact_pattern_analyzed_) {
-						chol_fact_SigmaI_plus_ZtWZ_grouped_.analyzePattern(SigmaI_plus_ZtWZ);
-						chol_fact_pattern_analyzed_ = true;
+					CalcSigmaIPlusZtWZGroupedRE(SigmaI_diag);
+					if (use_iterative) {
+						diag_SigmaI_plus_ZtWZ_ = SigmaI_plus_ZtWZ_grouped_.diagonal();
+					}
+					else {
+						if (!chol_fact_pattern_analyzed_) {
+							chol_fact_SigmaI_plus_ZtWZ_grouped_.analyzePattern(SigmaI_plus_ZtWZ_grouped_);
+							chol_fact_pattern_analyzed_ = true;
+						}
+						chol_fact_SigmaI_plus_ZtWZ_grouped_.factorize(SigmaI_plus_ZtWZ_grouped_);
 					}
-					chol_fact_SigmaI_plus_ZtWZ_grouped_.factorize(SigmaI_plus_ZtWZ);
 				}
 				// Update mode and do backtracking line search
-				mode_update = chol_fact_SigmaI_plus_ZtWZ_grouped_.solve(rhs);
+				if (use_iterative) {
+					den_mat_t rhs_cg = rhs, mode_update_cg = den_mat_t::Zero(rhs.size(), 1);
+					CGGroupedRE<sp_mat_t>(SigmaI_plus_ZtWZ_grouped_, diag_SigmaI_plus_ZtWZ_, rhs_cg, mode_update_cg, has_NA_or_Inf,
+						cg_max_num_it_, cg_delta_conv_, ZERO_RHS_CG_THRESHOLD, cg_preconditioner_type_);
+					if (has_NA_or_Inf) {
+						approx_marginal_ll = std::numeric_limits<double>::quiet_NaN();
+						Log::REDebug(NA_OR_INF_WARNING_);
+						na_or_inf_during_last_call_to_find_mode_ = true;
+						break;
+					}
+					mode_update = mode_update_cg.col(0);
+				}
+				else {
+					mode_update = chol_fact_SigmaI_plus_ZtWZ_grouped_.solve(rhs);
+				}
 				double lr_mode = 1.;
 				for (int ih = 0; ih < max_number_lr_shrinkage_steps_newton_; ++ih) {
 					mode_new = mode_ + lr_mode * mode_update;
 					// Update location parameter of log-likelihood for calculation of approx. marginal log-likelihood (objective function)
-					location_par = Z * mode_new;
+					location_par.noalias() = Zt.transpose() * mode_new;
 					if (fixed_effects != nullptr) {
 #pragma omp parallel for schedule(static)
 						for (data_size_t i = 0; i < num_data; ++i) {
 							location_par[i] += fixed_effects[i];
 						}
 					}
-					approx_marginal_ll_new = -0.5 * (mode_new.dot(SigmaI * mode_new)) + LogLikelihood(y_data, y_data_int, location_par.data(), num_data);// Calculate new objective function
+					SigmaI_mode.noalias() = SigmaI * mode_new;
+					approx_marginal_ll_new = -0.5 * (mode_new.dot(SigmaI_mode)) + LogLikelihood(y_data, y_data_int, location_par.data(), num_data);// Calculate new objective function
 					if (approx_marginal_ll_new < approx_marginal_ll ||
 						std::isnan(approx_marginal_ll_new) || std::isinf(approx_marginal_ll_new)) {
 						lr_mode *= 0.5;
@@ -2325,17 +2369,201 @@ namespace GPBoost {
 				CalcFirstDerivLogLik(y_data, y_data_int, location_par.data());//first derivative is not used here anymore but since it is reused in gradient calculation and in prediction, we calculate it once more
 				if (grad_information_wrt_mode_non_zero_) {
 					CalcDiagInformationLogLik(y_data, y_data_int, location_par.data());
-					SigmaI_plus_ZtWZ = SigmaI + Zt * information_ll_.asDiagonal() * Z;
-					SigmaI_plus_ZtWZ.makeCompressed();
-					chol_fact_SigmaI_plus_ZtWZ_grouped_.factorize(SigmaI_plus_ZtWZ);
+					CalcSigmaIPlusZtWZGroupedRE(SigmaI_diag);
+					if (use_iterative) {
+						diag_SigmaI_plus_ZtWZ_ = SigmaI_plus_ZtWZ_grouped_.diagonal();
+					}
+					else {
+						chol_fact_SigmaI_plus_ZtWZ_grouped_.factorize(SigmaI_plus_ZtWZ_grouped_);
+					}
+				}
+				if (use_iterative) {
+					double log_det_SigmaI_plus_ZtWZ;
+					CalcLogDetStochGroupedRE(has_NA_or_Inf, log_det_SigmaI_plus_ZtWZ);
+					if (has_NA_or_Inf) {
+						approx_marginal_ll = std::numeric_limits<double>::quiet_NaN();
+						Log::REDebug(NA_OR_INF_WARNING_);
+						na_or_inf_during_last_call_to_find_mode_ = true;
+						return;
+					}
+					approx_marginal_ll += -0.5 * log_det_SigmaI_plus_ZtWZ + 0.5 * SigmaI_diag.array().log().sum();
+				}
+				else {
+					approx_marginal_ll += -((sp_mat_t)chol_fact_SigmaI_plus_ZtWZ_grouped_.matrixL()).diagonal().array().log().sum() + 0.5 * SigmaI.diagonal().array().log().sum();
 				}
-				approx_marginal_ll += -((sp_mat_t)chol_fact_SigmaI_plus_ZtWZ_grouped_.matrixL()).diagonal().array().log().sum() + 0.5 * SigmaI.diagonal().array().log().sum();
+				chol_fact_grouped_RE_calculated_ = !use_iterative;
 				mode_has_been_calculated_ = true;
 				mode_is_zero_ = false;
 				na_or_inf_during_last_call_to_find_mode_ = false;
 			}
 		}//end FindModePostRandEffCalcMLLGroupedRE
 
+		/*!
+		* \brief Calculate log|Sigma^-1 + Zt*W*Z| using stochastic Lanczos quadrature when there are only grouped random effects.
+		*		The matrix Sigma^-1 + Zt*W*Z and its diagonal need to be saved in 'SigmaI_plus_ZtWZ_grouped_' and 'diag_SigmaI_plus_ZtWZ_'.
+		*		The "ssor" and "diagonal" preconditioners are calculated from this matrix and thus include W.
+		*		(Sigma^-1 + Zt*W*Z)^(-1) * (probe vectors) is saved in 'SigmaI_plus_W_inv_Z_' and reused for the stochastic traces in the gradient
+		* \param[out] has_NA_or_Inf Is set to true if NA or Inf occured in the conjugate gradient algorithm
+		* \param[out] log_det_SigmaI_plus_ZtWZ Approximation of log|Sigma^-1 + Zt*W*Z|
+		*/
+		void CalcLogDetStochGroupedRE(bool& has_NA_or_Inf,
+			double& log_det_SigmaI_plus_ZtWZ) {
+			const int num_REs = (int)SigmaI_plus_ZtWZ_grouped_.rows();
+			if (!cg_generator_seeded_) {
+				cg_generator_ = RNG_t(seed_rand_vec_trace_);
+				cg_generator_seeded_ = true;
+			}
+			//Generate random vectors (r_1, r_2, r_3, ...) with Cov(r_i) = I
+			if (!saved_rand_vec_trace_ || rand_vec_trace_I_.rows() != num_REs) {
+				rand_vec_trace_I_.resize(num_REs, num_rand_vec_trace_);
+				GenRandVecNormal(cg_generator_, rand_vec_trace_I_);
+				if (reuse_rand_vec_trace_) {
+					saved_rand_vec_trace_ = true;
+				}
+			}
+			//Get random vectors (z_1, ..., z_t) with Cov(z_i) = P: z_i = (D + L) * D^(-1/2) * r_i for "ssor" and z_i = D^(1/2) * r_i for "diagonal"
+			if (cg_preconditioner_type_ == "ssor") {
+				sp_mat_t SigmaI_plus_ZtWZ_lower = SigmaI_plus_ZtWZ_grouped_.triangularView<Eigen::Lower>();
+				rand_vec_trace_P_ = SigmaI_plus_ZtWZ_lower * (diag_SigmaI_plus_ZtWZ_.cwiseSqrt().cwiseInverse().asDiagonal() * rand_vec_trace_I_);
+			}
+			else if (cg_preconditioner_type_ == "diagonal") {
+				rand_vec_trace_P_ = diag_SigmaI_plus_ZtWZ_.cwiseSqrt().asDiagonal() * rand_vec_trace_I_;
+			}
+			else {
+				rand_vec_trace_P_ = rand_vec_trace_I_;
+			}
+			SigmaI_plus_W_inv_Z_.resize(num_REs, num_rand_vec_trace_);
+			std::vector<vec_t> Tdiags_PI_SigmaI_plus_ZtWZ(num_rand_vec_trace_, vec_t(cg_max_num_it_tridiag_));
+			std::vector<vec_t> Tsubdiags_PI_SigmaI_plus_ZtWZ(num_rand_vec_trace_, vec_t(cg_max_num_it_tridiag_ - 1));
+			CGTridiagGroupedRE<sp_mat_t>(SigmaI_plus_ZtWZ_grouped_, diag_SigmaI_plus_ZtWZ_, rand_vec_trace_P_,
+				Tdiags_PI_SigmaI_plus_ZtWZ, Tsubdiags_PI_SigmaI_plus_ZtWZ, SigmaI_plus_W_inv_Z_, has_NA_or_Inf, num_REs,
+				num_rand_vec_trace_, cg_max_num_it_tridiag_, cg_delta_conv_, cg_preconditioner_type_);
+			if (!has_NA_or_Inf) {
+				LogDetStochTridiag(Tdiags_PI_SigmaI_plus_ZtWZ, Tsubdiags_PI_SigmaI_plus_ZtWZ, log_det_SigmaI_plus_ZtWZ, num_REs, num_rand_vec_trace_);
+				// Correction for preconditioner: log|P| = log|D| for both "ssor" and "diagonal"
+				if (cg_preconditioner_type_ != "none") {
+					log_det_SigmaI_plus_ZtWZ += diag_SigmaI_plus_ZtWZ_.array().log().sum();
+				}
+			}
+		}//end CalcLogDetStochGroupedRE
+
+		/*!
+		* \brief Factorize Sigma^-1 + Zt*W*Z at the mode if this has not been done in the mode finding (matrix_inversion_method_ == "iterative").
+		*		The Cholesky factor is then only needed for predictive (co)variances
+		*/
+		void CalcCholFactGroupedREIfNotCalculated() {
+			if (!chol_fact_grouped_RE_calculated_) {
+				if (!chol_fact_pattern_analyzed_) {
+					chol_fact_SigmaI_plus_ZtWZ_grouped_.analyzePattern(SigmaI_plus_ZtWZ_grouped_);
+					chol_fact_pattern_analyzed_ = true;
+				}
+				chol_fact_SigmaI_plus_ZtWZ_grouped_.factorize(SigmaI_plus_ZtWZ_grouped_);
+				chol_fact_grouped_RE_calculated_ = true;
+			}
+		}//end CalcCholFactGroupedREIfNotCalculated
+
+		/*!
+		* \brief Build the plan that scatters the contribution of every observation to the value slots of the compressed matrix SigmaI + Zt * W * Z.
+		*		The sparsity pattern does not depend on W, so it is computed once and the plan is reused until InvalidateZtWZPlanGroupedRE() is called.
+		*		NOTE: IT IS ASSUMED THAT SIGMA IS A DIAGONAL MATRIX
+		* \param SigmaI Inverse covariance matrix of latent random effect (only its pattern is used)
+		* \param Zt Transpose Z^T of random effect design matrix
+		*/
+		void BuildZtWZPlanGroupedRE(const sp_mat_t& SigmaI,
+			const sp_mat_t& Zt) {
+			if (ZtWZ_plan_built_) {
+				CHECK(SigmaI_plus_ZtWZ_grouped_.rows() == Zt.rows());
+				return;
+			}
+			const int num_re = (int)Zt.rows();
+			const data_size_t num_data = (data_size_t)Zt.cols();
+			SigmaI_plus_ZtWZ_grouped_ = SigmaI + Zt * Zt.transpose();
+			SigmaI_plus_ZtWZ_grouped_.makeCompressed();
+			const int* outer = SigmaI_plus_ZtWZ_grouped_.outerIndexPtr();
+			const int* inner = SigmaI_plus_ZtWZ_grouped_.innerIndexPtr();
+			const int* zt_outer = Zt.outerIndexPtr();
+			const int* zt_inner = Zt.innerIndexPtr();
+			const double* zt_values = Zt.valuePtr();
+			// slot of every entry (k, l) contributed by observation i with Zt(k, i) != 0 and Zt(l, i) != 0
+			std::vector<int64_t> num_entries_data(num_data + 1, 0);
+			for (data_size_t i = 0; i < num_data; ++i) {
+				const int64_t nnz_i = zt_outer[i + 1] - zt_outer[i];
+				num_entries_data[i + 1] = num_entries_data[i] + nnz_i * nnz_i;
+			}
+			std::vector<int> slot_of_entry(num_entries_data[num_data]);
+			bool unit_weights = true;
+#pragma omp parallel for schedule(static) reduction(&&:unit_weights)
+			for (data_size_t i = 0; i < num_data; ++i) {
+				int64_t pos = num_entries_data[i];
+				for (int jl = zt_outer[i]; jl < zt_outer[i + 1]; ++jl) {
+					const int l = zt_inner[jl];
+					for (int jk = zt_outer[i]; jk < zt_outer[i + 1]; ++jk) {
+						const int k = zt_inner[jk];
+						slot_of_entry[pos++] = (int)(std::lower_bound(inner + outer[l], inner + outer[l + 1], k) - inner);
+						unit_weights = unit_weights && (zt_values[jl] * zt_values[jk] == 1.);
+					}
+				}
+			}
+			// counting sort of the entries by slot
+			const int num_slots = (int)SigmaI_plus_ZtWZ_grouped_.nonZeros();
+			ZtWZ_plan_slot_start_.assign(num_slots + 1, 0);
+			for (const int slot : slot_of_entry) {
+				ZtWZ_plan_slot_start_[slot + 1]++;
+			}
+			for (int slot = 0; slot < num_slots; ++slot) {
+				ZtWZ_plan_slot_start_[slot + 1] += ZtWZ_plan_slot_start_[slot];
+			}
+			std::vector<int64_t> next_pos(ZtWZ_plan_slot_start_.begin(), ZtWZ_plan_slot_start_.end() - 1);
+			ZtWZ_plan_data_idx_.resize(slot_of_entry.size());
+			ZtWZ_plan_weights_.resize(unit_weights ? 0 : slot_of_entry.size());
+			for (data_size_t i = 0; i < num_data; ++i) {
+				int64_t pos = num_entries_data[i];
+				for (int jl = zt_outer[i]; jl < zt_outer[i + 1]; ++jl) {
+					for (int jk = zt_outer[i]; jk < zt_outer[i + 1]; ++jk) {
+						const int64_t dest = next_pos[slot_of_entry[pos++]]++;
+						ZtWZ_plan_data_idx_[dest] = i;
+						if (!unit_weights) {
+							ZtWZ_plan_weights_[dest] = zt_values[jl] * zt_values[jk];
+						}
+					}
+				}
+			}
+			// diagonal slots receive the entries of SigmaI
+			ZtWZ_plan_diag_slot_.resize(num_re);
+			for (int l = 0; l < num_re; ++l) {
+				ZtWZ_plan_diag_slot_[l] = (int)(std::lower_bound(inner + outer[l], inner + outer[l + 1], l) - inner);
+			}
+			ZtWZ_plan_built_ = true;
+		}//end BuildZtWZPlanGroupedRE
+
+		/*!
+		* \brief Calculate the values of SigmaI_plus_ZtWZ_grouped_ = SigmaI + Zt * diag(information_ll_) * Z in place using the plan of BuildZtWZPlanGroupedRE
+		* \param SigmaI_diag Diagonal of SigmaI
+		*/
+		void CalcSigmaIPlusZtWZGroupedRE(const vec_t& SigmaI_diag) {
+			double* values = SigmaI_plus_ZtWZ_grouped_.valuePtr();
+			const int num_slots = (int)SigmaI_plus_ZtWZ_grouped_.nonZeros();
+			const bool unit_weights = ZtWZ_plan_weights_.empty();
+#pragma omp parallel for schedule(static)
+			for (int slot = 0; slot < num_slots; ++slot) {
+				double sum = 0.;
+				if (unit_weights) {
+					for (int64_t j = ZtWZ_plan_slot_start_[slot]; j < ZtWZ_plan_slot_start_[slot + 1]; ++j) {
+						sum += information_ll_[ZtWZ_plan_data_idx_[j]];
+					}
+				}
+				else {
+					for (int64_t j = ZtWZ_plan_slot_start_[slot]; j < ZtWZ_plan_slot_start_[slot + 1]; ++j) {
+						sum += ZtWZ_plan_weights_[j] * information_ll_[ZtWZ_plan_data_idx_[j]];
+					}
+				}
+				values[slot] = sum;
+			}
+			for (int l = 0; l < (int)ZtWZ_plan_diag_slot_.size(); ++l) {
+				values[ZtWZ_plan_diag_slot_[l]] += SigmaI_diag[l];
+			}
+		}//end CalcSigmaIPlusZtWZGroupedRE
+
 		/*!
 		* \brief Find the mode of the posterior of the latent random effects using Newton's method and calculate the approximative marginal log-likelihood.
 		*		Calculations are done by directly factorizing ("inverting) (Sigma^-1 + Zt*W*Z).
@@ -2449,6 +2677,8 @@ namespace GPBoost {
 			const std::vector<std::shared_ptr<RECompGP<den_mat_t>>>& re_comps_cross_cov_cluster_i,
 			const den_mat_t chol_ip_cross_cov,
 			const chol_den_mat_t chol_fact_sigma_ip) {
+			arena_.Consolidate();
+			IterationArena::Scope arena_scope(arena_);
 			// Initialize variables
 			if (!mode_initialized_) {//Better (numerically more stable) to re-initialize mode to zero in every call
 				InitializeModeAvec();
@@ -2459,7 +2689,8 @@ namespace GPBoost {
 			}
 			vec_t location_par;//location parameter = mode of random effects + fixed effects
 			double* location_par_ptr;
-			vec_t rhs, B_mode, mode_new, mode_update(dim_mode_);
+			vec_t rhs, mode_new, mode_update(dim_mode_);
+			arena_vec_t B_mode = arena_.Vec(B.rows());
 			// Variables when using Cholesky factorization
 			sp_mat_t SigmaI, SigmaI_plus_W;
 			vec_t mode_update_lag1;//auxiliary variable used only if quasi_newton_for_mode_finding_
@@ -2472,8 +2703,8 @@ namespace GPBoost {
 			den_mat_t I_k_plus_Sigma_L_kt_W_Sigma_L_k;
 			InitializeLocationPar(fixed_effects, location_par, &location_par_ptr);
 			// Initialize objective function (LA approx. marginal likelihood) for use as convergence criterion
-			B_mode = B * mode_;
-			approx_marginal_ll = -0.5 * (B_mode.dot(D_inv * B_mode)) + LogLikelihood(y_data, y_data_int, location_par_ptr, num_data_);
+			B_mode.noalias() = B * mode_;
+			approx_marginal_ll = -0.5 * (B_mode.dot(B_mode.cwiseProduct(D_inv.diagonal()))) + LogLikelihood(y_data, y_data_int, location_par_ptr, num_data_);
 			double approx_marginal_ll_new = approx_marginal_ll;
 			den_mat_t sigma_ip_stable;
 			if (matrix_inversion_method_ == "iterative") {
@@ -2532,9 +2763,9 @@ namespace GPBoost {
 						REModelTemplate<T_mat, T_chol>::ApplyMomentumStep(it, mode_update, mode_update_lag1,
 							mode_new, nesterov_acc_rate, 0, false, 2, false);
 						CapChangeModeUpdateNewton(mode_new);
-						B_mode = B * mode_new;
+						B_mode.noalias() = B * mode_new;
 						UpdateLocationPar(mode_, fixed_effects, location_par, &location_par_ptr); // Update location parameter of log-likelihood for calculation of approx. marginal log-likelihood (objective function)
-						approx_marginal_ll_new = -0.5 * (B_mode.dot(D_inv * B_mode)) + LogLikelihood(y_data, y_data_int, location_par_ptr, num_data_);
+						approx_marginal_ll_new = -0.5 * (B_mode.dot(B_mode.cwiseProduct(D_inv.diagonal()))) + LogLikelihood(y_data, y_data_int, location_par_ptr, num_data_);
 						if (approx_marginal_ll_new < approx_marginal_ll ||
 							std::isnan(approx_marginal_ll_new) || std::isinf(approx_marginal_ll_new)) {
 							lr_GD *= 0.5;
@@ -2572,17 +2803,7 @@ namespace GPBoost {
 							else {
 								const den_mat_t* cross_cov = re_comps_cross_cov_cluster_i[0]->GetSigmaPtr();
 								if (it == 0 || grad_information_wrt_mode_non_zero_) {
-									diagonal_approx_preconditioner_ = information_ll_.cwiseInverse();
-									diagonal_approx_preconditioner_.array() += sigma_ip_stable.coeffRef(0, 0);
-#pragma omp parallel for schedule(static)
-									for (int ii = 0; ii < diagonal_approx_preconditioner_.size(); ++ii) {
-										diagonal_approx_preconditioner_[ii] -= chol_ip_cross_cov.col(ii).array().square().sum();
-									}
-									diagonal_approx_inv_preconditioner_ = diagonal_approx_preconditioner_.cwiseInverse();
-									den_mat_t sigma_woodbury;
-									sigma_woodbury = (*cross_cov).transpose() * (diagonal_approx_inv_preconditioner_.asDiagonal() * (*cross_cov));
-									sigma_woodbury += sigma_ip_stable;
-									chol_fact_woodbury_preconditioner_.compute(sigma_woodbury);
+									CalcFITCPreconditionerWinvPlusSigma(sigma_ip_stable, *cross_cov, chol_ip_cross_cov);
 								}
 								CGVecchiaLaplaceVecWinvplusSigma_FITC_P(information_ll_, B_rm_, B_t_D_inv_rm_.transpose(), rhs, mode_update, has_NA_or_Inf,
 									cg_max_num_it, it, cg_delta_conv_, ZERO_RHS_CG_THRESHOLD, chol_fact_woodbury_preconditioner_, (*cross_cov), diagonal_approx_inv_preconditioner_);
@@ -2638,8 +2859,8 @@ namespace GPBoost {
 						}
 						CapChangeModeUpdateNewton(mode_new);
 						UpdateLocationPar(mode_new, fixed_effects, location_par, &location_par_ptr); // Update location parameter of log-likelihood for calculation of approx. marginal log-likelihood (objective function)
-						B_mode = B * mode_new;
-						approx_marginal_ll_new = -0.5 * (B_mode.dot(D_inv * B_mode)) + LogLikelihood(y_data, y_data_int, location_par_ptr, num_data_);// Calculate new objective function
+						B_mode.noalias() = B * mode_new;
+						approx_marginal_ll_new = -0.5 * (B_mode.dot(B_mode.cwiseProduct(D_inv.diagonal()))) + LogLikelihood(y_data, y_data_int, location_par_ptr, num_data_);// Calculate new objective function
 						if (approx_marginal_ll_new < approx_marginal_ll ||
 							std::isnan(approx_marginal_ll_new) || std::isinf(approx_marginal_ll_new)) {
 							lr_mode *= 0.5;
@@ -2729,7 +2950,10 @@ namespace GPBoost {
 
 		/*!
 		* \brief Find the mode of the posterior of the latent random effects using Newton's method and 
-		*			calculate the approximative marginal log-likelihood when the 'fitc' aproximation is used
+		*			calculate the approximative marginal log-likelihood when the 'fitc' aproximation is used.
+		*			If matrix_inversion_method_ == "iterative", the linear systems in Newton's method are solved with the conjugate gradient method
+		*			for (W^-1 + Sigma) and log|Sigma W + I| is approximated with stochastic Lanczos quadrature. In this case, the Cholesky factor
+		*			in 'chol_fact_dense_Newton_' is only calculated for predictive variances (see 'CalcCholFactDenseNewtonFITC')
 		* \param y_data Response variable data if response variable is continuous
 		* \param y_data_int Response variable data if response variable is integer-valued
 		* \param fixed_effects Fixed effects component of location parameter
@@ -2738,6 +2962,10 @@ namespace GPBoost {
 		* \param cross_cov Cross-covariance matrix between inducing points and all data points
 		* \param fitc_resid_diag Diagonal correction of predictive process
 		* \param[out] approx_marginal_ll Approximate marginal log-likelihood evaluated at the mode
+		* \param re_comps_ip_preconditioner_cluster_i Inducing points of the "fitc" preconditioner (only used if matrix_inversion_method_ == "iterative")
+		* \param re_comps_cross_cov_preconditioner_cluster_i Cross-covariance matrix between the data and the inducing points of the "fitc" preconditioner (only used if matrix_inversion_method_ == "iterative")
+		* \param chol_ip_cross_cov_preconditioner Inverse of the Cholesky factor of the covariance matrix of the inducing points of the preconditioner times the transposed cross-covariance matrix (only used if matrix_inversion_method_ == "iterative")
+		* \param chol_fact_sigma_ip_preconditioner Cholesky factor of the covariance matrix of the inducing points of the preconditioner (only used if matrix_inversion_method_ == "iterative")
 		*/
 		void FindModePostRandEffCalcMLLFITC(const double* y_data,
 			const int* y_data_int,
@@ -2746,7 +2974,11 @@ namespace GPBoost {
 			const chol_den_mat_t& chol_fact_sigma_ip,
 			const den_mat_t* cross_cov,
 			const vec_t& fitc_resid_diag,
-			double& approx_marginal_ll) {
+			double& approx_marginal_ll,
+			const std::vector<std::shared_ptr<RECompGP<den_mat_t>>>& re_comps_ip_preconditioner_cluster_i,
+			const std::vector<std::shared_ptr<RECompGP<den_mat_t>>>& re_comps_cross_cov_preconditioner_cluster_i,
+			const den_mat_t& chol_ip_cross_cov_preconditioner,
+			const chol_den_mat_t& chol_fact_sigma_ip_preconditioner) {
 			int num_ip = (int)((*sigma_ip).rows());
 			CHECK((int)((*cross_cov).rows()) == dim_mode_);
 			CHECK((int)((*cross_cov).cols()) == num_ip);
@@ -2773,6 +3005,20 @@ namespace GPBoost {
 			vec_t Wsqrt_diag(dim_mode_), sigma_ip_inv_cross_cov_T_rhs(num_ip), rhs(dim_mode_), Wsqrt_Sigma_rhs(dim_mode_), vaux(num_ip), vaux2(num_ip), vaux3(dim_mode_), 
 				mode_new(dim_mode_), a_vec_new, DW_plus_I_inv_diag(dim_mode_), a_vec_update, mode_update, W_times_DW_plus_I_inv_diag;//auxiliary variables for updating mode
 			den_mat_t M_aux_Woodbury(num_ip, num_ip); // = sigma_ip + (*cross_cov).transpose() * fitc_diag_plus_WI_inv.asDiagonal() * (*cross_cov)
+			// Variables when using iterative methods
+			vec_t fitc_diag_plus_WI;// = fitc_resid_diag + W^-1
+			den_mat_t sigma_ip_stable_preconditioner;
+			const den_mat_t* cross_cov_preconditioner = cross_cov;
+			if (matrix_inversion_method_ == "iterative") {
+				if (cg_preconditioner_type_ == "fitc") {
+					sigma_ip_stable_preconditioner = *(re_comps_ip_preconditioner_cluster_i[0]->GetZSigmaZt());
+					sigma_ip_stable_preconditioner.diagonal().array() *= JITTER_MULT_IP_FITC_FSA;
+					cross_cov_preconditioner = re_comps_cross_cov_preconditioner_cluster_i[0]->GetSigmaPtr();
+				}
+				else if (cg_preconditioner_type_ != "none") {
+					Log::REFatal("FindModePostRandEffCalcMLLFITC: Preconditioner type '%s' is not supported ", cg_preconditioner_type_.c_str());
+				}
+			}
 			// Start finding mode 
 			int it;
 			bool terminate_optim = false;
@@ -2780,7 +3026,14 @@ namespace GPBoost {
 			for (it = 0; it < maxit_mode_newton_; ++it) {
 				// Calculate first and second derivative of log-likelihood
 				CalcFirstDerivLogLik(y_data, y_data_int, location_par_ptr);
-				if (it == 0 || grad_information_wrt_mode_non_zero_) {
+				if ((it == 0 || grad_information_wrt_mode_non_zero_) && matrix_inversion_method_ == "iterative") {
+					CalcDiagInformationLogLik(y_data, y_data_int, location_par_ptr);
+					fitc_diag_plus_WI = fitc_resid_diag + information_ll_.cwiseInverse();
+					if (cg_preconditioner_type_ == "fitc") {
+						CalcFITCPreconditionerWinvPlusSigma(sigma_ip_stable_preconditioner, *cross_cov_preconditioner, chol_ip_cross_cov_preconditioner);
+					}
+				}
+				else if (it == 0 || grad_information_wrt_mode_non_zero_) {
 					CalcDiagInformationLogLik(y_data, y_data_int, location_par_ptr);
 					Wsqrt_diag.array() = information_ll_.array().sqrt();
 					DW_plus_I_inv_diag = (information_ll_.array() * fitc_resid_diag.array() + 1.).matrix().cwiseInverse();
@@ -2792,19 +3045,33 @@ namespace GPBoost {
 					W_times_DW_plus_I_inv_diag.array() *= DW_plus_I_inv_diag.array();
 					M_aux_Woodbury += (*cross_cov).transpose() * W_times_DW_plus_I_inv_diag.asDiagonal() * (*cross_cov);// = *sigma_ip + (*cross_cov).transpose() * fitc_diag_plus_WI_inv.asDiagonal() * (*cross_cov)
 					chol_fact_dense_Newton_.compute(M_aux_Woodbury);//Cholesky factor of sigma_ip + Sigma_nm^T * Wsqrt * DW_plus_I_inv_diag * Wsqrt * Sigma_nm
+					chol_fact_dense_Newton_calculated_ = true;
 				}
 				rhs.array() = information_ll_.array() * mode_.array() + first_deriv_ll_.array();
 				// Update mode and a_vec_
-				sigma_ip_inv_cross_cov_T_rhs = chol_fact_sigma_ip.solve((*cross_cov).transpose() * rhs);
-				Wsqrt_Sigma_rhs = ((*cross_cov) * sigma_ip_inv_cross_cov_T_rhs) + (fitc_resid_diag.asDiagonal() * rhs);//Sigma * rhs
-				vaux = (*cross_cov).transpose() * (W_times_DW_plus_I_inv_diag.asDiagonal() * Wsqrt_Sigma_rhs);
-				vaux2 = chol_fact_dense_Newton_.solve(vaux);
-				Wsqrt_Sigma_rhs.array() *= Wsqrt_diag.array();//Wsqrt_Sigma_rhs = sqrt(W) * Sigma * rhs
+				if (matrix_inversion_method_ == "iterative") {
+					// a_vec_ = Sigma^-1 * (Sigma^-1 + W)^-1 * rhs = (W^-1 + Sigma)^-1 * W^-1 * rhs, the previous value of a_vec_ is used as initial value for the CG
+					a_vec_update = a_vec_;
+					CGFITC(fitc_diag_plus_WI, *cross_cov, chol_fact_sigma_ip, rhs.cwiseQuotient(information_ll_), a_vec_update, has_NA_or_Inf,
+						cg_max_num_it_, cg_delta_conv_, ZERO_RHS_CG_THRESHOLD, cg_preconditioner_type_,
+						*cross_cov_preconditioner, chol_fact_woodbury_preconditioner_, diagonal_approx_inv_preconditioner_);
+					if (has_NA_or_Inf) {
+						CheckConvergenceModeFinding(it, std::numeric_limits<double>::quiet_NaN(), approx_marginal_ll, terminate_optim, has_NA_or_Inf);
+						break;
+					}
+				}
+				else {
+					sigma_ip_inv_cross_cov_T_rhs = chol_fact_sigma_ip.solve((*cross_cov).transpose() * rhs);
+					Wsqrt_Sigma_rhs = ((*cross_cov) * sigma_ip_inv_cross_cov_T_rhs) + (fitc_resid_diag.asDiagonal() * rhs);//Sigma * rhs
+					vaux = (*cross_cov).transpose() * (W_times_DW_plus_I_inv_diag.asDiagonal() * Wsqrt_Sigma_rhs);
+					vaux2 = chol_fact_dense_Newton_.solve(vaux);
+					Wsqrt_Sigma_rhs.array() *= Wsqrt_diag.array();//Wsqrt_Sigma_rhs = sqrt(W) * Sigma * rhs
+					a_vec_update = DW_plus_I_inv_diag.asDiagonal() * (Wsqrt_Sigma_rhs - Wsqrt_diag.asDiagonal() * ((*cross_cov) * vaux2));
+					a_vec_update.array() *= Wsqrt_diag.array();
+					a_vec_update.array() *= -1.;
+					a_vec_update.array() += rhs.array();//a_vec_ = rhs - sqrt(W) * Id_plus_Wsqrt_Sigma_Wsqrt^-1 * rhs2
+				}
 				// Backtracking line search
-				a_vec_update = DW_plus_I_inv_diag.asDiagonal() * (Wsqrt_Sigma_rhs - Wsqrt_diag.asDiagonal() * ((*cross_cov) * vaux2));
-				a_vec_update.array() *= Wsqrt_diag.array();
-				a_vec_update.array() *= -1.;
-				a_vec_update.array() += rhs.array();//a_vec_ = rhs - sqrt(W) * Id_plus_Wsqrt_Sigma_Wsqrt^-1 * rhs2
 				vaux3 = chol_fact_sigma_ip.solve((*cross_cov).transpose() * a_vec_update);
 				mode_update = ((*cross_cov) * vaux3) + (fitc_resid_diag.asDiagonal() * a_vec_update);//mode_ = Sigma * a_vec_
 				double lr_mode = 1.;
@@ -2840,25 +3107,64 @@ namespace GPBoost {
 				mode_is_zero_ = false;
 				na_or_inf_during_last_call_to_find_mode_ = false;
 				CalcFirstDerivLogLik(y_data, y_data_int, location_par_ptr);//first derivative is not used here anymore but since it is reused in gradient calculation and in prediction, we calculate it once more
-				vec_t fitc_diag_plus_WI_inv;
-				if (grad_information_wrt_mode_non_zero_) {
-					CalcDiagInformationLogLik(y_data, y_data_int, location_par_ptr);
-					fitc_diag_plus_WI_inv = (fitc_resid_diag + information_ll_.cwiseInverse()).cwiseInverse();
-					M_aux_Woodbury = *sigma_ip;
-					M_aux_Woodbury.diagonal().array() *= JITTER_MULT_IP_FITC_FSA;
-					M_aux_Woodbury += (*cross_cov).transpose() * fitc_diag_plus_WI_inv.asDiagonal() * (*cross_cov);
-					chol_fact_dense_Newton_.compute(M_aux_Woodbury);//Cholesky factor of (sigma_ip + Sigma_nm^T * fitc_diag_plus_WI_inv * Sigma_nm)
-				}
+				if (matrix_inversion_method_ == "iterative") {
+					if (grad_information_wrt_mode_non_zero_) {
+						CalcDiagInformationLogLik(y_data, y_data_int, location_par_ptr);
+						fitc_diag_plus_WI = fitc_resid_diag + information_ll_.cwiseInverse();
+						if (cg_preconditioner_type_ == "fitc") {
+							CalcFITCPreconditionerWinvPlusSigma(sigma_ip_stable_preconditioner, *cross_cov_preconditioner, chol_ip_cross_cov_preconditioner);
+						}
+					}
+					chol_fact_dense_Newton_calculated_ = false;
+					double log_det_WI_plus_Sigma;
+					CalcLogDetStochFITC(fitc_diag_plus_WI, *cross_cov, chol_fact_sigma_ip, *cross_cov_preconditioner,
+						chol_ip_cross_cov_preconditioner, chol_fact_sigma_ip_preconditioner, has_NA_or_Inf, log_det_WI_plus_Sigma);
+					if (has_NA_or_Inf) {
+						approx_marginal_ll = std::numeric_limits<double>::quiet_NaN();
+						Log::REDebug(NA_OR_INF_WARNING_);
+						na_or_inf_during_last_call_to_find_mode_ = true;
+					}
+					else {
+						//log|Sigma W + I| = log|W^(-1) + Sigma| + log|W|
+						approx_marginal_ll -= 0.5 * (log_det_WI_plus_Sigma + information_ll_.array().log().sum());
+					}
+				}//end iterative
 				else {
-					fitc_diag_plus_WI_inv = (fitc_resid_diag + information_ll_.cwiseInverse()).cwiseInverse();
+					if (grad_information_wrt_mode_non_zero_) {
+						CalcDiagInformationLogLik(y_data, y_data_int, location_par_ptr);
+						chol_fact_dense_Newton_calculated_ = false;
+						CalcCholFactDenseNewtonFITC(sigma_ip, cross_cov, fitc_resid_diag);
+					}
+					vec_t fitc_diag_plus_WI_inv = (fitc_resid_diag + information_ll_.cwiseInverse()).cwiseInverse();
+					approx_marginal_ll -= ((den_mat_t)chol_fact_dense_Newton_.matrixL()).diagonal().array().log().sum();
+					approx_marginal_ll += ((den_mat_t)chol_fact_sigma_ip.matrixL()).diagonal().array().log().sum();
+					approx_marginal_ll += 0.5 * fitc_diag_plus_WI_inv.array().log().sum();
+					approx_marginal_ll -= 0.5 * information_ll_.array().log().sum();
 				}
-				approx_marginal_ll -= ((den_mat_t)chol_fact_dense_Newton_.matrixL()).diagonal().array().log().sum();
-				approx_marginal_ll += ((den_mat_t)chol_fact_sigma_ip.matrixL()).diagonal().array().log().sum();
-				approx_marginal_ll += 0.5 * fitc_diag_plus_WI_inv.array().log().sum();
-				approx_marginal_ll -= 0.5 * information_ll_.array().log().sum();
 			}
 		}//end FindModePostRandEffCalcMLLFITC
 
+		/*!
+		* \brief Calculate the Cholesky factor of sigma_ip + cross_cov^T * (fitc_resid_diag + W^-1)^-1 * cross_cov and save it in 'chol_fact_dense_Newton_'
+		*		if this has not yet been done for the current mode. When using iterative methods, this is not done during the mode finding
+		*		and the gradient calculation but only when the factor is needed for calculating predictive variances
+		* \param sigma_ip Covariance matrix of inducing point process
+		* \param cross_cov Cross-covariance matrix between inducing points and all data points
+		* \param fitc_resid_diag Diagonal correction of predictive process
+		*/
+		void CalcCholFactDenseNewtonFITC(const std::shared_ptr<den_mat_t> sigma_ip,
+			const den_mat_t* cross_cov,
+			const vec_t& fitc_resid_diag) {
+			if (!chol_fact_dense_Newton_calculated_) {
+				vec_t fitc_diag_plus_WI_inv = (fitc_resid_diag + information_ll_.cwiseInverse()).cwiseInverse();
+				den_mat_t M_aux_Woodbury = *sigma_ip;
+				M_aux_Woodbury.diagonal().array() *= JITTER_MULT_IP_FITC_FSA;
+				M_aux_Woodbury += (*cross_cov).transpose() * fitc_diag_plus_WI_inv.asDiagonal() * (*cross_cov);
+				chol_fact_dense_Newton_.compute(M_aux_Woodbury);//Cholesky factor of (sigma_ip + Sigma_nm^T * fitc_diag_plus_WI_inv * Sigma_nm)
+				chol_fact_dense_Newton_calculated_ = true;
+			}
+		}//end CalcCholFactDenseNewtonFITC
+
 		/*!
 		* \brief Calculate the gradient of the negative Laplace-approximated marginal log-likelihood wrt covariance parameters,
 		*		fixed effects (e.g., for linear regression coefficients), and additional likelihood-related parameters.
@@ -3041,6 +3347,7 @@ namespace GPBoost {
 		* \brief Calculate the gradient of the negative Laplace-approximated marginal log-likelihood wrt covariance parameters,
 		*		fixed effects (e.g., for linear regression coefficients), and additional likelihood-related parameters.
 		*		Calculations are done by directly factorizing ("inverting) (Sigma^-1 + Zt*W*Z).
+		*		If matrix_inversion_method_ == "iterative", traces are approximated stochastically and linear systems are solved with the conjugate gradient method
 		*		NOTE: IT IS ASSUMED THAT SIGMA IS A DIAGONAL MATRIX
 		*		This version is used for the Laplace approximation when there are only grouped random effects.
 		* \param y_data Response variable data if response variable is continuous
@@ -3097,20 +3404,52 @@ namespace GPBoost {
 					location_par[i] += fixed_effects[i];
 				}
 			}
+			const bool use_iterative = matrix_inversion_method_ == "iterative";
 			// Calculate (Sigma^-1 + Zt*W*Z)^-1
-			sp_mat_t L_inv(num_REs, num_REs);
-			L_inv.setIdentity();
-			if (chol_fact_SigmaI_plus_ZtWZ_grouped_.permutationP().size() > 0) {//Permutation is only used when having an ordering
-				L_inv = chol_fact_SigmaI_plus_ZtWZ_grouped_.permutationP() * L_inv;
-			}
-			sp_mat_t L = chol_fact_SigmaI_plus_ZtWZ_grouped_.matrixL();
-			TriangularSolve<sp_mat_t, sp_mat_t, sp_mat_t>(L, L_inv, L_inv, false);
-			L.resize(0, 0);
+			sp_mat_t L_inv;
 			sp_mat_t SigmaI_plus_ZtWZ_inv;
+			// For iterative methods, the traces are approximated stochastically using (Sigma^-1 + Zt*W*Z)^-1 * (probe vectors) from the Lanczos algorithm
+			//	(see 'CalcLogDetStochGroupedRE') and linear systems are solved with the conjugate gradient method
+			den_mat_t PI_Z;//P^-1 * (probe vectors)
+			vec_t diag_Z_SigmaI_plus_ZtWZ_inv_Zt;//stochastic approximation of the diagonal of Z * (Sigma^-1 + Zt*W*Z)^-1 * Zt
+			vec_t SigmaI_plus_ZtWZ_inv_d_mll_d_mode;
+			if (use_iterative) {
+				PreconditionerSolveGroupedRE<sp_mat_t, den_mat_t>(SigmaI_plus_ZtWZ_grouped_, diag_SigmaI_plus_ZtWZ_,
+					cg_preconditioner_type_, rand_vec_trace_P_, PI_Z);
+				if (grad_information_wrt_mode_non_zero_ || calc_aux_par_grad) {
+					den_mat_t Z_SigmaI_plus_ZtWZ_inv_RV = Z * SigmaI_plus_W_inv_Z_;
+					den_mat_t Z_PI_Z = Z * PI_Z;
+					diag_Z_SigmaI_plus_ZtWZ_inv_Zt = Z_SigmaI_plus_ZtWZ_inv_RV.cwiseProduct(Z_PI_Z).rowwise().mean();
+				}
+			}
+			else {
+				L_inv = sp_mat_t(num_REs, num_REs);
+				L_inv.setIdentity();
+				if (chol_fact_SigmaI_plus_ZtWZ_grouped_.permutationP().size() > 0) {//Permutation is only used when having an ordering
+					L_inv = chol_fact_SigmaI_plus_ZtWZ_grouped_.permutationP() * L_inv;
+				}
+				sp_mat_t L = chol_fact_SigmaI_plus_ZtWZ_grouped_.matrixL();
+				TriangularSolve<sp_mat_t, sp_mat_t, sp_mat_t>(L, L_inv, L_inv, false);
+				L.resize(0, 0);
+			}
 			// calculate gradient of approx. marginal likelihood wrt the mode
 			vec_t deriv_information_loc_par;//usually vector of negative third derivatives of log-likelihood
 			vec_t d_mll_d_mode;
-			if (grad_information_wrt_mode_non_zero_) {
+			if (grad_information_wrt_mode_non_zero_ && use_iterative) {
+				deriv_information_loc_par = vec_t(num_data);
+				CalcFirstDerivInformationLocPar(y_data, y_data_int, location_par.data(), deriv_information_loc_par);
+				d_mll_d_mode = 0.5 * (Zt * deriv_information_loc_par.cwiseProduct(diag_Z_SigmaI_plus_ZtWZ_inv_Zt));
+				//For implicit derivatives: calculate (Sigma^-1 + Zt*W*Z)^-1 * d_mll_d_mode
+				den_mat_t d_mll_d_mode_cg = d_mll_d_mode, SigmaI_plus_ZtWZ_inv_d_mll_d_mode_cg = den_mat_t::Zero(num_REs, 1);
+				bool has_NA_or_Inf = false;
+				CGGroupedRE<sp_mat_t>(SigmaI_plus_ZtWZ_grouped_, diag_SigmaI_plus_ZtWZ_, d_mll_d_mode_cg, SigmaI_plus_ZtWZ_inv_d_mll_d_mode_cg, has_NA_or_Inf,
+					cg_max_num_it_, cg_delta_conv_, ZERO_RHS_CG_THRESHOLD, cg_preconditioner_type_);
+				if (has_NA_or_Inf) {
+					Log::REDebug(CG_NA_OR_INF_WARNING_);
+				}
+				SigmaI_plus_ZtWZ_inv_d_mll_d_mode = SigmaI_plus_ZtWZ_inv_d_mll_d_mode_cg.col(0);
+			}
+			else if (grad_information_wrt_mode_non_zero_) {
 				deriv_information_loc_par = vec_t(num_data);
 				CalcFirstDerivInformationLocPar(y_data, y_data_int, location_par.data(), deriv_information_loc_par);
 				d_mll_d_mode = vec_t(num_REs);
@@ -3131,7 +3470,38 @@ namespace GPBoost {
 				}
 			}
 			// calculate gradient wrt covariance parameters
-			if (calc_cov_grad) {
+			if (calc_cov_grad && use_iterative) {
+				vec_t SigmaI_mode = SigmaI * mode_;
+				vec_t Zt_first_deriv_ll;
+				if (grad_information_wrt_mode_non_zero_) {
+					Zt_first_deriv_ll = Zt * first_deriv_ll_;
+				}
+				for (int j = 0; j < num_comps; ++j) {
+					const int num_rand_eff = cum_num_rand_eff_cluster_i[j + 1] - cum_num_rand_eff_cluster_i[j];
+					const vec_t SigmaI_diag_j = SigmaI.diagonal().segment(cum_num_rand_eff_cluster_i[j], num_rand_eff);
+					// trace((Sigma^-1 + Zt*W*Z)^-1 * I_j * Zt*W*Z) = n_j - trace((Sigma^-1 + Zt*W*Z)^-1 * I_j * Sigma^-1)
+					vec_t sample_MInv = (SigmaI_diag_j.asDiagonal() * SigmaI_plus_W_inv_Z_.middleRows(cum_num_rand_eff_cluster_i[j], num_rand_eff)).cwiseProduct(
+						PI_Z.middleRows(cum_num_rand_eff_cluster_i[j], num_rand_eff)).colwise().sum();
+					double trace_MInv_SigmaI_j = sample_MInv.mean();
+					// Variance reduction using the exactly known trace of the diagonal preconditioner (as for Gaussian likelihoods)
+					if (cg_preconditioner_type_ == "diagonal") {
+						vec_t sample_P = (SigmaI_diag_j.asDiagonal() * PI_Z.middleRows(cum_num_rand_eff_cluster_i[j], num_rand_eff).cwiseAbs2()).colwise().sum();
+						double Tr_P_stoch = sample_P.mean();
+						double Tr_P = SigmaI_diag_j.cwiseQuotient(diag_SigmaI_plus_ZtWZ_.segment(cum_num_rand_eff_cluster_i[j], num_rand_eff)).sum();
+						double c_opt;
+						CalcOptimalC(sample_MInv, sample_P, trace_MInv_SigmaI_j, Tr_P, c_opt);
+						trace_MInv_SigmaI_j += c_opt * (Tr_P - Tr_P_stoch);
+					}
+					cov_grad[j] = -0.5 * SigmaI_mode.segment(cum_num_rand_eff_cluster_i[j], num_rand_eff).dot(mode_.segment(cum_num_rand_eff_cluster_i[j], num_rand_eff)) +
+						0.5 * (num_rand_eff - trace_MInv_SigmaI_j);
+					if (grad_information_wrt_mode_non_zero_) {
+						// calculate implicit derivative (through mode) of approx. mariginal log-likelihood
+						cov_grad[j] += SigmaI_plus_ZtWZ_inv_d_mll_d_mode.segment(cum_num_rand_eff_cluster_i[j], num_rand_eff).dot(
+							Zt_first_deriv_ll.segment(cum_num_rand_eff_cluster_i[j], num_rand_eff));
+					}
+				}
+			}//end calc_cov_grad && use_iterative
+			else if (calc_cov_grad) {
 				sp_mat_t ZtWZ = Zt * information_ll_.asDiagonal() * Z;
 				vec_t d_mode_d_par;//derivative of mode wrt to a covariance parameter
 				vec_t v_aux;//auxiliary variable for caclulating d_mode_d_par
@@ -3167,15 +3537,21 @@ namespace GPBoost {
 				fixed_effect_grad = -first_deriv_ll_;
 				if (grad_information_wrt_mode_non_zero_) {
 					CHECK(first_deriv_information_loc_par_caluclated_);
-					vec_t d_detmll_d_F(num_data);
+					if (use_iterative) {
+						fixed_effect_grad += 0.5 * deriv_information_loc_par.cwiseProduct(diag_Z_SigmaI_plus_ZtWZ_inv_Zt) -
+							information_ll_.cwiseProduct(Z * SigmaI_plus_ZtWZ_inv_d_mll_d_mode);
+					}
+					else {
+						vec_t d_detmll_d_F(num_data);
 #pragma omp parallel for schedule(static)
-					for (int i = 0; i < num_data; ++i) {
-						vec_t L_inv_Zt_col_i = L_inv * Zt.col(i);
-						d_detmll_d_F[i] = 0.5 * deriv_information_loc_par[i] * (L_inv_Zt_col_i.squaredNorm());
+						for (int i = 0; i < num_data; ++i) {
+							vec_t L_inv_Zt_col_i = L_inv * Zt.col(i);
+							d_detmll_d_F[i] = 0.5 * deriv_information_loc_par[i] * (L_inv_Zt_col_i.squaredNorm());
 
+						}
+						vec_t d_mll_d_modeT_SigmaI_plus_ZtWZ_inv_Zt_W = (((d_mll_d_mode.transpose() * L_inv.transpose()) * L_inv) * Zt) * information_ll_.asDiagonal();
+						fixed_effect_grad += d_detmll_d_F - d_mll_d_modeT_SigmaI_plus_ZtWZ_inv_Zt_W;
 					}
-					vec_t d_mll_d_modeT_SigmaI_plus_ZtWZ_inv_Zt_W = (((d_mll_d_mode.transpose() * L_inv.transpose()) * L_inv) * Zt) * information_ll_.asDiagonal();
-					fixed_effect_grad += d_detmll_d_F - d_mll_d_modeT_SigmaI_plus_ZtWZ_inv_Zt_W;
 				}//end grad_information_wrt_mode_non_zero_
 			}//end calc_F_grad
 			// calculate gradient wrt additional likelihood parameters
@@ -3187,14 +3563,23 @@ namespace GPBoost {
 				CalcGradNegLogLikAuxPars(y_data, y_data_int, location_par.data(), num_data, neg_likelihood_deriv.data());
 				for (int ind_ap = 0; ind_ap < num_aux_pars_estim_; ++ind_ap) {
 					CalcSecondDerivLogLikFirstDerivInformationAuxPar(y_data, y_data_int, location_par.data(), num_data, ind_ap, second_deriv_loc_aux_par.data(), deriv_information_aux_par.data());
-					sp_mat_t ZtdWZ = Zt * deriv_information_aux_par.asDiagonal() * Z;
-					SigmaI_plus_ZtWZ_inv = ZtdWZ;
-					CalcLtLGivenSparsityPattern<sp_mat_t>(L_inv, SigmaI_plus_ZtWZ_inv, false);
-					double d_detmll_d_aux_par = (SigmaI_plus_ZtWZ_inv.cwiseProduct(ZtdWZ)).sum();
-					aux_par_grad[ind_ap] = neg_likelihood_deriv[ind_ap] + 0.5 * d_detmll_d_aux_par;
-					if (grad_information_wrt_mode_non_zero_) {
-						d_mode_d_aux_par = L_inv.transpose() * (L_inv * (Zt * second_deriv_loc_aux_par));
-						aux_par_grad[ind_ap] += d_mll_d_mode.dot(d_mode_d_aux_par);
+					if (use_iterative) {
+						double d_detmll_d_aux_par = deriv_information_aux_par.dot(diag_Z_SigmaI_plus_ZtWZ_inv_Zt);
+						aux_par_grad[ind_ap] = neg_likelihood_deriv[ind_ap] + 0.5 * d_detmll_d_aux_par;
+						if (grad_information_wrt_mode_non_zero_) {
+							aux_par_grad[ind_ap] += SigmaI_plus_ZtWZ_inv_d_mll_d_mode.dot(Zt * second_deriv_loc_aux_par);
+						}
+					}
+					else {
+						sp_mat_t ZtdWZ = Zt * deriv_information_aux_par.asDiagonal() * Z;
+						SigmaI_plus_ZtWZ_inv = ZtdWZ;
+						CalcLtLGivenSparsityPattern<sp_mat_t>(L_inv, SigmaI_plus_ZtWZ_inv, false);
+						double d_detmll_d_aux_par = (SigmaI_plus_ZtWZ_inv.cwiseProduct(ZtdWZ)).sum();
+						aux_par_grad[ind_ap] = neg_likelihood_deriv[ind_ap] + 0.5 * d_detmll_d_aux_par;
+						if (grad_information_wrt_mode_non_zero_) {
+							d_mode_d_aux_par = L_inv.transpose() * (L_inv * (Zt * second_deriv_loc_aux_par));
+							aux_par_grad[ind_ap] += d_mll_d_mode.dot(d_mode_d_aux_par);
+						}
 					}
 				}
 				SetGradAuxParsNotEstimated(aux_par_grad);
@@ -3647,10 +4032,10 @@ namespace GPBoost {
 		/*!
 		* \brief Calculate the gradient of the negative Laplace-approximated marginal log-likelihood wrt covariance parameters,
 		*		fixed effects (e.g., for linear regression coefficients), and additional likelihood-related parameters.
-		*		Calculations are done by factorizing ("inverting) (Sigma^-1 + W) where it is assumed that an approximate Cholesky factor
-		*		of Sigma^-1 has previously been calculated using a Vecchia approximation.
-		*		This version is used for the Laplace approximation when there are only GP random effects and the Vecchia approximation is used.
-		*		Caveat: Sigma^-1 + W can be not very sparse
+		*		This version is used for the Laplace approximation when the 'fitc' approximation is used.
+		*		If matrix_inversion_method_ == "iterative", linear systems in (W^-1 + Sigma) are solved with the conjugate gradient method and 
+		*		traces and diagonals are estimated with the probe vectors of the last mode finding (see 'CalcLogDetStochFITC'). 
+		*		Otherwise, the Cholesky factor of sigma_ip + cross_cov^T * (fitc_resid_diag + W^-1)^-1 * cross_cov is used
 		* \param y_data Response variable data if response variable is continuous
 		* \param y_data_int Response variable data if response variable is integer-valued
 		* \param fixed_effects Fixed effects component of location parameter
@@ -3668,6 +4053,10 @@ namespace GPBoost {
 		* \param[out] aux_par_grad Gradient wrt additional likelihood parameters
 		* \param calc_mode If true, the mode of the random effects posterior is calculated otherwise the values in mode and a_vec_ are used (default=false)
 		* \param call_for_std_dev_coef If true, the function is called for calculating standard deviations of linear regression coefficients
+		* \param re_comps_ip_preconditioner_cluster_i Inducing points of the "fitc" preconditioner (only used if matrix_inversion_method_ == "iterative")
+		* \param re_comps_cross_cov_preconditioner_cluster_i Cross-covariance matrix between the data and the inducing points of the "fitc" preconditioner (only used if matrix_inversion_method_ == "iterative")
+		* \param chol_ip_cross_cov_preconditioner Inverse of the Cholesky factor of the covariance matrix of the inducing points of the preconditioner times the transposed cross-covariance matrix (only used if matrix_inversion_method_ == "iterative")
+		* \param chol_fact_sigma_ip_preconditioner Cholesky factor of the covariance matrix of the inducing points of the preconditioner (only used if matrix_inversion_method_ == "iterative")
 		*/
 		void CalcGradNegMargLikelihoodLaplaceApproxFITC(const double* y_data,
 			const int* y_data_int,
@@ -3685,7 +4074,11 @@ namespace GPBoost {
 			vec_t& fixed_effect_grad,
 			double* aux_par_grad,
 			bool calc_mode,
-			bool call_for_std_dev_coef) {
+			bool call_for_std_dev_coef,
+			const std::vector<std::shared_ptr<RECompGP<den_mat_t>>>& re_comps_ip_preconditioner_cluster_i,
+			const std::vector<std::shared_ptr<RECompGP<den_mat_t>>>& re_comps_cross_cov_preconditioner_cluster_i,
+			const den_mat_t& chol_ip_cross_cov_preconditioner,
+			const chol_den_mat_t& chol_fact_sigma_ip_preconditioner) {
 			int num_ip = (int)((*sigma_ip).rows());
 			CHECK((int)((*cross_cov).rows()) == dim_mode_);
 			CHECK((int)((*cross_cov).cols()) == num_ip);
@@ -3693,7 +4086,7 @@ namespace GPBoost {
 			if (calc_mode) {// Calculate mode and Cholesky factor 
 				double mll;//approximate marginal likelihood. This is a by-product that is not used here.
 				FindModePostRandEffCalcMLLFITC(y_data, y_data_int, fixed_effects, sigma_ip, chol_fact_sigma_ip, 
-					cross_cov, fitc_resid_diag, mll);
+					cross_cov, fitc_resid_diag, mll, re_comps_ip_preconditioner_cluster_i, re_comps_cross_cov_preconditioner_cluster_i, chol_ip_cross_cov_preconditioner, chol_fact_sigma_ip_preconditioner);
 			}
 			if (na_or_inf_during_last_call_to_find_mode_) {
 				if (call_for_std_dev_coef) {
@@ -3704,6 +4097,10 @@ namespace GPBoost {
 				}
 			}
 			CHECK(mode_has_been_calculated_);
+			bool use_iterative = matrix_inversion_method_ == "iterative";
+			if (!use_iterative) {
+				CalcCholFactDenseNewtonFITC(sigma_ip, cross_cov, fitc_resid_diag);
+			}
 			// Initialize variables
 			vec_t location_par;//location parameter = mode of random effects + fixed effects
 			double* location_par_ptr;
@@ -3724,7 +4121,35 @@ namespace GPBoost {
 			vec_t WI = information_ll_.cwiseInverse();
 			vec_t DW_plus_I_inv_diag, SigmaI_plus_W_inv_diag, d_mll_d_mode;
 			den_mat_t L_inv_cross_cov_T_DW_plus_I_inv;
-			if (grad_information_wrt_mode_non_zero_ || calc_aux_par_grad) {
+			// Variables when using iterative methods: the probe vectors z_i ~ N(0, P) and (W^-1 + Sigma)^-1 z_i in 'WI_plus_Sigma_inv_Z_' 
+			//	and the preconditioner are the ones calculated at the end of the mode finding (see 'CalcLogDetStochFITC')
+			vec_t fitc_diag_plus_WI;// = fitc_resid_diag + W^-1
+			den_mat_t PI_Z;// = P^-1 * (z_1, ..., z_t)
+			const den_mat_t* cross_cov_preconditioner = cross_cov;
+			bool has_NA_or_Inf = false;
+			if (use_iterative) {
+				CHECK(WI_plus_Sigma_inv_Z_.cols() == num_rand_vec_trace_);
+				fitc_diag_plus_WI = fitc_resid_diag + WI;
+				if (cg_preconditioner_type_ == "fitc") {
+					cross_cov_preconditioner = re_comps_cross_cov_preconditioner_cluster_i[0]->GetSigmaPtr();
+					den_mat_t diag_P_inv_Z = diagonal_approx_inv_preconditioner_.asDiagonal() * rand_vec_trace_P_;
+					PI_Z = diag_P_inv_Z - diagonal_approx_inv_preconditioner_.asDiagonal() * 
+						((*cross_cov_preconditioner) * chol_fact_woodbury_preconditioner_.solve((*cross_cov_preconditioner).transpose() * diag_P_inv_Z));
+				}
+				else if (cg_preconditioner_type_ == "none") {
+					PI_Z = rand_vec_trace_P_;
+				}
+				else {
+					Log::REFatal("CalcGradNegMargLikelihoodLaplaceApproxFITC: Preconditioner type '%s' is not supported ", cg_preconditioner_type_.c_str());
+				}
+			}
+			if (use_iterative && (grad_information_wrt_mode_non_zero_ || calc_aux_par_grad)) {
+				// diag((Sigma^-1 + W)^-1) = W^-1 - W^-1 * diag((W^-1 + Sigma)^-1) * W^-1, where diag((W^-1 + Sigma)^-1) is estimated 
+				//	by the mean of (W^-1 + Sigma)^-1 z_i * P^-1 z_i (elementwise) since E[z_i z_i^T] = P
+				vec_t WI_plus_Sigma_inv_diag = (WI_plus_Sigma_inv_Z_.cwiseProduct(PI_Z)).rowwise().mean();
+				SigmaI_plus_W_inv_diag = WI - (WI.array().square() * WI_plus_Sigma_inv_diag.array()).matrix();
+			}
+			else if (grad_information_wrt_mode_non_zero_ || calc_aux_par_grad) {
 				DW_plus_I_inv_diag = (information_ll_.array() * fitc_resid_diag.array() + 1.).matrix().cwiseInverse();
 				L_inv_cross_cov_T_DW_plus_I_inv = (*cross_cov).transpose() * (DW_plus_I_inv_diag.asDiagonal());
 				TriangularSolveGivenCholesky<chol_den_mat_t, den_mat_t, den_mat_t, den_mat_t>(chol_fact_dense_Newton_, L_inv_cross_cov_T_DW_plus_I_inv, L_inv_cross_cov_T_DW_plus_I_inv, false);
@@ -3743,36 +4168,50 @@ namespace GPBoost {
 			if (calc_cov_grad) {
 				vec_t sigma_ip_inv_cross_cov_T_a_vec = chol_fact_sigma_ip.solve((*cross_cov).transpose() * a_vec_);// sigma_ip^-1 * cross_cov^T * sigma^-1 * mode
 				vec_t fitc_diag_plus_WI_inv = (fitc_resid_diag + WI).cwiseInverse();
+				den_mat_t sigma_ip_inv_cross_cov_T = chol_fact_sigma_ip.solve((*cross_cov).transpose());
+				den_mat_t sigma_ip_inv_cross_cov_T_WI_plus_Sigma_inv_Z;// = sigma_ip^-1 * cross_cov^T * (W^-1 + Sigma)^-1 * (z_1, ..., z_t) (only used for iterative methods)
+				if (use_iterative) {
+					sigma_ip_inv_cross_cov_T_WI_plus_Sigma_inv_Z = sigma_ip_inv_cross_cov_T * WI_plus_Sigma_inv_Z_;
+				}
 				int par_count = 0;
 				double explicit_derivative;
 				for (int j = 0; j < (int)re_comps_ip_cluster_i.size(); ++j) {
 					for (int ipar = 0; ipar < re_comps_ip_cluster_i[j]->NumCovPar(); ++ipar) {
 						std::shared_ptr<den_mat_t> cross_cov_grad = re_comps_cross_cov_cluster_i[j]->GetZSigmaZtGrad(ipar, true, 0.);
 						den_mat_t sigma_ip_grad = *(re_comps_ip_cluster_i[j]->GetZSigmaZtGrad(ipar, true, 0.));
-						den_mat_t sigma_ip_inv_sigma_ip_grad = chol_fact_sigma_ip.solve(sigma_ip_grad);
 						vec_t fitc_diag_grad = vec_t::Zero(dim_mode_);
 						fitc_diag_grad.array() += sigma_ip_grad.coeffRef(0, 0);
-						den_mat_t sigma_ip_inv_cross_cov_T = chol_fact_sigma_ip.solve((*cross_cov).transpose());
 						den_mat_t sigma_ip_grad_sigma_ip_inv_cross_cov_T = sigma_ip_grad * sigma_ip_inv_cross_cov_T;
 						fitc_diag_grad -= 2 * (sigma_ip_inv_cross_cov_T.cwiseProduct((*cross_cov_grad).transpose())).colwise().sum();
 						fitc_diag_grad += (sigma_ip_inv_cross_cov_T.cwiseProduct(sigma_ip_grad_sigma_ip_inv_cross_cov_T)).colwise().sum();
-						// Derivative of Woodbury matrix
-						den_mat_t sigma_woodbury_grad = sigma_ip_grad;
-						den_mat_t cross_cov_T_fitc_diag_plus_WI_inv_cross_cov_grad = (*cross_cov).transpose() * fitc_diag_plus_WI_inv.asDiagonal() * (*cross_cov_grad);
-						sigma_woodbury_grad += cross_cov_T_fitc_diag_plus_WI_inv_cross_cov_grad + cross_cov_T_fitc_diag_plus_WI_inv_cross_cov_grad.transpose();
-						cross_cov_T_fitc_diag_plus_WI_inv_cross_cov_grad.resize(0, 0);
-						vec_t v_aux_grad = fitc_diag_plus_WI_inv;
-						v_aux_grad.array() *= v_aux_grad.array();
-						v_aux_grad.array() *= fitc_diag_grad.array();
-						sigma_woodbury_grad -= (*cross_cov).transpose() * v_aux_grad.asDiagonal() * (*cross_cov);
-						den_mat_t sigma_woodbury_inv_sigma_woodbury_grad = chol_fact_dense_Newton_.solve(sigma_woodbury_grad);
 						// Calculate explicit derivative of approx. mariginal log-likelihood
 						explicit_derivative = -((*cross_cov_grad).transpose() * a_vec_).dot(sigma_ip_inv_cross_cov_T_a_vec) +
 							0.5 * sigma_ip_inv_cross_cov_T_a_vec.dot(sigma_ip_grad * sigma_ip_inv_cross_cov_T_a_vec) -
 								0.5 * a_vec_.dot(fitc_diag_grad.asDiagonal() * a_vec_);//derivative of mode^T Sigma^-1 mode
-						explicit_derivative += 0.5 * sigma_woodbury_inv_sigma_woodbury_grad.trace() -
-							0.5 * sigma_ip_inv_sigma_ip_grad.trace() +
-							0.5 * fitc_diag_grad.dot(fitc_diag_plus_WI_inv);//derivative of log determinant
+						if (use_iterative) {
+							// d log|W^-1 + Sigma| = tr((W^-1 + Sigma)^-1 * Sigma_grad), stochastic estimate: mean of z_i^T P^-1 * Sigma_grad * (W^-1 + Sigma)^-1 z_i
+							den_mat_t Sigma_grad_WI_plus_Sigma_inv_Z = (*cross_cov_grad) * sigma_ip_inv_cross_cov_T_WI_plus_Sigma_inv_Z;
+							Sigma_grad_WI_plus_Sigma_inv_Z += sigma_ip_inv_cross_cov_T.transpose() * ((*cross_cov_grad).transpose() * WI_plus_Sigma_inv_Z_ -
+								sigma_ip_grad * sigma_ip_inv_cross_cov_T_WI_plus_Sigma_inv_Z);
+							Sigma_grad_WI_plus_Sigma_inv_Z += fitc_diag_grad.asDiagonal() * WI_plus_Sigma_inv_Z_;
+							explicit_derivative += 0.5 * (PI_Z.cwiseProduct(Sigma_grad_WI_plus_Sigma_inv_Z)).colwise().sum().mean();//derivative of log determinant
+						}
+						else {
+							// Derivative of Woodbury matrix
+							den_mat_t sigma_ip_inv_sigma_ip_grad = chol_fact_sigma_ip.solve(sigma_ip_grad);
+							den_mat_t sigma_woodbury_grad = sigma_ip_grad;
+							den_mat_t cross_cov_T_fitc_diag_plus_WI_inv_cross_cov_grad = (*cross_cov).transpose() * fitc_diag_plus_WI_inv.asDiagonal() * (*cross_cov_grad);
+							sigma_woodbury_grad += cross_cov_T_fitc_diag_plus_WI_inv_cross_cov_grad + cross_cov_T_fitc_diag_plus_WI_inv_cross_cov_grad.transpose();
+							cross_cov_T_fitc_diag_plus_WI_inv_cross_cov_grad.resize(0, 0);
+							vec_t v_aux_grad = fitc_diag_plus_WI_inv;
+							v_aux_grad.array() *= v_aux_grad.array();
+							v_aux_grad.array() *= fitc_diag_grad.array();
+							sigma_woodbury_grad -= (*cross_cov).transpose() * v_aux_grad.asDiagonal() * (*cross_cov);
+							den_mat_t sigma_woodbury_inv_sigma_woodbury_grad = chol_fact_dense_Newton_.solve(sigma_woodbury_grad);
+							explicit_derivative += 0.5 * sigma_woodbury_inv_sigma_woodbury_grad.trace() -
+								0.5 * sigma_ip_inv_sigma_ip_grad.trace() +
+								0.5 * fitc_diag_grad.dot(fitc_diag_plus_WI_inv);//derivative of log determinant
+						}
 						cov_grad[par_count] = explicit_derivative;
 						if (grad_information_wrt_mode_non_zero_) {
 							// Calculate implicit derivative (through mode) of approx. mariginal log-likelihood
@@ -3780,10 +4219,23 @@ namespace GPBoost {
 							SigmaDeriv_first_deriv_ll += sigma_ip_inv_cross_cov_T.transpose() * ((*cross_cov_grad).transpose() * first_deriv_ll_);
 							SigmaDeriv_first_deriv_ll -= sigma_ip_inv_cross_cov_T.transpose() * (sigma_ip_grad_sigma_ip_inv_cross_cov_T * first_deriv_ll_);
 							SigmaDeriv_first_deriv_ll += fitc_diag_grad.asDiagonal() * first_deriv_ll_;
-							vec_t rhs = (*cross_cov).transpose() * (fitc_diag_plus_WI_inv.asDiagonal() * SigmaDeriv_first_deriv_ll);
-							vec_t vaux = chol_fact_dense_Newton_.solve(rhs);
-							vec_t d_mode_d_par = WI.asDiagonal() *
-								(fitc_diag_plus_WI_inv.asDiagonal() * SigmaDeriv_first_deriv_ll - fitc_diag_plus_WI_inv.asDiagonal() * ((*cross_cov) * vaux));
+							vec_t d_mode_d_par;// = W^-1 * (W^-1 + Sigma)^-1 * Sigma_grad * first_deriv_ll_
+							if (use_iterative) {
+								d_mode_d_par = vec_t::Zero(dim_mode_);
+								CGFITC(fitc_diag_plus_WI, *cross_cov, chol_fact_sigma_ip, SigmaDeriv_first_deriv_ll, d_mode_d_par, has_NA_or_Inf,
+									cg_max_num_it_, cg_delta_conv_, ZERO_RHS_CG_THRESHOLD, cg_preconditioner_type_,
+									*cross_cov_preconditioner, chol_fact_woodbury_preconditioner_, diagonal_approx_inv_preconditioner_);
+								if (has_NA_or_Inf) {
+									Log::REDebug(CG_NA_OR_INF_WARNING_);
+								}
+								d_mode_d_par.array() *= WI.array();
+							}
+							else {
+								vec_t rhs = (*cross_cov).transpose() * (fitc_diag_plus_WI_inv.asDiagonal() * SigmaDeriv_first_deriv_ll);
+								vec_t vaux = chol_fact_dense_Newton_.solve(rhs);
+								d_mode_d_par = WI.asDiagonal() *
+									(fitc_diag_plus_WI_inv.asDiagonal() * SigmaDeriv_first_deriv_ll - fitc_diag_plus_WI_inv.asDiagonal() * ((*cross_cov) * vaux));
+							}
 							cov_grad[par_count] += d_mll_d_mode.dot(d_mode_d_par);
 							////for debugging
 							//if (ipar == 0) {
@@ -3807,7 +4259,19 @@ namespace GPBoost {
 			}//end calc_cov_grad
 			// calculate gradient wrt fixed effects
 			vec_t SigmaI_plus_W_inv_d_mll_d_mode;// for implicit derivative
-			if (grad_information_wrt_mode_non_zero_ && (calc_F_grad || calc_aux_par_grad)) {
+			if (grad_information_wrt_mode_non_zero_ && (calc_F_grad || calc_aux_par_grad) && use_iterative) {
+				// (Sigma^-1 + W)^-1 * d_mll_d_mode = W^-1 * d_mll_d_mode - W^-1 * (W^-1 + Sigma)^-1 * W^-1 * d_mll_d_mode
+				vec_t WI_d_mll_d_mode = WI.asDiagonal() * d_mll_d_mode;
+				vec_t WI_plus_Sigma_inv_WI_d_mll_d_mode = vec_t::Zero(dim_mode_);
+				CGFITC(fitc_diag_plus_WI, *cross_cov, chol_fact_sigma_ip, WI_d_mll_d_mode, WI_plus_Sigma_inv_WI_d_mll_d_mode, has_NA_or_Inf,
+					cg_max_num_it_, cg_delta_conv_, ZERO_RHS_CG_THRESHOLD, cg_preconditioner_type_,
+					*cross_cov_preconditioner, chol_fact_woodbury_preconditioner_, diagonal_approx_inv_preconditioner_);
+				if (has_NA_or_Inf) {
+					Log::REDebug(CG_NA_OR_INF_WARNING_);
+				}
+				SigmaI_plus_W_inv_d_mll_d_mode = WI_d_mll_d_mode - WI.asDiagonal() * WI_plus_Sigma_inv_WI_d_mll_d_mode;
+			}
+			else if (grad_information_wrt_mode_non_zero_ && (calc_F_grad || calc_aux_par_grad)) {
 				SigmaI_plus_W_inv_d_mll_d_mode = WI.asDiagonal() * d_mll_d_mode -
 					DW_plus_I_inv_diag.cwiseInverse().asDiagonal() * (WI.asDiagonal() * d_mll_d_mode) +
 					L_inv_cross_cov_T_DW_plus_I_inv.transpose() * (L_inv_cross_cov_T_DW_plus_I_inv * d_mll_d_mode);
@@ -3962,6 +4426,7 @@ namespace GPBoost {
 			CHECK(mode_has_been_calculated_);
 			pred_mean = Ztilde * (Sigma * (Zt * first_deriv_ll_));
 			if (calc_pred_cov || calc_pred_var) {
+				CalcCholFactGroupedREIfNotCalculated();
 				sp_mat_t SigmaI_plus_ZtWZ_I(Sigma.cols(), Sigma.cols());
 				SigmaI_plus_ZtWZ_I.setIdentity();
 				TriangularSolveGivenCholesky<chol_sp_mat_t, sp_mat_t, sp_mat_t, sp_mat_t>(chol_fact_SigmaI_plus_ZtWZ_grouped_, SigmaI_plus_ZtWZ_I, SigmaI_plus_ZtWZ_I, false);
@@ -4148,77 +4613,21 @@ namespace GPBoost {
 					}
 					vec_t W_diag_sqrt = information_ll_.cwiseSqrt();
 					sp_mat_rm_t B_t_D_inv_sqrt_rm = B_rm_.transpose() * D_inv_rm_.cwiseSqrt();
-					int num_threads;
-#ifdef _OPENMP
-					num_threads = omp_get_max_threads();
-#else
-					num_threads = 1;
-#endif
-					std::uniform_int_distribution<> unif(0, 2147483646);
-					std::vector<RNG_t> parallel_rngs;
-					for (int ig = 0; ig < num_threads; ++ig) {
-						int seed_local = unif(cg_generator_);
-						parallel_rngs.push_back(RNG_t(seed_local));
-					}
-#pragma omp parallel
-					{
-#pragma omp for nowait
-						for (int i = 0; i < nsim_var_pred_; ++i) {
-							//z_i ~ N(0,I)
-							int thread_nb;
-#ifdef _OPENMP
-							thread_nb = omp_get_thread_num();
-#else
-							thread_nb = 0;
-#endif
-							std::normal_distribution<double> ndist(0.0, 1.0);
-							vec_t rand_vec_pred_I_1(dim_mode_), rand_vec_pred_I_2(dim_mode_);
-							for (int j = 0; j < dim_mode_; j++) {
-								rand_vec_pred_I_1(j) = ndist(parallel_rngs[thread_nb]);
-								rand_vec_pred_I_2(j) = ndist(parallel_rngs[thread_nb]);
-							}
-							//z_i ~ N(0,(Sigma^{-1} + W))
-							vec_t rand_vec_pred_SigmaI_plus_W = B_t_D_inv_sqrt_rm * rand_vec_pred_I_1 + W_diag_sqrt.cwiseProduct(rand_vec_pred_I_2);
-							vec_t rand_vec_pred_SigmaI_plus_W_inv(dim_mode_);
-							//z_i ~ N(0,(Sigma^{-1} + W)^{-1})
-							bool has_NA_or_Inf = false;
-							if (cg_preconditioner_type_ == "pivoted_cholesky") {
-								CGVecchiaLaplaceVecWinvplusSigma(information_ll_, B_rm_, B_t_D_inv_rm_.transpose(), rand_vec_pred_SigmaI_plus_W, rand_vec_pred_SigmaI_plus_W_inv, has_NA_or_Inf,
-									cg_max_num_it_, 0, cg_delta_conv_pred_, ZERO_RHS_CG_THRESHOLD, chol_fact_I_k_plus_Sigma_L_kt_W_Sigma_L_k_vecchia_, Sigma_L_k_);
-							}
-							else if (cg_preconditioner_type_ == "fitc") {
-								const den_mat_t* cross_cov = re_comps_cross_cov_cluster_i[0]->GetSigmaPtr();
-								CGVecchiaLaplaceVecWinvplusSigma_FITC_P(information_ll_, B_rm_, B_t_D_inv_rm_.transpose(), rand_vec_pred_SigmaI_plus_W, rand_vec_pred_SigmaI_plus_W_inv, has_NA_or_Inf,
-									cg_max_num_it_, 0, cg_delta_conv_pred_, ZERO_RHS_CG_THRESHOLD, chol_fact_woodbury_preconditioner_, (*cross_cov), diagonal_approx_inv_preconditioner_);
-							}
-							else if (cg_preconditioner_type_ == "vadu" || cg_preconditioner_type_ == "incomplete_cholesky") {
-								CGVecchiaLaplaceVec(information_ll_, B_rm_, B_t_D_inv_rm_, rand_vec_pred_SigmaI_plus_W, rand_vec_pred_SigmaI_plus_W_inv, has_NA_or_Inf,
-									cg_max_num_it_, 0, cg_delta_conv_pred_, ZERO_RHS_CG_THRESHOLD, cg_preconditioner_type_, D_inv_plus_W_B_rm_, L_SigmaI_plus_W_rm_);
-							}
-							else {
-								Log::REFatal("PredictLaplaceApproxVecchia: Preconditioner type '%s' is not supported ", cg_preconditioner_type_.c_str());
-							}
-							if (has_NA_or_Inf) {
-								Log::REDebug(CG_NA_OR_INF_WARNING_);
-							}
-							//z_i ~ N(0, Bp^{-1} Bpo (Sigma^{-1} + W)^{-1} Bpo^T Bp^{-1})
-							vec_t rand_vec_pred = Bp_inv_Bpo_rm * rand_vec_pred_SigmaI_plus_W_inv;
-							if (calc_pred_cov) {
-								den_mat_t pred_cov_private = rand_vec_pred * rand_vec_pred.transpose();
-#pragma omp critical
-								{
-									pred_cov += pred_cov_private;
-								}
-							}
-							if (calc_pred_var) {
-								vec_t pred_var_private = rand_vec_pred.cwiseProduct(rand_vec_pred);
-#pragma omp critical
-								{
-									pred_var += pred_var_private;
-								}
-							}
+					StartRandVecPredVar();
+					//Simulations are done in blocks that are solved jointly
+					for (int i = 0; i < nsim_var_pred_; i += num_sim_block_var_pred_) {
+						int num_sim_block = std::min(num_sim_block_var_pred_, nsim_var_pred_ - i);
+						//z_i ~ N(0,(Sigma^{-1} + W)^{-1})
+						den_mat_t rand_vec_pred_SigmaI_plus_W_inv;
+						SimSigmaIPlusWInvVecchiaBlock(num_sim_block, B_t_D_inv_sqrt_rm, W_diag_sqrt, re_comps_cross_cov_cluster_i, rand_vec_pred_SigmaI_plus_W_inv);
+						//z_i ~ N(0, Bp^{-1} Bpo (Sigma^{-1} + W)^{-1} Bpo^T Bp^{-1})
+						den_mat_t rand_vec_pred = Bp_inv_Bpo_rm * rand_vec_pred_SigmaI_plus_W_inv;
+						if (calc_pred_cov) {
+							pred_cov += rand_vec_pred * rand_vec_pred.transpose();
+						}
+						if (calc_pred_var) {
+							pred_var += rand_vec_pred.rowwise().squaredNorm();
 						}
-
 					}
 					if (calc_pred_cov) {
 						pred_cov /= nsim_var_pred_;
@@ -4301,6 +4710,10 @@ namespace GPBoost {
 		* \param calc_pred_cov If true, predictive covariance matrix is also calculated
 		* \param calc_pred_var If true, predictive variances are also calculated
 		* \param calc_mode If true, the mode of the random effects posterior is calculated otherwise the values in mode and a_vec_ are used (default=false)
+		* \param re_comps_ip_preconditioner_cluster_i Inducing points of the "fitc" preconditioner (only used if matrix_inversion_method_ == "iterative")
+		* \param re_comps_cross_cov_preconditioner_cluster_i Cross-covariance matrix between the data and the inducing points of the "fitc" preconditioner (only used if matrix_inversion_method_ == "iterative")
+		* \param chol_ip_cross_cov_preconditioner Inverse of the Cholesky factor of the covariance matrix of the inducing points of the preconditioner times the transposed cross-covariance matrix (only used if matrix_inversion_method_ == "iterative")
+		* \param chol_fact_sigma_ip_preconditioner Cholesky factor of the covariance matrix of the inducing points of the preconditioner (only used if matrix_inversion_method_ == "iterative")
 		*/
 		void PredictLaplaceApproxFITC(const double* y_data,
 			const int* y_data_int,
@@ -4317,11 +4730,15 @@ namespace GPBoost {
 			vec_t& pred_var,
 			bool calc_pred_cov,
 			bool calc_pred_var,
-			bool calc_mode) {
+			bool calc_mode,
+			const std::vector<std::shared_ptr<RECompGP<den_mat_t>>>& re_comps_ip_preconditioner_cluster_i,
+			const std::vector<std::shared_ptr<RECompGP<den_mat_t>>>& re_comps_cross_cov_preconditioner_cluster_i,
+			const den_mat_t& chol_ip_cross_cov_preconditioner,
+			const chol_den_mat_t& chol_fact_sigma_ip_preconditioner) {
 			if (calc_mode) {// Calculate mode and Cholesky factor 
 				double mll;//approximate marginal likelihood. This is a by-product that is not used here.
 				FindModePostRandEffCalcMLLFITC(y_data, y_data_int, fixed_effects, sigma_ip, chol_fact_sigma_ip,
-					cross_cov, fitc_resid_diag, mll);
+					cross_cov, fitc_resid_diag, mll, re_comps_ip_preconditioner_cluster_i, re_comps_cross_cov_preconditioner_cluster_i, chol_ip_cross_cov_preconditioner, chol_fact_sigma_ip_preconditioner);
 			}
 			if (na_or_inf_during_last_call_to_find_mode_) {
 				Log::REFatal(NA_OR_INF_ERROR_);
@@ -4333,6 +4750,7 @@ namespace GPBoost {
 			}
 
 			if (calc_pred_cov || calc_pred_var) {
+				CalcCholFactDenseNewtonFITC(sigma_ip, cross_cov, fitc_resid_diag);
 				den_mat_t woodburry_part_sqrt = cross_cov_pred_ip.transpose();
 				sp_mat_t resid_obs_inv_resid_pred_obs_t;
 				if (has_fitc_correction) {
@@ -4422,6 +4840,7 @@ namespace GPBoost {
 			}
 			CHECK(mode_has_been_calculated_);
 			pred_var = vec_t(num_re_);
+			CalcCholFactGroupedREIfNotCalculated();
 			sp_mat_t L_inv(num_re_, num_re_);
 			L_inv.setIdentity();
 			TriangularSolveGivenCholesky<chol_sp_mat_t, sp_mat_t, sp_mat_t, sp_mat_t>(chol_fact_SigmaI_plus_ZtWZ_grouped_, L_inv, L_inv, false);
@@ -4460,65 +4879,14 @@ namespace GPBoost {
 				pred_var = vec_t::Zero(num_re_);
 				vec_t W_diag_sqrt = information_ll_.cwiseSqrt();
 				sp_mat_rm_t B_t_D_inv_sqrt_rm = B_rm_.transpose() * D_inv_rm_.cwiseSqrt();
-				int num_threads;
-#ifdef _OPENMP
-				num_threads = omp_get_max_threads();
-#else
-				num_threads = 1;
-#endif
-				std::uniform_int_distribution<> unif(0, 2147483646);
-				std::vector<RNG_t> parallel_rngs;
-				for (int ig = 0; ig < num_threads; ++ig) {
-					int seed_local = unif(cg_generator_);
-					parallel_rngs.push_back(RNG_t(seed_local));
-				}
-#pragma omp parallel
-				{
-#pragma omp for nowait
-					for (int i = 0; i < nsim_var_pred_; ++i) {
-						//z_i ~ N(0,I)
-						int thread_nb;
-#ifdef _OPENMP
-						thread_nb = omp_get_thread_num();
-#else
-						thread_nb = 0;
-#endif
-						std::normal_distribution<double> ndist(0.0, 1.0);
-						vec_t rand_vec_pred_I_1(num_re_), rand_vec_pred_I_2(num_re_);
-						for (int j = 0; j < num_re_; j++) {
-							rand_vec_pred_I_1(j) = ndist(parallel_rngs[thread_nb]);
-							rand_vec_pred_I_2(j) = ndist(parallel_rngs[thread_nb]);
-						}
-						//z_i ~ N(0,(Sigma^{-1} + W))
-						vec_t rand_vec_pred_SigmaI_plus_W = B_t_D_inv_sqrt_rm * rand_vec_pred_I_1 + W_diag_sqrt.cwiseProduct(rand_vec_pred_I_2);
-						vec_t rand_vec_pred_SigmaI_plus_W_inv(num_re_);
-						//z_i ~ N(0,(Sigma^{-1} + W)^{-1})
-						bool has_NA_or_Inf = false;
-						if (cg_preconditioner_type_ == "pivoted_cholesky") {
-							CGVecchiaLaplaceVecWinvplusSigma(information_ll_, B_rm_, B_t_D_inv_rm_.transpose(), rand_vec_pred_SigmaI_plus_W, rand_vec_pred_SigmaI_plus_W_inv, has_NA_or_Inf,
-								cg_max_num_it_, 0, cg_delta_conv_pred_, ZERO_RHS_CG_THRESHOLD, chol_fact_I_k_plus_Sigma_L_kt_W_Sigma_L_k_vecchia_, Sigma_L_k_);
-						}
-						else if (cg_preconditioner_type_ == "fitc") {
-							const den_mat_t* cross_cov = re_comps_cross_cov_cluster_i[0]->GetSigmaPtr();
-							CGVecchiaLaplaceVecWinvplusSigma_FITC_P(information_ll_, B_rm_, B_t_D_inv_rm_.transpose(), rand_vec_pred_SigmaI_plus_W, rand_vec_pred_SigmaI_plus_W_inv, has_NA_or_Inf,
-								cg_max_num_it_, 0, cg_delta_conv_pred_, ZERO_RHS_CG_THRESHOLD, chol_fact_woodbury_preconditioner_, (*cross_cov), diagonal_approx_inv_preconditioner_);
-						}
-						else if (cg_preconditioner_type_ == "vadu" || cg_preconditioner_type_ == "incomplete_cholesky") {
-							CGVecchiaLaplaceVec(information_ll_, B_rm_, B_t_D_inv_rm_, rand_vec_pred_SigmaI_plus_W, rand_vec_pred_SigmaI_plus_W_inv, has_NA_or_Inf,
-								cg_max_num_it_, 0, cg_delta_conv_pred_, ZERO_RHS_CG_THRESHOLD, cg_preconditioner_type_, D_inv_plus_W_B_rm_, L_SigmaI_plus_W_rm_);
-						}
-						else {
-							Log::REFatal("CalcVarLaplaceApproxVecchia: Preconditioner type '%s' is not supported ", cg_preconditioner_type_.c_str());
-						}
-						if (has_NA_or_Inf) {
-							Log::REDebug(CG_NA_OR_INF_WARNING_);
-						}
-						vec_t pred_var_private = rand_vec_pred_SigmaI_plus_W_inv.cwiseProduct(rand_vec_pred_SigmaI_plus_W_inv);
-#pragma omp critical
-						{
-							pred_var += pred_var_private;
-						}
-					}
+				StartRandVecPredVar();
+				//Simulations are done in blocks that are solved jointly
+				for (int i = 0; i < nsim_var_pred_; i += num_sim_block_var_pred_) {
+					int num_sim_block = std::min(num_sim_block_var_pred_, nsim_var_pred_ - i);
+					//z_i ~ N(0,(Sigma^{-1} + W)^{-1})
+					den_mat_t rand_vec_pred_SigmaI_plus_W_inv;
+					SimSigmaIPlusWInvVecchiaBlock(num_sim_block, B_t_D_inv_sqrt_rm, W_diag_sqrt, re_comps_cross_cov_cluster_i, rand_vec_pred_SigmaI_plus_W_inv);
+					pred_var += rand_vec_pred_SigmaI_plus_W_inv.rowwise().squaredNorm();
 				}
 				pred_var /= nsim_var_pred_;
 			} //end Version Simulation
@@ -4533,6 +4901,69 @@ namespace GPBoost {
 			}
 		}//end CalcVarLaplaceApproxVecchia
 
+		/*!
+		* \brief Saves the state of cg_generator_ at the beginning of a simulation of predictive variances,
+		*		or restores the saved state if reuse_rand_vec_pred_var_ is true and a state has been saved
+		*/
+		void StartRandVecPredVar() {
+			if (reuse_rand_vec_pred_var_ && cg_generator_pred_var_start_saved_) {
+				cg_generator_ = cg_generator_pred_var_start_;
+			}
+			else {
+				cg_generator_pred_var_start_ = cg_generator_;
+				cg_generator_pred_var_start_saved_ = true;
+			}
+		}
+
+		/*!
+		* \brief Simulate a block of vectors z_i ~ N(0,(Sigma^-1 + W)^-1) for simulation-based predictive variances when using the Vecchia approximation and iterative methods.
+		*		All vectors of the block are obtained with one block conjugate gradient run
+		* \param num_sim Number of simulated vectors
+		* \param B_t_D_inv_sqrt_rm Row-major matrix B^T D^(-1/2)
+		* \param W_diag_sqrt Square root of the diagonal of W
+		* \param re_comps_cross_cov_cluster_i Cross-covariance between inducing points and observations (used only for the "fitc" preconditioner)
+		* \param[out] rand_vec_SigmaI_plus_W_inv Matrix with the num_sim simulated vectors in its columns
+		*/
+		void SimSigmaIPlusWInvVecchiaBlock(int num_sim,
+			const sp_mat_rm_t& B_t_D_inv_sqrt_rm,
+			const vec_t& W_diag_sqrt,
+			const std::vector<std::shared_ptr<RECompGP<den_mat_t>>>& re_comps_cross_cov_cluster_i,
+			den_mat_t& rand_vec_SigmaI_plus_W_inv) {
+			const int dim = (int)W_diag_sqrt.size();
+			//z_i ~ N(0,I), one generator per column such that the result does not depend on the number of threads
+			std::uniform_int_distribution<> unif(0, 2147483646);
+			std::vector<int> seeds(2 * num_sim);
+			for (int j = 0; j < 2 * num_sim; ++j) {
+				seeds[j] = unif(cg_generator_);
+			}
+			den_mat_t rand_vec_I(dim, 2 * num_sim);
+			GenRandVecNormalParallel(seeds, rand_vec_I);
+			//z_i ~ N(0,(Sigma^{-1} + W))
+			den_mat_t rand_vec_SigmaI_plus_W = B_t_D_inv_sqrt_rm * rand_vec_I.leftCols(num_sim);
+			rand_vec_SigmaI_plus_W += W_diag_sqrt.asDiagonal() * rand_vec_I.rightCols(num_sim);
+			//z_i ~ N(0,(Sigma^{-1} + W)^{-1})
+			bool has_NA_or_Inf = false;
+			if (cg_preconditioner_type_ == "pivoted_cholesky") {
+				CGVecchiaLaplaceBlockWinvplusSigma(information_ll_, B_rm_, B_t_D_inv_rm_.transpose(), rand_vec_SigmaI_plus_W, rand_vec_SigmaI_plus_W_inv, has_NA_or_Inf,
+					cg_max_num_it_, cg_delta_conv_pred_, ZERO_RHS_CG_THRESHOLD, chol_fact_I_k_plus_Sigma_L_kt_W_Sigma_L_k_vecchia_, Sigma_L_k_);
+			}
+			else if (cg_preconditioner_type_ == "fitc") {
+				const den_mat_t* cross_cov = re_comps_cross_cov_cluster_i[0]->GetSigmaPtr();
+				CGVecchiaLaplaceBlockWinvplusSigma_FITC_P(information_ll_, B_rm_, B_t_D_inv_rm_.transpose(), rand_vec_SigmaI_plus_W, rand_vec_SigmaI_plus_W_inv, has_NA_or_Inf,
+					cg_max_num_it_, cg_delta_conv_pred_, ZERO_RHS_CG_THRESHOLD, chol_fact_woodbury_preconditioner_, (*cross_cov), diagonal_approx_inv_preconditioner_);
+			}
+			else if (cg_preconditioner_type_ == "vadu" || cg_preconditioner_type_ == "incomplete_cholesky") {
+				CGVecchiaLaplaceBlock(information_ll_, B_rm_, B_t_D_inv_rm_, rand_vec_SigmaI_plus_W, rand_vec_SigmaI_plus_W_inv, has_NA_or_Inf,
+					cg_max_num_it_, cg_delta_conv_pred_, ZERO_RHS_CG_THRESHOLD, cg_preconditioner_type_, D_inv_plus_W_B_rm_, L_SigmaI_plus_W_rm_);
+			}
+			else {
+				Log::REFatal("SimSigmaIPlusWInvVecchiaBlock: Preconditioner type '%s' is not supported ", cg_preconditioner_type_.c_str());
+			}
+			if (has_NA_or_Inf) {
+				Log::REDebug(CG_NA_OR_INF_WARNING_);
+			}
+		}//end SimSigmaIPlusWInvVecchiaBlock
+
 		/*!
 		* \brief Make predictions for the response variable (label) based on predictions for the mean and variance of the latent random effects
 		* \param pred_mean[in & out] Predictive mean of latent random effects. The Predictive mean for the response variables is written on this
@@ -4743,6 +5174,101 @@ namespace GPBoost {
 			nsim_var_pred_ = nsim_var_pred;
 		}//end SetMatrixInversionProperties
 
+		/*!
+		* \brief Set whether the simulation of predictive variances reuses the random vectors of the previous simulation.
+		*		This is used when predictions are made in chunks such that the results do not depend on the chunking
+		* \param reuse If true, cg_generator_ is reset to its state at the beginning of the first simulation of predictive variances after this call
+		*/
+		void SetReuseRandVecPredVar(bool reuse) {
+			reuse_rand_vec_pred_var_ = reuse;
+			cg_generator_pred_var_start_saved_ = false;
+		}
+
+		/*!
+		* \brief Calculate the components of the "fitc" preconditioner P = W^(-1) + D_k + cross_cov_k * sigma_ip_k^-1 * cross_cov_k^T for W^(-1) + Sigma,
+		*		where D_k is such that diag(P) = diag(W^(-1) + Sigma). The results are saved in 'diagonal_approx_preconditioner_', 
+		*		'diagonal_approx_inv_preconditioner_', and 'chol_fact_woodbury_preconditioner_'
+		* \param sigma_ip_stable Covariance matrix of the inducing points of the preconditioner (with jitter on the diagonal)
+		* \param cross_cov Cross-covariance matrix between the data and the inducing points of the preconditioner
+		* \param chol_ip_cross_cov Inverse of the Cholesky factor of 'sigma_ip_stable' times the transposed cross-covariance matrix
+		*/
+		void CalcFITCPreconditionerWinvPlusSigma(const den_mat_t& sigma_ip_stable,
+			const den_mat_t& cross_cov,
+			const den_mat_t& chol_ip_cross_cov) {
+			diagonal_approx_preconditioner_ = information_ll_.cwiseInverse();
+			diagonal_approx_preconditioner_.array() += sigma_ip_stable.coeffRef(0, 0);
+#pragma omp parallel for schedule(static)
+			for (int ii = 0; ii < diagonal_approx_preconditioner_.size(); ++ii) {
+				diagonal_approx_preconditioner_[ii] -= chol_ip_cross_cov.col(ii).array().square().sum();
+			}
+			diagonal_approx_inv_preconditioner_ = diagonal_approx_preconditioner_.cwiseInverse();
+			den_mat_t sigma_woodbury = cross_cov.transpose() * (diagonal_approx_inv_preconditioner_.asDiagonal() * cross_cov);
+			sigma_woodbury += sigma_ip_stable;
+			chol_fact_woodbury_preconditioner_.compute(sigma_woodbury);
+		}//end CalcFITCPreconditionerWinvPlusSigma
+
+		/*!
+		* \brief Calculate log|W^(-1) + Sigma| using stochastic Lanczos quadrature when Sigma = D + cross_cov * sigma_ip^-1 * cross_cov^T is a FITC approximation.
+		*		(W^(-1) + Sigma)^(-1) * (probe vectors) is saved in 'WI_plus_Sigma_inv_Z_'
+		* \param fitc_diag_plus_WI Diagonal D of the FITC approximation plus W^(-1)
+		* \param cross_cov Cross-covariance matrix between inducing points and all data points
+		* \param chol_fact_sigma_ip Cholesky factor of the covariance matrix of the inducing points
+		* \param cross_cov_preconditioner Cross-covariance matrix between the data and the inducing points of the preconditioner
+		* \param chol_ip_cross_cov_preconditioner Inverse of the Cholesky factor of the covariance matrix of the inducing points of the preconditioner times the transposed cross-covariance matrix
+		* \param chol_fact_sigma_ip_preconditioner Cholesky factor of the covariance matrix of the inducing points of the preconditioner
+		* \param[out] has_NA_or_Inf Is set to true if NA or Inf occured in the conjugate gradient algorithm
+		* \param[out] log_det_WI_plus_Sigma Approximation of log|W^(-1) + Sigma|
+		*/
+		void CalcLogDetStochFITC(const vec_t& fitc_diag_plus_WI,
+			const den_mat_t& cross_cov,
+			const chol_den_mat_t& chol_fact_sigma_ip,
+			const den_mat_t& cross_cov_preconditioner,
+			const den_mat_t& chol_ip_cross_cov_preconditioner,
+			const chol_den_mat_t& chol_fact_sigma_ip_preconditioner,
+			bool& has_NA_or_Inf,
+			double& log_det_WI_plus_Sigma) {
+			if (!cg_generator_seeded_) {
+				cg_generator_ = RNG_t(seed_rand_vec_trace_);
+				cg_generator_seeded_ = true;
+			}
+			//Generate random vectors (r_1, r_2, r_3, ...) with Cov(r_i) = I
+			if (!saved_rand_vec_trace_) {
+				rand_vec_trace_I_.resize(dim_mode_, num_rand_vec_trace_);
+				GenRandVecNormal(cg_generator_, rand_vec_trace_I_);
+				if (cg_preconditioner_type_ == "fitc") {
+					rand_vec_trace_I2_.resize(chol_ip_cross_cov_preconditioner.rows(), num_rand_vec_trace_);
+					GenRandVecNormal(cg_generator_, rand_vec_trace_I2_);
+				}
+				if (reuse_rand_vec_trace_) {
+					saved_rand_vec_trace_ = true;
+				}
+			}
+			//Get random vectors (z_1, ..., z_t) with Cov(z_i) = P
+			if (cg_preconditioner_type_ == "fitc") {
+				//For P = D_k + chol_ip_cross_cov^T chol_ip_cross_cov: z_i = D_k^(1/2) r_j + chol_ip_cross_cov^T r_i, where r_i, r_j ~ N(0,I)
+				rand_vec_trace_P_ = chol_ip_cross_cov_preconditioner.transpose() * rand_vec_trace_I2_ + diagonal_approx_preconditioner_.cwiseSqrt().asDiagonal() * rand_vec_trace_I_;
+			}
+			else {
+				rand_vec_trace_P_ = rand_vec_trace_I_;
+			}
+			WI_plus_Sigma_inv_Z_.resize(dim_mode_, num_rand_vec_trace_);
+			WI_plus_Sigma_inv_Z_.setZero();
+			std::vector<vec_t> Tdiags_PI_WI_plus_Sigma(num_rand_vec_trace_, vec_t(cg_max_num_it_tridiag_));
+			std::vector<vec_t> Tsubdiags_PI_WI_plus_Sigma(num_rand_vec_trace_, vec_t(cg_max_num_it_tridiag_ - 1));
+			CGTridiagFITC(fitc_diag_plus_WI, cross_cov, chol_fact_sigma_ip, rand_vec_trace_P_, Tdiags_PI_WI_plus_Sigma, Tsubdiags_PI_WI_plus_Sigma,
+				WI_plus_Sigma_inv_Z_, has_NA_or_Inf, dim_mode_, num_rand_vec_trace_, cg_max_num_it_tridiag_, cg_delta_conv_, cg_preconditioner_type_,
+				cross_cov_preconditioner, chol_fact_woodbury_preconditioner_, diagonal_approx_inv_preconditioner_);
+			if (!has_NA_or_Inf) {
+				LogDetStochTridiag(Tdiags_PI_WI_plus_Sigma, Tsubdiags_PI_WI_plus_Sigma, log_det_WI_plus_Sigma, dim_mode_, num_rand_vec_trace_);
+				if (cg_preconditioner_type_ == "fitc") {
+					//log|W^(-1) + Sigma| = log|P^(-1) (W^(-1) + Sigma)| + log|P|, where log|P| = log|Woodburry| - log|Sigma_k| - log|D_k^-1|
+					log_det_WI_plus_Sigma += 2. * ((den_mat_t)chol_fact_woodbury_preconditioner_.matrixL()).diagonal().array().log().sum() -
+						2. * (((den_mat_t)chol_fact_sigma_ip_preconditioner.matrixL()).diagonal().array().log().sum()) -
+						diagonal_approx_inv_preconditioner_.array().log().sum();
+				}
+			}
+		}//end CalcLogDetStochFITC
+
 		/*!
 		* \brief Calculate log|Sigma W + I| using stochastic trace estimation and variance reduction.
 		* \param num_data Number of data points
@@ -4804,17 +5330,7 @@ namespace GPBoost {
 				if (grad_information_wrt_mode_non_zero_) {
 					den_mat_t sigma_ip_stable = *(re_comps_ip_cluster_i[0]->GetZSigmaZt());
 					sigma_ip_stable.diagonal().array() *= JITTER_MULT_IP_FITC_FSA;
-					diagonal_approx_preconditioner_ = information_ll_.cwiseInverse();
-					diagonal_approx_preconditioner_.array() += sigma_ip_stable.coeffRef(0, 0);
-#pragma omp parallel for schedule(static)
-					for (int ii = 0; ii < diagonal_approx_preconditioner_.size(); ++ii) {
-						diagonal_approx_preconditioner_[ii] -= chol_ip_cross_cov_.col(ii).array().square().sum();
-					}
-					diagonal_approx_inv_preconditioner_ = diagonal_approx_preconditioner_.cwiseInverse();
-					den_mat_t sigma_woodbury;
-					sigma_woodbury = (*cross_cov).transpose() * (diagonal_approx_inv_preconditioner_.asDiagonal() * (*cross_cov));
-					sigma_woodbury += sigma_ip_stable;
-					chol_fact_woodbury_preconditioner_.compute(sigma_woodbury);
+					CalcFITCPreconditionerWinvPlusSigma(sigma_ip_stable, *cross_cov, chol_ip_cross_cov_);
 				}
 				rand_vec_trace_P_ = chol_ip_cross_cov_.transpose() * rand_vec_trace_I2_ + diagonal_approx_preconditioner_.cwiseSqrt().asDiagonal() * rand_vec_trace_I_;
 				CGTridiagVecchiaLaplaceWinvplusSigma_FITC_P(information_ll_, B_rm_, B_t_D_inv_rm_.transpose(), rand_vec_trace_P_, Tdiags_PI_WI_plus_Sigma, Tsubdiags_PI_WI_plus_Sigma,
@@ -5325,12 +5841,28 @@ namespace GPBoost {
 		vec_t information_ll_;
 		/*! \brief The diagonal of the (observed or expected) Fisher information for the log-likelihood (diagonal of matrix "W") on the data scale of length num_data_. Usually, this consists of the second derivatives of the negative log-likelihood. This is an auxiliary variable used only if use_Z_for_duplicates_ */
 		vec_t information_ll_data_scale_;
-		/*! \brief Diagonal of matrix Sigma^-1 + Zt * W * Z in Laplace approximation (used only in version 'GroupedRE' when there is only one random effect and ZtWZ is diagonal. Otherwise 'diag_SigmaI_plus_ZtWZ_' is used for grouped REs) */
+		/*! \brief Diagonal of matrix Sigma^-1 + Zt * W * Z in Laplace approximation (used in version 'GroupedRE' when there is only one random effect and ZtWZ is diagonal, and for the preconditioners when there are multiple grouped random effects and matrix_inversion_method_ == "iterative") */
 		vec_t diag_SigmaI_plus_ZtWZ_;
 		/*! \brief Cholesky factors of matrix Sigma^-1 + Zt * W * Z in Laplace approximation (used only in version'GroupedRE' if there is more than one random effect). */
 		chol_sp_mat_t chol_fact_SigmaI_plus_ZtWZ_grouped_;
+		/*! \brief Matrix Sigma^-1 + Zt * W * Z in Laplace approximation (used only in version 'GroupedRE' if there is more than one random effect). Its pattern is fixed and the values are updated with the plan of BuildZtWZPlanGroupedRE */
+		sp_mat_t SigmaI_plus_ZtWZ_grouped_;
+		/*! \brief If true, chol_fact_SigmaI_plus_ZtWZ_grouped_ is the factor of SigmaI_plus_ZtWZ_grouped_ at the current mode (this is not the case after the mode finding if matrix_inversion_method_ == "iterative") */
+		bool chol_fact_grouped_RE_calculated_ = false;
+		/*! \brief If true, the plan for calculating SigmaI_plus_ZtWZ_grouped_ has been built */
+		bool ZtWZ_plan_built_ = false;
+		/*! \brief Start of the entries of every value slot of SigmaI_plus_ZtWZ_grouped_ in ZtWZ_plan_data_idx_ */
+		std::vector<int64_t> ZtWZ_plan_slot_start_;
+		/*! \brief Observation of every entry of the plan, sorted by value slot */
+		std::vector<data_size_t> ZtWZ_plan_data_idx_;
+		/*! \brief Product Z(i, k) * Z(i, l) of every entry of the plan, empty if all are 1 */
+		std::vector<double> ZtWZ_plan_weights_;
+		/*! \brief Value slot of the diagonal entry of every column of SigmaI_plus_ZtWZ_grouped_ */
+		std::vector<int> ZtWZ_plan_diag_slot_;
 		/*! \brief Cholesky factors of matrix Sigma^-1 + Zt * W * Z in Laplace approximation (used only in version 'Vecchia') */
 		chol_sp_mat_t chol_fact_SigmaI_plus_ZtWZ_vecchia_;
+		/*! \brief Memory for temporary vectors in the mode finding algorithms */
+		IterationArena arena_;
 		/*!
 		* \brief Cholesky factors of matrix B = I + Wsqrt *  Z * Sigma * Zt * Wsqrt in Laplace approximation (for version 'Stable')
 		*		or of matrix B = Id + ZtWZsqrt * Sigma * ZtWZsqrt (for version 'OnlyOneGPCalculationsOnREScale')
@@ -5338,6 +5870,8 @@ namespace GPBoost {
 		T_chol chol_fact_Id_plus_Wsqrt_Sigma_Wsqrt_;
 		/*! \brief Cholesky factor of dense matrix used in Newton's method for finding mode (used in version 'FITC') */
 		chol_den_mat_t chol_fact_dense_Newton_;
+		/*! \brief If true, 'chol_fact_dense_Newton_' has been calculated for the current mode (only relevant for version 'FITC') */
+		bool chol_fact_dense_Newton_calculated_ = false;
 		/*! \brief If true, the pattern for the Cholesky factor (chol_fact_Id_plus_Wsqrt_Sigma_Wsqrt_, chol_fact_SigmaI_plus_ZtWZ_grouped_, or chol_fact_SigmaI_plus_ZtWZ_vecchia_) has been analyzed */
 		bool chol_fact_pattern_analyzed_ = false;
 		/*! \brief If true, the mode has been initialized to 0 */
@@ -5438,6 +5972,8 @@ namespace GPBoost {
 		int rank_pred_approx_matrix_lanczos_;
 		/*! \brief Number of samples when simulation is used for calculating predictive variances */
 		int nsim_var_pred_;
+		/*! \brief Number of samples that are solved jointly with a block conjugate gradient algorithm when simulation is used for calculating predictive variances */
+		const int num_sim_block_var_pred_ = 64;
 		/*! \brief If true, cg_max_num_it and cg_max_num_it_tridiag are reduced by 2/3 (multiplied by 1/3) for the mode finding of the Laplace approximation in the first gradient step when finding a learning rate that reduces the ll */
 		bool reduce_cg_max_num_it_first_optim_step_ = true;
 
@@ -5455,6 +5991,12 @@ namespace GPBoost {
 		RNG_t cg_generator_;
 		/*! If the seed of the random number generator cg_generator_ is set, cg_generator_seeded_ is set to true*/
 		bool cg_generator_seeded_ = false;
+		/*! State of cg_generator_ at the beginning of the last simulation of predictive variances */
+		RNG_t cg_generator_pred_var_start_;
+		/*! True if cg_generator_pred_var_start_ has been saved since the last call to SetReuseRandVecPredVar() */
+		bool cg_generator_pred_var_start_saved_ = false;
+		/*! If true, the simulation of predictive variances starts from cg_generator_pred_var_start_ (see SetReuseRandVecPredVar()) */
+		bool reuse_rand_vec_pred_var_ = false;
 		/*! If reuse_rand_vec_trace_ is true and rand_vec_trace_I_ has been generated for the first time, then saved_rand_vec_trace_ is set to true */
 		bool saved_rand_vec_trace_ = false;
 		/*! Matrix of random vectors (r_1, r_2, r_3, ...) with Cov(r_i) = I, r_i is of dimension num_data, and t = num_rand_vec_trace_ */
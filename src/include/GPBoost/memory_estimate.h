@@ -0,0 +1,167 @@
+/*!
+* This file is part of GPBoost a C++ library for combining
+*	boosting with Gaussian process and mixed effects models
+*
+* Copyright (c) 2020 Fabio Sigrist. All rights reserved.
+*
+* Licensed under the Apache License Version 2.0. See LICENSE file in the project root for license information.
+*/
+#ifndef GPB_MEMORY_ESTIMATE_H_
+#define GPB_MEMORY_ESTIMATE_H_
+
+#include <GPBoost/type_defs.h>
+
+#include <algorithm>
+
+namespace GPBoost {
+
+	/*!
+	* \brief Expected peak memory (in bytes) of the different phases of a REModel
+	*/
+	struct MemoryEstimate {
+		/*! \brief Memory of a constructed model (data, random effects components, neighbors, distances) */
+		double construction = 0.;
+		/*! \brief Peak memory during parameter estimation (including construction) */
+		double estimation = 0.;
+		/*! \brief Peak memory when making predictions (including construction) */
+		double prediction = 0.;
+		/*! \brief Part of 'prediction' that grows linearly with the number of prediction points */
+		double prediction_per_point = 0.;
+		/*! \brief Part of 'estimation' per row of a block of the cross-covariance matrix when it is calculated in blocks of rows for the FITC approximation (0 for other models) */
+		double estimation_per_fitc_streaming_row = 0.;
+	};
+
+	/*!
+	* \brief Rough estimate of the peak memory of a REModel. Only the dominating terms are considered and
+	*		the number of levels of grouped random effects is bounded by the number of data points
+	* \param num_data Number of data points
+	* \param num_re_group_total Number of grouped random effects (including random coefficients)
+	* \param num_gp_total Number of Gaussian processes (including random coefficients)
+	* \param dim_gp_coords Dimension of the coordinates of the Gaussian process
+	* \param gp_approx Type of GP approximation ("none", "vecchia", "tapering", "fitc", "full_scale_tapering")
+	* \param num_neighbors Number of neighbors for the Vecchia approximation (also used as proxy for the number of non-zeros per row for tapering)
+	* \param num_neighbors_pred Number of neighbors for the Vecchia approximation for making predictions
+	* \param num_ind_points Number of inducing points for "fitc" and "full_scale_tapering"
+	* \param gauss_likelihood If true, the likelihood is Gaussian
+	* \param iterative If true, iterative methods are used for matrix inversion
+	* \param num_rand_vec_trace Number of random vectors for stochastic trace estimation (only relevant if iterative)
+	* \param num_cov_par Number of covariance parameters
+	* \param num_data_pred Number of prediction points
+	* \param predict_cov_mat If true, the predictive covariance matrix is calculated
+	* \param fitc_streaming_block_size If > 0, the cross-covariance matrix of the FITC approximation is not stored but calculated in blocks of this many rows
+	*/
+	inline MemoryEstimate EstimateMemoryREModel(data_size_t num_data,
+		int num_re_group_total,
+		int num_gp_total,
+		int dim_gp_coords,
+		const string_t& gp_approx,
+		int num_neighbors,
+		int num_neighbors_pred,
+		int num_ind_points,
+		bool gauss_likelihood,
+		bool iterative,
+		int num_rand_vec_trace,
+		int num_cov_par,
+		data_size_t num_data_pred,
+		bool predict_cov_mat,
+		data_size_t fitc_streaming_block_size = 0) {
+		const double SIZE_DOUBLE = (double)sizeof(double);
+		const double SIZE_INT = (double)sizeof(int);
+		const double SIZE_SP_ENTRY = SIZE_DOUBLE + SIZE_INT;
+		const double n = (double)num_data;
+		const double n_p = (double)num_data_pred;
+		const double d = (double)dim_gp_coords;
+		const double m = (double)num_neighbors;
+		const double m_p = (double)num_neighbors_pred;
+		const double k = (double)num_ind_points;
+		const double q = (double)num_re_group_total;
+		const double p = (double)std::max(num_cov_par, 1);
+		MemoryEstimate est;
+		// Data (response variable, auxiliary vectors for the likelihood)
+		double data = 4. * n * SIZE_DOUBLE;
+		double constr = 0., estim = 0., pred_const = 0., pred_per_point = 0.;
+		// Grouped random effects: incidence matrices Z and Z^T Z
+		if (num_re_group_total > 0) {
+			constr += 2. * n * q * SIZE_SP_ENTRY;
+			// Cholesky factor of Sigma^-1 + Z^T Z and its derivatives
+			estim += (2. + p) * n * q * SIZE_SP_ENTRY;
+			pred_per_point += 2. * q * SIZE_SP_ENTRY + 2. * SIZE_DOUBLE;
+		}
+		if (num_gp_total > 0) {
+			const double g = (double)num_gp_total;
+			data += n * d * SIZE_DOUBLE;
+			pred_per_point += d * SIZE_DOUBLE;
+			if (gp_approx == "vecchia") {
+				// Neighbors, cached distances (upper triangle), and matrices B and D
+				constr += n * m * SIZE_INT + n * m * (m + 1.) / 2. * SIZE_DOUBLE + n * (m + 1.) * SIZE_SP_ENTRY + n * SIZE_DOUBLE;
+				// Derivatives of B and D for every covariance parameter
+				estim += p * (n * (m + 1.) * SIZE_SP_ENTRY + n * SIZE_DOUBLE);
+				if (!gauss_likelihood) {
+					if (iterative) {
+						// Random vectors and solutions for stochastic trace estimation and preconditioner
+						estim += 6. * n * (double)num_rand_vec_trace * SIZE_DOUBLE + 2. * n * (m + 1.) * SIZE_SP_ENTRY;
+					}
+					else {
+						// Cholesky factor of Sigma^-1 + W (with some fill-in)
+						estim += 4. * n * m * SIZE_SP_ENTRY;
+					}
+				}
+				// Joint Vecchia approximation for observed and prediction locations
+				pred_const += n * m_p * (m_p + 1.) * SIZE_DOUBLE + n * (m_p + 1.) * SIZE_SP_ENTRY;
+				pred_per_point += m_p * SIZE_INT + m_p * (m_p + 1.) * SIZE_DOUBLE + 2. * (m_p + 1.) * SIZE_SP_ENTRY + 2. * SIZE_DOUBLE;
+			}
+			else if (gp_approx == "fitc" && fitc_streaming_block_size > 0) {
+				// Covariance of inducing points and diagonal of the residual covariance, the cross-covariance is not stored
+				constr += g * k * k * SIZE_DOUBLE + k * d * SIZE_DOUBLE + n * SIZE_DOUBLE;
+				// Derivatives of the Woodbury matrix and Cholesky factors
+				estim += p * k * k * SIZE_DOUBLE + 2. * k * k * SIZE_DOUBLE;
+				// Blocks of the cross-covariance, its derivative, and sigma_ip^-1 * cross_cov^T
+				est.estimation_per_fitc_streaming_row = 3. * k * SIZE_DOUBLE;
+				estim += (double)std::min(fitc_streaming_block_size, num_data) * est.estimation_per_fitc_streaming_row;
+				pred_per_point += 2. * k * SIZE_DOUBLE;
+			}
+			else if (gp_approx == "fitc" || gp_approx == "full_scale_tapering") {
+				// Cross-covariance and covariance of inducing points
+				constr += g * (n * k + k * k) * SIZE_DOUBLE + k * d * SIZE_DOUBLE;
+				// Derivatives of cross-covariances and Cholesky factors
+				estim += p * (n * k + k * k) * SIZE_DOUBLE + 2. * k * k * SIZE_DOUBLE;
+				if (gp_approx == "full_scale_tapering") {
+					constr += 2. * n * m * SIZE_SP_ENTRY;
+					estim += (2. + p) * n * m * SIZE_SP_ENTRY;
+					pred_const += n * m * SIZE_SP_ENTRY;
+				}
+				if (gp_approx == "fitc") {
+					est.estimation_per_fitc_streaming_row = 3. * k * SIZE_DOUBLE;
+				}
+				pred_per_point += 2. * k * SIZE_DOUBLE;
+			}
+			else if (gp_approx == "tapering") {
+				constr += 2. * g * n * m * SIZE_SP_ENTRY;
+				estim += (2. + p) * n * m * SIZE_SP_ENTRY;
+				pred_per_point += 2. * m * SIZE_SP_ENTRY;
+			}
+			else {
+				// Distances and covariance matrices
+				constr += (1. + g) * n * n * SIZE_DOUBLE;
+				// Cholesky factor, inverse covariance matrix, and derivatives for every covariance parameter
+				estim += (2. + p) * n * n * SIZE_DOUBLE;
+				// Cross-distances, cross-covariances, and Sigma^-1 Cross_cov^T for variances
+				pred_per_point += 3. * n * SIZE_DOUBLE;
+			}
+		}
+		if (predict_cov_mat) {
+			// Predictive covariance matrix and output
+			pred_const += 2. * n_p * n_p * SIZE_DOUBLE;
+		}
+		// Output (mean and variances)
+		pred_per_point += 2. * SIZE_DOUBLE;
+		est.construction = data + constr;
+		est.estimation = est.construction + estim;
+		est.prediction_per_point = pred_per_point;
+		est.prediction = est.construction + pred_const + n_p * pred_per_point;
+		return est;
+	}//end EstimateMemoryREModel
+
+}  // namespace GPBoost
+
+#endif   // GPB_MEMORY_ESTIMATE_H_
@@ -12,6 +12,7 @@
 #include <GPBoost/type_defs.h>
 #include <GPBoost/cov_fcts.h>
 #include <GPBoost/GP_utils.h>
+#include <GPBoost/sparse_matrix_utils.h>
 
 #include <memory>
 #include <mutex>
@@ -269,13 +270,7 @@ namespace GPBoost {
 			this->rand_coef_data_ = rand_coef_data;
 			this->is_rand_coef_ = true;
 			this->num_cov_par_ = 1;
-			this->Z_ = sp_mat_t(this->num_data_, num_group_);
-			std::vector<Triplet_t> triplets(this->num_data_);
-#pragma omp parallel for schedule(static)
-			for (int i = 0; i < this->num_data_; ++i) {
-				triplets[i] = Triplet_t(i, random_effects_indices_of_data[i], this->rand_coef_data_[i]);
-			}
-			this->Z_.setFromTriplets(triplets.begin(), triplets.end());
+			CreateIncidenceMatrix(this->num_data_, num_group_, random_effects_indices_of_data, this->rand_coef_data_.data(), this->Z_);
 			//// Alternative version: inserting elements directly (see constructor above)
 			//for (int i = 0; i < this->num_data_; ++i) {
 			//	this->Z_.insert(i, (*map_group_label_index_)[(*group_data_)[i]]) = this->rand_coef_data_[i];
@@ -326,19 +321,7 @@ namespace GPBoost {
 		*/
 		void CreateZ() {
 			CHECK(!this->is_rand_coef_);//not intended for random coefficient models
-			this->Z_ = sp_mat_t(this->num_data_, num_group_);
-			std::vector<Triplet_t> triplets(this->num_data_);
-#pragma omp parallel for schedule(static)
-			for (int i = 0; i < this->num_data_; ++i) {
-				triplets[i] = Triplet_t(i, this->random_effects_indices_of_data_[i], 1.);
-			}
-			this->Z_.setFromTriplets(triplets.begin(), triplets.end());
-			// Alternative version: inserting elements directly
-			// Note: compared to using triples, this is much slower when group_data is not ordered (e.g. [1,2,3,1,2,3]), otherwise if group_data is ordered (e.g. [1,1,2,2,3,3]) there is no big difference
-			////this->Z_.reserve(Eigen::VectorXi::Constant(this->num_data_, 1));//don't use this, it makes things much slower
-			//for (int i = 0; i < this->num_data_; ++i) {
-			//	this->Z_.insert(i, this->random_effects_indices_of_data_[i]) = 1.;
-			//}
+			CreateIncidenceMatrix(this->num_data_, num_group_, this->random_effects_indices_of_data_.data(), nullptr, this->Z_);
 		}
 
 		/*!
@@ -1062,6 +1045,14 @@ namespace GPBoost {
 			return(cov_function_->IsIsotropic());
 		}
 
+		/*!
+		* \brief Set whether precomputed distances or the coordinates are used for calculating covariances in 'CalcSigmaAndSigmaGradVecchia'
+		* \param use_precomputed_dist_for_calc_cov If true, precomputed distances are used (only possible for isotropic covariance functions)
+		*/
+		void SetUsePrecomputedDistForCalcCov(bool use_precomputed_dist_for_calc_cov) {
+			cov_function_->SetUsePrecomputedDistForCalcCov(use_precomputed_dist_for_calc_cov);
+		}
+
 		bool IsSpaceTimeModel() const {
 			return(cov_function_->IsSpaceTimeModel());
 		}
@@ -1235,6 +1226,79 @@ namespace GPBoost {
 			return(&sigma_);
 		}
 
+		/*!
+		* \brief Calculate a block of consecutive rows of the cross-covariance matrix between the locations and the inducing points without calculating and saving the full matrix sigma_
+		*		Note: this is used when the cross-covariance matrix is streamed in blocks for the FITC approximation and is only called for T_mat == den_mat_t
+		* \param row_start First row of the block
+		* \param num_rows Number of rows in the block
+		* \param[out] sigma_rows Rows row_start,...,(row_start + num_rows - 1) of the cross-covariance matrix
+		*/
+		void CalcSigmaRows(data_size_t row_start,
+			data_size_t num_rows,
+			T_mat& sigma_rows) const {
+			CHECK(is_cross_covariance_IP_);
+			CHECK(!dist_saved_);
+			CHECK(row_start >= 0);
+			CHECK(row_start + num_rows <= num_random_effects_);
+			if (this->cov_pars_.size() == 0) { Log::REFatal("Covariance parameters are not specified. Call 'SetCovPars' first."); }
+			den_mat_t coords_rows = coords_.middleRows(row_start, num_rows);
+			T_mat dist_dummy;// unused dummy variable
+			(*cov_function_).template CalculateCovMat<T_mat>(dist_dummy, coords_ind_point_, coords_rows, this->cov_pars_, sigma_rows, false);
+		}
+
+		/*!
+		* \brief Calculate the cross-covariance matrix between the locations with indices 'rows' and the inducing points without calculating and saving the full matrix sigma_
+		*		Note: this is only called for T_mat == den_mat_t
+		* \param rows Indices of the rows
+		* \param[out] sigma_rows Rows of the cross-covariance matrix with indices 'rows'
+		*/
+		void CalcSigmaRows(const std::vector<int>& rows,
+			T_mat& sigma_rows) const {
+			CHECK(is_cross_covariance_IP_);
+			CHECK(!dist_saved_);
+			if (this->cov_pars_.size() == 0) { Log::REFatal("Covariance parameters are not specified. Call 'SetCovPars' first."); }
+			den_mat_t coords_rows = coords_(rows, Eigen::all);
+			T_mat dist_dummy;// unused dummy variable
+			(*cov_function_).template CalculateCovMat<T_mat>(dist_dummy, coords_ind_point_, coords_rows, this->cov_pars_, sigma_rows, false);
+		}
+
+		/*!
+		* \brief Calculate derivatives with respect to the parameters of a block of consecutive rows of the cross-covariance matrix between the locations and the inducing points
+		*		Note: this is only called for T_mat == den_mat_t
+		* \param ind_par Index for parameter (0=variance, 1=inverse range)
+		* \param transf_scale If true, the derivative is taken on the transformed scale otherwise on the original scale
+		* \param nugget_var Nugget effect variance parameter sigma^2 (used only if transf_scale = false to transform back)
+		* \param sigma_rows Rows of the cross-covariance matrix (output of 'CalcSigmaRows' for the same block)
+		* \param row_start First row of the block
+		* \param[out] sigma_grad_rows Derivative of rows row_start,...,(row_start + sigma_rows.rows() - 1) of the cross-covariance matrix
+		*/
+		void CalcSigmaGradRows(int ind_par,
+			bool transf_scale,
+			double nugget_var,
+			const T_mat& sigma_rows,
+			data_size_t row_start,
+			T_mat& sigma_grad_rows) const {
+			CHECK(is_cross_covariance_IP_);
+			CHECK(!dist_saved_);
+			CHECK(ind_par >= 0);
+			CHECK(ind_par < this->num_cov_par_);
+			if (ind_par == 0) {//variance
+				if (transf_scale) {
+					sigma_grad_rows = sigma_rows;
+				}
+				else {
+					sigma_grad_rows = sigma_rows / this->cov_pars_[0];
+				}
+			}
+			else {//inverse range parameters
+				CHECK(cov_function_->cov_fct_type_ != "wendland");
+				den_mat_t coords_rows = coords_.middleRows(row_start, sigma_rows.rows());
+				T_mat dist_dummy;// unused dummy variable
+				(*cov_function_).template CalculateGradientCovMat<T_mat>(dist_dummy, coords_ind_point_, coords_rows, sigma_rows, this->cov_pars_,
+					sigma_grad_rows, transf_scale, nugget_var, ind_par - 1, false);
+			}
+		}
+
 		/*!
 		* \brief Calculate covariance matrix
 		* \return Covariance matrix Z*Sigma*Z^T of this component
@@ -11,6 +11,8 @@
 
 #include <GPBoost/type_defs.h>
 #include <GPBoost/re_model_template.h>
+#include <GPBoost/memory_estimate.h>
+#include <GPBoost/thread_budget.h>
 #include <LightGBM/export.h>
 
 #include <memory>
@@ -59,7 +61,8 @@ namespace GPBoost {
 		* \param likelihood_additional_param Additional parameter for the likelihood which cannot be estimated (e.g., degrees of freedom for likelihood = "t")
 		* \param matrix_inversion_method Method which is used for matrix inversion
 		* \param seed Seed used for model creation (e.g., random ordering in Vecchia approximation)
-		* \param num_parallel_threads Number of parallel threads for OMP
+		* \param num_parallel_threads Number of parallel threads for OMP used for the computations of this model (<= 0: settings of the calling thread are used).
+		*		The settings of the calling thread are restored after every operation
 		*/
 		LIGHTGBM_EXPORT REModel(data_size_t num_data,
 			const data_size_t* cluster_ids_data,
@@ -123,6 +126,59 @@ namespace GPBoost {
 
 		string_t GetCGPreconditionerType() const;
 
+		/*!
+		* \brief Set the threads used for the computations of this model. The budget is applied whenever this model does computations
+		*		and the previous thread settings of the calling thread are restored afterwards
+		* \param num_threads Maximal number of OMP threads. If <= 0, the settings of the calling thread are used
+		* \param cpu_ids CPUs to which the threads are pinned (only supported on Linux). Can be nullptr if num_cpu_ids == 0
+		* \param num_cpu_ids Number of CPUs in cpu_ids. If 0, threads are not pinned
+		*/
+		void SetThreadBudget(int num_threads,
+			const int* cpu_ids,
+			int num_cpu_ids);
+
+		/*!
+		* \brief Rough estimate of the peak memory (in bytes) of the construction, estimation, and prediction phases of this model
+		* \param num_data_pred Number of prediction points
+		* \param predict_cov_mat If true, the predictive covariance matrix is calculated
+		*/
+		MemoryEstimate EstimateMemory(data_size_t num_data_pred,
+			bool predict_cov_mat) const;
+
+		/*!
+		* \brief Rough estimate of the peak memory (in bytes) of this model
+		* \param num_data_pred Number of prediction points
+		* \param predict_cov_mat If true, the predictive covariance matrix is calculated
+		* \param fitc_streaming_block_size Number of rows of the blocks of the cross-covariance matrix for the FITC approximation (0 = stored, < 0 = current setting)
+		*/
+		MemoryEstimate EstimateMemory(data_size_t num_data_pred,
+			bool predict_cov_mat,
+			data_size_t fitc_streaming_block_size) const;
+
+		/*!
+		* \brief Set a hard memory cap for this model. If the estimated peak memory of the parameter estimation is larger than the cap, the cross-covariance
+		*		matrix of the FITC approximation is calculated in blocks of rows that fit into the cap (if this is supported, see 'fitc_streaming_block_size'),
+		*		otherwise parameter estimation fails before starting.
+		*		Predictions are made in chunks of prediction points if this is possible (no predictive covariance matrix and predictions of a point
+		*		do not depend on other prediction points), otherwise they fail before allocating memory
+		* \param max_bytes Maximal memory in bytes. If <= 0, there is no cap
+		*/
+		void SetMemoryCap(double max_bytes);
+
+		/*!
+		* \brief Reset the covariance parameters and the state of the parameter estimation such that the model can be fitted again as if it had been newly created.
+		*		The structures that depend only on the data (random effects components, nearest neighbors, incidence matrices, etc.) are kept
+		*/
+		void ResetEstimation();
+
+		/*!
+		* \brief Set the policy for caching the distances among locations and their nearest neighbors for the Vecchia approximation
+		* \param policy "auto" (cache in double precision if this fits into the budget), "none", "double", or "float"
+		* \param budget_bytes Memory budget in bytes for the "auto" policy (the current budget is kept if budget_bytes <= 0)
+		*/
+		void SetVecchiaDistanceCache(const char* policy,
+			double budget_bytes);
+
 		/*!
 		* \brief Set configuration parameters for the optimizer
 		* \param init_cov_pars Initial values for covariance parameters of RE components
@@ -152,6 +208,7 @@ namespace GPBoost {
 		* \param piv_chol_rank Rank of the pivoted cholseky decomposition used as preconditioner of the conjugate gradient algorithm
 		* \param init_aux_pars Initial values for values for aux_pars_ (e.g., shape parameter of gamma likelihood)
 		* \param estimate_aux_pars If true, any additional parameters for non-Gaussian likelihoods are also estimated (e.g., shape parameter of gamma likelihood)
+		* \param fitc_streaming_block_size If > 0, the cross-covariance matrix for the FITC approximation is not stored but calculated in blocks of this many rows
 		*/
 		void SetOptimConfig(double* init_cov_pars,
 			double lr,
@@ -179,7 +236,8 @@ namespace GPBoost {
 			int seed_rand_vec_trace,
 			int piv_chol_rank,
 			double* init_aux_pars,
-			bool estimate_aux_pars);
+			bool estimate_aux_pars,
+			int fitc_streaming_block_size);
 
 		/*!
 		* \brief Reset cov_pars_ (to their initial values).
@@ -454,6 +512,41 @@ namespace GPBoost {
 
 	private:
 
+		/*!
+		* \brief Fails if an estimated memory is larger than the memory cap
+		* \param mem_bytes Estimated memory in bytes
+		* \param phase Name of the phase for the error message
+		*/
+		void CheckMemoryCap(double mem_bytes,
+			const char* phase) const;
+
+		/*!
+		* \brief Check whether parameter estimation fits into the memory cap. If not, the cross-covariance matrix of the FITC approximation
+		*		is calculated in blocks of rows if this is supported and makes the estimation fit into the cap
+		*/
+		void ApplyMemoryCapEstimation();
+
+		/*!
+		* \brief Make predictions separately for chunks of prediction points such that the memory cap is not exceeded.
+		*		Only predictive means and variances are calculated, and the predictions of a point must not depend on other prediction points
+		* \param chunk_size Number of prediction points per chunk
+		* (see Predict() for the other parameters)
+		*/
+		void PredictInChunks(const double* y_obs,
+			data_size_t num_data_pred,
+			double* out_predict,
+			bool predict_var,
+			bool predict_response,
+			const data_size_t* cluster_ids_data_pred,
+			double* gp_coords_data_pred,
+			const double* gp_rand_coef_data_pred,
+			const double* cov_pars_pred,
+			const double* covariate_data_pred,
+			const double* fixed_effects,
+			const double* fixed_effects_pred,
+			bool suppress_calc_cov_factor,
+			data_size_t chunk_size);
+
 		string_t matrix_format_ = "den_mat_t";//den_mat_t, sp_mat_t, sp_mat_rm_t
 		std::unique_ptr<REModelTemplate<sp_mat_t, chol_sp_mat_t>> re_model_sp_;
 		std::unique_ptr<REModelTemplate<sp_mat_rm_t, chol_sp_mat_rm_t>> re_model_sp_rm_;
@@ -461,6 +554,8 @@ namespace GPBoost {
 		/*! \brief List of covariance functions wtih compact support */
 		const std::set<string_t> COMPACT_SUPPORT_COVS_{ "wendland", "exponential_tapered" };
 		int num_it_ = 0; //Number of iterations done for covariance and linear regression parameter estimation
+		ThreadBudget thread_budget_; //Threads used for the computations of this model (applied with a 'ScopedThreadBudget' in every function that does computations)
+		double memory_cap_ = 0.; //Maximal memory in bytes for this model (no cap if <= 0)
 		bool calc_std_dev_ = false;
 		// Covariance parameters related variables
 		vec_t cov_pars_; //Covariance parameters
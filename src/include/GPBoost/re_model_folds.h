@@ -0,0 +1,178 @@
+/*!
+* This file is part of GPBoost a C++ library for combining
+*	boosting with Gaussian process and mixed effects models
+*
+* Copyright (c) 2020 Fabio Sigrist. All rights reserved.
+*
+* Licensed under the Apache License Version 2.0. See LICENSE file in the project root for license information.
+*/
+#ifndef GPB_RE_MODEL_FOLDS_H_
+#define GPB_RE_MODEL_FOLDS_H_
+
+#include <GPBoost/type_defs.h>
+#include <GPBoost/re_model.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GPBoost {
+
+	/*!
+	* \brief Random effects models for the folds of a cross-validation (e.g., for tuning parameters with a grid search).
+	*		The data is stored once for all folds, and the model for the training data of every fold is built only once
+	*		(when it is used for the first time) and reused for all parameter combinations. Before a model is reused,
+	*		only the state of the parameter estimation is reset, i.e., nearest neighbors, incidence matrices, etc. are not recalculated
+	*/
+	class REModelFolds {
+	public:
+		/*!
+		* \brief Constructor (see REModel::REModel() for the description of the data and model parameters)
+		* \param num_folds Number of folds
+		* \param fold_ids Fold of every data point (length = num_data). Data points with fold_ids[i] == k are held out for fold k,
+		*		data points with fold_ids[i] < 0 or fold_ids[i] >= num_folds are always used for training
+		*/
+		REModelFolds(data_size_t num_data,
+			const data_size_t* cluster_ids_data,
+			const char* re_group_data,
+			data_size_t num_re_group,
+			const double* re_group_rand_coef_data,
+			const data_size_t* ind_effect_group_rand_coef,
+			data_size_t num_re_group_rand_coef,
+			const int* drop_intercept_group_rand_effect,
+			data_size_t num_gp,
+			const double* gp_coords_data,
+			int dim_gp_coords,
+			const double* gp_rand_coef_data,
+			data_size_t num_gp_rand_coef,
+			const char* cov_fct,
+			double cov_fct_shape,
+			const char* gp_approx,
+			double cov_fct_taper_range,
+			double cov_fct_taper_shape,
+			int num_neighbors,
+			const char* vecchia_ordering,
+			int num_ind_points,
+			double cover_tree_radius,
+			const char* ind_points_selection,
+			const char* likelihood,
+			double likelihood_additional_param,
+			const char* matrix_inversion_method,
+			int seed,
+			int num_parallel_threads,
+			int num_folds,
+			const int* fold_ids);
+
+		/*! \brief Disable copy */
+		REModelFolds& operator=(const REModelFolds&) = delete;
+
+		/*! \brief Disable copy */
+		REModelFolds(const REModelFolds&) = delete;
+
+		int NumFolds() const {
+			return(num_folds_);
+		}
+
+		/*!
+		* \brief Number of training or held-out data points of a fold
+		* \param fold Index of the fold
+		* \param held_out If true, the number of held-out data points is returned, otherwise the number of training data points
+		*/
+		data_size_t NumData(int fold,
+			bool held_out) const;
+
+		/*!
+		* \brief Model for the training data of a fold. The model is created when it is requested for the first time,
+		*		afterwards its estimation state is reset (see REModel::ResetEstimation()) such that it can be fitted again.
+		*		The model is owned by this object
+		* \param fold Index of the fold
+		*/
+		REModel* GetTrainModel(int fold);
+
+		/*!
+		* \brief Set the held-out data of a fold as prediction data of the model for the training data of the fold (see REModel::SetPredictionData())
+		* \param fold Index of the fold
+		*/
+		void SetHeldOutPredictionData(int fold,
+			const char* vecchia_pred_type,
+			int num_neighbors_pred,
+			double cg_delta_conv_pred,
+			int nsim_var_pred,
+			int rank_pred_approx_matrix_lanczos);
+
+	private:
+		/*! \brief Copy of a C string that can be a null pointer */
+		struct OptionalString {
+			bool is_null = true;
+			string_t str;
+			void Set(const char* s) {
+				is_null = s == nullptr;
+				str = is_null ? "" : string_t(s);
+			}
+			const char* c_str() const {
+				return(is_null ? nullptr : str.c_str());
+			}
+		};
+
+		/*! \brief Data of a subset of the data points in the format of the REModel constructor */
+		struct RowSubset {
+			data_size_t num_data = 0;
+			std::vector<data_size_t> cluster_ids;
+			std::vector<char> re_group;
+			std::vector<double> re_group_rand_coef;
+			std::vector<double> gp_coords;
+			std::vector<double> gp_rand_coef;
+		};
+
+		/*!
+		* \brief Gather the data of a subset of the data points
+		* \param rows Indices of the data points
+		* \param[out] subset Data of the data points
+		*/
+		void GatherRows(const std::vector<data_size_t>& rows,
+			RowSubset& subset) const;
+
+		void CheckFold(int fold) const;
+
+		data_size_t num_data_;
+		int num_folds_;
+		/*! \brief Training data points of every fold */
+		std::vector<std::vector<data_size_t>> train_rows_;
+		/*! \brief Held-out data points of every fold */
+		std::vector<std::vector<data_size_t>> held_out_rows_;
+		/*! \brief Models for the training data of the folds (nullptr if not yet created) */
+		std::vector<std::unique_ptr<REModel>> train_models_;
+		// Data
+		std::vector<data_size_t> cluster_ids_;
+		/*! \brief Group levels of every grouped random effect and data point (including the terminating null character) */
+		std::vector<std::vector<std::string>> re_group_levels_;
+		std::vector<double> re_group_rand_coef_;
+		data_size_t num_re_group_rand_coef_;
+		std::vector<data_size_t> ind_effect_group_rand_coef_;
+		std::vector<int> drop_intercept_group_rand_effect_;
+		data_size_t num_gp_;
+		std::vector<double> gp_coords_;
+		int dim_gp_coords_;
+		std::vector<double> gp_rand_coef_;
+		data_size_t num_gp_rand_coef_;
+		// Model parameters
+		OptionalString cov_fct_;
+		double cov_fct_shape_;
+		OptionalString gp_approx_;
+		double cov_fct_taper_range_;
+		double cov_fct_taper_shape_;
+		int num_neighbors_;
+		OptionalString vecchia_ordering_;
+		int num_ind_points_;
+		double cover_tree_radius_;
+		OptionalString ind_points_selection_;
+		OptionalString likelihood_;
+		double likelihood_additional_param_;
+		OptionalString matrix_inversion_method_;
+		int seed_;
+		int num_parallel_threads_;
+	};
+
+}  // namespace GPBoost
+
+#endif   // GPB_RE_MODEL_FOLDS_H_
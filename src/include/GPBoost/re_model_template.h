@@ -17,6 +17,8 @@
 #include <GPBoost/Vecchia_utils.h>
 #include <GPBoost/GP_utils.h>
 #include <GPBoost/likelihoods.h>
+#include <GPBoost/iteration_arena.h>
+#include <GPBoost/memory_estimate.h>
 #include <GPBoost/utils.h>
 #include <GPBoost/optim_utils.h>
 #include <LBFGSpp/BFGSMat.h>
@@ -82,7 +84,7 @@ namespace GPBoost {
 		* \param likelihood_additional_param Additional parameter for the likelihood which cannot be estimated (e.g., degrees of freedom for likelihood = "t")
 		* \param matrix_inversion_method Method which is used for matrix inversion
 		* \param seed Seed used for model creation (e.g., random ordering in Vecchia approximation)
-		* \param num_parallel_threads Number of parallel threads for OMP
+		*		Note: the number of threads is not set here but by the caller for every operation (see 'ScopedThreadBudget' in re_model.cpp)
 		*/
 		REModelTemplate(data_size_t num_data,
 			const data_size_t* cluster_ids_data,
@@ -110,12 +112,7 @@ namespace GPBoost {
 			const char* likelihood,
 			double likelihood_additional_param,
 			const char* matrix_inversion_method,
-			int seed,
-			int num_parallel_threads) {
-			if (num_parallel_threads > 0) {
-				Eigen::setNbThreads(num_parallel_threads);
-				omp_set_num_threads(num_parallel_threads);
-			}
+			int seed) {
 			CHECK(num_data > 0);
 			num_data_ = num_data;
 			//Initialize RNG
@@ -281,10 +278,8 @@ namespace GPBoost {
 						re_comps_cluster_i, nearest_neighbors_cluster_i, dist_obs_neighbors_cluster_i, dist_between_neighbors_cluster_i,
 						entries_init_B_cluster_i, z_outer_z_obs_neighbors_cluster_i, only_one_GP_calculations_on_RE_scale_, has_duplicates_coords_,
 						vecchia_ordering_, num_neighbors_, vecchia_neighbor_selection_, true, rng_, num_gp_rand_coef_, num_gp_total_, num_comps_total_, gauss_likelihood_,
-						std::string(cov_fct), cov_fct_shape, cov_fct_taper_range, cov_fct_taper_shape, gp_approx_ == "tapering", save_distances_isotropic_cov_fct_Vecchia_);
+						std::string(cov_fct), cov_fct_shape, cov_fct_taper_range, cov_fct_taper_shape, gp_approx_ == "tapering", false);//distances are cached in 'ApplyVecchiaDistanceCachePolicy'
 					nearest_neighbors_.insert({ cluster_i, nearest_neighbors_cluster_i });
-					dist_obs_neighbors_.insert({ cluster_i, dist_obs_neighbors_cluster_i });
-					dist_between_neighbors_.insert({ cluster_i, dist_between_neighbors_cluster_i });
 					entries_init_B_.insert({ cluster_i, entries_init_B_cluster_i });
 					z_outer_z_obs_neighbors_.insert({ cluster_i, z_outer_z_obs_neighbors_cluster_i });
 					re_comps_vecchia_.insert({ cluster_i, re_comps_cluster_i });
@@ -311,6 +306,9 @@ namespace GPBoost {
 					re_comps_.insert({ cluster_i, re_comps_cluster_i });
 				}
 			}//end loop over clusters
+			if (gp_approx_ == "vecchia") {
+				ApplyVecchiaDistanceCachePolicy();
+			}
 			//Create matrices Z and ZtZ if Woodbury identity is used (used only if there are only grouped REs and no GPs)
 			if (only_grouped_REs_use_woodbury_identity_ && !only_one_grouped_RE_calculations_on_RE_scale_) {
 				InitializeMatricesForOnlyGroupedREsUseWoodburyIdentity();
@@ -323,6 +321,12 @@ namespace GPBoost {
 			InitializeDefaultSettings();
 			CheckCompatibilitySpecialOptions();
 			SetMatrixInversionPropertiesLikelihood();
+			rng_init_ = rng_;
+			if (ShouldRedetermineNearestNeighborsVecchia(true)) {
+				// the neighbors are changed during the estimation, save them such that they can be restored in 'ResetEstimation'
+				nearest_neighbors_init_ = nearest_neighbors_;
+				entries_init_B_init_ = entries_init_B_;
+			}
 		}//end REModelTemplate
 
 		/*! \brief Destructor */
@@ -342,6 +346,97 @@ namespace GPBoost {
 			return(gauss_likelihood_);
 		}
 
+		/*!
+		* \brief Rough estimate of the peak memory (in bytes) of this model
+		* \param num_data_pred Number of prediction points
+		* \param predict_cov_mat If true, the predictive covariance matrix is calculated
+		* \param fitc_streaming_block_size Number of rows of the blocks of the cross-covariance matrix for the FITC approximation (0 = stored, < 0 = current setting)
+		*/
+		MemoryEstimate EstimateMemory(data_size_t num_data_pred,
+			bool predict_cov_mat,
+			data_size_t fitc_streaming_block_size = -1) const {
+			if (fitc_streaming_block_size < 0) {
+				fitc_streaming_block_size = FITCStreaming() ? fitc_streaming_block_size_ : 0;
+			}
+			int num_neighbors = 0, num_neighbors_pred = 0, num_ind_points = 0;
+			if (gp_approx_ == "vecchia") {
+				num_neighbors = num_neighbors_;
+				num_neighbors_pred = num_neighbors_pred_;
+			}
+			else if (gp_approx_ == "fitc" || gp_approx_ == "full_scale_tapering") {
+				num_ind_points = num_ind_points_;
+			}
+			return(EstimateMemoryREModel(num_data_, (int)num_re_group_total_, (int)num_gp_total_, dim_gp_coords_, gp_approx_,
+				num_neighbors, num_neighbors_pred, num_ind_points, gauss_likelihood_, matrix_inversion_method_ == "iterative",
+				num_rand_vec_trace_, (int)num_cov_par_, num_data_pred, predict_cov_mat, fitc_streaming_block_size));
+		}
+
+		/*! \brief Returns true if the cross-covariance matrix of the FITC approximation can be calculated in blocks of rows (see 'CheckFITCStreaming') */
+		bool FITCStreamingSupported() const {
+			return(gp_approx_ == "fitc" && gauss_likelihood_ && matrix_inversion_method_ == "cholesky" && num_comps_total_ == 1);
+		}
+
+		/*!
+		* \brief Calculate the cross-covariance matrix of the FITC approximation in blocks of rows instead of storing it (same as 'fitc_streaming_block_size' in SetOptimConfig)
+		* \param block_size Number of rows per block
+		*/
+		void SetFITCStreamingBlockSize(data_size_t block_size) {
+			CHECK(block_size > 0);
+			fitc_streaming_block_size_ = std::min(block_size, num_data_);
+			CheckFITCStreaming();
+		}
+
+		/*!
+		* \brief Returns true if the predictive means and variances of a prediction point do not depend on the other prediction points.
+		*		In this case, predictions can be made separately for chunks of prediction points
+		* \param predict_var If true, predictive variances are calculated
+		*/
+		bool PredictionsArePointwise(bool predict_var) const {
+			if (predict_var && gp_approx_ == "full_scale_tapering" && matrix_inversion_method_ == "iterative") {
+				// the stochastic estimate of the predictive variances uses random vectors over all prediction points
+				return(false);
+			}
+			if (gp_approx_ == "vecchia") {
+				return(vecchia_pred_type_ == "order_obs_first_cond_obs_only" || vecchia_pred_type_ == "latent_order_obs_first_cond_obs_only");
+			}
+			return(true);
+		}
+
+		/*!
+		* \brief Set whether simulation-based predictive variances of consecutive predictions use the same random vectors.
+		*		This is used when predictions are made in chunks such that the results do not depend on the chunking
+		* \param reuse If true, the random number generators of the likelihoods are reset to their states at the beginning of the first simulation after this call
+		*/
+		void SetReuseRandVecPredVar(bool reuse) {
+			if (!gauss_likelihood_) {
+				for (const auto& cluster_i : unique_clusters_) {
+					likelihood_[cluster_i]->SetReuseRandVecPredVar(reuse);
+				}
+			}
+		}
+
+		/*!
+		* \brief Set the policy for caching the distances among locations and their nearest neighbors for the Vecchia approximation
+		*		with isotropic covariance functions. If the distances are not cached, they are recalculated from the coordinates in every iteration
+		* \param policy "auto": the distances are cached in double precision if this needs at most 'budget_bytes' of memory,
+		*		otherwise they are not cached. "double" / "float": the distances are always cached in double / single precision
+		*		(single precision needs to be requested explicitly). "none": the distances are not cached
+		* \param budget_bytes Memory budget in bytes for the "auto" policy. If budget_bytes <= 0, the current budget is kept
+		*/
+		void SetVecchiaDistanceCache(const char* policy,
+			double budget_bytes) {
+			if (SUPPORTED_VECCHIA_DISTANCE_CACHE_.find(string_t(policy)) == SUPPORTED_VECCHIA_DISTANCE_CACHE_.end()) {
+				Log::REFatal("Distance cache policy '%s' is not supported ", policy);
+			}
+			vecchia_distance_cache_ = string_t(policy);
+			if (budget_bytes > 0.) {
+				vecchia_distance_cache_budget_ = budget_bytes;
+			}
+			if (gp_approx_ == "vecchia") {
+				ApplyVecchiaDistanceCachePolicy();
+			}
+		}
+
 		/*!
 		* \brief Returns the type of likelihood
 		*/
@@ -349,6 +444,35 @@ namespace GPBoost {
 			return(likelihood_[unique_clusters_[0]]->GetLikelihood());
 		}
 
+		/*!
+		* \brief Reset the state of the parameter estimation such that the model can be fitted again as if it had been newly created.
+		*		The structures that depend only on the data (random effects components, nearest neighbors, incidence matrices, etc.) are kept.
+		*		Nearest neighbors that have been redetermined during the estimation (see 'RedetermineNearestNeighborsVecchia') and
+		*		the state of the random number generator are reset to the ones after the construction of the model
+		*/
+		void ResetEstimation() {
+			rng_ = rng_init_;
+			if (!nearest_neighbors_init_.empty()) {
+				nearest_neighbors_ = nearest_neighbors_init_;
+				entries_init_B_ = entries_init_B_init_;
+			}
+			InitializeLikelihoods(GetLikelihood());//this also resets the mode and the auxiliary parameters
+			SetMatrixInversionPropertiesLikelihood();
+			num_iter_ = 0;
+			num_ll_evaluations_ = 0;
+			first_update_ = false;
+			model_has_been_estimated_ = false;
+			y_has_been_set_ = false;
+			y_aux_has_been_calculated_ = false;
+			covariance_matrix_has_been_factorized_ = false;
+			solution_for_trace_grouped_REs_calculated_.clear();
+			m_bfgs_ = LBFGSpp::BFGSMat<double>();
+			lr_cov_after_first_iteration_ = lr_cov_init_;
+			lr_cov_after_first_optim_boosting_iteration_ = lr_cov_init_;
+			lr_aux_pars_after_first_iteration_ = lr_aux_pars_init_;
+			lr_aux_pars_after_first_optim_boosting_iteration_ = lr_aux_pars_init_;
+		}
+
 		/*!
 		* \brief Set / change the type of likelihood
 		* \param likelihood Likelihood name
@@ -466,6 +590,7 @@ namespace GPBoost {
 		* \param seed_rand_vec_trace Seed number to generate random vectors (e.g. Rademacher) for stochastic approximation of the trace of a matrix
 		* \param piv_chol_rank Rank of the pivoted cholseky decomposition used as preconditioner of the conjugate gradient algorithm
 		* \param estimate_aux_pars If true, any additional parameters for non-Gaussian likelihoods are also estimated (e.g., shape parameter of gamma likelihood)
+		* \param fitc_streaming_block_size If > 0, the cross-covariance matrix between the data and the inducing points is not saved for gp_approx = "fitc" but generated on the fly in blocks of this many rows
 		*/
 		void SetOptimConfig(double lr,
 			double acc_rate_cov,
@@ -487,7 +612,8 @@ namespace GPBoost {
 			const char* cg_preconditioner_type,
 			int seed_rand_vec_trace,
 			int piv_chol_rank,
-			bool estimate_aux_pars) {
+			bool estimate_aux_pars,
+			int fitc_streaming_block_size) {
 			lr_cov_init_ = lr;
 			lr_cov_after_first_iteration_ = lr;
 			lr_cov_after_first_optim_boosting_iteration_ = lr;
@@ -571,6 +697,11 @@ namespace GPBoost {
 				SetMatrixInversionPropertiesLikelihood();
 			}
 			estimate_aux_pars_ = estimate_aux_pars;
+			if (fitc_streaming_block_size < 0) {
+				Log::REFatal("'fitc_streaming_block_size' cannot be negative ");
+			}
+			fitc_streaming_block_size_ = fitc_streaming_block_size;
+			CheckFITCStreaming();
 			if (lr > 0) {
 				lr_aux_pars_init_ = lr;
 				lr_aux_pars_after_first_iteration_ = lr;
@@ -1445,26 +1576,27 @@ namespace GPBoost {
 					grad_cov_aux_par = include_error_var ? vec_t::Zero(num_cov_par_) : vec_t::Zero(num_cov_par_ - 1);
 					int first_cov_par = include_error_var ? 1 : 0;
 					for (const auto& cluster_i : unique_clusters_) {
+						IterationArena::Scope arena_scope(arena_);
 						if (gp_approx_ == "vecchia") {//Vechia approximation
-							vec_t u(num_data_per_cluster_[cluster_i]);
-							vec_t uk(num_data_per_cluster_[cluster_i]);
+							arena_vec_t u = arena_.Vec(num_data_per_cluster_[cluster_i]);
+							arena_vec_t uk = arena_.Vec(num_data_per_cluster_[cluster_i]);
+							u.noalias() = B_[cluster_i] * y_[cluster_i];
 							if (include_error_var) {
-								u = B_[cluster_i] * y_[cluster_i];
-								grad_cov_aux_par[0] += -1. * ((double)(u.transpose() * D_inv_[cluster_i] * u)) / cov_pars[0] / 2. + num_data_per_cluster_[cluster_i] / 2.;
-								u = D_inv_[cluster_i] * u;
-							}
-							else {
-								u = D_inv_[cluster_i] * B_[cluster_i] * y_[cluster_i];//TODO: this is already calculated in CalcYAux -> save it there and re-use here?
+								grad_cov_aux_par[0] += -1. * u.dot(u.cwiseProduct(D_inv_[cluster_i].diagonal())) / cov_pars[0] / 2. + num_data_per_cluster_[cluster_i] / 2.;
 							}
+							u.array() *= D_inv_[cluster_i].diagonal().array();//TODO: this is already calculated in CalcYAux -> save it there and re-use here?
 							for (int j = 0; j < num_comps_total_; ++j) {
 								int num_par_comp = re_comps_vecchia_[cluster_i][j]->num_cov_par_;
 								for (int ipar = 0; ipar < num_par_comp; ++ipar) {
-									uk = B_grad_[cluster_i][num_par_comp * j + ipar] * y_[cluster_i];
-									grad_cov_aux_par[first_cov_par + ind_par_[j] - 1 + ipar] += ((uk.dot(u) - 0.5 * u.dot(D_grad_[cluster_i][num_par_comp * j + ipar] * u)) / cov_pars[0] +
+									uk.noalias() = B_grad_[cluster_i][num_par_comp * j + ipar] * y_[cluster_i];
+									grad_cov_aux_par[first_cov_par + ind_par_[j] - 1 + ipar] += ((uk.dot(u) - 0.5 * u.dot(u.cwiseProduct(D_grad_[cluster_i][num_par_comp * j + ipar].diagonal()))) / cov_pars[0] +
 										0.5 * (D_inv_[cluster_i].diagonal()).dot(D_grad_[cluster_i][num_par_comp * j + ipar].diagonal()));
 								}
 							}
 						}//end gp_approx_ == "vecchia"
+						else if (FITCStreaming()) {
+							CalcGradPars_FITC_Streaming_GaussLikelihood_Cluster_i(cov_pars, grad_cov_aux_par, include_error_var, first_cov_par, cluster_i);
+						}// end FITCStreaming()
 						else if (gp_approx_ == "fitc" || gp_approx_ == "full_scale_tapering") {
 							CalcGradPars_FITC_FSA_GaussLikelihood_Cluster_i(cov_pars, grad_cov_aux_par, include_error_var, first_cov_par, cluster_i);
 						}// end gp_approx_ == "fitc" || gp_approx_ == "full_scale_tapering"
@@ -1502,7 +1634,6 @@ namespace GPBoost {
 			else {//not gauss_likelihood_
 				vec_t grad_cov_aux_cluster_i, grad_F;
 				const double* fixed_effects_cluster_i_ptr = nullptr;
-				vec_t fixed_effects_cluster_i;
 				if(calc_cov_aux_par_grad) {
 					CHECK(!include_error_var);
 					int length_cov_grad = num_cov_par_;
@@ -1517,6 +1648,7 @@ namespace GPBoost {
 				}
 				bool calc_grad_aux_par = calc_cov_aux_par_grad && estimate_aux_pars_;
 				for (const auto& cluster_i : unique_clusters_) {
+					IterationArena::Scope arena_scope(arena_);
 					vec_t grad_F_cluster_i;
 					if (calc_beta_grad) {
 						grad_F_cluster_i = vec_t(num_data_per_cluster_[cluster_i]);
@@ -1526,7 +1658,7 @@ namespace GPBoost {
 						fixed_effects_cluster_i_ptr = fixed_effects;
 					}
 					else if (fixed_effects != nullptr) {//more than one cluster and order of samples matters
-						fixed_effects_cluster_i = vec_t(num_data_per_cluster_[cluster_i]);
+						arena_vec_t fixed_effects_cluster_i = arena_.Vec(num_data_per_cluster_[cluster_i]);
 #pragma omp parallel for schedule(static)
 						for (int j = 0; j < num_data_per_cluster_[cluster_i]; ++j) {
 							fixed_effects_cluster_i[j] = fixed_effects[data_indices_per_cluster_[cluster_i][j]];
@@ -1547,7 +1679,8 @@ namespace GPBoost {
 							re_comps_cross_cov_[cluster_i][0]->GetSigmaPtr(), fitc_resid_diag_[cluster_i], re_comps_ip_[cluster_i], re_comps_cross_cov_[cluster_i],
 							calc_cov_aux_par_grad, calc_beta_grad, calc_grad_aux_par,
 							grad_cov_aux_cluster_i.data(), grad_F_cluster_i,
-							grad_cov_aux_cluster_i.data() + num_cov_par_, false, call_for_std_dev_coef);
+							grad_cov_aux_cluster_i.data() + num_cov_par_, false, call_for_std_dev_coef, re_comps_ip_preconditioner_[cluster_i],
+							re_comps_cross_cov_preconditioner_[cluster_i], chol_ip_cross_cov_preconditioner_[cluster_i], chol_fact_sigma_ip_preconditioner_[cluster_i]);
 					}
 					else if (only_grouped_REs_use_woodbury_identity_ && !only_one_grouped_RE_calculations_on_RE_scale_) {
 						likelihood_[cluster_i]->CalcGradNegMargLikelihoodLaplaceApproxGroupedRE(y_[cluster_i].data(), y_int_[cluster_i].data(),
@@ -1654,9 +1787,6 @@ namespace GPBoost {
 					chol_fact_resid_inv.resize(0, 0);
 				}
 				else if (matrix_inversion_method_ == "iterative") {
-					if (gp_approx_ == "fitc") {
-						Log::REFatal("'iterative' methods are not implemented for gp_approx = '%s'. Use 'cholesky' ", gp_approx_.c_str());
-					}
 					// P^-1 * sample vectors
 					if (cg_preconditioner_type_ == "fitc") {
 						const den_mat_t* cross_cov_preconditioner = re_comps_cross_cov_preconditioner_[cluster_i][j]->GetSigmaPtr();
@@ -1769,17 +1899,30 @@ namespace GPBoost {
 							FITC_Diag_grad[ii] -= 2 * sigma_ip_inv_sigma_cross_cov.col(ii).dot((*cross_cov_grad).transpose().col(ii))
 								- sigma_ip_inv_sigma_cross_cov.col(ii).dot(sigma_ip_grad_inv_sigma_cross_cov.col(ii));
 						}
-						sigma_ip_inv_sigma_cross_cov.resize(0, 0);
-						sigma_ip_grad_inv_sigma_cross_cov.resize(0, 0);
 						grad_cov_aux_par[first_cov_par + ind_par_[j] - 1 + ipar] -= 0.5 * y_aux_[cluster_i].dot(FITC_Diag_grad.asDiagonal() * y_aux_[cluster_i]) / cov_pars[0];
-						grad_cov_aux_par[first_cov_par + ind_par_[j] - 1 + ipar] += 0.5 * FITC_Diag_grad.dot(fitc_resid_diag_[cluster_i].cwiseInverse());
-						// Derivative of Woodbury Matrix
-						vec_t fitc_resid_diag_I = fitc_resid_diag_[cluster_i].cwiseInverse();
-						cross_cov_grad_sigma_resid_inv_cross_cov_T = (*cross_cov).transpose() * fitc_resid_diag_I.asDiagonal() * (*cross_cov_grad);
-						sigma_woodbury_grad = cross_cov_grad_sigma_resid_inv_cross_cov_T + cross_cov_grad_sigma_resid_inv_cross_cov_T.transpose();
-						fitc_resid_diag_I.array() *= fitc_resid_diag_I.array();
-						fitc_resid_diag_I.array() *= FITC_Diag_grad.array();
-						sigma_woodbury_grad -= (*cross_cov).transpose() * fitc_resid_diag_I.asDiagonal() * (*cross_cov);
+						if (matrix_inversion_method_ == "cholesky") {
+							sigma_ip_inv_sigma_cross_cov.resize(0, 0);
+							sigma_ip_grad_inv_sigma_cross_cov.resize(0, 0);
+							grad_cov_aux_par[first_cov_par + ind_par_[j] - 1 + ipar] += 0.5 * FITC_Diag_grad.dot(fitc_resid_diag_[cluster_i].cwiseInverse());
+							// Derivative of Woodbury Matrix
+							vec_t fitc_resid_diag_I = fitc_resid_diag_[cluster_i].cwiseInverse();
+							cross_cov_grad_sigma_resid_inv_cross_cov_T = (*cross_cov).transpose() * fitc_resid_diag_I.asDiagonal() * (*cross_cov_grad);
+							sigma_woodbury_grad = cross_cov_grad_sigma_resid_inv_cross_cov_T + cross_cov_grad_sigma_resid_inv_cross_cov_T.transpose();
+							fitc_resid_diag_I.array() *= fitc_resid_diag_I.array();
+							fitc_resid_diag_I.array() *= FITC_Diag_grad.array();
+							sigma_woodbury_grad -= (*cross_cov).transpose() * fitc_resid_diag_I.asDiagonal() * (*cross_cov);
+						}
+						else if (matrix_inversion_method_ == "iterative") {
+							// Stochastic trace of Psi^-1 * Psi_grad using Psi^-1 * (sample vectors) from the Lanczos algorithm and P^-1 * (sample vectors)
+							// Note: no variance reduction is done since the preconditioner has different inducing points
+							den_mat_t sigma_ip_inv_sigma_cross_cov_Z = sigma_ip_inv_sigma_cross_cov * rand_vec_probe_P_inv;
+							den_mat_t sigma_grad_Z = FITC_Diag_grad.asDiagonal() * rand_vec_probe_P_inv;
+							sigma_grad_Z += (*cross_cov_grad) * sigma_ip_inv_sigma_cross_cov_Z +
+								sigma_ip_inv_sigma_cross_cov.transpose() * ((*cross_cov_grad).transpose() * rand_vec_probe_P_inv) -
+								sigma_ip_inv_sigma_cross_cov.transpose() * (sigma_ip_stable_grad * sigma_ip_inv_sigma_cross_cov_Z);
+							vec_t sample_Sigma = (solution_for_trace_[cluster_i].cwiseProduct(sigma_grad_Z)).colwise().sum();
+							grad_cov_aux_par[first_cov_par + ind_par_[j] - 1 + ipar] += 0.5 * sample_Sigma.mean();
+						}
 					}
 					// sigma_woodbury^-1 * sigma_woodbury_grad
 					if (matrix_inversion_method_ == "cholesky") {
@@ -1791,6 +1934,110 @@ namespace GPBoost {
 			}//end loop over comps						
 		}//end CalcGradPars_FITC_FSA_GaussLikelihood_Cluster_i
 
+		/*!
+		* \brief Calculate gradient wrt the covariance and auxiliary parameters for the FITC approximation for Gaussian likelihoods 
+		*	when the cross-covariance matrix is not stored but calculated in blocks of rows (see 'fitc_streaming_block_size_').
+		*	All quantities that depend on the cross-covariance are accumulated in one pass over the blocks of rows.
+		*	The gradient wrt covariance and auxiliary parameters is calculated on the log-scale
+		*/
+		void CalcGradPars_FITC_Streaming_GaussLikelihood_Cluster_i(const vec_t& cov_pars,
+			vec_t& grad_cov_aux_par,
+			bool include_error_var,
+			int first_cov_par,
+			data_size_t cluster_i) {
+			CHECK(FITCStreaming());
+			CHECK(gauss_likelihood_);
+			CHECK(matrix_inversion_method_ == "cholesky");
+			CHECK(num_comps_total_ == 1);
+			if (include_error_var) {
+				grad_cov_aux_par[0] += -1. * ((double)(y_[cluster_i].transpose() * y_aux_[cluster_i])) / cov_pars[0] / 2. + num_data_per_cluster_[cluster_i] / 2.;
+			}
+			int num_par_comp = re_comps_ip_[cluster_i][0]->num_cov_par_;
+			int num_ip = (int)chol_fact_sigma_ip_[cluster_i].rows();
+			std::vector<den_mat_t> sigma_ip_stable_grad(num_par_comp);
+			for (int ipar = 0; ipar < num_par_comp; ++ipar) {
+				sigma_ip_stable_grad[ipar] = *(re_comps_ip_[cluster_i][0]->GetZSigmaZtGrad(ipar, true, 0.));
+			}
+			// Quantities accumulated over blocks of rows of the cross-covariance matrix
+			vec_t cross_covT_y_aux = vec_t::Zero(num_ip);// cross_cov^T * y_aux
+			std::vector<vec_t> cross_cov_gradT_y_aux(num_par_comp, vec_t::Zero(num_ip));// cross_cov_grad^T * y_aux
+			std::vector<den_mat_t> sigma_woodbury_grad(num_par_comp, den_mat_t::Zero(num_ip, num_ip));// derivative of cross_cov^T * sigma_resid^-1 * cross_cov
+			std::vector<double> grad_diag(num_par_comp, 0.);// terms involving the derivative of the diagonal part
+			data_size_t num_REs = num_data_per_cluster_[cluster_i];
+			den_mat_t cross_cov_block, cross_cov_grad_block;
+			for (data_size_t row_start = 0; row_start < num_REs; row_start += fitc_streaming_block_size_) {
+				data_size_t num_rows = std::min(fitc_streaming_block_size_, num_REs - row_start);
+				re_comps_cross_cov_[cluster_i][0]->CalcSigmaRows(row_start, num_rows, cross_cov_block);
+				const vec_t y_aux_block = y_aux_[cluster_i].segment(row_start, num_rows);
+				const vec_t fitc_resid_diag_I_block = fitc_resid_diag_[cluster_i].segment(row_start, num_rows).cwiseInverse();
+				cross_covT_y_aux += cross_cov_block.transpose() * y_aux_block;
+				den_mat_t sigma_ip_inv_cross_cov_blockT = chol_fact_sigma_ip_[cluster_i].solve(cross_cov_block.transpose());
+				for (int ipar = 0; ipar < num_par_comp; ++ipar) {
+					re_comps_cross_cov_[cluster_i][0]->CalcSigmaGradRows(ipar, true, 0., cross_cov_block, row_start, cross_cov_grad_block);
+					cross_cov_gradT_y_aux[ipar] += cross_cov_grad_block.transpose() * y_aux_block;
+					// Derivative of diagonal part
+					vec_t FITC_Diag_grad(num_rows);
+					FITC_Diag_grad.array() = sigma_ip_stable_grad[ipar].coeffRef(0, 0);
+					den_mat_t sigma_ip_grad_inv_cross_cov_blockT = sigma_ip_stable_grad[ipar] * sigma_ip_inv_cross_cov_blockT;
+#pragma omp parallel for schedule(static)
+					for (int ii = 0; ii < num_rows; ++ii) {
+						FITC_Diag_grad[ii] -= 2 * sigma_ip_inv_cross_cov_blockT.col(ii).dot(cross_cov_grad_block.row(ii).transpose())
+							- sigma_ip_inv_cross_cov_blockT.col(ii).dot(sigma_ip_grad_inv_cross_cov_blockT.col(ii));
+					}
+					grad_diag[ipar] += -0.5 * y_aux_block.dot(FITC_Diag_grad.asDiagonal() * y_aux_block) / cov_pars[0] + 0.5 * FITC_Diag_grad.dot(fitc_resid_diag_I_block);
+					// Derivative of Woodbury Matrix
+					den_mat_t cross_cov_grad_sigma_resid_inv_cross_cov_T = cross_cov_block.transpose() * (fitc_resid_diag_I_block.asDiagonal() * cross_cov_grad_block);
+					sigma_woodbury_grad[ipar] += cross_cov_grad_sigma_resid_inv_cross_cov_T + cross_cov_grad_sigma_resid_inv_cross_cov_T.transpose();
+					vec_t diag_scaling = fitc_resid_diag_I_block.cwiseProduct(fitc_resid_diag_I_block).cwiseProduct(FITC_Diag_grad);
+					sigma_woodbury_grad[ipar] -= cross_cov_block.transpose() * (diag_scaling.asDiagonal() * cross_cov_block);
+				}
+			}
+			// sigma_ip^-1 * sigma_cross_cov * sigma^-1 * y
+			vec_t sigma_ip_inv_cross_cov_y_aux = chol_fact_sigma_ip_[cluster_i].solve(cross_covT_y_aux);
+			for (int ipar = 0; ipar < num_par_comp; ++ipar) {
+				den_mat_t sigma_ip_inv_sigma_ip_stable_grad = chol_fact_sigma_ip_[cluster_i].solve(sigma_ip_stable_grad[ipar]);
+				grad_cov_aux_par[first_cov_par + ind_par_[0] - 1 + ipar] -= 0.5 * sigma_ip_inv_sigma_ip_stable_grad.trace();
+				grad_cov_aux_par[first_cov_par + ind_par_[0] - 1 + ipar] += ((0.5 * sigma_ip_inv_cross_cov_y_aux.dot(sigma_ip_stable_grad[ipar] * sigma_ip_inv_cross_cov_y_aux)
+					- cross_cov_gradT_y_aux[ipar].dot(sigma_ip_inv_cross_cov_y_aux)) / cov_pars[0]);
+				grad_cov_aux_par[first_cov_par + ind_par_[0] - 1 + ipar] += grad_diag[ipar];
+				// sigma_woodbury^-1 * sigma_woodbury_grad
+				sigma_woodbury_grad[ipar] += sigma_ip_stable_grad[ipar];
+				den_mat_t sigma_woodbury_inv_sigma_woodbury_grad = chol_fact_sigma_woodbury_[cluster_i].solve(sigma_woodbury_grad[ipar]);
+				grad_cov_aux_par[first_cov_par + ind_par_[0] - 1 + ipar] += 0.5 * ((sigma_woodbury_inv_sigma_woodbury_grad.trace()));
+			}
+		}//end CalcGradPars_FITC_Streaming_GaussLikelihood_Cluster_i
+
+		/*!
+		* \brief Calculate Psi^-1 * rhs for the FITC approximation when the cross-covariance matrix is calculated in blocks of rows (see 'fitc_streaming_block_size_')
+		*		using the Woodbury identity Psi^-1 = D^-1 - D^-1 * cross_cov * sigma_woodbury^-1 * cross_cov^T * D^-1
+		* \param cluster_i Cluster index
+		* \param rhs Right-hand side (vector or matrix)
+		* \param[out] psi_inv_rhs Psi^-1 * rhs
+		*/
+		template <typename T_rhs>
+		void CalcPsiInvRhsFITCStreaming(data_size_t cluster_i,
+			const T_rhs& rhs,
+			T_rhs& psi_inv_rhs) {
+			CHECK(FITCStreaming());
+			data_size_t num_REs = (data_size_t)rhs.rows();
+			const vec_t& fitc_resid_diag = fitc_resid_diag_[cluster_i];
+			T_rhs cross_covT_resid_inv_rhs = T_rhs::Zero(chol_fact_sigma_ip_[cluster_i].rows(), rhs.cols());
+			den_mat_t cross_cov_block;
+			for (data_size_t row_start = 0; row_start < num_REs; row_start += fitc_streaming_block_size_) {
+				data_size_t num_rows = std::min(fitc_streaming_block_size_, num_REs - row_start);
+				re_comps_cross_cov_[cluster_i][0]->CalcSigmaRows(row_start, num_rows, cross_cov_block);
+				cross_covT_resid_inv_rhs += cross_cov_block.transpose() * (fitc_resid_diag.segment(row_start, num_rows).cwiseInverse().asDiagonal() * rhs.middleRows(row_start, num_rows));
+			}
+			T_rhs sigma_woodbury_inv_cross_covT_resid_inv_rhs = chol_fact_sigma_woodbury_[cluster_i].solve(cross_covT_resid_inv_rhs);
+			psi_inv_rhs.resize(rhs.rows(), rhs.cols());
+			for (data_size_t row_start = 0; row_start < num_REs; row_start += fitc_streaming_block_size_) {
+				data_size_t num_rows = std::min(fitc_streaming_block_size_, num_REs - row_start);
+				re_comps_cross_cov_[cluster_i][0]->CalcSigmaRows(row_start, num_rows, cross_cov_block);
+				psi_inv_rhs.middleRows(row_start, num_rows) = fitc_resid_diag.segment(row_start, num_rows).cwiseInverse().asDiagonal() * 
+					(rhs.middleRows(row_start, num_rows) - cross_cov_block * sigma_woodbury_inv_cross_covT_resid_inv_rhs);
+			}
+		}//end CalcPsiInvRhsFITCStreaming
+
 		/*!
 		* \brief Calculate gradient wrt the covariance and auxiliary parameters when having only grouped REs for Gaussian likelihoods
 		*	The gradient wrt covariance and auxiliary parameters is calculated on the log-scale
@@ -1813,31 +2060,66 @@ namespace GPBoost {
 				LInvZtZj_[cluster_i].clear();
 				LInvZtZj_cluster_i = std::vector<T_mat>(num_comps_total_);
 			}
+			// For iterative methods, the traces are approximated stochastically using (Sigma^-1 + Z^T * Z)^-1 * (probe vectors) from the Lanczos algorithm
+			//	(see 'CalcLogDetSigmaIPlusZtZStochastic'), except if the Cholesky factor is needed anyway for the Fisher information
+			const bool stochastic_trace = GroupedREsIterative() && !save_psi_inv_for_FI;
+			den_mat_t rand_vec_probe_P_inv;
+			if (stochastic_trace) {
+				if (!solution_for_trace_grouped_REs_calculated_[cluster_i]) {
+					CalcLogDetSigmaIPlusZtZStochastic(cluster_i);
+				}
+				PreconditionerSolveGroupedRE<T_mat, den_mat_t>(SigmaI_plus_ZtZ_[cluster_i], diag_SigmaI_plus_ZtZ_[cluster_i],
+					cg_preconditioner_type_, rand_vec_probe_[cluster_i], rand_vec_probe_P_inv);
+			}
+			else if (GroupedREsIterative()) {
+				CalcCholFactGroupedREsIterative();
+			}
 			for (int j = 0; j < num_comps_total_; ++j) {
 				sp_mat_t* Z_j = re_comps_[cluster_i][j]->GetZ();
 				vec_t y_tilde_j = (*Z_j).transpose() * y_[cluster_i];
 				vec_t y_tilde2_j = (*Z_j).transpose() * y_tilde2_[cluster_i];
 				double yTPsiIGradPsiPsiIy = y_tilde_j.transpose() * y_tilde_j - 2. * (double)(y_tilde_j.transpose() * y_tilde2_j) + y_tilde2_j.transpose() * y_tilde2_j;
 				yTPsiIGradPsiPsiIy *= cov_pars[j + 1];
-				T_mat LInvZtZj;
-				if (num_re_group_total_ == 1 && num_comps_total_ == 1) {//only one random effect -> ZtZ_ == ZtZj_ and L_inv are diagonal  
-					LInvZtZj = ZtZ_[cluster_i];
-					LInvZtZj.diagonal().array() /= sqrt_diag_SigmaI_plus_ZtZ_[cluster_i].array();
+				double trace_PsiInvGradPsi;
+				if (stochastic_trace) {
+					// trace(Psi^-1 * dPsi / dlog(sigma2_j)) = n_j - trace((M^-1)_jj) / sigma2_j, M = Sigma^-1 + Z^T * Z, (M^-1)_jj = diagonal block of M^-1 of component j
+					int num_rand_eff = cum_num_rand_eff_[cluster_i][j + 1] - cum_num_rand_eff_[cluster_i][j];
+					vec_t sample_MInv = (solution_for_trace_[cluster_i].middleRows(cum_num_rand_eff_[cluster_i][j], num_rand_eff).cwiseProduct(
+						rand_vec_probe_P_inv.middleRows(cum_num_rand_eff_[cluster_i][j], num_rand_eff))).colwise().sum();
+					double trace_MInv_j = sample_MInv.mean();
+					// Variance reduction using the exactly known trace of the diagonal preconditioner. This is not done for the "ssor" preconditioner
+					//	since the diagonal of P^-1 = (D + L)^-T * D * (D + L)^-1 is not available in closed form
+					if (cg_preconditioner_type_ == "diagonal") {
+						vec_t sample_P = rand_vec_probe_P_inv.middleRows(cum_num_rand_eff_[cluster_i][j], num_rand_eff).colwise().squaredNorm();
+						double Tr_P_stoch = sample_P.mean();
+						double Tr_P = diag_SigmaI_plus_ZtZ_[cluster_i].segment(cum_num_rand_eff_[cluster_i][j], num_rand_eff).cwiseInverse().sum();
+						double c_opt;
+						CalcOptimalC(sample_MInv, sample_P, trace_MInv_j, Tr_P, c_opt);
+						trace_MInv_j += c_opt * (Tr_P - Tr_P_stoch);
+					}
+					trace_PsiInvGradPsi = num_rand_eff - trace_MInv_j / cov_pars[j + 1];
 				}
 				else {
-					// Note: the following is often the bottleneck (= slower than Cholesky dec.) when there are multiple REs and the number of random effects is large
-					if (CholeskyHasPermutation<T_chol>(chol_facts_[cluster_i])) {
-						TriangularSolve<T_mat, sp_mat_t, T_mat>(chol_facts_[cluster_i].CholFactMatrix(), P_ZtZj_[cluster_i][j], LInvZtZj, false);
+					T_mat LInvZtZj;
+					if (num_re_group_total_ == 1 && num_comps_total_ == 1) {//only one random effect -> ZtZ_ == ZtZj_ and L_inv are diagonal  
+						LInvZtZj = ZtZ_[cluster_i];
+						LInvZtZj.diagonal().array() /= sqrt_diag_SigmaI_plus_ZtZ_[cluster_i].array();
 					}
 					else {
-						TriangularSolve<T_mat, sp_mat_t, T_mat>(chol_facts_[cluster_i].CholFactMatrix(), ZtZj_[cluster_i][j], LInvZtZj, false);
+						// Note: the following is often the bottleneck (= slower than Cholesky dec.) when there are multiple REs and the number of random effects is large
+						if (CholeskyHasPermutation<T_chol>(chol_facts_[cluster_i])) {
+							TriangularSolve<T_mat, sp_mat_t, T_mat>(chol_facts_[cluster_i].CholFactMatrix(), P_ZtZj_[cluster_i][j], LInvZtZj, false);
+						}
+						else {
+							TriangularSolve<T_mat, sp_mat_t, T_mat>(chol_facts_[cluster_i].CholFactMatrix(), ZtZj_[cluster_i][j], LInvZtZj, false);
+						}
 					}
+					if (save_psi_inv_for_FI) {//save for latter use when calculating the Fisher information
+						LInvZtZj_cluster_i[j] = LInvZtZj;
+					}
+					trace_PsiInvGradPsi = Zj_square_sum_[cluster_i][j] - LInvZtZj.squaredNorm();
+					trace_PsiInvGradPsi *= cov_pars[j + 1];
 				}
-				if (save_psi_inv_for_FI) {//save for latter use when calculating the Fisher information
-					LInvZtZj_cluster_i[j] = LInvZtZj;
-				}
-				double trace_PsiInvGradPsi = Zj_square_sum_[cluster_i][j] - LInvZtZj.squaredNorm();
-				trace_PsiInvGradPsi *= cov_pars[j + 1];
 				grad_cov_aux_par[first_cov_par + j] += -1. * yTPsiIGradPsiPsiIy / cov_pars[0] / 2. + trace_PsiInvGradPsi / 2.;
 			}//end loop over comps
 			if (save_psi_inv_for_FI) {
@@ -2019,6 +2301,7 @@ namespace GPBoost {
 		*/
 		void CalcCovFactorOrModeAndNegLL(const vec_t& cov_pars,
 			const double* fixed_effects) {
+			arena_.Consolidate();
 			SetCovParsComps(cov_pars);
 			CalcCovFactor(true, 1.);
 			if (gauss_likelihood_) {
@@ -2182,7 +2465,7 @@ namespace GPBoost {
 								GenRandVecNormal(cg_generator_, rand_vec_probe_[cluster_i]);
 								// Sample probe vectors from N(0,P)
 								if (cg_preconditioner_type_ == "fitc") {
-									rand_vec_probe_low_rank_[cluster_i].resize(num_ind_points_, num_rand_vec_trace_);
+									rand_vec_probe_low_rank_[cluster_i].resize(chol_ip_cross_cov_preconditioner_[cluster_i].rows(), num_rand_vec_trace_);
 									GenRandVecNormal(cg_generator_, rand_vec_probe_low_rank_[cluster_i]);
 									rand_vec_probe_P_[cluster_i] = rand_vec_probe_[cluster_i];
 								}
@@ -2195,7 +2478,6 @@ namespace GPBoost {
 								rand_vec_probe_[cluster_i] = chol_ip_cross_cov_Z + diagonal_approx_preconditioner_[cluster_i].cwiseSqrt().asDiagonal() * rand_vec_probe_P_[cluster_i];
 							}
 							const den_mat_t* cross_cov = re_comps_cross_cov_[cluster_i][0]->GetSigmaPtr();
-							std::shared_ptr<T_mat> sigma_resid = re_comps_resid_[cluster_i][0]->GetZSigmaZt();
 							// Initialize Solution Sigma^-1 (u_1,...,u_t) 
 							solution_for_trace_[cluster_i].resize(num_data_per_cluster_[cluster_i], num_rand_vec_trace_);
 							solution_for_trace_[cluster_i].setZero();
@@ -2207,15 +2489,26 @@ namespace GPBoost {
 							std::vector<vec_t> Tdiags_(num_rand_vec_trace_, vec_t(cg_max_num_it_tridiag));
 							std::vector<vec_t> Tsubdiags_(num_rand_vec_trace_, vec_t(cg_max_num_it_tridiag - 1));
 							// Conjuagte Gradient with Lanczos
-							const den_mat_t* cross_cov_preconditioner;
-							if (cg_preconditioner_type_ == "fitc") {
-								cross_cov_preconditioner = re_comps_cross_cov_preconditioner_[cluster_i][0]->GetSigmaPtr();
+							if (gp_approx_ == "fitc") {
+								const den_mat_t* cross_cov_preconditioner = cross_cov;
+								if (cg_preconditioner_type_ == "fitc") {
+									cross_cov_preconditioner = re_comps_cross_cov_preconditioner_[cluster_i][0]->GetSigmaPtr();
+								}
+								CGTridiagFITC(fitc_resid_diag_[cluster_i], *cross_cov, chol_fact_sigma_ip_[cluster_i], rand_vec_probe_[cluster_i],
+									Tdiags_, Tsubdiags_, solution_for_trace_[cluster_i], NaN_found, num_data_per_cluster_[cluster_i],
+									num_rand_vec_trace_, cg_max_num_it_tridiag, cg_delta_conv_, cg_preconditioner_type_,
+									*cross_cov_preconditioner, chol_fact_woodbury_preconditioner_[cluster_i], diagonal_approx_inv_preconditioner_[cluster_i]);
+							}
+							else if (cg_preconditioner_type_ == "fitc") {
+								std::shared_ptr<T_mat> sigma_resid = re_comps_resid_[cluster_i][0]->GetZSigmaZt();
+								const den_mat_t* cross_cov_preconditioner = re_comps_cross_cov_preconditioner_[cluster_i][0]->GetSigmaPtr();
 								CGTridiagFSA<T_mat>(*sigma_resid, *cross_cov_preconditioner, chol_ip_cross_cov_[cluster_i], rand_vec_probe_[cluster_i],
 									Tdiags_, Tsubdiags_, solution_for_trace_[cluster_i], NaN_found, num_data_per_cluster_[cluster_i],
 									num_rand_vec_trace_, cg_max_num_it_tridiag, cg_delta_conv_, cg_preconditioner_type_,
 									chol_fact_woodbury_preconditioner_[cluster_i], diagonal_approx_inv_preconditioner_[cluster_i]);
 							}
 							else {
+								std::shared_ptr<T_mat> sigma_resid = re_comps_resid_[cluster_i][0]->GetZSigmaZt();
 								CGTridiagFSA<T_mat>(*sigma_resid, *cross_cov, chol_ip_cross_cov_[cluster_i], rand_vec_probe_[cluster_i],
 									Tdiags_, Tsubdiags_, solution_for_trace_[cluster_i], NaN_found, num_data_per_cluster_[cluster_i],
 									num_rand_vec_trace_, cg_max_num_it_tridiag, cg_delta_conv_, cg_preconditioner_type_,
@@ -2242,6 +2535,9 @@ namespace GPBoost {
 							if (num_re_group_total_ == 1 && num_comps_total_ == 1) {
 								log_det_Psi_ += (2. * sqrt_diag_SigmaI_plus_ZtZ_[cluster_i].array().log().sum());
 							}
+							else if (GroupedREsIterative()) {
+								log_det_Psi_ += CalcLogDetSigmaIPlusZtZStochastic(cluster_i);
+							}
 							else {
 								log_det_Psi_ += (2. * chol_facts_[cluster_i].CholFactMatrix().diagonal().array().log().sum());
 							}
@@ -2478,6 +2774,9 @@ namespace GPBoost {
 					num_neighbors_pred_ = num_neighbors_pred;
 				}
 			}
+			if (nsim_var_pred > 0) {
+				nsim_var_pred_ = nsim_var_pred;
+			}
 			if (matrix_inversion_method_ == "iterative") {
 				if (cg_delta_conv_pred > 0) {
 					cg_delta_conv_pred_ = cg_delta_conv_pred;
@@ -2487,9 +2786,6 @@ namespace GPBoost {
 				}
 				SetMatrixInversionPropertiesLikelihood();
 			}
-			if (nsim_var_pred > 0) {
-				nsim_var_pred_ = nsim_var_pred;
-			}
 		}//end SetPredictionData
 
 		/*!
@@ -2714,7 +3010,7 @@ namespace GPBoost {
 								entries_init_B_cluster_i, z_outer_z_obs_neighbors_cluster_i, only_one_GP_calculations_on_RE_scale_, has_duplicates_coords_,
 								"none", num_neighbors_pred_, vecchia_neighbor_selection_, false, rng_, num_gp_rand_coef_, num_gp_total_, num_comps_total_, gauss_likelihood_,
 								re_comp_gp_clus0->CovFunctionName(), re_comp_gp_clus0->CovFunctionShape(), re_comp_gp_clus0->CovFunctionTaperRange(), re_comp_gp_clus0->CovFunctionTaperShape(),
-								gp_approx_ == "tapering", save_distances_isotropic_cov_fct_Vecchia_);//TODO: maybe also use ordering for making predictions? (need to check that there are not errors)
+								gp_approx_ == "tapering", false);//TODO: maybe also use ordering for making predictions? (need to check that there are not errors)
 							for (int j = 0; j < num_comps_total_; ++j) {
 								const vec_t pars = cov_pars.segment(ind_par_[j], ind_par_[j + 1] - ind_par_[j]);
 								re_comps_vecchia_cluster_i[j]->SetCovPars(pars);
@@ -2733,7 +3029,7 @@ namespace GPBoost {
 								nearest_neighbors_cluster_i, dist_obs_neighbors_cluster_i, dist_between_neighbors_cluster_i,
 								entries_init_B_cluster_i, z_outer_z_obs_neighbors_cluster_i,
 								B_cluster_i, D_inv_cluster_i, B_grad_cluster_i, D_grad_cluster_i,
-								true, 1., false, num_gp_total_, ind_intercept_gp_, gauss_likelihood_, save_distances_isotropic_cov_fct_Vecchia_);
+								true, 1., false, num_gp_total_, ind_intercept_gp_, gauss_likelihood_, false);
 							//Calculate Psi
 							sp_mat_t D_sqrt(num_data_per_cluster_pred[cluster_i], num_data_per_cluster_pred[cluster_i]);
 							D_sqrt.setIdentity();
@@ -2975,6 +3271,8 @@ namespace GPBoost {
 					if (gp_approx_ == "vecchia") {
 						den_mat_t cov_mat_pred_vecchia_id;
 						std::shared_ptr<RECompGP<den_mat_t>> re_comp_gp = re_comps_vecchia_[cluster_i][ind_intercept_gp_];
+						// Distances are not saved for predictions since the per-point distance matrices are not bounded by 'vecchia_distance_cache_budget_'
+						SetUsePrecomputedDistVecchia(cluster_i, false);
 						if (gauss_likelihood_) {
 							int num_data_tot = num_data_per_cluster_[cluster_i] + num_data_per_cluster_pred[cluster_i];
 							double num_mem_d = ((double)num_neighbors_pred_) * ((double)num_neighbors_pred_) * (double)(num_data_tot)+(double)(num_neighbors_pred_) * (double)(num_data_tot);
@@ -2989,19 +3287,19 @@ namespace GPBoost {
 								CalcPredVecchiaObservedFirstOrder(true, cluster_i, num_data_pred, data_indices_per_cluster_pred,
 									re_comp_gp->coords_, gp_coords_mat_pred, gp_rand_coef_data_pred, num_neighbors_pred_, vecchia_neighbor_selection_,
 									re_comps_vecchia_, ind_intercept_gp_, num_gp_rand_coef_, num_gp_total_, y_[cluster_i], gauss_likelihood_, rng_,
-									predict_cov_mat, predict_var, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, Bpo, Bp, Dp, save_distances_isotropic_cov_fct_Vecchia_);
+									predict_cov_mat, predict_var, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, Bpo, Bp, Dp, false);
 							}
 							else if (vecchia_pred_type_ == "order_obs_first_cond_all") {
 								CalcPredVecchiaObservedFirstOrder(false, cluster_i, num_data_pred, data_indices_per_cluster_pred,
 									re_comp_gp->coords_, gp_coords_mat_pred, gp_rand_coef_data_pred, num_neighbors_pred_, vecchia_neighbor_selection_,
 									re_comps_vecchia_, ind_intercept_gp_, num_gp_rand_coef_, num_gp_total_, y_[cluster_i], gauss_likelihood_, rng_,
-									predict_cov_mat, predict_var, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, Bpo, Bp, Dp, save_distances_isotropic_cov_fct_Vecchia_);
+									predict_cov_mat, predict_var, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, Bpo, Bp, Dp, false);
 							}
 							else if (vecchia_pred_type_ == "order_pred_first") {
 								CalcPredVecchiaPredictedFirstOrder(cluster_i, num_data_pred, data_indices_per_cluster_pred,
 									re_comp_gp->coords_, gp_coords_mat_pred, gp_rand_coef_data_pred, num_neighbors_pred_, vecchia_neighbor_selection_,
 									re_comps_vecchia_, ind_intercept_gp_, num_gp_rand_coef_, num_gp_total_, y_[cluster_i], rng_,
-									predict_cov_mat, predict_var, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, save_distances_isotropic_cov_fct_Vecchia_);
+									predict_cov_mat, predict_var, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, false);
 							}
 							else if (vecchia_pred_type_ == "latent_order_obs_first_cond_obs_only") {
 								if (num_gp_rand_coef_ > 0) {
@@ -3010,7 +3308,7 @@ namespace GPBoost {
 								CalcPredVecchiaLatentObservedFirstOrder(true, cluster_i,
 									re_comp_gp->coords_, gp_coords_mat_pred, num_neighbors_pred_, vecchia_neighbor_selection_,
 									re_comps_vecchia_, ind_intercept_gp_, y_[cluster_i], rng_,
-									predict_cov_mat, predict_var, predict_response, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, save_distances_isotropic_cov_fct_Vecchia_);
+									predict_cov_mat, predict_var, predict_response, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, false);
 								// Note: we use the function 'CalcPredVecchiaLatentObservedFirstOrder' instead of the function 'CalcPredVecchiaObservedFirstOrder' since 
 								//	the current implementation cannot handle duplicate values in gp_coords (coordinates / input features) for Vecchia approximations
 								//	for latent processes (as matrices that need to be inverted will be singular due to the duplicate values).
@@ -3024,7 +3322,7 @@ namespace GPBoost {
 								CalcPredVecchiaLatentObservedFirstOrder(false, cluster_i,
 									re_comp_gp->coords_, gp_coords_mat_pred, num_neighbors_pred_, vecchia_neighbor_selection_,
 									re_comps_vecchia_, ind_intercept_gp_, y_[cluster_i], rng_,
-									predict_cov_mat, predict_var, predict_response, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, save_distances_isotropic_cov_fct_Vecchia_);
+									predict_cov_mat, predict_var, predict_response, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, false);
 							}
 							else {
 								Log::REFatal("Prediction type '%s' is not supported for the Veccia approximation.", vecchia_pred_type_.c_str());
@@ -3058,7 +3356,7 @@ namespace GPBoost {
 								CalcPredVecchiaObservedFirstOrder(true, cluster_i, num_data_pred, data_indices_per_cluster_pred,
 									re_comp_gp->coords_, gp_coords_mat_pred, gp_rand_coef_data_pred, num_neighbors_pred_, vecchia_neighbor_selection_,
 									re_comps_vecchia_, ind_intercept_gp_, num_gp_rand_coef_, num_gp_total_, y_[cluster_i], gauss_likelihood_, rng_,
-									false, false, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, Bpo, Bp, Dp, save_distances_isotropic_cov_fct_Vecchia_);
+									false, false, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, Bpo, Bp, Dp, false);
 								likelihood_[cluster_i]->PredictLaplaceApproxVecchia(y_[cluster_i].data(), y_int_[cluster_i].data(), fixed_effects_cluster_i_ptr,
 									B_[cluster_i], D_inv_[cluster_i], Bpo, Bp, Dp,
 									mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id,
@@ -3069,7 +3367,7 @@ namespace GPBoost {
 								CalcPredVecchiaObservedFirstOrder(false, cluster_i, num_data_pred, data_indices_per_cluster_pred,
 									re_comp_gp->coords_, gp_coords_mat_pred, gp_rand_coef_data_pred, num_neighbors_pred_, vecchia_neighbor_selection_,
 									re_comps_vecchia_, ind_intercept_gp_, num_gp_rand_coef_, num_gp_total_, y_[cluster_i], gauss_likelihood_, rng_,
-									false, false, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, Bpo, Bp, Dp, save_distances_isotropic_cov_fct_Vecchia_);
+									false, false, mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id, Bpo, Bp, Dp, false);
 								likelihood_[cluster_i]->PredictLaplaceApproxVecchia(y_[cluster_i].data(), y_int_[cluster_i].data(), fixed_effects_cluster_i_ptr,
 									B_[cluster_i], D_inv_[cluster_i], Bpo, Bp, Dp,
 									mean_pred_id, cov_mat_pred_vecchia_id, var_pred_id,
@@ -3083,6 +3381,7 @@ namespace GPBoost {
 						if (predict_cov_mat) {
 							ConvertTo_T_mat_FromDense(cov_mat_pred_vecchia_id, cov_mat_pred_id);
 						}
+						SetUsePrecomputedDistVecchia(cluster_i, save_distances_isotropic_cov_fct_Vecchia_);
 					}//end gp_approx_ == "vecchia"
 					else {// not gp_approx_ == "vecchia"
 						if (gp_approx_ == "fitc" || gp_approx_ == "full_scale_tapering") {
@@ -3231,6 +3530,9 @@ namespace GPBoost {
 				fixed_effects_ptr = fixed_effects_.data();
 			}
 			SetYCalcCovCalcYAuxForPred(cov_pars, coef, y_obs, calc_cov_factor, fixed_effects_ptr, true);
+			if (calc_var) {
+				CalcCholFactGroupedREsIterative();
+			}
 			// Loop over different clusters to calculate predictions
 			for (const auto& cluster_i : unique_clusters_) {
 				if (gauss_likelihood_) {
@@ -3668,6 +3970,7 @@ namespace GPBoost {
 				Log::REFatal("Newton updates for leaf values is only supported for Gaussian data");
 			}
 			CHECK(y_aux_has_been_calculated_);//y_aux_ has already been calculated when calculating the gradient for finding the tree structure from 'GetGradients' in 'regression_objetive.hpp'
+			CalcCholFactGroupedREsIterative();
 			den_mat_t HTPsiInvH(num_leaves, num_leaves);
 			vec_t HTYAux(num_leaves);
 			HTPsiInvH.setZero();
@@ -3920,6 +4223,9 @@ namespace GPBoost {
 		/*! \brief If true, the Vecchia approximation is done for the latent process for Gaussian likelihoods */
 		bool vecchia_latent_approx_gaussian_ = false;
 
+		/*! \brief Memory for temporary vectors in functions that are called in every iteration of the optimization (e.g., CalcYAux, CalcGradPars) */
+		IterationArena arena_;
+
 		// RANDOM EFFECT / GP COMPONENTS
 		/*! \brief Keys: labels of independent realizations of REs/GPs, values: vectors with individual RE/GP components */
 		std::map<data_size_t, std::vector<std::shared_ptr<RECompBase<T_mat>>>> re_comps_;
@@ -4206,10 +4512,24 @@ namespace GPBoost {
 		std::map<data_size_t, den_mat_t> solution_for_trace_;
 		/*! \brief Type of preconditioner used for conjugate gradient algorithms */
 		string_t cg_preconditioner_type_;
-		/*! \brief List of supported preconditioners for conjugate gradient algorithms for Gaussian likelihoods and gp_approx = "full_scale_tapering" */
+		/*! \brief List of supported preconditioners for conjugate gradient algorithms for Gaussian likelihoods and gp_approx = "full_scale_tapering" or "fitc" */
 		const std::set<string_t> SUPPORTED_PRECONDITIONERS_GAUSS_FSA_{ "none", "fitc" };
 		/*! \brief List of supported preconditioners for conjugate gradient algorithms for non-Gaussian likelihoods and gp_approx = "vecchia" */
 		const std::set<string_t> SUPPORTED_PRECONDITIONERS_NONGAUSS_VECCHIA_{ "vadu", "pivoted_cholesky", "fitc", "incomplete_cholesky" };
+		/*! \brief List of supported preconditioners for conjugate gradient algorithms for non-Gaussian likelihoods and gp_approx = "fitc" */
+		const std::set<string_t> SUPPORTED_PRECONDITIONERS_NONGAUSS_FITC_{ "fitc", "none" };
+		/*! \brief List of supported preconditioners for conjugate gradient algorithms for only grouped random effects */
+		const std::set<string_t> SUPPORTED_PRECONDITIONERS_GROUPED_RE_{ "ssor", "diagonal", "none" };
+		/*! \brief Key: labels of independent realizations of REs/GPs, value: Sigma^-1 + Z^T * Z (only saved for iterative methods for grouped random effects, see 'GroupedREsIterative') */
+		std::map<data_size_t, T_mat> SigmaI_plus_ZtZ_;
+		/*! \brief Key: labels of independent realizations of REs/GPs, value: diagonal of Sigma^-1 + Z^T * Z (only saved for iterative methods for grouped random effects) */
+		std::map<data_size_t, vec_t> diag_SigmaI_plus_ZtZ_;
+		/*! \brief Key: labels of independent realizations of REs/GPs, value: (Sigma^-1 + Z^T * Z)^-1 * Z^T * y (used instead of y_tilde_ for iterative methods for grouped random effects) */
+		std::map<data_size_t, vec_t> MInvZty_;
+		/*! \brief true if the Cholesky factor of Sigma^-1 + Z^T * Z has been calculated for the current covariance parameters (only relevant for iterative methods for grouped random effects) */
+		bool chol_fact_grouped_REs_iterative_calculated_ = false;
+		/*! \brief Key: labels of independent realizations of REs/GPs, value: true if 'solution_for_trace_' and 'rand_vec_probe_' have been calculated for the current Sigma^-1 + Z^T * Z (only relevant for iterative methods for grouped random effects) */
+		std::map<data_size_t, bool> solution_for_trace_grouped_REs_calculated_;
 		/*! \brief true if 'cg_preconditioner_type_' has been set */
 		bool cg_preconditioner_type_has_been_set_ = false;
 		/*! \brief Rank of the pivoted Cholesky decomposition used as preconditioner in conjugate gradient algorithms */
@@ -4275,10 +4595,14 @@ namespace GPBoost {
 			"latent_order_obs_first_cond_all", "order_obs_first_cond_obs_only", "order_obs_first_cond_all" };
 		/*! \brief Collects indices of nearest neighbors (used for Vecchia approximation) */
 		std::map<data_size_t, std::vector<std::vector<int>>> nearest_neighbors_;
-		/*! \brief Distances between locations and their nearest neighbors (this is used only if the Vecchia approximation is used, otherwise the distances are saved directly in the base GP component) */
-		std::map<data_size_t, std::vector<den_mat_t>> dist_obs_neighbors_;
-		/*! \brief Distances between nearest neighbors for all locations (this is used only if the Vecchia approximation is used, otherwise the distances are saved directly in the base GP component) */
-		std::map<data_size_t, std::vector<den_mat_t>> dist_between_neighbors_;//Note: this contains duplicate information (i.e. distances might be saved reduntly several times). But there is a trade-off between storage and computational speed. I currently don't see a way for saving unique distances without copying them when using them.
+		/*! \brief Compact caches of the distances between locations and their nearest neighbors and among the nearest neighbors (this is used only if the Vecchia approximation is used and the distances are cached, see 'vecchia_distance_cache_') */
+		std::map<data_size_t, VecchiaDistanceCache> vecchia_dist_cache_;
+		/*! \brief Policy for caching the distances for the Vecchia approximation: "auto", "none", "double", or "float" (see 'SetVecchiaDistanceCache') */
+		string_t vecchia_distance_cache_ = "auto";
+		/*! \brief Memory budget in bytes for caching the distances for the Vecchia approximation when vecchia_distance_cache_ == "auto" */
+		double vecchia_distance_cache_budget_ = 1024. * 1024. * 1024.;
+		/*! \brief List of supported policies for caching the distances for the Vecchia approximation */
+		const std::set<string_t> SUPPORTED_VECCHIA_DISTANCE_CACHE_{ "auto", "none", "double", "float" };
 		/*! \brief Outer product of covariate vector at observations and neighbors with itself. First index = cluster, second index = data point i, third index = GP number j (this is used only if the Vecchia approximation is used, this is handled saved directly in the GP component using Z_) */
 		std::map<data_size_t, std::vector<std::vector<den_mat_t>>> z_outer_z_obs_neighbors_;
 		/*! \brief Collects matrices B = I - A (=Cholesky factor of inverse covariance) for Vecchia approximation */
@@ -4291,11 +4615,14 @@ namespace GPBoost {
 		std::map<data_size_t, std::vector<sp_mat_t>> D_grad_;
 		/*! \brief Triplets for initializing the matrices B */
 		std::map<data_size_t, std::vector<Triplet_t>> entries_init_B_;
+		/*! \brief Nearest neighbors and triplets for initializing the matrices B after the construction of the model (saved only if the neighbors are redetermined during the estimation, see 'ResetEstimation') */
+		std::map<data_size_t, std::vector<std::vector<int>>> nearest_neighbors_init_;
+		std::map<data_size_t, std::vector<Triplet_t>> entries_init_B_init_;
 		/*! \brief If true, the function 'SetVecchiaPredType' has been called and vecchia_pred_type_ has been set */
 		bool vecchia_pred_type_has_been_set_ = false;
 		/*! \brief If true, a stochastic trace approximation is used to calculate the Fisher information for a Vecchia approximation for Gaussian likelihoods */
 		bool use_stochastic_trace_for_Fisher_information_Vecchia_ = true;
-		/*! \brief If true, distances among points and neighbors are saved for Vecchia approximations for isotropic covariance functions */
+		/*! \brief If true, distances among points and neighbors are saved for Vecchia approximations for isotropic covariance functions (set in 'ApplyVecchiaDistanceCachePolicy', used only for parameter estimation) */
 		bool save_distances_isotropic_cov_fct_Vecchia_ = false;
 		/*! \brief Keys: labels of independent realizations of REs/GPs, values: vectors with Vecchia GP components */
 		std::map<data_size_t, std::vector<std::shared_ptr<RECompGP<den_mat_t>>>> re_comps_vecchia_;
@@ -4331,6 +4658,8 @@ namespace GPBoost {
 
 		/*! \brief Key: labels of independent realizations of REs/GPs, values: diagonal of fully independent training conditional for predictive process */
 		std::map<data_size_t, vec_t> fitc_resid_diag_;
+		/*! \brief If > 0, the cross-covariance matrix between the data and the inducing points is not saved for gp_approx = "fitc" but generated on the fly in blocks of this many rows. Memory is then O(m^2 + block size * m) instead of O(n * m) */
+		int fitc_streaming_block_size_ = 0;
 		/*! \brief Key: labels of independent realizations of REs/GPs, values: Cholesky decompositions of residual covariance matrix */
 		std::map<data_size_t, T_chol> chol_fact_resid_;
 		/*! \brief Key: labels of independent realizations of REs/GPs, values: Cholesky decompositions of matrix sigma_ip + cross_cov^T * sigma_resid^-1 * cross_cov used in Woodbury identity */
@@ -4372,6 +4701,8 @@ namespace GPBoost {
 
 		/*! Random number generator */
 		RNG_t rng_;
+		/*! \brief State of the random number generator after the construction of the model (see 'ResetEstimation') */
+		RNG_t rng_init_;
 
 		/*! \brief Nesterov schedule */
 		static double NesterovSchedule(int iter,
@@ -4646,6 +4977,7 @@ namespace GPBoost {
 			if (gp_approx_ == "vecchia" || gp_approx_ == "fitc" || gp_approx_ == "full_scale_tapering") {
 				Log::REFatal("'CalcPsiInv': no implemented for approximation '%s' ", gp_approx_.c_str());
 			}
+			CalcCholFactGroupedREsIterative();
 			if (only_grouped_REs_use_woodbury_identity_) {
 				sp_mat_t MInvSqrtZt;
 				if (num_re_group_total_ == 1 && num_comps_total_ == 1) {//only one random effect -> ZtZ_ is diagonal
@@ -4700,6 +5032,7 @@ namespace GPBoost {
 			if (gp_approx_ == "vecchia" || gp_approx_ == "fitc" || gp_approx_ == "full_scale_tapering") {
 				Log::REFatal("'CalcPsiInv': no implemented for approximation '%s' ", gp_approx_.c_str());
 			}
+			CalcCholFactGroupedREsIterative();
 			if (only_grouped_REs_use_woodbury_identity_) {//typically currently not called as only_grouped_REs_use_woodbury_identity_ is only true for grouped REs only i.e. sparse matrices
 				den_mat_t MInvSqrtZt;
 				if (num_re_group_total_ == 1 && num_comps_total_ == 1) {//only one random effect -> ZtZ_ is diagonal
@@ -4735,11 +5068,17 @@ namespace GPBoost {
 						den_mat_t MInvSqrtZtX;
 						if (num_re_group_total_ == 1 && num_comps_total_ == 1) {//only one random effect -> ZtZ_ is diagonal
 							MInvSqrtZtX = sqrt_diag_SigmaI_plus_ZtZ_[unique_clusters_[0]].array().inverse().matrix().asDiagonal() * ZtX;
+							XT_psi_inv_X = X.transpose() * X - MInvSqrtZtX.transpose() * MInvSqrtZtX;
+						}
+						else if (GroupedREsIterative()) {
+							den_mat_t MInvZtX;
+							SolveSigmaIPlusZtZIterative(ZtX, MInvZtX, unique_clusters_[0]);
+							XT_psi_inv_X = X.transpose() * X - ZtX.transpose() * MInvZtX;
 						}
 						else {
 							TriangularSolveGivenCholesky<T_chol, T_mat, den_mat_t, den_mat_t>(chol_facts_[unique_clusters_[0]], ZtX, MInvSqrtZtX, false);
+							XT_psi_inv_X = X.transpose() * X - MInvSqrtZtX.transpose() * MInvSqrtZtX;
 						}
-						XT_psi_inv_X = X.transpose() * X - MInvSqrtZtX.transpose() * MInvSqrtZtX;
 					}
 					else {
 						den_mat_t MInvSqrtX;
@@ -4761,7 +5100,10 @@ namespace GPBoost {
 					else if (gp_approx_ == "full_scale_tapering" || gp_approx_ == "fitc") {
 						const den_mat_t* cross_cov = re_comps_cross_cov_[cluster_i][0]->GetSigmaPtr();
 						if (matrix_inversion_method_ == "cholesky") {
-							if (gp_approx_ == "fitc") {
+							if (FITCStreaming()) {
+								CalcPsiInvRhsFITCStreaming<den_mat_t>(cluster_i, X_cluster_i, psi_inv_X);
+							}
+							else if (gp_approx_ == "fitc") {
 								den_mat_t cross_covT_X = (*cross_cov).transpose() * (fitc_resid_diag_[cluster_i].cwiseInverse().asDiagonal() * X_cluster_i);
 								den_mat_t sigma_woodbury_I_cross_covT_X = chol_fact_sigma_woodbury_[cluster_i].solve(cross_covT_X);
 								cross_covT_X.resize(0, 0);
@@ -4794,15 +5136,28 @@ namespace GPBoost {
 							if (first_update_) {
 								cg_max_num_it = (int)round(cg_max_num_it_ / 3);
 							}
-							std::shared_ptr<T_mat> sigma_resid = re_comps_resid_[cluster_i][0]->GetZSigmaZt();
-							const den_mat_t* cross_cov_preconditioner;
-							if (cg_preconditioner_type_ == "fitc") {
-								cross_cov_preconditioner = re_comps_cross_cov_preconditioner_[cluster_i][0]->GetSigmaPtr();
+							if (gp_approx_ == "fitc") {
+								const den_mat_t* cross_cov_preconditioner = cross_cov;
+								if (cg_preconditioner_type_ == "fitc") {
+									cross_cov_preconditioner = re_comps_cross_cov_preconditioner_[cluster_i][0]->GetSigmaPtr();
+								}
+								for (int icol = 0; icol < (int)X_cluster_i.cols(); ++icol) {
+									vec_t psi_inv_X_col = psi_inv_X.col(icol);
+									CGFITC(fitc_resid_diag_[cluster_i], *cross_cov, chol_fact_sigma_ip_[cluster_i], X_cluster_i.col(icol), psi_inv_X_col,
+										NaN_found, cg_max_num_it, cg_delta_conv_, THRESHOLD_ZERO_RHS_CG_, cg_preconditioner_type_,
+										*cross_cov_preconditioner, chol_fact_woodbury_preconditioner_[cluster_i], diagonal_approx_inv_preconditioner_[cluster_i]);
+									psi_inv_X.col(icol) = psi_inv_X_col;
+								}
+							}
+							else if (cg_preconditioner_type_ == "fitc") {
+								std::shared_ptr<T_mat> sigma_resid = re_comps_resid_[cluster_i][0]->GetZSigmaZt();
+								const den_mat_t* cross_cov_preconditioner = re_comps_cross_cov_preconditioner_[cluster_i][0]->GetSigmaPtr();
 								CGFSA_MULTI_RHS<T_mat>(*sigma_resid, (*cross_cov_preconditioner), chol_ip_cross_cov_[cluster_i], X_cluster_i, psi_inv_X,
 									NaN_found, num_data_per_cluster_[cluster_i], (int)X_cluster_i.cols(), cg_max_num_it, cg_delta_conv_,
 									cg_preconditioner_type_, chol_fact_woodbury_preconditioner_[cluster_i], diagonal_approx_inv_preconditioner_[cluster_i]);
 							}
 							else {
+								std::shared_ptr<T_mat> sigma_resid = re_comps_resid_[cluster_i][0]->GetZSigmaZt();
 								CGFSA_MULTI_RHS<T_mat>(*sigma_resid, (*cross_cov), chol_ip_cross_cov_[cluster_i], X_cluster_i, psi_inv_X,
 									NaN_found, num_data_per_cluster_[cluster_i], (int)X_cluster_i.cols(), cg_max_num_it, cg_delta_conv_,
 									cg_preconditioner_type_, chol_fact_woodbury_preconditioner_[cluster_i], diagonal_approx_inv_preconditioner_[cluster_i]);
@@ -4820,11 +5175,17 @@ namespace GPBoost {
 							den_mat_t MInvSqrtZtX;
 							if (num_re_group_total_ == 1 && num_comps_total_ == 1) {//only one random effect -> ZtZ_ is diagonal
 								MInvSqrtZtX = sqrt_diag_SigmaI_plus_ZtZ_[cluster_i].array().inverse().matrix().asDiagonal() * ZtX;
+								XT_psi_inv_X += (X_cluster_i).transpose() * X_cluster_i - MInvSqrtZtX.transpose() * MInvSqrtZtX;
+							}
+							else if (GroupedREsIterative()) {
+								den_mat_t MInvZtX;
+								SolveSigmaIPlusZtZIterative(ZtX, MInvZtX, cluster_i);
+								XT_psi_inv_X += (X_cluster_i).transpose() * X_cluster_i - ZtX.transpose() * MInvZtX;
 							}
 							else {
 								TriangularSolveGivenCholesky<T_chol, T_mat, den_mat_t, den_mat_t>(chol_facts_[cluster_i], ZtX, MInvSqrtZtX, false);
+								XT_psi_inv_X += (X_cluster_i).transpose() * X_cluster_i - MInvSqrtZtX.transpose() * MInvSqrtZtX;
 							}
-							XT_psi_inv_X += (X_cluster_i).transpose() * X_cluster_i - MInvSqrtZtX.transpose() * MInvSqrtZtX;
 						}
 						else {
 							den_mat_t MInvSqrtX;
@@ -5052,12 +5413,15 @@ namespace GPBoost {
 				}
 			}
 			if (!cg_preconditioner_type_has_been_set_) {
-				if (gauss_likelihood_ && gp_approx_ == "full_scale_tapering") {
+				if ((gauss_likelihood_ && gp_approx_ == "full_scale_tapering") || gp_approx_ == "fitc") {
 					cg_preconditioner_type_ = "fitc";
 				}
 				else if (!gauss_likelihood_ && gp_approx_ == "vecchia") {
 					cg_preconditioner_type_ = "vadu";
 				}
+				else if (only_grouped_REs_use_woodbury_identity_) {
+					cg_preconditioner_type_ = "ssor";
+				}
 				CheckPreconditionerType();
 			}
 		}//end InitializeDefaultSettings
@@ -5085,33 +5449,45 @@ namespace GPBoost {
 					non_zeros += (int)Z_j->nonZeros();
 					cum_num_rand_eff_cluster_i[j + 1] = ncols;
 				}
-				//Create matrix Z and calculate sum(Z_j^2) = trace(Z_j^T * Z_j)
-				std::vector<Triplet_t> triplets;
-				triplets.reserve(non_zeros);
+				//Calculate sum(Z_j^2) = trace(Z_j^T * Z_j)
 				std::vector<double> Zj_square_sum_cluster_i(num_comps_total_);
-				int ncol_prev = 0;
+				std::vector<const sp_mat_t*> Z_comps(num_comps_total_);
 				for (int j = 0; j < num_comps_total_; ++j) {
-					sp_mat_t* Z_j = re_comps_[cluster_i][j]->GetZ();
-					for (int k = 0; k < Z_j->outerSize(); ++k) {
-						for (sp_mat_t::InnerIterator it(*Z_j, k); it; ++it) {
-							triplets.emplace_back(it.row(), ncol_prev + it.col(), it.value());
-						}
-					}
-					ncol_prev += (int)Z_j->cols();
-					Zj_square_sum_cluster_i[j] = Z_j->squaredNorm();
+					Z_comps[j] = re_comps_[cluster_i][j]->GetZ();
+					Zj_square_sum_cluster_i[j] = Z_comps[j]->squaredNorm();
 				}
-				sp_mat_t Z_cluster_i(num_data_per_cluster_[cluster_i], ncols);
-				Z_cluster_i.setFromTriplets(triplets.begin(), triplets.end());
-				sp_mat_t Zt_cluster_i = Z_cluster_i.transpose();
-				sp_mat_t ZtZ_cluster_i = Zt_cluster_i * Z_cluster_i;
-				//Calculate Z^T * Z_j
+				//Create matrices Z^T and Z^T * Z directly from the incidence matrices of the components (in parallel)
+				sp_mat_t Zt_cluster_i, ZtZ_cluster_i;
 				std::vector<sp_mat_t> ZtZj_cluster_i(num_comps_total_);
-				for (int j = 0; j < num_comps_total_; ++j) {
-					sp_mat_t* Z_j = re_comps_[cluster_i][j]->GetZ();
-					ZtZj_cluster_i[j] = Zt_cluster_i * (*Z_j);
+				if (CreateZtAndZtZFromIncidenceMatrices(Z_comps, Zt_cluster_i, ZtZ_cluster_i)) {
+					//Z^T * Z_j are the columns of Z^T * Z that belong to component j
+					for (int j = 0; j < num_comps_total_; ++j) {
+						ZtZj_cluster_i[j] = ZtZ_cluster_i.middleCols(cum_num_rand_eff_cluster_i[j], cum_num_rand_eff_cluster_i[j + 1] - cum_num_rand_eff_cluster_i[j]);
+					}
+				}
+				else {//some Z_j has not exactly one non-zero entry per row -> use sparse matrix products
+					std::vector<Triplet_t> triplets;
+					triplets.reserve(non_zeros);
+					for (int j = 0; j < num_comps_total_; ++j) {
+						for (int k = 0; k < Z_comps[j]->outerSize(); ++k) {
+							for (sp_mat_t::InnerIterator it(*Z_comps[j], k); it; ++it) {
+								triplets.emplace_back(it.row(), cum_num_rand_eff_cluster_i[j] + it.col(), it.value());
+							}
+						}
+					}
+					sp_mat_t Z_cluster_i(num_data_per_cluster_[cluster_i], ncols);
+					Z_cluster_i.setFromTriplets(triplets.begin(), triplets.end());
+					Zt_cluster_i = Z_cluster_i.transpose();
+					ZtZ_cluster_i = Zt_cluster_i * Z_cluster_i;
+					for (int j = 0; j < num_comps_total_; ++j) {
+						ZtZj_cluster_i[j] = Zt_cluster_i * (*Z_comps[j]);
+					}
 				}
 				//Save all quantities
 				Zt_.insert({ cluster_i, Zt_cluster_i });
+				if (!gauss_likelihood_ && likelihood_.find(cluster_i) != likelihood_.end()) {
+					likelihood_[cluster_i]->InvalidateZtWZPlanGroupedRE();
+				}
 				ZtZ_.insert({ cluster_i, ZtZ_cluster_i });
 				cum_num_rand_eff_.insert({ cluster_i, cum_num_rand_eff_cluster_i });
 				Zj_square_sum_.insert({ cluster_i, Zj_square_sum_cluster_i });
@@ -5186,7 +5562,8 @@ namespace GPBoost {
 					Log::REFatal("Approximation '%s' is currently not supported for non-Gaussian likelihoods ", gp_approx_.c_str());
 			}
 			if (matrix_inversion_method_ == "iterative") {
-				bool can_use_iterative = (gp_approx_ == "vecchia" && !gauss_likelihood_) || (gp_approx_ == "full_scale_tapering" && gauss_likelihood_);
+				bool can_use_iterative = (gp_approx_ == "vecchia" && !gauss_likelihood_) || gp_approx_ == "fitc" ||
+					(gp_approx_ == "full_scale_tapering" && gauss_likelihood_) || only_grouped_REs_use_woodbury_identity_;
 				if (!can_use_iterative) {
 					Log::REFatal("Cannot use matrix_inversion_method = 'iterative' if gp_approx = '%s' and likelihood = '%s'. Use matrix_inversion_method = 'cholesky' instead ", 
 						gp_approx_.c_str(), (likelihood_[unique_clusters_[0]]->GetLikelihood()).c_str());
@@ -5196,7 +5573,7 @@ namespace GPBoost {
 
 		/*! \brief Check whether preconditioner is supported */
 		void CheckPreconditionerType() {
-			if (gauss_likelihood_ && gp_approx_ == "full_scale_tapering") {
+			if (gauss_likelihood_ && (gp_approx_ == "full_scale_tapering" || gp_approx_ == "fitc")) {
 				if (SUPPORTED_PRECONDITIONERS_GAUSS_FSA_.find(cg_preconditioner_type_) == SUPPORTED_PRECONDITIONERS_GAUSS_FSA_.end()) {
 					Log::REFatal("Preconditioner type '%s' is not supported for gp_approx = '%s' and likelihood = '%s'",
 						cg_preconditioner_type_.c_str(), gp_approx_.c_str(), (likelihood_[unique_clusters_[0]]->GetLikelihood()).c_str());
@@ -5208,8 +5585,49 @@ namespace GPBoost {
 						cg_preconditioner_type_.c_str(), gp_approx_.c_str(), (likelihood_[unique_clusters_[0]]->GetLikelihood()).c_str());
 				}
 			}
+			else if (!gauss_likelihood_ && gp_approx_ == "fitc") {
+				if (SUPPORTED_PRECONDITIONERS_NONGAUSS_FITC_.find(cg_preconditioner_type_) == SUPPORTED_PRECONDITIONERS_NONGAUSS_FITC_.end()) {
+					Log::REFatal("Preconditioner type '%s' is not supported for gp_approx = '%s' and likelihood = '%s'",
+						cg_preconditioner_type_.c_str(), gp_approx_.c_str(), (likelihood_[unique_clusters_[0]]->GetLikelihood()).c_str());
+				}
+			}
+			else if (only_grouped_REs_use_woodbury_identity_) {
+				if (SUPPORTED_PRECONDITIONERS_GROUPED_RE_.find(cg_preconditioner_type_) == SUPPORTED_PRECONDITIONERS_GROUPED_RE_.end()) {
+					Log::REFatal("Preconditioner type '%s' is not supported for grouped random effects and likelihood = '%s'",
+						cg_preconditioner_type_.c_str(), (likelihood_[unique_clusters_[0]]->GetLikelihood()).c_str());
+				}
+			}
 		}//end CheckPreconditionerType
 
+		/*! \brief Returns true if conjugate gradient and stochastic Lanczos methods are used instead of a Cholesky factorization of Sigma^-1 + Z^T * Z for grouped random effects */
+		bool GroupedREsIterative() const {
+			return(matrix_inversion_method_ == "iterative" && gauss_likelihood_ && only_grouped_REs_use_woodbury_identity_ &&
+				!(num_re_group_total_ == 1 && num_comps_total_ == 1));
+		}
+
+		/*! \brief Returns true if the cross-covariance matrix for the FITC approximation is not saved but generated on the fly in blocks of rows */
+		bool FITCStreaming() const {
+			return(gp_approx_ == "fitc" && fitc_streaming_block_size_ > 0);
+		}
+
+		/*! \brief Check whether streaming of the cross-covariance matrix is supported for the FITC approximation */
+		void CheckFITCStreaming() const {
+			if (fitc_streaming_block_size_ > 0) {
+				if (gp_approx_ != "fitc") {
+					Log::REFatal("'fitc_streaming_block_size' > 0 is only supported for gp_approx = 'fitc' ");
+				}
+				if (!gauss_likelihood_) {
+					Log::REFatal("'fitc_streaming_block_size' > 0 is currently only supported for likelihood = 'gaussian' ");
+				}
+				if (matrix_inversion_method_ != "cholesky") {
+					Log::REFatal("'fitc_streaming_block_size' > 0 is currently only supported for matrix_inversion_method = 'cholesky' ");
+				}
+				if (num_comps_total_ > 1) {
+					Log::REFatal("'fitc_streaming_block_size' > 0 is currently not supported when having more than one GP ");
+				}
+			}
+		}//end CheckFITCStreaming
+
 		static string_t ParsePreconditionerAlias(const string_t& type) {
 			if (type == "VADU" || type == "vadu" || type == "vecchia_approximation_with_diagonal_update" || type == "Sigma_inv_plus_BtWB") {
 				return "vadu";
@@ -5228,6 +5646,12 @@ namespace GPBoost {
 			else if (type == "FITC" || type == "fitc" || type == "predictive_process_plus_diagonal") {
 				return "fitc";
 			}
+			else if (type == "SSOR" || type == "ssor" || type == "symmetric_gauss_seidel" || type == "sgs") {
+				return "ssor";
+			}
+			else if (type == "diagonal" || type == "jacobi" || type == "Jacobi" || type == "block_jacobi" || type == "block_Jacobi") {
+				return "diagonal";
+			}
 			return type;
 		}
 
@@ -5620,15 +6044,14 @@ namespace GPBoost {
 				for (int j = 0; j < num_comps_total_; ++j) {
 					if (gp_approx_ == "fitc" || gp_approx_ == "full_scale_tapering") {
 						re_comps_ip_[cluster_i][j]->CalcSigma();
-						re_comps_cross_cov_[cluster_i][j]->CalcSigma();
+						if (!FITCStreaming()) {
+							re_comps_cross_cov_[cluster_i][j]->CalcSigma();
+						}
 						den_mat_t sigma_ip_stable = *(re_comps_ip_[cluster_i][j]->GetZSigmaZt());
 						sigma_ip_stable.diagonal().array() *= JITTER_MULT_IP_FITC_FSA;
 						chol_fact_sigma_ip_[cluster_i].compute(sigma_ip_stable);
 						const den_mat_t* cross_cov = re_comps_cross_cov_[cluster_i][j]->GetSigmaPtr();
 						if (gp_approx_ == "fitc") {
-							den_mat_t sigma_ip_Ihalf_sigma_cross_covT = (*cross_cov).transpose();
-							TriangularSolveGivenCholesky<chol_den_mat_t, den_mat_t, den_mat_t, den_mat_t>(chol_fact_sigma_ip_[cluster_i],
-								sigma_ip_Ihalf_sigma_cross_covT, sigma_ip_Ihalf_sigma_cross_covT, false);
 							if (gauss_likelihood_) {
 								fitc_resid_diag_[cluster_i] = vec_t::Ones(re_comps_cross_cov_[cluster_i][0]->GetNumUniqueREs());//add nugget effect variance
 							}
@@ -5636,9 +6059,29 @@ namespace GPBoost {
 								fitc_resid_diag_[cluster_i] = vec_t::Zero(re_comps_cross_cov_[cluster_i][0]->GetNumUniqueREs());
 							}
 							fitc_resid_diag_[cluster_i].array() += sigma_ip_stable.coeffRef(0, 0);
+							if (FITCStreaming()) {
+								data_size_t num_REs = re_comps_cross_cov_[cluster_i][0]->GetNumUniqueREs();
+								den_mat_t cross_cov_block;
+								for (data_size_t row_start = 0; row_start < num_REs; row_start += fitc_streaming_block_size_) {
+									data_size_t num_rows = std::min(fitc_streaming_block_size_, num_REs - row_start);
+									re_comps_cross_cov_[cluster_i][0]->CalcSigmaRows(row_start, num_rows, cross_cov_block);
+									den_mat_t sigma_ip_Ihalf_cross_cov_blockT = cross_cov_block.transpose();
+									TriangularSolveGivenCholesky<chol_den_mat_t, den_mat_t, den_mat_t, den_mat_t>(chol_fact_sigma_ip_[cluster_i],
+										sigma_ip_Ihalf_cross_cov_blockT, sigma_ip_Ihalf_cross_cov_blockT, false);
 #pragma omp parallel for schedule(static)
-							for (int ii = 0; ii < re_comps_cross_cov_[cluster_i][0]->GetNumUniqueREs(); ++ii) {
-								fitc_resid_diag_[cluster_i][ii] -= sigma_ip_Ihalf_sigma_cross_covT.col(ii).array().square().sum();
+									for (int ii = 0; ii < num_rows; ++ii) {
+										fitc_resid_diag_[cluster_i][row_start + ii] -= sigma_ip_Ihalf_cross_cov_blockT.col(ii).array().square().sum();
+									}
+								}
+							}
+							else {
+								den_mat_t sigma_ip_Ihalf_sigma_cross_covT = (*cross_cov).transpose();
+								TriangularSolveGivenCholesky<chol_den_mat_t, den_mat_t, den_mat_t, den_mat_t>(chol_fact_sigma_ip_[cluster_i],
+									sigma_ip_Ihalf_sigma_cross_covT, sigma_ip_Ihalf_sigma_cross_covT, false);
+#pragma omp parallel for schedule(static)
+								for (int ii = 0; ii < re_comps_cross_cov_[cluster_i][0]->GetNumUniqueREs(); ++ii) {
+									fitc_resid_diag_[cluster_i][ii] -= sigma_ip_Ihalf_sigma_cross_covT.col(ii).array().square().sum();
+								}
 							}
 						}
 						else if (gp_approx_ == "full_scale_tapering") {
@@ -6046,7 +6489,8 @@ namespace GPBoost {
 					likelihood_[cluster_i]->CalcGradNegMargLikelihoodLaplaceApproxFITC(y_[cluster_i].data(), y_int_[cluster_i].data(),
 						fixed_effects_cluster_i_ptr, re_comps_ip_[cluster_i][0]->GetZSigmaZt(), chol_fact_sigma_ip_[cluster_i],
 						re_comps_cross_cov_[cluster_i][0]->GetSigmaPtr(), fitc_resid_diag_[cluster_i], re_comps_ip_[cluster_i], re_comps_cross_cov_[cluster_i],
-						false, true, false, nullptr, grad_F_cluster_i, nullptr, false, false);
+						false, true, false, nullptr, grad_F_cluster_i, nullptr, false, false, re_comps_ip_preconditioner_[cluster_i],
+						re_comps_cross_cov_preconditioner_[cluster_i], chol_ip_cross_cov_preconditioner_[cluster_i], chol_fact_sigma_ip_preconditioner_[cluster_i]);
 				}
 				else if (only_grouped_REs_use_woodbury_identity_ && !only_one_grouped_RE_calculations_on_RE_scale_) {
 					likelihood_[cluster_i]->CalcGradNegMargLikelihoodLaplaceApproxGroupedRE(y_[cluster_i].data(), y_int_[cluster_i].data(),
@@ -6729,7 +7173,8 @@ namespace GPBoost {
 					likelihood_[cluster_i]->FindModePostRandEffCalcMLLFITC(y_[cluster_i].data(), y_int_[cluster_i].data(),
 						fixed_effects_cluster_i_ptr, re_comps_ip_[cluster_i][0]->GetZSigmaZt(),
 						chol_fact_sigma_ip_[cluster_i], re_comps_cross_cov_[cluster_i][0]->GetSigmaPtr(),
-						fitc_resid_diag_[cluster_i], mll_cluster_i);
+						fitc_resid_diag_[cluster_i], mll_cluster_i, re_comps_ip_preconditioner_[cluster_i],
+						re_comps_cross_cov_preconditioner_[cluster_i], chol_ip_cross_cov_preconditioner_[cluster_i], chol_fact_sigma_ip_preconditioner_[cluster_i]);
 				}
 				else if (only_grouped_REs_use_woodbury_identity_ && !only_one_grouped_RE_calculations_on_RE_scale_) {
 					likelihood_[cluster_i]->FindModePostRandEffCalcMLLGroupedRE(y_[cluster_i].data(), y_int_[cluster_i].data(),
@@ -6761,14 +7206,22 @@ namespace GPBoost {
 			if (gp_approx_ == "vecchia") {
 				CalcCovFactorVecchia(transf_scale, nugget_var);
 				if (!gauss_likelihood_ && matrix_inversion_method_ == "iterative" && cg_preconditioner_type_ == "fitc") {
-					Calc_FITC_Preconditioner_Vecchia();
+					Calc_FITC_Preconditioner();
 				}
 			}
 			else {
 				CalcSigmaComps();
+				if (!gauss_likelihood_ && gp_approx_ == "fitc" && matrix_inversion_method_ == "iterative" && cg_preconditioner_type_ == "fitc") {
+					// the preconditioner is a FITC approximation with fewer inducing points
+					Calc_FITC_Preconditioner();
+				}
 				if (gauss_likelihood_) {
 					if (gp_approx_ == "fitc" || gp_approx_ == "full_scale_tapering") {
-						if (cg_preconditioner_type_ == "fitc" && matrix_inversion_method_ == "iterative") {
+						if (cg_preconditioner_type_ == "fitc" && matrix_inversion_method_ == "iterative" && gp_approx_ == "fitc") {
+							// the preconditioner is a FITC approximation with fewer inducing points
+							Calc_FITC_Preconditioner();
+						}
+						else if (cg_preconditioner_type_ == "fitc" && matrix_inversion_method_ == "iterative") {
 							for (const auto& cluster_i : unique_clusters_) {
 								re_comps_ip_preconditioner_[cluster_i] = re_comps_ip_[cluster_i];
 								re_comps_cross_cov_preconditioner_[cluster_i] = re_comps_cross_cov_[cluster_i];
@@ -6788,8 +7241,16 @@ namespace GPBoost {
 								else {
 									sp_mat_t SigmaI;
 									CalcSigmaIGroupedREsOnly(SigmaI, cluster_i, true);
-									T_mat SigmaIplusZtZ = SigmaI + ZtZ_[cluster_i];
-									CalcChol(SigmaIplusZtZ, cluster_i);
+									if (GroupedREsIterative()) {//no factorization, the Cholesky factor is only calculated when needed (see 'CalcCholFactGroupedREsIterative')
+										SigmaI_plus_ZtZ_[cluster_i] = SigmaI + ZtZ_[cluster_i];
+										diag_SigmaI_plus_ZtZ_[cluster_i] = SigmaI_plus_ZtZ_[cluster_i].diagonal();
+										chol_fact_grouped_REs_iterative_calculated_ = false;
+										solution_for_trace_grouped_REs_calculated_[cluster_i] = false;
+									}
+									else {
+										T_mat SigmaIplusZtZ = SigmaI + ZtZ_[cluster_i];
+										CalcChol(SigmaIplusZtZ, cluster_i);
+									}
 								}
 							}//end only_grouped_REs_use_woodbury_identity_
 							else {//not only_grouped_REs_use_woodbury_identity_
@@ -6807,6 +7268,65 @@ namespace GPBoost {
 			}
 		}//end CalcCovFactor
 
+		/*!
+		* \brief Decide according to 'vecchia_distance_cache_' and 'vecchia_distance_cache_budget_' whether the distances
+		*		for the Vecchia approximation are cached or recalculated in every iteration, and (re)build the caches
+		*/
+		void ApplyVecchiaDistanceCachePolicy() {
+			std::shared_ptr<RECompGP<den_mat_t>> re_comp = re_comps_vecchia_[unique_clusters_[0]][ind_intercept_gp_];
+			bool cache = false, single_precision = false;
+			if (re_comp->HasIsotropicCovFct() && vecchia_distance_cache_ != "none") {
+				if (vecchia_distance_cache_ == "double") {
+					cache = true;
+				}
+				else if (vecchia_distance_cache_ == "float") {
+					cache = true;
+					single_precision = true;
+					Log::REInfo("The distances for the Vecchia approximation are cached in single precision ");
+				}
+				else {//"auto": single precision is never chosen automatically since it changes the likelihood
+					double required_double = 0.;
+					for (const auto& cluster_i : unique_clusters_) {
+						required_double += VecchiaDistanceCache::RequiredBytes(nearest_neighbors_[cluster_i], false);
+					}
+					cache = required_double <= vecchia_distance_cache_budget_;
+					if (!cache) {
+						Log::REInfo("The distances for the Vecchia approximation are not cached since this requires %g MB of memory "
+							"which is more than the budget of %g MB ", required_double / 1048576., vecchia_distance_cache_budget_ / 1048576.);
+					}
+				}
+			}
+			for (const auto& cluster_i : unique_clusters_) {
+				if (cache) {
+					vecchia_dist_cache_[cluster_i].Build(re_comps_vecchia_[cluster_i][ind_intercept_gp_]->GetCoords(),
+						nearest_neighbors_[cluster_i], single_precision);
+				}
+				else {
+					vecchia_dist_cache_[cluster_i].Clear();
+				}
+				SetUsePrecomputedDistVecchia(cluster_i, cache);
+			}
+			save_distances_isotropic_cov_fct_Vecchia_ = cache;
+		}//end ApplyVecchiaDistanceCachePolicy
+
+		/*!
+		* \brief Set whether the Vecchia GP components of a cluster calculate covariances from precomputed distances or from the coordinates
+		* \param cluster_i Cluster index
+		* \param use_precomputed_dist If true, precomputed distances are used
+		*/
+		void SetUsePrecomputedDistVecchia(data_size_t cluster_i,
+			bool use_precomputed_dist) {
+			for (const auto& re_comp_cl : re_comps_vecchia_[cluster_i]) {
+				re_comp_cl->SetUsePrecomputedDistForCalcCov(use_precomputed_dist);
+			}
+		}
+
+		/*! \brief Distance cache of a cluster for the Vecchia approximation (nullptr if the distances are not cached) */
+		const VecchiaDistanceCache* VecchiaDistanceCacheCluster(data_size_t cluster_i) {
+			VecchiaDistanceCache& dist_cache = vecchia_dist_cache_[cluster_i];
+			return(dist_cache.IsEmpty() ? nullptr : &dist_cache);
+		}
+
 		/*!
 		* \brief Calculate matrices A and D_inv for Vecchia approximation
 		* \param transf_scale If true, the derivatives are taken on the transformed scale otherwise on the original scale
@@ -6817,18 +7337,32 @@ namespace GPBoost {
 			cov_factor_vecchia_calculated_on_transf_scale_ = transf_scale;
 			for (const auto& cluster_i : unique_clusters_) {
 				data_size_t num_re_cluster_i = re_comps_vecchia_[cluster_i][ind_intercept_gp_]->GetNumUniqueREs();
+				SetUsePrecomputedDistVecchia(cluster_i, save_distances_isotropic_cov_fct_Vecchia_);//the prediction functions use the coordinates
+				std::vector<den_mat_t> dist_dummy;//distances are taken from 'vecchia_dist_cache_' or calculated from the coordinates
 				CalcCovFactorGradientVecchia(num_re_cluster_i, true, false, re_comps_vecchia_[cluster_i], nearest_neighbors_[cluster_i],
-					dist_obs_neighbors_[cluster_i], dist_between_neighbors_[cluster_i],
+					dist_dummy, dist_dummy,
 					entries_init_B_[cluster_i], z_outer_z_obs_neighbors_[cluster_i],
 					B_[cluster_i], D_inv_[cluster_i], B_grad_[cluster_i], D_grad_[cluster_i], transf_scale, nugget_var,
-					false, num_gp_total_, ind_intercept_gp_, gauss_likelihood_, save_distances_isotropic_cov_fct_Vecchia_);
+					false, num_gp_total_, ind_intercept_gp_, gauss_likelihood_, save_distances_isotropic_cov_fct_Vecchia_,
+					VecchiaDistanceCacheCluster(cluster_i));
 			}
 		}//end CalcCovFactorVecchia
 
-		void Calc_FITC_Preconditioner_Vecchia() {
-			CHECK(!gauss_likelihood_ && matrix_inversion_method_ == "iterative" && cg_preconditioner_type_ == "fitc");
+		/*!
+		* \brief Calculate the components of the "fitc" preconditioner which uses 'piv_chol_rank_' inducing points.
+		*		This is used for non-Gaussian likelihoods with a Vecchia approximation and for FITC approximations
+		*/
+		void Calc_FITC_Preconditioner() {
+			CHECK(matrix_inversion_method_ == "iterative" && cg_preconditioner_type_ == "fitc");
+			CHECK((!gauss_likelihood_ && gp_approx_ == "vecchia") || gp_approx_ == "fitc");
 			for (const auto& cluster_i : unique_clusters_) {
-				std::shared_ptr<RECompGP<den_mat_t>> re_comp_gp_clus0 = re_comps_vecchia_[cluster_i][0];
+				std::shared_ptr<RECompGP<den_mat_t>> re_comp_gp_clus0;
+				if (gp_approx_ == "vecchia") {
+					re_comp_gp_clus0 = re_comps_vecchia_[cluster_i][0];
+				}
+				else {
+					re_comp_gp_clus0 = re_comps_cross_cov_[cluster_i][0];
+				}
 				if (!ind_points_determined_for_preconditioner_) {
 					std::vector<std::shared_ptr<RECompGP<den_mat_t>>> re_comps_ip_cluster_i;
 					std::vector<std::shared_ptr<RECompGP<den_mat_t>>> re_comps_cross_cov_cluster_i;
@@ -6913,7 +7447,7 @@ namespace GPBoost {
 						chol_ip_cross_cov_preconditioner_[cluster_i], chol_ip_cross_cov_preconditioner_[cluster_i], false);
 				}
 			}//end loop over unique_clusters_
-		}//end Calc_FITC_Preconditioner_Vecchia
+		}//end Calc_FITC_Preconditioner
 
 		/*!
 		* \brief Calculate gradients of matrices A and D_inv for Vecchia approximation
@@ -6927,11 +7461,13 @@ namespace GPBoost {
 			CHECK(cov_factor_vecchia_calculated_on_transf_scale_ == transf_scale);
 			for (const auto& cluster_i : unique_clusters_) {
 				data_size_t num_re_cluster_i = re_comps_vecchia_[cluster_i][ind_intercept_gp_]->GetNumUniqueREs();
+				std::vector<den_mat_t> dist_dummy;//distances are taken from 'vecchia_dist_cache_' or calculated from the coordinates
 				CalcCovFactorGradientVecchia(num_re_cluster_i, false, true, re_comps_vecchia_[cluster_i], nearest_neighbors_[cluster_i],
-					dist_obs_neighbors_[cluster_i], dist_between_neighbors_[cluster_i],
+					dist_dummy, dist_dummy,
 					entries_init_B_[cluster_i], z_outer_z_obs_neighbors_[cluster_i],
 					B_[cluster_i], D_inv_[cluster_i], B_grad_[cluster_i], D_grad_[cluster_i], transf_scale, nugget_var,
-					calc_gradient_nugget, num_gp_total_, ind_intercept_gp_, gauss_likelihood_, save_distances_isotropic_cov_fct_Vecchia_);
+					calc_gradient_nugget, num_gp_total_, ind_intercept_gp_, gauss_likelihood_, save_distances_isotropic_cov_fct_Vecchia_,
+					VecchiaDistanceCacheCluster(cluster_i));
 			}
 		}//end CalcGradientVecchia
 
@@ -6943,7 +7479,26 @@ namespace GPBoost {
 				// factorize matrix used in Woodbury identity
 				if (matrix_inversion_method_ == "iterative") {
 					if (gp_approx_ == "fitc") {
-						Log::REFatal("'iterative' methods are not implemented for gp_approx = '%s'. Use 'cholesky' ", gp_approx_.c_str());
+						if (cg_preconditioner_type_ == "fitc") {
+							// FITC approximation with fewer inducing points as preconditioner
+							const den_mat_t* cross_cov_preconditioner = re_comps_cross_cov_preconditioner_[cluster_i][0]->GetSigmaPtr();
+							den_mat_t sigma_ip_stable_preconditioner = *(re_comps_ip_preconditioner_[cluster_i][0]->GetZSigmaZt());
+							sigma_ip_stable_preconditioner.diagonal().array() *= JITTER_MULT_IP_FITC_FSA;
+							diagonal_approx_preconditioner_[cluster_i] = vec_t::Ones(num_data_per_cluster_[cluster_i]);//add nugget effect variance
+							diagonal_approx_preconditioner_[cluster_i].array() += sigma_ip_stable_preconditioner.coeffRef(0, 0);
+#pragma omp parallel for schedule(static)
+							for (int ii = 0; ii < num_data_per_cluster_[cluster_i]; ++ii) {
+								diagonal_approx_preconditioner_[cluster_i][ii] -= chol_ip_cross_cov_preconditioner_[cluster_i].col(ii).array().square().sum();
+							}
+							diagonal_approx_inv_preconditioner_[cluster_i] = diagonal_approx_preconditioner_[cluster_i].cwiseInverse();
+							den_mat_t sigma_woodbury_preconditioner = (*cross_cov_preconditioner).transpose() * (diagonal_approx_inv_preconditioner_[cluster_i].asDiagonal() * (*cross_cov_preconditioner));
+							sigma_woodbury_preconditioner += sigma_ip_stable_preconditioner;
+							chol_fact_woodbury_preconditioner_[cluster_i].compute(sigma_woodbury_preconditioner);
+						}
+						else if (cg_preconditioner_type_ != "none") {
+							Log::REFatal("Preconditioner type '%s' is not supported for gp_approx = '%s' and likelihood = '%s'", 
+								cg_preconditioner_type_.c_str(), gp_approx_.c_str(), (likelihood_[unique_clusters_[0]]->GetLikelihood()).c_str());
+						}
 					}
 					else if (gp_approx_ == "full_scale_tapering") {
 						if (cg_preconditioner_type_ == "fitc") {
@@ -6967,38 +7522,7 @@ namespace GPBoost {
 					}
 				}
 				else if (matrix_inversion_method_ == "cholesky") {
-					const den_mat_t* cross_cov = re_comps_cross_cov_[cluster_i][0]->GetSigmaPtr();
-					den_mat_t sigma_ip_stable = *(re_comps_ip_[cluster_i][0]->GetZSigmaZt());
-					sigma_ip_stable.diagonal().array() *= JITTER_MULT_IP_FITC_FSA;
-					den_mat_t sigma_woodbury;// sigma_woodbury = sigma_ip + cross_cov^T * sigma_resid^-1 * cross_cov or for Preconditioner sigma_ip + cross_cov^T * D^-1 * cross_cov
-					if (gp_approx_ == "fitc") {						
-						sigma_woodbury = ((*cross_cov).transpose() * fitc_resid_diag_[cluster_i].cwiseInverse().asDiagonal()) * (*cross_cov);
-					}
-					else if (gp_approx_ == "full_scale_tapering") {
-						// factorize residual covariance matrix
-						std::shared_ptr<T_mat> sigma_resid = re_comps_resid_[cluster_i][0]->GetZSigmaZt();
-						CalcCholFSAResid(*sigma_resid, cluster_i);
-						den_mat_t sigma_resid_Ihalf_cross_cov;
-						//ApplyPermutationCholeskyFactor<den_mat_t, T_chol>(chol_fact_resid_[cluster_i], *cross_cov, sigma_resid_Ihalf_cross_cov, false);//DELETE_SOLVEINPLACE
-						//chol_fact_resid_[cluster_i].matrixL().solveInPlace(sigma_resid_Ihalf_cross_cov);
-						TriangularSolveGivenCholesky<T_chol, T_mat, den_mat_t, den_mat_t>(chol_fact_resid_[cluster_i], *cross_cov, sigma_resid_Ihalf_cross_cov, false);
-						sigma_woodbury = sigma_resid_Ihalf_cross_cov.transpose() * sigma_resid_Ihalf_cross_cov;
-					}
-					sigma_woodbury += sigma_ip_stable;
-
-					//// adding jitter to this Woodbury matrix changes the results too much without helping really (06.11.2024)
-					//sigma_woodbury.diagonal().array() *= JITTER_MULT_IP_FITC_FSA;
-
-					chol_fact_sigma_woodbury_[cluster_i].compute(sigma_woodbury);
-
-					////alternative way for calculating determinants with Woodbury (does not solve numerical stability issue, 05.06.2024)
-					//den_mat_t sigma_woodbury_stable = sigma_woodbury;
-					//TriangularSolveGivenCholesky<chol_den_mat_t, den_mat_t, den_mat_t, den_mat_t>(chol_fact_sigma_ip_[cluster_i], sigma_woodbury_stable, sigma_woodbury_stable, false);
-					//den_mat_t sigma_woodbury_stable_aux = sigma_woodbury_stable.transpose();
-					//TriangularSolveGivenCholesky<chol_den_mat_t, den_mat_t, den_mat_t, den_mat_t>(chol_fact_sigma_ip_[cluster_i], sigma_woodbury_stable_aux, sigma_woodbury_stable_aux, false);
-					//sigma_woodbury_stable = sigma_woodbury_stable_aux.transpose();
-					//sigma_woodbury_stable.diagonal().array() += 1.;
-					//chol_fact_sigma_woodbury_stable_[cluster_i].compute(sigma_woodbury_stable);
+					CalcCholFactSigmaWoodburyFITC_FSA(cluster_i);
 				}
 				else {
 					Log::REFatal("Matrix inversion method '%s' is not supported.", matrix_inversion_method_.c_str());
@@ -7006,6 +7530,59 @@ namespace GPBoost {
 			}
 		}//end CalcCovFactorFITC_FSA
 
+		/*!
+		* \brief Calculate the Cholesky factor of the Woodbury matrix sigma_ip + cross_cov^T * sigma_resid^-1 * cross_cov for fitc and full scale approximations
+		*		Note: if matrix_inversion_method_ == "iterative", this is only done for the FITC approximation when it is needed for calculating predictive (co)variances and Fisher information matrices
+		* \param cluster_i Cluster index
+		*/
+		void CalcCholFactSigmaWoodburyFITC_FSA(data_size_t cluster_i) {
+			const den_mat_t* cross_cov = re_comps_cross_cov_[cluster_i][0]->GetSigmaPtr();
+			den_mat_t sigma_ip_stable = *(re_comps_ip_[cluster_i][0]->GetZSigmaZt());
+			sigma_ip_stable.diagonal().array() *= JITTER_MULT_IP_FITC_FSA;
+			den_mat_t sigma_woodbury;// sigma_woodbury = sigma_ip + cross_cov^T * sigma_resid^-1 * cross_cov or for Preconditioner sigma_ip + cross_cov^T * D^-1 * cross_cov
+			if (FITCStreaming()) {
+				// accumulate the lower triangle of cross_cov^T * sigma_resid^-1 * cross_cov with symmetric rank-k updates over blocks of rows of cross_cov
+				data_size_t num_REs = re_comps_cross_cov_[cluster_i][0]->GetNumUniqueREs();
+				den_mat_t sigma_woodbury_lower = den_mat_t::Zero(sigma_ip_stable.rows(), sigma_ip_stable.cols());
+				den_mat_t cross_cov_block;
+				for (data_size_t row_start = 0; row_start < num_REs; row_start += fitc_streaming_block_size_) {
+					data_size_t num_rows = std::min(fitc_streaming_block_size_, num_REs - row_start);
+					re_comps_cross_cov_[cluster_i][0]->CalcSigmaRows(row_start, num_rows, cross_cov_block);
+					den_mat_t resid_Ihalf_cross_cov_block = fitc_resid_diag_[cluster_i].segment(row_start, num_rows).cwiseInverse().cwiseSqrt().asDiagonal() * cross_cov_block;
+					sigma_woodbury_lower.selfadjointView<Eigen::Lower>().rankUpdate(resid_Ihalf_cross_cov_block.transpose());
+				}
+				sigma_woodbury = sigma_woodbury_lower.selfadjointView<Eigen::Lower>();
+			}
+			else if (gp_approx_ == "fitc") {						
+				sigma_woodbury = ((*cross_cov).transpose() * fitc_resid_diag_[cluster_i].cwiseInverse().asDiagonal()) * (*cross_cov);
+			}
+			else if (gp_approx_ == "full_scale_tapering") {
+				// factorize residual covariance matrix
+				std::shared_ptr<T_mat> sigma_resid = re_comps_resid_[cluster_i][0]->GetZSigmaZt();
+				CalcCholFSAResid(*sigma_resid, cluster_i);
+				den_mat_t sigma_resid_Ihalf_cross_cov;
+				//ApplyPermutationCholeskyFactor<den_mat_t, T_chol>(chol_fact_resid_[cluster_i], *cross_cov, sigma_resid_Ihalf_cross_cov, false);//DELETE_SOLVEINPLACE
+				//chol_fact_resid_[cluster_i].matrixL().solveInPlace(sigma_resid_Ihalf_cross_cov);
+				TriangularSolveGivenCholesky<T_chol, T_mat, den_mat_t, den_mat_t>(chol_fact_resid_[cluster_i], *cross_cov, sigma_resid_Ihalf_cross_cov, false);
+				sigma_woodbury = sigma_resid_Ihalf_cross_cov.transpose() * sigma_resid_Ihalf_cross_cov;
+			}
+			sigma_woodbury += sigma_ip_stable;
+
+			//// adding jitter to this Woodbury matrix changes the results too much without helping really (06.11.2024)
+			//sigma_woodbury.diagonal().array() *= JITTER_MULT_IP_FITC_FSA;
+
+			chol_fact_sigma_woodbury_[cluster_i].compute(sigma_woodbury);
+
+			////alternative way for calculating determinants with Woodbury (does not solve numerical stability issue, 05.06.2024)
+			//den_mat_t sigma_woodbury_stable = sigma_woodbury;
+			//TriangularSolveGivenCholesky<chol_den_mat_t, den_mat_t, den_mat_t, den_mat_t>(chol_fact_sigma_ip_[cluster_i], sigma_woodbury_stable, sigma_woodbury_stable, false);
+			//den_mat_t sigma_woodbury_stable_aux = sigma_woodbury_stable.transpose();
+			//TriangularSolveGivenCholesky<chol_den_mat_t, den_mat_t, den_mat_t, den_mat_t>(chol_fact_sigma_ip_[cluster_i], sigma_woodbury_stable_aux, sigma_woodbury_stable_aux, false);
+			//sigma_woodbury_stable = sigma_woodbury_stable_aux.transpose();
+			//sigma_woodbury_stable.diagonal().array() += 1.;
+			//chol_fact_sigma_woodbury_stable_[cluster_i].compute(sigma_woodbury_stable);
+		}//end CalcCholFactSigmaWoodburyFITC_FSA
+
 		/*!
 		* \brief Calculate Psi^-1*y (and save in y_aux_)
 		* \param marg_variance The marginal variance. Default = 1.
@@ -7013,6 +7590,7 @@ namespace GPBoost {
 		void CalcYAux(double marg_variance) {
 			CHECK(gauss_likelihood_);
 			for (const auto& cluster_i : unique_clusters_) {
+				IterationArena::Scope arena_scope(arena_);
 				if (y_.find(cluster_i) == y_.end()) {
 					Log::REFatal("Response variable data (y_) for random effects model has not been set. Call 'SetY' first ");
 				}
@@ -7025,23 +7603,31 @@ namespace GPBoost {
 				else if (gp_approx_ == "fitc" || gp_approx_ == "full_scale_tapering") {
 					const den_mat_t* cross_cov = re_comps_cross_cov_[cluster_i][0]->GetSigmaPtr();
 					if (matrix_inversion_method_ == "cholesky") {
-						if (gp_approx_ == "fitc") {
-							vec_t cross_covT_y = (*cross_cov).transpose() * (fitc_resid_diag_[cluster_i].cwiseInverse().asDiagonal() * y_[cluster_i]);
-							vec_t sigma_woodbury_I_cross_covT_y = chol_fact_sigma_woodbury_[cluster_i].solve(cross_covT_y);
-							cross_covT_y.resize(0);
-							vec_t cross_cov_sigma_woodbury_I_cross_covT_y = fitc_resid_diag_[cluster_i].cwiseInverse().asDiagonal() * ((*cross_cov) * sigma_woodbury_I_cross_covT_y);
-							sigma_woodbury_I_cross_covT_y.resize(0);
-							y_aux_[cluster_i] = fitc_resid_diag_[cluster_i].cwiseInverse().asDiagonal() * y_[cluster_i] - cross_cov_sigma_woodbury_I_cross_covT_y;
+						if (FITCStreaming()) {
+							CalcPsiInvRhsFITCStreaming<vec_t>(cluster_i, y_[cluster_i], y_aux_[cluster_i]);
+						}
+						else if (gp_approx_ == "fitc") {
+							arena_vec_t resid_diag_I_y = arena_.Vec(num_data_per_cluster_[cluster_i]);
+							resid_diag_I_y = y_[cluster_i].cwiseQuotient(fitc_resid_diag_[cluster_i]);
+							arena_vec_t cross_covT_y = arena_.Vec((*cross_cov).cols());
+							cross_covT_y.noalias() = (*cross_cov).transpose() * resid_diag_I_y;
+							arena_vec_t sigma_woodbury_I_cross_covT_y = arena_.Vec((*cross_cov).cols());
+							sigma_woodbury_I_cross_covT_y = chol_fact_sigma_woodbury_[cluster_i].solve(cross_covT_y);
+							arena_vec_t cross_cov_sigma_woodbury_I_cross_covT_y = arena_.Vec(num_data_per_cluster_[cluster_i]);
+							cross_cov_sigma_woodbury_I_cross_covT_y.noalias() = (*cross_cov) * sigma_woodbury_I_cross_covT_y;
+							y_aux_[cluster_i] = resid_diag_I_y - cross_cov_sigma_woodbury_I_cross_covT_y.cwiseQuotient(fitc_resid_diag_[cluster_i]);
 						}
 						else if (gp_approx_ == "full_scale_tapering") {
-							vec_t sigma_resid_I_y = chol_fact_resid_[cluster_i].solve(y_[cluster_i]);
-							vec_t cross_covT_sigma_resid_I_y = (*cross_cov).transpose() * sigma_resid_I_y;
-							vec_t sigma_woodbury_I_cross_covT_sigma_resid_I_y = chol_fact_sigma_woodbury_[cluster_i].solve(cross_covT_sigma_resid_I_y);
-							cross_covT_sigma_resid_I_y.resize(0);
-							vec_t cross_cov_sigma_woodbury_I_cross_covT_sigma_resid_I_y = (*cross_cov) * sigma_woodbury_I_cross_covT_sigma_resid_I_y;
-							sigma_woodbury_I_cross_covT_sigma_resid_I_y.resize(0);
-							vec_t sigma_resid_I_cross_cov_sigma_woodbury_I_cross_covT_sigma_resid_I_y = chol_fact_resid_[cluster_i].solve(cross_cov_sigma_woodbury_I_cross_covT_sigma_resid_I_y);
-							y_aux_[cluster_i] = sigma_resid_I_y - sigma_resid_I_cross_cov_sigma_woodbury_I_cross_covT_sigma_resid_I_y;
+							arena_vec_t sigma_resid_I_y = arena_.Vec(num_data_per_cluster_[cluster_i]);
+							sigma_resid_I_y = chol_fact_resid_[cluster_i].solve(y_[cluster_i]);
+							arena_vec_t cross_covT_sigma_resid_I_y = arena_.Vec((*cross_cov).cols());
+							cross_covT_sigma_resid_I_y.noalias() = (*cross_cov).transpose() * sigma_resid_I_y;
+							arena_vec_t sigma_woodbury_I_cross_covT_sigma_resid_I_y = arena_.Vec((*cross_cov).cols());
+							sigma_woodbury_I_cross_covT_sigma_resid_I_y = chol_fact_sigma_woodbury_[cluster_i].solve(cross_covT_sigma_resid_I_y);
+							arena_vec_t cross_cov_sigma_woodbury_I_cross_covT_sigma_resid_I_y = arena_.Vec(num_data_per_cluster_[cluster_i]);
+							cross_cov_sigma_woodbury_I_cross_covT_sigma_resid_I_y.noalias() = (*cross_cov) * sigma_woodbury_I_cross_covT_sigma_resid_I_y;
+							y_aux_[cluster_i] = chol_fact_resid_[cluster_i].solve(cross_cov_sigma_woodbury_I_cross_covT_sigma_resid_I_y);
+							y_aux_[cluster_i] = sigma_resid_I_y - y_aux_[cluster_i];
 						}
 					}
 					else {
@@ -7057,15 +7643,24 @@ namespace GPBoost {
 						if (first_update_) {
 							cg_max_num_it = (int)round(cg_max_num_it_ / 3);
 						}
-						std::shared_ptr<T_mat> sigma_resid = re_comps_resid_[cluster_i][0]->GetZSigmaZt();
-						const den_mat_t* cross_cov_preconditioner;
-						if (cg_preconditioner_type_ == "fitc") {
-							cross_cov_preconditioner = re_comps_cross_cov_preconditioner_[cluster_i][0]->GetSigmaPtr();
+						if (gp_approx_ == "fitc") {
+							const den_mat_t* cross_cov_preconditioner = cross_cov;
+							if (cg_preconditioner_type_ == "fitc") {
+								cross_cov_preconditioner = re_comps_cross_cov_preconditioner_[cluster_i][0]->GetSigmaPtr();
+							}
+							CGFITC(fitc_resid_diag_[cluster_i], *cross_cov, chol_fact_sigma_ip_[cluster_i], y_[cluster_i], y_aux_[cluster_i],
+								NaN_found, cg_max_num_it, cg_delta_conv_, THRESHOLD_ZERO_RHS_CG_, cg_preconditioner_type_,
+								*cross_cov_preconditioner, chol_fact_woodbury_preconditioner_[cluster_i], diagonal_approx_inv_preconditioner_[cluster_i]);
+						}
+						else if (cg_preconditioner_type_ == "fitc") {
+							std::shared_ptr<T_mat> sigma_resid = re_comps_resid_[cluster_i][0]->GetZSigmaZt();
+							const den_mat_t* cross_cov_preconditioner = re_comps_cross_cov_preconditioner_[cluster_i][0]->GetSigmaPtr();
 							CGFSA<T_mat>(*sigma_resid, *cross_cov_preconditioner, chol_ip_cross_cov_[cluster_i], y_[cluster_i], y_aux_[cluster_i],
 								NaN_found, cg_max_num_it, cg_delta_conv_, THRESHOLD_ZERO_RHS_CG_, cg_preconditioner_type_,
 								chol_fact_woodbury_preconditioner_[cluster_i], diagonal_approx_inv_preconditioner_[cluster_i]);
 						}
 						else {
+							std::shared_ptr<T_mat> sigma_resid = re_comps_resid_[cluster_i][0]->GetZSigmaZt();
 							CGFSA<T_mat>(*sigma_resid, *cross_cov, chol_ip_cross_cov_[cluster_i], y_[cluster_i], y_aux_[cluster_i],
 								NaN_found, cg_max_num_it, cg_delta_conv_, THRESHOLD_ZERO_RHS_CG_, cg_preconditioner_type_,
 								chol_fact_woodbury_preconditioner_[cluster_i], diagonal_approx_inv_preconditioner_[cluster_i]);
@@ -7078,14 +7673,19 @@ namespace GPBoost {
 					}
 				}//end gp_approx_ == "fitc" || gp_approx_ == "full_scale_tapering"
 				else if (only_grouped_REs_use_woodbury_identity_) {
-					vec_t MInvZty;
+					arena_vec_t MInvZty = arena_.Vec(Zty_[cluster_i].size());
 					if (num_re_group_total_ == 1 && num_comps_total_ == 1) {//only one random effect -> ZtZ_ is diagonal
 						MInvZty = (Zty_[cluster_i].array() / sqrt_diag_SigmaI_plus_ZtZ_[cluster_i].array().square()).matrix();
 					}
+					else if (GroupedREsIterative()) {
+						SolveSigmaIPlusZtZIterative(Zty_[cluster_i], MInvZty_[cluster_i], cluster_i);
+						MInvZty = MInvZty_[cluster_i];
+					}
 					else {
 						MInvZty = chol_facts_[cluster_i].solve(Zty_[cluster_i]);
 					}
-					y_aux_[cluster_i] = y_[cluster_i] - Zt_[cluster_i].transpose() * MInvZty;
+					y_aux_[cluster_i] = y_[cluster_i];
+					y_aux_[cluster_i].noalias() -= Zt_[cluster_i].transpose() * MInvZty;
 				}
 				else {//not only_grouped_REs_use_woodbury_identity_ || gp_approx_ == "vecchia" || gp_approx_ == "fitc" || gp_approx_ == "full_scale_tapering"
 					y_aux_[cluster_i] = chol_facts_[cluster_i].solve(y_[cluster_i]);
@@ -7097,6 +7697,105 @@ namespace GPBoost {
 			y_aux_has_been_calculated_ = true;
 		}
 
+		/*!
+		* \brief Calculate the Cholesky factor of Sigma^-1 + Z^T * Z if iterative methods are used for grouped random effects and this has not yet been done
+		*		for the current covariance parameters. The factor is only needed for, e.g., predictive variances and Fisher information matrices
+		*/
+		void CalcCholFactGroupedREsIterative() {
+			if (GroupedREsIterative() && !chol_fact_grouped_REs_iterative_calculated_) {
+				for (const auto& cluster_i : unique_clusters_) {
+					CalcChol(SigmaI_plus_ZtZ_[cluster_i], cluster_i);
+				}
+				chol_fact_grouped_REs_iterative_calculated_ = true;
+			}
+		}//end CalcCholFactGroupedREsIterative
+
+		/*!
+		* \brief Calculate (Sigma^-1 + Z^T * Z)^-1 * rhs with the conjugate gradient algorithm when having only grouped random effects
+		* \param rhs Right-hand side (vector or matrix)
+		* \param[out] sol Solution. If this has the correct dimensions, it is used as initial value (e.g., the solution from the previous iteration)
+		* \param cluster_i Cluster index
+		*/
+		template <typename T_dense>
+		void SolveSigmaIPlusZtZIterative(const T_dense& rhs,
+			T_dense& sol,
+			data_size_t cluster_i) {
+			CHECK(GroupedREsIterative());
+			den_mat_t U;
+			if (sol.rows() == rhs.rows() && sol.cols() == rhs.cols()) {
+				U = sol;
+			}
+			else {
+				U = den_mat_t::Zero(rhs.rows(), rhs.cols());
+			}
+			//Reduce max. number of iterations for the CG in first update
+			int cg_max_num_it = cg_max_num_it_;
+			if (first_update_) {
+				cg_max_num_it = (int)round(cg_max_num_it_ / 3);
+			}
+			CGGroupedRE<T_mat>(SigmaI_plus_ZtZ_[cluster_i], diag_SigmaI_plus_ZtZ_[cluster_i], rhs, U,
+				NaN_found, cg_max_num_it, cg_delta_conv_, THRESHOLD_ZERO_RHS_CG_, cg_preconditioner_type_);
+			if (NaN_found) {
+				Log::REFatal("There was Nan or Inf value generated in the Conjugate Gradient Method!");
+			}
+			sol = U;
+		}//end SolveSigmaIPlusZtZIterative
+
+		/*!
+		* \brief Stochastic Lanczos quadrature approximation of log(det(Sigma^-1 + Z^T * Z)) when having only grouped random effects.
+		*		(Sigma^-1 + Z^T * Z)^-1 * (probe vectors) is saved in 'solution_for_trace_' and reused for the stochastic traces in the gradient
+		* \param cluster_i Cluster index
+		* \return Approximation of log(det(Sigma^-1 + Z^T * Z))
+		*/
+		double CalcLogDetSigmaIPlusZtZStochastic(data_size_t cluster_i) {
+			CHECK(GroupedREsIterative());
+			const data_size_t num_REs = cum_num_rand_eff_[cluster_i][num_re_group_total_];
+			// Sample probe vectors u ~ N(0,I)
+			if (!saved_rand_vec_[cluster_i]) {
+				if (!cg_generator_seeded_) {
+					cg_generator_ = RNG_t(seed_rand_vec_trace_);
+					cg_generator_seeded_ = true;
+				}
+				rand_vec_probe_P_[cluster_i].resize(num_REs, num_rand_vec_trace_);
+				GenRandVecNormal(cg_generator_, rand_vec_probe_P_[cluster_i]);
+				if (reuse_rand_vec_trace_) {
+					saved_rand_vec_[cluster_i] = true;
+				}
+			}
+			// Probe vectors z ~ N(0,P): z = (D + L) * D^(-1/2) * u for "ssor" and z = D^(1/2) * u for "diagonal"
+			if (cg_preconditioner_type_ == "ssor") {
+				T_mat SigmaI_plus_ZtZ_lower = SigmaI_plus_ZtZ_[cluster_i].template triangularView<Eigen::Lower>();
+				rand_vec_probe_[cluster_i] = SigmaI_plus_ZtZ_lower * (diag_SigmaI_plus_ZtZ_[cluster_i].cwiseSqrt().cwiseInverse().asDiagonal() * rand_vec_probe_P_[cluster_i]);
+			}
+			else if (cg_preconditioner_type_ == "diagonal") {
+				rand_vec_probe_[cluster_i] = diag_SigmaI_plus_ZtZ_[cluster_i].cwiseSqrt().asDiagonal() * rand_vec_probe_P_[cluster_i];
+			}
+			else {
+				rand_vec_probe_[cluster_i] = rand_vec_probe_P_[cluster_i];
+			}
+			solution_for_trace_[cluster_i].resize(num_REs, num_rand_vec_trace_);
+			int cg_max_num_it_tridiag = cg_max_num_it_tridiag_;
+			if (first_update_) {
+				cg_max_num_it_tridiag = (int)round(cg_max_num_it_tridiag_ / 3);
+			}
+			std::vector<vec_t> Tdiags(num_rand_vec_trace_, vec_t(cg_max_num_it_tridiag));
+			std::vector<vec_t> Tsubdiags(num_rand_vec_trace_, vec_t(cg_max_num_it_tridiag - 1));
+			CGTridiagGroupedRE<T_mat>(SigmaI_plus_ZtZ_[cluster_i], diag_SigmaI_plus_ZtZ_[cluster_i], rand_vec_probe_[cluster_i],
+				Tdiags, Tsubdiags, solution_for_trace_[cluster_i], NaN_found, num_REs,
+				num_rand_vec_trace_, cg_max_num_it_tridiag, cg_delta_conv_, cg_preconditioner_type_);
+			if (NaN_found) {
+				Log::REFatal("There was Nan or Inf value generated in the Conjugate Gradient Method!");
+			}
+			double log_det;
+			LogDetStochTridiag(Tdiags, Tsubdiags, log_det, num_REs, num_rand_vec_trace_);
+			// Correction for preconditioner: log(det(P)) = log(det(D)) for both "ssor" and "diagonal"
+			if (cg_preconditioner_type_ != "none") {
+				log_det += diag_SigmaI_plus_ZtZ_[cluster_i].array().log().sum();
+			}
+			solution_for_trace_grouped_REs_calculated_[cluster_i] = true;
+			return(log_det);
+		}//end CalcLogDetSigmaIPlusZtZStochastic
+
 		/*!
 		* \brief Calculate y_tilde = L^-1 * Z^T * y, L = chol(Sigma^-1 + Z^T * Z) (and save in y_tilde_)
 		* \param also_calculate_ytilde2 If true, y_tilde2 = Z * L^-T * L^-1 * Z^T * y is also calculated
@@ -7113,6 +7812,12 @@ namespace GPBoost {
 						y_tilde2_[cluster_i] = Zt_[cluster_i].transpose() * ((y_tilde_[cluster_i].array() / sqrt_diag_SigmaI_plus_ZtZ_[cluster_i].array()).matrix());
 					}
 				}
+				else if (GroupedREsIterative()) {//y_tilde is not calculated, (Sigma^-1 + Z^T * Z)^-1 * Z^T * y is saved in MInvZty_ instead
+					SolveSigmaIPlusZtZIterative(Zty_[cluster_i], MInvZty_[cluster_i], cluster_i);
+					if (also_calculate_ytilde2) {
+						y_tilde2_[cluster_i] = Zt_[cluster_i].transpose() * MInvZty_[cluster_i];
+					}
+				}
 				else {
 					TriangularSolveGivenCholesky<T_chol, T_mat, vec_t, vec_t>(chol_facts_[cluster_i], Zty_[cluster_i], y_tilde_[cluster_i], false);
 					if (also_calculate_ytilde2) {
@@ -7173,10 +7878,18 @@ namespace GPBoost {
 					if (!CalcYtilde_already_done) {
 						CalcYtilde(false);//y_tilde = L^-1 * Z^T * y, L = chol(Sigma^-1 + Z^T * Z)
 					}
-					else if ((int)y_tilde_[cluster_i].size() != cum_num_rand_eff_[cluster_i][num_re_group_total_]) {
-						Log::REFatal("y_tilde = L^-1 * Z^T * y has not the correct number of data points. Call 'CalcYtilde' first.");
+					if (GroupedREsIterative()) {
+						if ((int)MInvZty_[cluster_i].size() != cum_num_rand_eff_[cluster_i][num_re_group_total_]) {
+							Log::REFatal("(Sigma^-1 + Z^T * Z)^-1 * Z^T * y has not the correct number of data points. Call 'CalcYtilde' first.");
+						}
+						yTPsiInvy += (y_[cluster_i].transpose() * y_[cluster_i])(0, 0) - Zty_[cluster_i].dot(MInvZty_[cluster_i]);
+					}
+					else {
+						if ((int)y_tilde_[cluster_i].size() != cum_num_rand_eff_[cluster_i][num_re_group_total_]) {
+							Log::REFatal("y_tilde = L^-1 * Z^T * y has not the correct number of data points. Call 'CalcYtilde' first.");
+						}
+						yTPsiInvy += (y_[cluster_i].transpose() * y_[cluster_i])(0, 0) - (y_tilde_[cluster_i].transpose() * y_tilde_[cluster_i])(0, 0);
 					}
-					yTPsiInvy += (y_[cluster_i].transpose() * y_[cluster_i])(0, 0) - (y_tilde_[cluster_i].transpose() * y_tilde_[cluster_i])(0, 0);
 				}//end only_grouped_REs_use_woodbury_identity_
 				else {//not only_grouped_REs_use_woodbury_identity_
 					if (CalcYAux_already_done) {
@@ -7218,6 +7931,7 @@ namespace GPBoost {
 			bool include_error_var,
 			bool use_saved_psi_inv) {
 			CHECK(gauss_likelihood_);
+			CalcCholFactGroupedREsIterative();
 			if (include_error_var) {
 				FI = den_mat_t(num_cov_par_, num_cov_par_);
 			}
@@ -7438,7 +8152,13 @@ namespace GPBoost {
 			bool include_error_var,
 			int first_cov_par) {
 			CHECK(gauss_likelihood_);
+			if (FITCStreaming()) {
+				Log::REFatal("The Fisher information is currently not implemented when 'fitc_streaming_block_size' > 0 ");
+			}
 			for (const auto& cluster_i : unique_clusters_) {
+				if (gp_approx_ == "fitc" && matrix_inversion_method_ == "iterative") {
+					CalcCholFactSigmaWoodburyFITC_FSA(cluster_i);
+				}
 				// Hutchinson's Trace estimator
 				// Sample vectors
 				if (!saved_rand_vec_fisher_info_[cluster_i]) {
@@ -7978,6 +8698,9 @@ namespace GPBoost {
 			vec_t& mean_pred_id,
 			T_mat& cov_mat_pred_id,
 			vec_t& var_pred_id) {
+			if (predict_cov_mat || predict_var) {
+				CalcCholFactGroupedREsIterative();
+			}
 			int num_REs_obs, num_REs_pred;
 			if (only_one_grouped_RE_calculations_on_RE_scale_ || only_one_grouped_RE_calculations_on_RE_scale_for_prediction_) {
 				num_REs_pred = (int)re_group_levels_pred[0].size();
@@ -8304,10 +9027,16 @@ namespace GPBoost {
 			T_mat cov_mat_pred_obs, cov_mat_pred; // unused dummy variables
 			std::shared_ptr<T_mat> sigma_resid;
 			sp_mat_t fitc_resid_pred_obs;//FITC residual correction for entries for which the prediction and training coordinates are the same
+			sp_mat_t fitc_resid_pred_dupl_obs;//same as fitc_resid_pred_obs but only for the columns (training locations) in dupl_obs_ind
+			std::vector<int> dupl_obs_ind;//training locations that also appear in the prediction locations
+			den_mat_t cross_cov_dupl_obs;//rows of the cross-covariance matrix for the training locations in dupl_obs_ind
 			bool has_fitc_correction = false;
 			if (num_comps_total_ > 1) {
 				Log::REFatal("CalcPredFITC_FSA is not implemented when num_comps_total_ > 1");
 			}
+			if (gauss_likelihood_ && gp_approx_ == "fitc" && matrix_inversion_method_ == "iterative") {
+				CalcCholFactSigmaWoodburyFITC_FSA(cluster_i);
+			}
 			// Construct components
 			const den_mat_t* cross_cov = re_comps_cross_cov_[cluster_i][0]->GetSigmaPtr();
 			den_mat_t sigma_ip_stable = *(re_comps_ip_[cluster_i][0]->GetZSigmaZt());
@@ -8339,8 +9068,7 @@ namespace GPBoost {
 				for (int i = 0; i < num_REs_pred; ++i) {
 					coords_pred_sum[i] = gp_coords_mat_pred(i, Eigen::all).sum();
 				}
-				den_mat_t sigma_ip_inv_cross_cov_T;
-				re_comp_cross_cov_cluster_i_pred_ip->coords_;
+				std::vector<std::pair<int, int>> duplicate_pred_obs;// pairs of prediction and training indices with the same coordinates
 #pragma omp parallel for schedule(static)
 				for (int ii = 0; ii < num_REs_pred; ++ii) {
 					for (int jj = 0; jj < num_REs_obs; ++jj) {
@@ -8351,22 +9079,45 @@ namespace GPBoost {
 							}
 							if (are_the_same) {
 #pragma omp critical
-								{
-									if (!has_fitc_correction) {
-										has_fitc_correction = true;
-										sigma_ip_inv_cross_cov_T = chol_fact_sigma_ip_[cluster_i].solve((*cross_cov).transpose());
-									}
-								}
-								double fitc_corr_ij = sigma2 - (cross_cov_pred_ip.row(ii)).dot(sigma_ip_inv_cross_cov_T.col(jj));
-#pragma omp critical
-								triplets.push_back(Triplet_t(ii, jj, fitc_corr_ij));
+								duplicate_pred_obs.push_back(std::pair<int, int>(ii, jj));
 							}
 						}
 					}
 				}
-				if (has_fitc_correction) {
+				if (!duplicate_pred_obs.empty()) {
+					has_fitc_correction = true;
+					// only the rows of the cross-covariance matrix for the training locations that also appear in the prediction locations are needed
+					std::sort(duplicate_pred_obs.begin(), duplicate_pred_obs.end());
+					std::map<int, int> obs_to_dupl_row;
+					for (const auto& pair : duplicate_pred_obs) {
+						if (obs_to_dupl_row.find(pair.second) == obs_to_dupl_row.end()) {
+							int dupl_row = (int)obs_to_dupl_row.size();
+							obs_to_dupl_row[pair.second] = dupl_row;
+							dupl_obs_ind.push_back(pair.second);
+						}
+					}
+					if (FITCStreaming()) {
+						re_comp_cross_cov_cluster_i_pred_ip->CalcSigmaRows(dupl_obs_ind, cross_cov_dupl_obs);
+					}
+					else {
+						cross_cov_dupl_obs = (*cross_cov)(dupl_obs_ind, Eigen::all);
+					}
+					den_mat_t sigma_ip_inv_cross_cov_dupl_obs_T = chol_fact_sigma_ip_[cluster_i].solve(cross_cov_dupl_obs.transpose());
+					triplets.resize(duplicate_pred_obs.size());
+					std::vector<Triplet_t> triplets_dupl(duplicate_pred_obs.size());
+#pragma omp parallel for schedule(static)
+					for (int i = 0; i < (int)duplicate_pred_obs.size(); ++i) {
+						int ii = duplicate_pred_obs[i].first;
+						int jj = duplicate_pred_obs[i].second;
+						int jj_dupl = obs_to_dupl_row.at(jj);
+						double fitc_corr_ij = sigma2 - (cross_cov_pred_ip.row(ii)).dot(sigma_ip_inv_cross_cov_dupl_obs_T.col(jj_dupl));
+						triplets[i] = Triplet_t(ii, jj, fitc_corr_ij);
+						triplets_dupl[i] = Triplet_t(ii, jj_dupl, fitc_corr_ij);
+					}
 					fitc_resid_pred_obs = sp_mat_t(num_REs_pred, num_REs_obs);
 					fitc_resid_pred_obs.setFromTriplets(triplets.begin(), triplets.end());
+					fitc_resid_pred_dupl_obs = sp_mat_t(num_REs_pred, (int)dupl_obs_ind.size());
+					fitc_resid_pred_dupl_obs.setFromTriplets(triplets_dupl.begin(), triplets_dupl.end());
 				}
 			}//end gp_approx_ == "fitc"
 			// Calculating predictive mean for gauss_likelihood_
@@ -8381,7 +9132,20 @@ namespace GPBoost {
 					pred_mean += sigma_resid_pred_obs * y_aux_[cluster_i];
 				}
 				else if (gp_approx_ == "fitc") {
-					pred_mean = cross_cov_pred_ip * (chol_fact_sigma_woodbury_[cluster_i].solve((*cross_cov).transpose() * (fitc_resid_diag_[cluster_i].cwiseInverse().cwiseProduct(y_[cluster_i]))));
+					vec_t cross_covT_resid_inv_y;
+					if (FITCStreaming()) {
+						cross_covT_resid_inv_y = vec_t::Zero(cross_cov_pred_ip.cols());
+						den_mat_t cross_cov_block;
+						for (data_size_t row_start = 0; row_start < num_REs_obs; row_start += fitc_streaming_block_size_) {
+							data_size_t num_rows = std::min(fitc_streaming_block_size_, num_REs_obs - row_start);
+							re_comp_cross_cov_cluster_i_pred_ip->CalcSigmaRows(row_start, num_rows, cross_cov_block);
+							cross_covT_resid_inv_y += cross_cov_block.transpose() * (fitc_resid_diag_[cluster_i].segment(row_start, num_rows).cwiseInverse().cwiseProduct(y_[cluster_i].segment(row_start, num_rows)));
+						}
+					}
+					else {
+						cross_covT_resid_inv_y = (*cross_cov).transpose() * (fitc_resid_diag_[cluster_i].cwiseInverse().cwiseProduct(y_[cluster_i]));
+					}
+					pred_mean = cross_cov_pred_ip * (chol_fact_sigma_woodbury_[cluster_i].solve(cross_covT_resid_inv_y));
 					if (has_fitc_correction) {
 						pred_mean += fitc_resid_pred_obs * y_aux_[cluster_i];
 					}
@@ -8467,7 +9231,9 @@ namespace GPBoost {
 						sp_mat_t resid_obs_inv_resid_pred_obs_t;
 						if (has_fitc_correction) {
 							resid_obs_inv_resid_pred_obs_t = fitc_resid_diag_[cluster_i].cwiseInverse().asDiagonal() * (fitc_resid_pred_obs.transpose());
-							Maux_rhs -= (*cross_cov).transpose() * resid_obs_inv_resid_pred_obs_t;
+							vec_t fitc_resid_diag_dupl_obs_inv = fitc_resid_diag_[cluster_i](dupl_obs_ind).cwiseInverse();
+							sp_mat_t resid_dupl_obs_inv_resid_pred_dupl_obs_t = fitc_resid_diag_dupl_obs_inv.asDiagonal() * (fitc_resid_pred_dupl_obs.transpose());
+							Maux_rhs -= cross_cov_dupl_obs.transpose() * resid_dupl_obs_inv_resid_pred_dupl_obs_t;
 						}
 						den_mat_t woodburry_part_sqrt;
 						TriangularSolveGivenCholesky<chol_den_mat_t, den_mat_t, den_mat_t, den_mat_t>(chol_fact_sigma_woodbury_[cluster_i], Maux_rhs, woodburry_part_sqrt, false);
@@ -8867,7 +9633,11 @@ namespace GPBoost {
 					pred_var,
 					calc_pred_cov,
 					calc_pred_var,
-					false);
+					false,
+					re_comps_ip_preconditioner_[cluster_i],
+					re_comps_cross_cov_preconditioner_[cluster_i],
+					chol_ip_cross_cov_preconditioner_[cluster_i],
+					chol_fact_sigma_ip_preconditioner_[cluster_i]);
 			}//end !gauss_likelihood_
 		}//end CalcPredFITC_FSA
 
@@ -9,6 +9,7 @@
 #ifndef GPB_SPARSE_MAT_H_
 #define GPB_SPARSE_MAT_H_
 #include <memory>
+#include <vector>
 #include <GPBoost/type_defs.h>
 #include <LightGBM/utils/log.h>
 #include <GPBoost/utils.h>
@@ -477,6 +478,34 @@ namespace GPBoost {
 		vec_t& ZtV,
 		bool initialize_zero);
 
+	/*!
+	* \brief Create an incidence matrix Z (one non-zero per row) from the indices that indicate to which random effect every data point is related.
+	*		The compressed column storage is built directly in parallel with a counting sort of the data points by random effect
+	* \param num_data Number of data points (= number of rows of Z)
+	* \param num_re Number of random effects (= number of columns of Z)
+	* \param random_effects_indices_of_data Indices that indicate to which random effect every data point is related
+	* \param values Values of the non-zero entries (e.g., covariate data for random coefficients). If nullptr, all non-zero entries are 1
+	* \param[out] Z Incidence matrix
+	*/
+	void CreateIncidenceMatrix(const data_size_t num_data,
+		const data_size_t num_re,
+		const data_size_t* const random_effects_indices_of_data,
+		const double* const values,
+		sp_mat_t& Z);
+
+	/*!
+	* \brief Calculate Zt = [Z_1, ..., Z_q]^T and ZtZ = Zt * Zt^T for incidence matrices Z_j that have exactly one non-zero entry per row.
+	*		Zt is built directly from the random effect indices of every data point, and the columns of ZtZ are calculated in parallel
+	*		from the co-occurrences of the random effects of the data points that belong to a random effect (no sparse matrix product)
+	* \param Z_comps Incidence matrices Z_j of the random effects components (all with the same number of rows)
+	* \param[out] Zt Transpose of the stacked incidence matrix
+	* \param[out] ZtZ Matrix Zt * Zt^T
+	* \return false if some Z_j does not have exactly one non-zero entry per row (Zt and ZtZ are then not calculated)
+	*/
+	bool CreateZtAndZtZFromIncidenceMatrices(const std::vector<const sp_mat_t*>& Z_comps,
+		sp_mat_t& Zt,
+		sp_mat_t& ZtZ);
+
 }  // namespace GPBoost
 
 #endif   // GPB_SPARSE_MAT_H_
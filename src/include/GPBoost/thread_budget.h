@@ -0,0 +1,124 @@
+/*!
+* This file is part of GPBoost a C++ library for combining
+*	boosting with Gaussian process and mixed effects models
+*
+* Copyright (c) 2020 Fabio Sigrist. All rights reserved.
+*
+* Licensed under the Apache License Version 2.0. See LICENSE file in the project root for license information.
+*/
+#ifndef GPB_THREAD_BUDGET_H_
+#define GPB_THREAD_BUDGET_H_
+
+#include <LightGBM/utils/openmp_wrapper.h>
+
+#include <vector>
+
+#if defined(__linux__) && defined(_OPENMP)
+#include <sched.h>
+#define GPB_THREAD_AFFINITY_SUPPORTED
+#endif
+
+namespace GPBoost {
+
+	/*!
+	* \brief Threads that a model is allowed to use for its computations
+	*/
+	struct ThreadBudget {
+		/*! \brief Maximal number of OpenMP threads. If <= 0, the settings of the calling thread are used */
+		int num_threads = 0;
+		/*! \brief CPUs to which the OpenMP threads are pinned (thread i is pinned to cpu_ids[i % cpu_ids.size()]). If empty, no pinning is done */
+		std::vector<int> cpu_ids;
+
+		/*! \brief Returns true if pinning threads to CPUs is supported on this platform */
+		static bool AffinitySupported() {
+#ifdef GPB_THREAD_AFFINITY_SUPPORTED
+			return true;
+#else
+			return false;
+#endif
+		}
+	};
+
+	/*!
+	* \brief Applies a ThreadBudget for the lifetime of this object and restores the previous settings on destruction.
+	*	The number of OpenMP threads is an internal control variable of the calling thread, i.e., other threads that use
+	*	other models or boosters concurrently are not affected.
+	*	Note: the budget only applies to OpenMP. The number of threads of Eigen's own parallelization (Eigen::setNbThreads) is a
+	*	process-wide setting and is not changed by models
+	*/
+	class ScopedThreadBudget {
+	public:
+		explicit ScopedThreadBudget(const ThreadBudget& budget) {
+			if (budget.num_threads > 0) {
+				prev_num_threads_omp_ = omp_get_max_threads();
+				omp_set_num_threads(budget.num_threads);
+				num_threads_changed_ = true;
+			}
+#ifdef GPB_THREAD_AFFINITY_SUPPORTED
+			if (!budget.cpu_ids.empty()) {
+				PinThreads(budget.cpu_ids);
+			}
+#endif
+		}
+
+		~ScopedThreadBudget() {
+#ifdef GPB_THREAD_AFFINITY_SUPPORTED
+			if (!prev_affinity_.empty()) {
+				RestoreAffinity();
+			}
+#endif
+			if (num_threads_changed_) {
+				omp_set_num_threads(prev_num_threads_omp_);
+			}
+		}
+
+		ScopedThreadBudget(const ScopedThreadBudget&) = delete;
+		ScopedThreadBudget& operator=(const ScopedThreadBudget&) = delete;
+
+	private:
+		bool num_threads_changed_ = false;
+		int prev_num_threads_omp_ = 1;
+
+#ifdef GPB_THREAD_AFFINITY_SUPPORTED
+		/*! \brief Affinity masks of the OpenMP threads before pinning (index = OpenMP thread number) */
+		std::vector<cpu_set_t> prev_affinity_;
+		/*! \brief 1 if the affinity mask of a thread has been saved and needs to be restored */
+		std::vector<char> affinity_saved_;
+
+		/*!
+		* \brief Pin every thread of the OpenMP team of the calling thread to a CPU.
+		*	Note: OpenMP runtimes reuse the same threads for teams of the same size, the previous masks are thus restored on the same threads
+		*/
+		void PinThreads(const std::vector<int>& cpu_ids) {
+			const int num_threads = omp_get_max_threads();
+			prev_affinity_.resize(num_threads);
+			affinity_saved_.assign(num_threads, 0);
+#pragma omp parallel num_threads(num_threads)
+			{
+				const int tid = omp_get_thread_num();
+				if (sched_getaffinity(0, sizeof(cpu_set_t), &prev_affinity_[tid]) == 0) {
+					cpu_set_t cpu_set;
+					CPU_ZERO(&cpu_set);
+					CPU_SET(cpu_ids[tid % cpu_ids.size()], &cpu_set);
+					if (sched_setaffinity(0, sizeof(cpu_set_t), &cpu_set) == 0) {
+						affinity_saved_[tid] = 1;
+					}
+				}
+			}
+		}
+
+		void RestoreAffinity() {
+#pragma omp parallel num_threads(static_cast<int>(prev_affinity_.size()))
+			{
+				const int tid = omp_get_thread_num();
+				if (affinity_saved_[tid] != 0) {
+					sched_setaffinity(0, sizeof(cpu_set_t), &prev_affinity_[tid]);
+				}
+			}
+		}
+#endif
+	};
+
+}  // namespace GPBoost
+
+#endif   // GPB_THREAD_BUDGET_H_
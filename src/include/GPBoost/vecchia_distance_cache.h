@@ -0,0 +1,163 @@
+/*!
+* This file is part of GPBoost a C++ library for combining
+*	boosting with Gaussian process and mixed effects models
+*
+* Copyright (c) 2020 Fabio Sigrist. All rights reserved.
+*
+* Licensed under the Apache License Version 2.0. See LICENSE file in the project root for license information.
+*/
+#ifndef GPB_VECCHIA_DISTANCE_CACHE_H_
+#define GPB_VECCHIA_DISTANCE_CACHE_H_
+
+#include <GPBoost/type_defs.h>
+
+#include <cmath>
+#include <vector>
+
+namespace GPBoost {
+
+	/*!
+	* \brief Compact cache of the distances needed for the Vecchia approximation with isotropic covariance functions.
+	*		For every point, the distances to its neighbors and the strict upper triangle of the distances among its neighbors
+	*		are stored contiguously in double or single precision. The full matrices are restored when they are used
+	*/
+	class VecchiaDistanceCache {
+	public:
+		/*!
+		* \brief Number of bytes needed for caching the distances
+		* \param nearest_neighbors Nearest neighbors of every point
+		* \param single_precision If true, the distances are stored in single precision
+		*/
+		static double RequiredBytes(const std::vector<std::vector<int>>& nearest_neighbors,
+			bool single_precision) {
+			double num_entries = 0.;
+			for (const auto& nn : nearest_neighbors) {
+				double m = (double)nn.size();
+				num_entries += m * (m + 1.) / 2.;
+			}
+			double size_entry = single_precision ? (double)sizeof(float) : (double)sizeof(double);
+			return(num_entries * size_entry + (double)(nearest_neighbors.size() + 1) * (double)sizeof(size_t));
+		}
+
+		/*!
+		* \brief Calculate and cache the distances
+		* \param coords Coordinates of all points
+		* \param nearest_neighbors Nearest neighbors of every point
+		* \param single_precision If true, the distances are stored in single precision
+		*/
+		void Build(const den_mat_t& coords,
+			const std::vector<std::vector<int>>& nearest_neighbors,
+			bool single_precision) {
+			Clear();
+			single_precision_ = single_precision;
+			offsets_.resize(nearest_neighbors.size() + 1);
+			offsets_[0] = 0;
+			for (size_t i = 0; i < nearest_neighbors.size(); ++i) {
+				size_t m = nearest_neighbors[i].size();
+				offsets_[i + 1] = offsets_[i] + m * (m + 1) / 2;
+			}
+			if (single_precision_) {
+				dist_float_.resize(offsets_.back());
+				Fill<float>(coords, nearest_neighbors, dist_float_.data());
+			}
+			else {
+				dist_double_.resize(offsets_.back());
+				Fill<double>(coords, nearest_neighbors, dist_double_.data());
+			}
+		}
+
+		/*! \brief Free the memory of the cache */
+		void Clear() {
+			std::vector<size_t>().swap(offsets_);
+			std::vector<double>().swap(dist_double_);
+			std::vector<float>().swap(dist_float_);
+		}
+
+		bool IsEmpty() const {
+			return(offsets_.empty());
+		}
+
+		bool SinglePrecision() const {
+			return(single_precision_);
+		}
+
+		/*! \brief Memory used by the cache in bytes */
+		double MemoryBytes() const {
+			return((double)offsets_.capacity() * sizeof(size_t) + (double)dist_double_.capacity() * sizeof(double) +
+				(double)dist_float_.capacity() * sizeof(float));
+		}
+
+		/*!
+		* \brief Restore the distances of a point
+		* \param i Index of the point
+		* \param[out] dist_obs_neighbors Distances between the point and its neighbors (num_neighbors x 1)
+		* \param[out] dist_between_neighbors Distances among the neighbors (num_neighbors x num_neighbors)
+		*/
+		void GetDistances(data_size_t i,
+			den_mat_t& dist_obs_neighbors,
+			den_mat_t& dist_between_neighbors) const {
+			size_t num_entries = offsets_[i + 1] - offsets_[i];
+			//num_entries = m * (m + 1) / 2
+			int m = (int)((std::sqrt(8. * (double)num_entries + 1.) - 1.) / 2. + 0.5);
+			if (single_precision_) {
+				Unpack<float>(dist_float_.data() + offsets_[i], m, dist_obs_neighbors, dist_between_neighbors);
+			}
+			else {
+				Unpack<double>(dist_double_.data() + offsets_[i], m, dist_obs_neighbors, dist_between_neighbors);
+			}
+		}
+
+	private:
+		/*! \brief Start of the distances of every point (length = number of points + 1) */
+		std::vector<size_t> offsets_;
+		std::vector<double> dist_double_;
+		std::vector<float> dist_float_;
+		bool single_precision_ = false;
+
+		template<typename T>
+		void Fill(const den_mat_t& coords,
+			const std::vector<std::vector<int>>& nearest_neighbors,
+			T* dist) const {
+			int num_points = (int)nearest_neighbors.size();
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < num_points; ++i) {
+				const std::vector<int>& nn = nearest_neighbors[i];
+				const int m = (int)nn.size();
+				T* dist_i = dist + offsets_[i];
+				for (int j = 0; j < m; ++j) {
+					dist_i[j] = (T)((coords(i, Eigen::all) - coords(nn[j], Eigen::all)).lpNorm<2>());
+				}
+				dist_i += m;
+				for (int j = 0; j < m; ++j) {
+					for (int k = j + 1; k < m; ++k) {
+						*dist_i++ = (T)((coords(nn[j], Eigen::all) - coords(nn[k], Eigen::all)).lpNorm<2>());
+					}
+				}
+			}
+		}
+
+		template<typename T>
+		static void Unpack(const T* dist,
+			int m,
+			den_mat_t& dist_obs_neighbors,
+			den_mat_t& dist_between_neighbors) {
+			dist_obs_neighbors.resize(m, 1);
+			dist_between_neighbors.resize(m, m);
+			for (int j = 0; j < m; ++j) {
+				dist_obs_neighbors(j, 0) = (double)dist[j];
+			}
+			dist += m;
+			for (int j = 0; j < m; ++j) {
+				dist_between_neighbors(j, j) = 0.;
+				for (int k = j + 1; k < m; ++k) {
+					double d = (double)(*dist++);
+					dist_between_neighbors(j, k) = d;
+					dist_between_neighbors(k, j) = d;
+				}
+			}
+		}
+	};
+
+}  // namespace GPBoost
+
+#endif   // GPB_VECCHIA_DISTANCE_CACHE_H_
@@ -336,6 +336,23 @@ class Bin {
   virtual void ConstructHistogram(data_size_t start, data_size_t end,
                                   const score_t* ordered_gradients, hist_t* out) const = 0;
 
+  /*!
+  * \brief Construct histogram of this feature without ordered gradients, i.e., the gradient of the data_indices[i]-th data
+  *        is gradients[data_indices[i]]. This saves the copy into ordered gradients when only one feature group
+  *        reads the gradients of a leaf
+  * \param data_indices Used data indices in current leaf
+  * \param start start index in data_indices
+  * \param end end index in data_indices
+  * \param gradients Pointer to the gradients of all data
+  * \param hessians Pointer to the hessians of all data
+  * \param out Output Result
+  */
+  virtual void ConstructHistogramUnordered(const data_size_t* data_indices, data_size_t start, data_size_t end,
+                                           const score_t* gradients, const score_t* hessians, hist_t* out) const = 0;
+
+  virtual void ConstructHistogramUnordered(const data_size_t* data_indices, data_size_t start, data_size_t end,
+                                           const score_t* gradients, hist_t* out) const = 0;
+
   virtual data_size_t Split(uint32_t min_bin, uint32_t max_bin,
                             uint32_t default_bin, uint32_t most_freq_bin,
                             MissingType missing_type, bool default_left,
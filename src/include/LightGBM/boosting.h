@@ -7,6 +7,7 @@
 
 #include <LightGBM/config.h>
 #include <LightGBM/meta.h>
+#include <LightGBM/nesterov_boosting.h>
 
 #include <string>
 #include <map>
@@ -20,6 +21,7 @@ class Dataset;
 class ObjectiveFunction;
 class Metric;
 struct PredictionEarlyStopInstance;
+struct TreeContribPaths;
 
 /*!
 * \brief The interface for Boosting
@@ -172,6 +174,25 @@ class LIGHTGBM_EXPORT Boosting {
   virtual void PredictContribByMap(const std::unordered_map<int, double>& features,
                                    std::vector<std::unordered_map<int, double>>* output) const = 0;
 
+  /*!
+  * \brief Precompute the root-to-leaf paths of the trees used by PredictContribBlock.
+  *        The paths are owned by the caller, e.g., a predictor, such that concurrent predictions do not change the model
+  * \param start_iteration Start index of the iteration to predict
+  * \param num_iteration Number of used iterations
+  * \param[out] paths Paths of every tree, only the trees of the used iterations are initialized
+  */
+  virtual void InitContribPaths(int start_iteration, int num_iteration, std::vector<TreeContribPaths>* paths) const = 0;
+
+  /*!
+  * \brief Feature contributions for the model's prediction of a block of records
+  * \param paths Paths of the trees calculated by InitContribPaths, only the trees with initialized paths are used
+  * \param features Feature values of the records in row-major format (num_rows x (MaxFeatureIdx() + 1))
+  * \param num_rows Number of records
+  * \param output Prediction results of the records in row-major format (NumPredictOneRow() values per record)
+  */
+  virtual void PredictContribBlock(const std::vector<TreeContribPaths>& paths, const double* features, int num_rows,
+                                   double* output) const = 0;
+
   /*!
   * \brief Dump model to json format string
   * \param start_iteration The model will be saved start from
@@ -215,6 +236,16 @@ class LIGHTGBM_EXPORT Boosting {
   */
   virtual std::string SaveModelToString(int start_iteration, int num_iterations, int feature_importance_type) const = 0;
 
+  /*!
+  * \brief Save the model to a file in the shared model format (see shared_model.h). The trees are stored as raw arrays
+  *        such that the model can be loaded without parsing or memory-mapped read-only by several processes for prediction (SharedModel)
+  * \param start_iteration The model will be saved start from
+  * \param num_iterations Number of model that want to save, -1 means save all
+  * \param filename Filename that want to save to
+  * \return true if succeeded
+  */
+  virtual bool SaveSharedModelToFile(int start_iteration, int num_iterations, const char* filename) const = 0;
+
   /*!
   * \brief Restore from a serialized string
   * \param buffer The content of model
@@ -223,6 +254,14 @@ class LIGHTGBM_EXPORT Boosting {
   */
   virtual bool LoadModelFromString(const char* buffer, size_t len) = 0;
 
+  /*!
+  * \brief Restore from a buffer in the shared model format
+  * \param buffer The content of the shared model (e.g., a memory-mapped shared model file), aligned to 8 bytes
+  * \param len The length of buffer
+  * \return true if succeeded
+  */
+  virtual bool LoadModelFromSharedModel(const char* buffer, size_t len) = 0;
+
   /*!
   * \brief Calculate feature importances
   * \param num_iteration Number of model that want to use for feature importance, -1 means use all
@@ -314,6 +353,39 @@ class LIGHTGBM_EXPORT Boosting {
   static Boosting* CreateBoosting(const std::string& type, const char* filename);
 
   virtual bool IsLinear() const { return false; }
+
+  /*! \brief Nesterov schedule */
+  static double NesterovSchedule(int iter, int momentum_schedule_version = 0,
+                                 double nesterov_acc_rate = 0.5, int momentum_offset = 0) {
+    if (iter < momentum_offset) {
+      return(0.);
+    } else if (momentum_schedule_version == 0) {
+      return(nesterov_acc_rate);
+    } else if (momentum_schedule_version == 1) {
+      return(1. - (3. / (6. + iter)));
+    } else {
+      return(0.);
+    }
+  }
+
+  /*!
+  * \brief Momentum step that is applied to the prediction of one data point before the trees of an iteration are added
+  * \param iter Iteration whose trees are added next
+  * \param num_tree_per_iteration Number of trees per iteration
+  * \param momentum_schedule_version, nesterov_acc_rate, momentum_offset Nesterov schedule (see NesterovSchedule)
+  * \param[out] output Prediction
+  * \param[out] pred_lag1 Prediction of the previous iteration (initialized in iteration 1)
+  */
+  static void PredictionMomentumStep(int iter, int num_tree_per_iteration, int momentum_schedule_version,
+                                     double nesterov_acc_rate, int momentum_offset,
+                                     double* output, std::vector<double>* pred_lag1) {
+    if (iter == 1) {
+      pred_lag1->assign(output, output + num_tree_per_iteration);
+    } else if (iter > 1) {
+      double mu = NesterovSchedule(iter, momentum_schedule_version, nesterov_acc_rate, momentum_offset);
+      DoOneMomentumStep(output, pred_lag1->data(), (int64_t)num_tree_per_iteration, mu);
+    }
+  }
 };
 
 class GBDTBase : public Boosting {
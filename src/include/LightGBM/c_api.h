@@ -30,6 +30,8 @@ typedef void* DatasetHandle;  /*!< \brief Handle of dataset. */
 typedef void* BoosterHandle;  /*!< \brief Handle of booster. */
 typedef void* FastConfigHandle; /*!< \brief Handle of FastConfig. */
 typedef void* REModelHandle;  /*!< \brief Handle of re_model. */
+typedef void* SharedModelHandle;  /*!< \brief Handle of a read-only memory-mapped model. */
+typedef void* REModelFoldsHandle;  /*!< \brief Handle of re_model for the folds of a cross-validation. */
 
 #define C_API_DTYPE_FLOAT32 (0)  /*!< \brief float32 (single precision float). */
 #define C_API_DTYPE_FLOAT64 (1)  /*!< \brief float64 (double precision float). */
@@ -60,6 +62,13 @@ GPBOOST_C_EXPORT const char* LGBM_GetLastError();
  */
 GPBOOST_C_EXPORT int LGBM_RegisterLogCallback(void (*callback)(const char*));
 
+/*!
+ * \brief Get the maximal number of OpenMP threads of the calling thread, i.e., ``omp_get_max_threads()``.
+ * \param[out] out Maximal number of OpenMP threads
+ * \return 0 when succeed, -1 when failure happens
+ */
+GPBOOST_C_EXPORT int LGBM_GetMaxThreads(int* out);
+
 // --- start Dataset interface
 
 /*!
@@ -440,7 +449,7 @@ GPBOOST_C_EXPORT int LGBM_GPBoosterCreate(const DatasetHandle train_data,
     BoosterHandle* out);
 
 /*!
- * \brief Load an existing booster from model file.
+ * \brief Load an existing booster from model file (in the text or the shared model format).
  * \param filename Filename of model
  * \param[out] out_num_iterations Number of iterations of this booster
  * \param[out] out Handle of created booster
@@ -1135,6 +1144,32 @@ GPBOOST_C_EXPORT int LGBM_BoosterPredictForMatSingleRowFast(FastConfigHandle fas
                                                              int64_t* out_len,
                                                              double* out_result);
 
+/*!
+ * \brief Faster variant of ``LGBM_BoosterPredictForMatSingleRowFast`` for micro-batches of rows.
+ *
+ * Score ``nrow`` rows after setup with ``LGBM_BoosterPredictForMatSingleRowFastInit``.
+ *
+ * Every row is copied straight into a dense feature buffer owned by the ``FastConfig``,
+ * without building (index, value) pairs, and the predictions are written into ``out_result``.
+ *
+ * \note
+ *   Different ``FastConfig`` objects of the same booster can be used from different threads at the same time,
+ *   a single ``FastConfig`` must not be.
+ *   Rows are scored sequentially on the calling thread.
+ *
+ * \param fastConfig_handle FastConfig object handle returned by ``LGBM_BoosterPredictForMatSingleRowFastInit``
+ * \param data Pointer to the data space, row-major with ``nrow`` rows
+ * \param nrow Number of rows
+ * \param[out] out_len Length of output result
+ * \param[out] out_result Pointer to array with predictions, must have space for ``nrow`` times the length of one row prediction
+ * \return 0 when it succeeds, -1 when failure happens
+ */
+GPBOOST_C_EXPORT int LGBM_BoosterPredictForMatRowsFast(FastConfigHandle fastConfig_handle,
+                                                       const void* data,
+                                                       const int32_t nrow,
+                                                       int64_t* out_len,
+                                                       double* out_result);
+
 /*!
  * \brief Make prediction for a new dataset presented in a form of array of pointers to rows.
  * \note
@@ -1186,6 +1221,81 @@ GPBOOST_C_EXPORT int LGBM_BoosterSaveModel(BoosterHandle handle,
                                             int feature_importance_type,
                                             const char* filename);
 
+/*!
+ * \brief Save the tree ensemble of a model into a file in the shared model format.
+ *        The file can be opened with ``LGBM_SharedModelCreateFromFile`` by several processes
+ *        that then share one read-only memory mapping of the model.
+ *        The trees are stored as raw arrays, i.e., the file is also loaded without parsing by ``LGBM_BoosterCreateFromModelfile``.
+ *        The text model format remains the format for exchanging models.
+ *        The random effects / Gaussian process model of a GPBoost booster is not saved,
+ *        i.e., predictions of a shared model only contain the tree ensemble part
+ * \param handle Handle of booster
+ * \param start_iteration Start index of the iteration that should be saved
+ * \param num_iteration Index of the iteration that should be saved, <= 0 means save all
+ * \param filename The name of the file
+ * \return 0 when succeed, -1 when failure happens
+ */
+GPBOOST_C_EXPORT int LGBM_BoosterSaveSharedModel(BoosterHandle handle,
+                                                  int start_iteration,
+                                                  int num_iteration,
+                                                  const char* filename);
+
+/*!
+ * \brief Map a shared model file (saved with ``LGBM_BoosterSaveSharedModel``) read-only into memory.
+ *        The trees are not copied, i.e., all processes that open the same file share the physical memory of the model.
+ *        Predictions only contain the tree ensemble part of a GPBoost booster.
+ * \param filename The name of the file
+ * \param[out] out Handle of the created shared model
+ * \return 0 when succeed, -1 when failure happens
+ */
+GPBOOST_C_EXPORT int LGBM_SharedModelCreateFromFile(const char* filename,
+                                                     SharedModelHandle* out);
+
+/*!
+ * \brief Get number of classes of a shared model.
+ * \param handle Handle of shared model
+ * \param[out] out_len Number of classes
+ * \return 0 when succeed, -1 when failure happens
+ */
+GPBOOST_C_EXPORT int LGBM_SharedModelGetNumClasses(SharedModelHandle handle,
+                                                    int* out_len);
+
+/*!
+ * \brief Make prediction for a new dataset with a shared model.
+ * \note
+ * You should pre-allocate memory for ``out_result`` (``nrow`` * number of classes).
+ * \param handle Handle of shared model
+ * \param data Pointer to the data space
+ * \param data_type Type of ``data`` pointer, can be ``C_API_DTYPE_FLOAT32`` or ``C_API_DTYPE_FLOAT64``
+ * \param nrow Number of rows
+ * \param ncol Number of columns
+ * \param is_row_major 1 for row-major, 0 for column-major
+ * \param predict_type What should be predicted, only ``C_API_PREDICT_NORMAL`` and ``C_API_PREDICT_RAW_SCORE`` are supported
+ * \param start_iteration Start index of the iteration to predict
+ * \param num_iteration Number of iterations for prediction, <= 0 means no limit
+ * \param[out] out_len Length of output result
+ * \param[out] out_result Pointer to array with predictions
+ * \return 0 when succeed, -1 when failure happens
+ */
+GPBOOST_C_EXPORT int LGBM_SharedModelPredictForMat(SharedModelHandle handle,
+                                                    const void* data,
+                                                    int data_type,
+                                                    int32_t nrow,
+                                                    int32_t ncol,
+                                                    int is_row_major,
+                                                    int predict_type,
+                                                    int start_iteration,
+                                                    int num_iteration,
+                                                    int64_t* out_len,
+                                                    double* out_result);
+
+/*!
+ * \brief Unmap a shared model.
+ * \param handle Handle of shared model to be freed
+ * \return 0 when succeed, -1 when failure happens
+ */
+GPBOOST_C_EXPORT int LGBM_SharedModelFree(SharedModelHandle handle);
+
 /*!
  * \brief Save model to string.
  * \param handle Handle of booster
@@ -1388,6 +1498,183 @@ GPBOOST_C_EXPORT int GPB_CreateREModel(int32_t num_data,
  */
 GPBOOST_C_EXPORT int GPB_REModelFree(REModelHandle handle);
 
+/*!
+* \brief Create a REModel for the folds of a cross-validation. The data is stored once and the model for the training data
+*        of every fold is created only once (when it is requested for the first time) and reused for all parameter combinations
+*        (e.g., in a grid search). The data and model parameters are the same as for GPB_CreateREModel
+* \param num_folds Number of folds
+* \param fold_ids Fold of every data point (length = num_data). Data points with fold_ids[i] == k are held out for fold k,
+*        data points with fold_ids[i] < 0 or fold_ids[i] >= num_folds are always used for training
+* \param[out] out Created REModelFolds
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT int GPB_CreateREModelFolds(int32_t num_data,
+    const int32_t* cluster_ids_data,
+    const char* re_group_data,
+    int32_t num_re_group,
+    const double* re_group_rand_coef_data,
+    const int32_t* ind_effect_group_rand_coef,
+    int32_t num_re_group_rand_coef,
+    const int* drop_intercept_group_rand_effect,
+    int32_t num_gp,
+    const double* gp_coords_data,
+    const int dim_gp_coords,
+    const double* gp_rand_coef_data,
+    int32_t num_gp_rand_coef,
+    const char* cov_fct,
+    double cov_fct_shape,
+    const char* gp_approx,
+    double cov_fct_taper_range,
+    double cov_fct_taper_shape,
+    int num_neighbors,
+    const char* vecchia_ordering,
+    int num_ind_points,
+    double cover_tree_radius,
+    const char* ind_points_selection,
+    const char* likelihood,
+    double likelihood_additional_param,
+    const char* matrix_inversion_method,
+    int seed,
+    int num_parallel_threads,
+    int num_folds,
+    const int32_t* fold_ids,
+    REModelFoldsHandle* out);
+
+/*!
+* \brief Get the REModel for the training data of a fold. If the model has been requested before, its parameter estimation state is reset
+*        such that it can be fitted again, but nearest neighbors, incidence matrices, etc. are not recalculated.
+*        The model is owned by the REModelFolds and must not be freed with GPB_REModelFree
+* \param handle Handle of REModelFolds
+* \param fold Index of the fold
+* \param[out] out Handle of the REModel for the training data of the fold
+* \param[out] out_num_data Number of training data points of the fold
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT int GPB_REModelFoldsGetTrainModel(REModelFoldsHandle handle,
+    int fold,
+    REModelHandle* out,
+    int32_t* out_num_data);
+
+/*!
+* \brief Set the held-out data of a fold as prediction data for the REModel of the fold (see GPB_SetPredictionData).
+*        GPB_REModelFoldsGetTrainModel needs to be called for this fold before
+* \param handle Handle of REModelFolds
+* \param fold Index of the fold
+* \param vecchia_pred_type Type of Vecchia approximation for making predictions
+* \param num_neighbors_pred The number of neighbors used in the Vecchia approximation for making predictions
+* \param cg_delta_conv_pred Tolerance level for L2 norm of residuals for checking convergence in conjugate gradient algorithm when being used for prediction
+* \param nsim_var_pred Number of random vectors (e.g. Rademacher) for stochastic approximation of the predictive variance
+* \param rank_pred_approx_matrix_lanczos Rank of the matrix for approximating predictive covariance matrices obtained using the Lanczos algorithm
+* \param[out] out_num_data_pred Number of held-out data points of the fold
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT int GPB_REModelFoldsSetHeldOutPredictionData(REModelFoldsHandle handle,
+    int fold,
+    const char* vecchia_pred_type,
+    int num_neighbors_pred,
+    double cg_delta_conv_pred,
+    int nsim_var_pred,
+    int rank_pred_approx_matrix_lanczos,
+    int32_t* out_num_data_pred);
+
+/*!
+ * \brief Free space for REModelFolds (including the REModels of the folds).
+ * \param handle Handle of REModelFolds to be freed
+ * \return 0 when succeed, -1 when failure happens
+ */
+GPBOOST_C_EXPORT int GPB_REModelFoldsFree(REModelFoldsHandle handle);
+
+/*!
+* \brief Rough estimate of the peak memory of a REModel (only the dominating terms are considered).
+*        This can be called before creating a model to check whether a given model specification fits into memory
+* \param num_data Number of data points
+* \param num_re_group Number of grouped (intercept) random effects
+* \param num_re_group_rand_coef Number of grouped random coefficients
+* \param num_gp Number of (intercept) Gaussian processes (0 or 1)
+* \param dim_gp_coords Dimension of the coordinates (=number of features) for Gaussian process
+* \param num_gp_rand_coef Number of Gaussian process random coefficients
+* \param gp_approx Type of GP-approximation for handling large data
+* \param num_neighbors The number of neighbors used in the Vecchia approximation
+* \param num_neighbors_pred The number of neighbors used in the Vecchia approximation for making predictions. If <= 0, the default of a model (2 * num_neighbors) is used
+* \param num_ind_points Number of inducing points / knots for, e.g., a predictive process approximation
+* \param likelihood Likelihood function for the observed response variable
+* \param matrix_inversion_method Method which is used for matrix inversion
+* \param num_rand_vec_trace Number of random vectors for stochastic approximations of traces (only relevant for matrix_inversion_method = "iterative"). If <= 0, the default of a model (50) is used
+* \param num_data_pred Number of prediction points
+* \param predict_cov_mat If true, the memory for calculating the predictive covariance matrix is included
+* \param[out] out_bytes Estimated peak memory in bytes for the construction, the parameter estimation, and the prediction phase (array of length 3)
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT int GPB_EstimateMemory(int32_t num_data,
+    int32_t num_re_group,
+    int32_t num_re_group_rand_coef,
+    int32_t num_gp,
+    int dim_gp_coords,
+    int32_t num_gp_rand_coef,
+    const char* gp_approx,
+    int num_neighbors,
+    int num_neighbors_pred,
+    int num_ind_points,
+    const char* likelihood,
+    const char* matrix_inversion_method,
+    int num_rand_vec_trace,
+    int32_t num_data_pred,
+    bool predict_cov_mat,
+    double* out_bytes);
+
+/*!
+* \brief Rough estimate of the peak memory of an existing REModel using its settings (e.g., num_neighbors_pred and num_rand_vec_trace)
+* \param handle Handle of REModel
+* \param num_data_pred Number of prediction points
+* \param predict_cov_mat If true, the memory for calculating the predictive covariance matrix is included
+* \param[out] out_bytes Estimated peak memory in bytes for the construction, the parameter estimation, and the prediction phase (array of length 3)
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT int GPB_EstimateMemoryREModel(REModelHandle handle,
+    int32_t num_data_pred,
+    bool predict_cov_mat,
+    double* out_bytes);
+
+/*!
+* \brief Set a hard memory cap for a REModel. If the estimated peak memory of the parameter estimation is larger than the cap, the cross-covariance matrix
+*        of the FITC approximation is calculated in blocks of rows (if supported, see 'fitc_streaming_block_size'), otherwise parameter estimation fails before starting.
+*        Predictions are made in chunks of prediction points if possible, otherwise they fail before allocating memory
+* \param handle Handle of REModel
+* \param max_bytes Maximal memory in bytes. If <= 0, there is no cap
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT int GPB_SetMemoryCap(REModelHandle handle,
+    double max_bytes);
+
+/*!
+* \brief Set the policy for caching the distances among locations and their nearest neighbors for the Vecchia approximation
+*        with isotropic covariance functions. Distances that are not cached are recalculated from the coordinates in every iteration
+* \param handle Handle of REModel
+* \param policy "auto" (cache in double precision if this fits into the budget, otherwise no caching), "none", "double",
+*        or "float" (single precision is only used if requested explicitly)
+* \param budget_bytes Memory budget in bytes for the "auto" policy. If <= 0, the current budget is kept
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT int GPB_SetVecchiaDistanceCache(REModelHandle handle,
+    const char* policy,
+    double budget_bytes);
+
+/*!
+* \brief Set the threads used for the computations of a REModel.
+*        The budget is applied whenever the model does computations and the previous thread settings of the calling thread are restored afterwards.
+*        This allows several models and boosters to run concurrently in one process without changing each others thread settings
+* \param handle Handle of REModel
+* \param num_threads Maximal number of OpenMP threads. If <= 0, the settings of the calling thread are used.
+*        Eigen's own parallelization is a process-wide setting and is not affected
+* \param cpu_ids CPUs to which the threads are pinned (only supported on Linux). Can be nullptr if num_cpu_ids == 0
+* \param num_cpu_ids Number of CPUs in cpu_ids. If 0, threads are not pinned
+* \return 0 when succeed, -1 when failure happens
+*/
+GPBOOST_C_EXPORT int GPB_SetThreadBudget(REModelHandle handle,
+    int num_threads,
+    const int* cpu_ids,
+    int num_cpu_ids);
+
 /*!
 * \brief Set configuration parameters for the optimizer
 * \param handle Handle of REModel
@@ -1418,6 +1705,7 @@ GPBOOST_C_EXPORT int GPB_REModelFree(REModelHandle handle);
 * \param piv_chol_rank Rank of the pivoted cholseky decomposition used as preconditioner of the conjugate gradient algorithm
 * \param init_aux_pars Initial values for values for aux_pars_ (e.g., shape parameter of gamma likelihood)
 * \param estimate_aux_pars If true, any additional parameters for non-Gaussian likelihoods are also estimated (e.g., shape parameter of gamma likelihood)
+* \param fitc_streaming_block_size If > 0, the cross-covariance matrix for the FITC approximation is not stored but calculated in blocks of this many rows
 * \return 0 when succeed, -1 when failure happens
 */
 GPBOOST_C_EXPORT int GPB_SetOptimConfig(REModelHandle handle,
@@ -1447,7 +1735,8 @@ GPBOOST_C_EXPORT int GPB_SetOptimConfig(REModelHandle handle,
     int seed_rand_vec_trace,
     int piv_chol_rank,
     double* init_aux_pars,
-    bool estimate_aux_pars);
+    bool estimate_aux_pars,
+    int fitc_streaming_block_size);
 
 /*!
 * \brief Find parameters that minimize the negative log-ligelihood (=MLE)
@@ -182,6 +182,16 @@ namespace LightGBM {
 		// desc = if ``true``, the covariance parameters of the Gaussian process / random effects model are trained (estimated) in every boosting iteration of the GPBoost algorithm, otherwise not
 		bool train_gp_model_cov_pars = true;
 
+		// check = >=0
+		// check = <=1
+		// desc = lag (in boosting iterations) with which the covariance parameters estimated in the GPBoost algorithm are used. Only relevant if ``train_gp_model_cov_pars`` = ``true``
+		// desc = ``0``: the covariance parameters are estimated from the residuals of the current iteration before the gradients are calculated
+		// desc = ``1``: the covariance parameters are estimated from the residuals of the previous iteration in a background thread while the next tree is grown, and the gradients are calculated with the most recent estimates. The first estimation is not lagged
+		// desc = with ``1``, the threads are split between the estimation (half of them) and the tree learner while the tree is grown. With ``line_search_step_length`` = ``true``, the line search of a tree already uses the new estimates, whereas the tree has been fitted to gradients calculated with the previous ones
+		// desc = the results are deterministic for a given lag, but they differ between different lags
+		// desc = **Note**: messages of the lagged estimation (e.g., ``trace`` output of the optimizer) are not shown
+		int lag_gp_model_cov_pars = 0;
+
 		// desc = set this to ``true`` to also use the Gaussian process / random effects model (in addition to the tree model) for calculating predictions on the validation data when using the GPBoost algorithm
 		bool use_gp_model_for_validation = true;
 
@@ -282,6 +292,18 @@ namespace LightGBM {
 		// desc = ``< 0`` means no limit
 		double histogram_pool_size = -1.0;
 
+		// check = >=0.0
+		// check = <1.0
+		// desc = if ``> 0``, the data of a leaf with at most ``leaf_reorder_data_ratio * #data`` data points is copied into contiguous leaf-local buffers (feature bins and gradients). Histograms of this leaf and of all its descendants are then constructed on sequential memory
+		// desc = this can speed up training when the dataset is much larger than the CPU caches
+		// desc = **Note**: this is only used by the ``serial`` tree learner on CPU with column-wise histogram construction and if there are no multi-value bins (i.e., no sparse features that are bundled row-wise)
+		double leaf_reorder_data_ratio = 0.0;
+
+		// desc = if ``true``, the split gains of all thresholds of a numerical feature are evaluated in a vectorized batch when searching for the best split. If ``false``, they are evaluated one after another during the scan over the histogram
+		// desc = both give identical splits, ``false`` is mainly useful for testing
+		// desc = **Note**: batches are not used with monotone constraints, with ``extra_trees`` or for features with missing values
+		bool batched_split_search = true;
+
 		// desc = limit the max depth for tree model. This is used to deal with over-fitting when ``#data`` is small. Tree still grows leaf-wise
 		// desc = ``<= 0`` means no limit
 		int max_depth = -1;
@@ -1015,6 +1037,26 @@ namespace LightGBM {
 		// desc = list of machines in the following format: ``ip1:port1,ip2:port2``
 		std::string machines = "";
 
+		// desc = set this to ``true`` to benchmark the allreduce algorithms (all gather, recursive halving, ring) for different message sizes when the network is initialized. If the network has been initialized without the benchmark (e.g. by ``LGBM_NetworkInit``), the ``data`` and ``voting`` parallel tree learners run it when they are initialized
+		// desc = every allreduce then uses the fastest algorithm for its size, otherwise a fixed size heuristic is used
+		// desc = the histogram reduce scatter of ``data`` and ``voting`` parallel learning uses the faster of recursive halving and ring for its size
+		// desc = **Note**: not used with external collective functions, and it adds a few seconds to the start-up
+		bool network_benchmark = false;
+
+		// check = >0
+		// desc = number of chunks the histogram reduce scatter of ``data`` parallel learning is split into
+		// desc = with ``> 1``, split finding on the chunks that are already reduced overlaps with the transfer of the remaining chunks
+		// desc = ``1`` means the histograms are reduce scattered in one collective
+		int histogram_reduce_chunks = 1;
+
+		// desc = set this to ``true`` to send only the non-empty histogram bins in ``data`` and ``voting`` parallel learning
+		// desc = every histogram block is sent either sparse or dense, whichever is smaller
+		bool histogram_exchange_sparse = false;
+
+		// desc = set this to ``true`` to send the histogram sums in single precision, they are still accumulated in double precision
+		// desc = **Note**: used only when ``histogram_exchange_sparse = true``
+		bool histogram_exchange_single_precision = false;
+
 
 
 
@@ -66,6 +66,9 @@ std::function<void(const std::vector<std::pair<int, double>>&, std::vector<std::
 
 typedef void(*ReduceFunction)(const char* input, char* output, int type_size, comm_size_t array_size);
 
+/*! \brief Decodes one received encoded block and accumulates it into the local result */
+using AccumulateFunction = std::function<void(const char* input, comm_size_t input_size)>;
+
 
 typedef void(*ReduceScatterFunction)(char* input, comm_size_t input_size, int type_size,
                                      const comm_size_t* block_start, const comm_size_t* block_len, int num_block, char* output, comm_size_t output_size,
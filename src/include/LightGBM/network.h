@@ -165,6 +165,30 @@ class Network {
                             const comm_size_t* block_start, const comm_size_t* block_len, char* output, comm_size_t output_size,
                             const ReduceFunction& reducer);
 
+  /*!
+  * \brief Measure latency and bandwidth of the allreduce algorithms (all gather, recursive halving, ring)
+  *        for message sizes from 256B to 16MB, and let Allreduce use the fastest one for every size afterwards.
+  *        ReduceScatter (used for the histograms in data parallel learning) uses the faster of recursive halving and ring.
+  *        All machines need to call it at the same time
+  */
+  static void BenchmarkAllreduce();
+
+  /*! \brief True if BenchmarkAllreduce has been called since the network was initialized */
+  static bool allreduce_benchmarked();
+
+  /*!
+  * \brief Perform reduce scatter on blocks that are encoded with variable size, e.g. compressed.
+           Every machine exchanges its encoded blocks directly with every other machine,
+  *        communication times is O(n), and communication cost is O(encoded input size)
+  * \param input Encoded input data
+  * \param block_start The encoded block start for different machines
+  * \param block_len The encoded block size for different machines
+  * \param accumulate Called once for every encoded block received from another machine,
+  *        the local block is not passed to it
+  */
+  static void ReduceScatterEncoded(char* input, const comm_size_t* block_start, const comm_size_t* block_len,
+                                   const AccumulateFunction& accumulate);
+
   template<class T>
   static T GlobalSyncUpByMin(T local) {
     T global = local;
@@ -275,6 +299,21 @@ class Network {
   }
 
  private:
+  /*! \brief Algorithms for all_reduce */
+  enum class AllreduceAlgorithm : int8_t {
+    kAllGather,
+    kRecursiveHalving,
+    kRing,
+    /*! \brief reduce scatter chooses recursive halving or ring by input size */
+    kReduceScatter
+  };
+
+  /*! \brief Benchmarked algorithm for an input size */
+  static AllreduceAlgorithm BenchmarkedAlgorithm(const std::vector<AllreduceAlgorithm>& algorithm_by_size, comm_size_t input_size);
+
+  static void AllreduceWith(AllreduceAlgorithm algorithm, char* input, comm_size_t input_size, int type_size,
+                            char* output, const ReduceFunction& reducer);
+
   static void AllgatherBruck(char* input, const comm_size_t* block_start, const comm_size_t* block_len, char* output, comm_size_t all_size);
 
   static void AllgatherRecursiveDoubling(char* input, const comm_size_t* block_start, const comm_size_t* block_len, char* output, comm_size_t all_size);
@@ -310,6 +349,10 @@ class Network {
   /*! \brief Funcs*/
   static THREAD_LOCAL ReduceScatterFunction reduce_scatter_ext_fun_;
   static THREAD_LOCAL AllgatherFunction allgather_ext_fun_;
+  /*! \brief Fastest all_reduce algorithm for input sizes in [2^i, 2^(i+1)), empty if not benchmarked */
+  static THREAD_LOCAL std::vector<AllreduceAlgorithm> allreduce_algorithm_by_size_;
+  /*! \brief Faster reduce scatter algorithm (recursive halving or ring) for input sizes in [2^i, 2^(i+1)), empty if not benchmarked */
+  static THREAD_LOCAL std::vector<AllreduceAlgorithm> reduce_scatter_algorithm_by_size_;
 };
 
 }  // namespace LightGBM
@@ -46,6 +46,9 @@ namespace LightGBM {
 
 		virtual bool IsConstantHessian() const { return false; }
 
+		/*! \brief Notify that the hessians written by GetGradients() have been modified outside of the objective function (e.g., rescaled by GOSS) or that the buffer has been reallocated */
+		virtual void ResetConstantHessians() const {}
+
 		virtual bool IsRenewTreeOutput() const { return false; }
 
 		virtual double RenewTreeOutput(double ori_output, std::function<double(const label_t*, int)>,
@@ -143,6 +146,17 @@ namespace LightGBM {
 			const double* new_score,
 			double& lr) const = 0;//used only for "regression" loss
 
+		/*!
+		* \brief Start the lagged estimation of the covariance parameters in a background thread (only used when has_gp_model_ == true and lag_gp_model_cov_pars > 0).
+		*		This is called before a tree is grown, the random effect / GP model must not be used until FinishLaggedCovParEstimation() has been called
+		*/
+		virtual void StartLaggedCovParEstimation() const {}
+
+		/*!
+		* \brief Wait until the lagged estimation of the covariance parameters started with StartLaggedCovParEstimation() has finished
+		*/
+		virtual void FinishLaggedCovParEstimation() const {}
+
 	protected:
 		///*! \brief Gaussian process model */
 		REModel* re_model_;
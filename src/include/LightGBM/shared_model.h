@@ -0,0 +1,264 @@
+/*!
+ * Copyright (c) 2020 Fabio Sigrist. All rights reserved.
+ * Licensed under the Apache License Version 2.0 See LICENSE file in the project root for license information.
+ */
+#ifndef LIGHTGBM_SHARED_MODEL_H_
+#define LIGHTGBM_SHARED_MODEL_H_
+
+#include <LightGBM/meta.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace LightGBM {
+
+class ObjectiveFunction;
+
+/*!
+* \brief Layout of a shared model file. The same file is loaded into a Booster (Boosting::LoadModelFromSharedModel)
+*        and memory-mapped read-only for prediction (SharedModel). The file consists of a SharedModelHeader followed by sections.
+*        Every section is described by its offset in bytes relative to the beginning of the file, its size, and a checksum
+*        of its content, such that the file can be mapped at any address. All sections and arrays are aligned to 8 bytes.
+*        Numbers are stored in the byte order of the machine that saved the model. The sections are:
+*        - kSharedModelMetaSection: the text model (see GBDT::SaveModelToString) without the trees, terminated by '\0'
+*        - kSharedModelObjectiveSection: the objective string (see ObjectiveFunction::ToString)
+*        - kSharedModelTreeOffsetsSection: int64_t[num_trees + 1], offsets of the trees relative to the beginning of the trees section
+*        - kSharedModelTreesSection: the trees, each a SharedTreeHeader followed by its arrays (see Tree::AppendToSharedModel)
+*        The text model format remains the interchange format, a shared model can be converted to it by loading
+*        and saving it again.
+*/
+const char kSharedModelMagic[8] = { 'G', 'P', 'B', 'S', 'H', 'M', 'D', 'L' };
+const int32_t kSharedModelVersion = 2;
+
+enum SharedModelSection {
+  kSharedModelMetaSection = 0,
+  kSharedModelObjectiveSection = 1,
+  kSharedModelTreeOffsetsSection = 2,
+  kSharedModelTreesSection = 3,
+  kNumSharedModelSections = 4
+};
+
+struct SharedModelSectionEntry {
+  int64_t offset;
+  int64_t size;
+  uint64_t checksum;
+};
+
+struct SharedModelHeader {
+  char magic[8];
+  int32_t version;
+  int32_t num_sections;
+  int32_t num_trees;
+  int32_t num_tree_per_iteration;
+  int32_t max_feature_idx;
+  int32_t average_output;
+  int32_t use_nesterov_acc;
+  int32_t momentum_schedule_version;
+  int32_t momentum_offset;
+  int32_t padding;
+  double nesterov_acc_rate;
+  int64_t file_size;
+  SharedModelSectionEntry sections[kNumSharedModelSections];
+};
+
+/*!
+* \brief Header of a tree in a shared model. All offsets are in bytes relative to the beginning of the SharedTreeHeader,
+*        i.e., a tree can be read without the rest of the file
+*/
+struct SharedTreeHeader {
+  int32_t num_leaves;
+  int32_t num_cat;
+  int32_t is_linear;
+  /*! \brief 1 if leaf_weight and leaf_count are stored (trees with a single leaf that are loaded from a text model have none) */
+  int32_t has_leaf_stats;
+  double shrinkage;
+  /*! \brief int32_t[num_leaves - 1] */
+  int64_t split_feature;
+  /*! \brief float[num_leaves - 1] */
+  int64_t split_gain;
+  /*! \brief double[num_leaves - 1] */
+  int64_t threshold;
+  /*! \brief int8_t[num_leaves - 1] */
+  int64_t decision_type;
+  /*! \brief int32_t[num_leaves - 1] */
+  int64_t left_child;
+  /*! \brief int32_t[num_leaves - 1] */
+  int64_t right_child;
+  /*! \brief double[num_leaves] */
+  int64_t leaf_value;
+  /*! \brief double[num_leaves] */
+  int64_t leaf_weight;
+  /*! \brief int32_t[num_leaves] */
+  int64_t leaf_count;
+  /*! \brief double[num_leaves - 1] */
+  int64_t internal_value;
+  /*! \brief double[num_leaves - 1] */
+  int64_t internal_weight;
+  /*! \brief int32_t[num_leaves - 1] */
+  int64_t internal_count;
+  /*! \brief int32_t[num_cat + 1] */
+  int64_t cat_boundaries;
+  /*! \brief uint32_t[cat_boundaries[num_cat]] */
+  int64_t cat_threshold;
+  /*! \brief Linear trees only: double[num_leaves] */
+  int64_t leaf_const;
+  /*! \brief Linear trees only: int32_t[num_leaves + 1], start of the features of every leaf in leaf_features and leaf_coeff */
+  int64_t leaf_features_start;
+  /*! \brief Linear trees only: int32_t[leaf_features_start[num_leaves]] */
+  int64_t leaf_features;
+  /*! \brief Linear trees only: double[leaf_features_start[num_leaves]] */
+  int64_t leaf_coeff;
+};
+
+/*!
+* \brief Append an array to a shared model buffer (aligned to 8 bytes)
+* \return Offset of the array in the buffer
+*/
+inline int64_t AppendToSharedModelBuffer(std::string* buffer, const void* data, size_t num_bytes) {
+  buffer->resize((buffer->size() + 7) / 8 * 8, '\0');
+  const int64_t offset = static_cast<int64_t>(buffer->size());
+  if (num_bytes > 0) {
+    buffer->append(reinterpret_cast<const char*>(data), num_bytes);
+  }
+  return offset;
+}
+
+/*!
+* \brief Returns true if an array of num_elements elements at offset is aligned to 8 bytes and lies within a buffer of num_bytes bytes
+*/
+inline bool IsValidSharedModelArray(int64_t offset, int64_t num_elements, size_t element_size, int64_t num_bytes) {
+  if (offset < 0 || offset % 8 != 0 || offset > num_bytes || num_elements < 0) {
+    return false;
+  }
+  return num_elements <= (num_bytes - offset) / static_cast<int64_t>(element_size);
+}
+
+/*! \brief Returns true if a buffer starts with the magic bytes of a shared model */
+inline bool IsSharedModel(const char* buffer, size_t len) {
+  return len >= sizeof(kSharedModelMagic) && std::memcmp(buffer, kSharedModelMagic, sizeof(kSharedModelMagic)) == 0;
+}
+
+/*!
+* \brief 64-bit FNV-1a checksum of a section of a shared model (applied to 8-byte words and the remaining bytes)
+*/
+inline uint64_t SharedModelChecksum(const char* data, size_t len) {
+  const uint64_t kPrime = 1099511628211ULL;
+  uint64_t hash = 14695981039346656037ULL;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(uint64_t));
+    hash = (hash ^ word) * kPrime;
+  }
+  for (; i < len; ++i) {
+    hash = (hash ^ static_cast<uint8_t>(data[i])) * kPrime;
+  }
+  return hash;
+}
+
+/*!
+* \brief Check the header, the section bounds, the checksums, and the tree offsets of a shared model. Fails if the model is truncated or corrupted
+* \param buffer Content of the shared model
+* \param len Length of buffer
+* \return Header of the shared model
+*/
+const SharedModelHeader* CheckSharedModel(const char* buffer, size_t len);
+
+/*!
+* \brief Returns true if all arrays of a tree lie within the tree and all child and category indices are valid
+* \param tree Beginning of the tree (aligned to 8 bytes)
+* \param num_bytes Size of the tree in bytes
+* \param num_features Number of features of the model, split and linear model features are not checked if num_features < 0
+*/
+bool IsValidSharedTree(const SharedTreeHeader* tree, size_t num_bytes, int num_features);
+
+/*!
+* \brief Offsets of the trees of a checked shared model relative to the beginning of the trees section (num_trees + 1 entries)
+*/
+inline const int64_t* SharedModelTreeOffsets(const char* buffer, const SharedModelHeader* header) {
+  return reinterpret_cast<const int64_t*>(buffer + header->sections[kSharedModelTreeOffsetsSection].offset);
+}
+
+/*!
+* \brief Read-only memory mapping of a file. Pages are shared among all processes that map the same file
+*/
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+#ifdef _WIN32
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#endif
+};
+
+/*!
+* \brief Tree ensemble for prediction that is read directly from a memory-mapped shared model file
+*        (written with Boosting::SaveSharedModelToFile). The trees are not copied to private memory, i.e.,
+*        several processes that open the same file share one physical copy of the model.
+*        The random effects / Gaussian process model of a GPBoost booster is not part of the file
+*/
+class SharedModel {
+ public:
+  /*!
+  * \brief Map a shared model file and check its layout and checksums
+  * \param filename Name of the file
+  */
+  explicit SharedModel(const std::string& filename);
+
+  ~SharedModel();
+
+  /*! \brief Number of trees per iteration (= number of classes for multiclass models) */
+  int NumberOfClasses() const { return header_->num_tree_per_iteration; }
+
+  /*! \brief Number of iterations */
+  int NumberOfIterations() const { return header_->num_trees / header_->num_tree_per_iteration; }
+
+  /*! \brief Number of features used by the model */
+  int NumFeatures() const { return header_->max_feature_idx + 1; }
+
+  /*!
+  * \brief Prediction for one data point
+  * \param features Feature values (of length NumFeatures())
+  * \param start_iteration Start index of the iteration to predict
+  * \param num_iteration Number of iterations for prediction, <= 0 means no limit
+  * \param is_raw_score If true, the raw scores are returned, otherwise the output is transformed by the objective
+  * \param[out] output Predictions (of length NumberOfClasses())
+  */
+  void Predict(const double* features, int start_iteration, int num_iteration, bool is_raw_score, double* output) const;
+
+ private:
+  /*! \brief Array of a tree at an offset relative to the beginning of the tree */
+  template<typename T>
+  static const T* Array(const SharedTreeHeader& tree, int64_t offset) {
+    return reinterpret_cast<const T*>(reinterpret_cast<const char*>(&tree) + offset);
+  }
+
+  const SharedTreeHeader& Tree(int index) const {
+    return *reinterpret_cast<const SharedTreeHeader*>(file_.data() + header_->sections[kSharedModelTreesSection].offset
+                                                      + tree_offsets_[index]);
+  }
+
+  /*! \brief Prediction of a tree using the decision functions of Tree */
+  double PredictTree(const SharedTreeHeader& tree, const double* features) const;
+
+  MappedFile file_;
+  const SharedModelHeader* header_;
+  const int64_t* tree_offsets_;
+  std::unique_ptr<ObjectiveFunction> objective_function_;
+};
+
+}  // namespace LightGBM
+
+#endif  // LIGHTGBM_SHARED_MODEL_H_
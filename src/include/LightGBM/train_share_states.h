@@ -11,6 +11,7 @@
 #include <LightGBM/utils/threading.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -148,6 +149,8 @@ class MultiValBinWrapper {
   hist_t* origin_hist_data_;
 
   const size_t kHistBufferEntrySize = 2 * sizeof(hist_t);
+  /*! \brief Up to this number of data blocks, the thread histograms are merged in one pass, otherwise a two-level reduction is used */
+  const int kMaxDataBlocksFlatHistMerge = 16;
 };
 
 struct TrainingShareStates {
@@ -13,6 +13,7 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace LightGBM {
@@ -20,6 +21,22 @@ namespace LightGBM {
 #define kCategoricalMask (1)
 #define kDefaultLeftMask (2)
 
+struct SharedTreeHeader;
+
+/*!
+* \brief Root-to-leaf path of every leaf of a tree for Tree::PredictContribBlock. A path has one element per distinct
+*        split feature with the product of the cover fractions of the nodes splitting on this feature, and the nodes
+*        (with the child taken on the path) which determine whether a record follows the path for this feature
+*/
+struct TreeContribPaths {
+  std::vector<int> leaf;
+  std::vector<int> begin;
+  std::vector<int> feature;
+  std::vector<double> zero_fraction;
+  std::vector<int> node_begin;
+  std::vector<std::pair<int, int>> nodes;
+};
+
 /*!
 * \brief Tree model
 */
@@ -40,6 +57,13 @@ class Tree {
   */
   Tree(const char* str, size_t* used_len);
 
+  /*!
+  * \brief Constructor, from a tree in a shared model (see shared_model.h)
+  * \param tree Beginning of the tree in the shared model (aligned to 8 bytes)
+  * \param num_bytes Size of the tree in bytes
+  */
+  Tree(const SharedTreeHeader* tree, size_t num_bytes);
+
   ~Tree() noexcept = default;
 
   /*!
@@ -141,6 +165,25 @@ class Tree {
   inline void PredictContribByMap(const std::unordered_map<int, double>& feature_values,
                                   int num_features, std::unordered_map<int, double>* output);
 
+  /*!
+  * \brief Precompute the root-to-leaf paths used by PredictContribBlock (they become invalid when the tree is changed)
+  * \param[out] paths Paths of all leaves
+  */
+  void InitContribPaths(TreeContribPaths* paths) const;
+
+  /*!
+  * \brief Feature contributions (SHAP values) for a block of records. Same result as PredictContrib for every record,
+  *        but the precomputed paths of InitContribPaths are evaluated for all records of the block at once
+  * \param paths Paths of the tree calculated by InitContribPaths
+  * \param feature_values Feature values of the records in row-major format (num_rows x num_features)
+  * \param num_rows Number of records
+  * \param num_features Number of features
+  * \param output Contributions of the first record (num_features + 1 values), contributions of later records start every output_stride values
+  * \param output_stride Distance between the contributions of two records in output
+  */
+  void PredictContribBlock(const TreeContribPaths& paths, const double* feature_values, int num_rows, int num_features,
+                           double* output, int64_t output_stride) const;
+
   /*! \brief Get Number of leaves*/
   inline int num_leaves() const { return num_leaves_; }
 
@@ -241,6 +284,13 @@ class Tree {
   /*! \brief Serialize this object to string*/
   std::string ToString() const;
 
+  /*!
+  * \brief Append this tree to the trees section of a shared model (see shared_model.h).
+  *        The tree starts at the end of the buffer, which needs to be aligned to 8 bytes, and is padded to a multiple of 8 bytes
+  * \param buffer Trees section of a shared model
+  */
+  void AppendToSharedModel(std::string* buffer) const;
+
   /*! \brief Serialize this object to json*/
   std::string ToJSON() const;
 
@@ -276,6 +326,106 @@ class Tree {
     (*decision_type) |= (input << 2);
   }
 
+  /*!
+  * \brief Child of a numerical split for a feature value. The static decision functions work on the raw arrays
+  *        of a tree such that they are shared by Tree and SharedModel
+  */
+  inline static int NumericalDecision(double fval, int8_t decision_type, double threshold,
+                                      int left_child, int right_child) {
+    uint8_t missing_type = GetMissingType(decision_type);
+    if (std::isnan(fval) && missing_type != MissingType::NaN) {
+      fval = 0.0f;
+    }
+    if ((missing_type == MissingType::Zero && IsZero(fval))
+        || (missing_type == MissingType::NaN && std::isnan(fval))) {
+      if (GetDecisionType(decision_type, kDefaultLeftMask)) {
+        return left_child;
+      } else {
+        return right_child;
+      }
+    }
+    if (fval <= threshold) {
+      return left_child;
+    } else {
+      return right_child;
+    }
+  }
+
+  /*!
+  * \brief Child of a categorical split for a feature value
+  * \param cat_threshold Bitset of the categories that go to the left child
+  * \param num_cat_threshold Number of words of the bitset
+  */
+  inline static int CategoricalDecision(double fval, int8_t decision_type, const uint32_t* cat_threshold,
+                                        int num_cat_threshold, int left_child, int right_child) {
+    uint8_t missing_type = GetMissingType(decision_type);
+    int int_fval = static_cast<int>(fval);
+    if (int_fval < 0) {
+      return right_child;
+    } else if (std::isnan(fval)) {
+      // NaN is always in the right
+      if (missing_type == MissingType::NaN) {
+        return right_child;
+      }
+      int_fval = 0;
+    }
+    if (Common::FindInBitset(cat_threshold, num_cat_threshold, int_fval)) {
+      return left_child;
+    }
+    return right_child;
+  }
+
+  /*!
+  * \brief Leaf index of a data point for the raw arrays of a tree with at least two leaves
+  * \param cat_boundaries, cat_threshold Bitsets of the categorical splits (used only if num_cat > 0)
+  */
+  inline static int GetLeaf(const double* feature_values, int num_cat, const int* split_feature,
+                            const double* threshold, const int8_t* decision_type,
+                            const int* left_child, const int* right_child,
+                            const int* cat_boundaries, const uint32_t* cat_threshold) {
+    int node = 0;
+    if (num_cat > 0) {
+      while (node >= 0) {
+        const double fval = feature_values[split_feature[node]];
+        if (GetDecisionType(decision_type[node], kCategoricalMask)) {
+          const int cat_idx = static_cast<int>(threshold[node]);
+          node = CategoricalDecision(fval, decision_type[node], cat_threshold + cat_boundaries[cat_idx],
+                                     cat_boundaries[cat_idx + 1] - cat_boundaries[cat_idx],
+                                     left_child[node], right_child[node]);
+        } else {
+          node = NumericalDecision(fval, decision_type[node], threshold[node], left_child[node], right_child[node]);
+        }
+      }
+    } else {
+      while (node >= 0) {
+        node = NumericalDecision(feature_values[split_feature[node]], decision_type[node], threshold[node],
+                                 left_child[node], right_child[node]);
+      }
+    }
+    return ~node;
+  }
+
+  /*!
+  * \brief Output of a leaf of a linear tree. If a feature of the linear model is NaN, the leaf value is returned
+  * \param leaf_value Leaf value of the piecewise constant tree
+  * \param leaf_const Constant term of the linear model of the leaf
+  * \param leaf_features Features of the linear model of the leaf
+  * \param leaf_coeff Coefficients of the linear model of the leaf
+  * \param num_leaf_features Number of features of the linear model of the leaf
+  */
+  inline static double LinearLeafOutput(const double* feature_values, double leaf_value, double leaf_const,
+                                        const int* leaf_features, const double* leaf_coeff, int num_leaf_features) {
+    double output = leaf_const;
+    for (int i = 0; i < num_leaf_features; ++i) {
+      const double feat_val = feature_values[leaf_features[i]];
+      if (std::isnan(feat_val)) {
+        return leaf_value;
+      }
+      output += leaf_coeff[i] * feat_val;
+    }
+    return output;
+  }
+
   void RecomputeMaxDepth();
 
   int NextLeafId() const { return num_leaves_; }
@@ -327,23 +477,7 @@ class Tree {
   std::string CategoricalDecisionIfElse(int node) const;
 
   inline int NumericalDecision(double fval, int node) const {
-    uint8_t missing_type = GetMissingType(decision_type_[node]);
-    if (std::isnan(fval) && missing_type != MissingType::NaN) {
-      fval = 0.0f;
-    }
-    if ((missing_type == MissingType::Zero && IsZero(fval))
-        || (missing_type == MissingType::NaN && std::isnan(fval))) {
-      if (GetDecisionType(decision_type_[node], kDefaultLeftMask)) {
-        return left_child_[node];
-      } else {
-        return right_child_[node];
-      }
-    }
-    if (fval <= threshold_[node]) {
-      return left_child_[node];
-    } else {
-      return right_child_[node];
-    }
+    return NumericalDecision(fval, decision_type_[node], threshold_[node], left_child_[node], right_child_[node]);
   }
 
   inline int NumericalDecisionInner(uint32_t fval, int node, uint32_t default_bin, uint32_t max_bin) const {
@@ -364,23 +498,9 @@ class Tree {
   }
 
   inline int CategoricalDecision(double fval, int node) const {
-    uint8_t missing_type = GetMissingType(decision_type_[node]);
-    int int_fval = static_cast<int>(fval);
-    if (int_fval < 0) {
-      return right_child_[node];;
-    } else if (std::isnan(fval)) {
-      // NaN is always in the right
-      if (missing_type == MissingType::NaN) {
-        return right_child_[node];
-      }
-      int_fval = 0;
-    }
     int cat_idx = static_cast<int>(threshold_[node]);
-    if (Common::FindInBitset(cat_threshold_.data() + cat_boundaries_[cat_idx],
-                             cat_boundaries_[cat_idx + 1] - cat_boundaries_[cat_idx], int_fval)) {
-      return left_child_[node];
-    }
-    return right_child_[node];
+    return CategoricalDecision(fval, decision_type_[node], cat_threshold_.data() + cat_boundaries_[cat_idx],
+                               cat_boundaries_[cat_idx + 1] - cat_boundaries_[cat_idx], left_child_[node], right_child_[node]);
   }
 
   inline int CategoricalDecisionInner(uint32_t fval, int node) const {
@@ -469,6 +589,14 @@ class Tree {
   /*! determine what the total permutation weight would be if we unwound a previous extension in the decision path*/
   static double UnwoundPathSum(const PathElement *unique_path, int unique_depth, int path_index);
 
+  /*!
+  * \brief Builds the paths used by PredictContribBlock for all leaves below a node
+  * \param node Current node
+  * \param path_nodes Nodes from the root to the current node together with the child taken on the path
+  * \param[out] paths Paths of all leaves
+  */
+  void InitContribPaths(int node, std::vector<std::pair<int, int>>* path_nodes, TreeContribPaths* paths) const;
+
   /*! \brief Number of max leaves*/
   int max_leaves_;
   /*! \brief Number of current leaves*/
@@ -577,23 +705,8 @@ inline void Tree::Split(int leaf, int feature, int real_feature,
 inline double Tree::Predict(const double* feature_values) const {
   if (is_linear_) {
       int leaf = GetLeaf(feature_values);
-      double output = leaf_const_[leaf];
-      bool nan_found = false;
-      for (size_t i = 0; i < leaf_features_[leaf].size(); ++i) {
-        int feat_raw = leaf_features_[leaf][i];
-        double feat_val = feature_values[feat_raw];
-        if (std::isnan(feat_val)) {
-          nan_found = true;
-          break;
-        } else {
-          output += leaf_coeff_[leaf][i] * feat_val;
-        }
-      }
-      if (nan_found) {
-        return LeafOutput(leaf);
-      } else {
-        return output;
-      }
+      return LinearLeafOutput(feature_values, leaf_value_[leaf], leaf_const_[leaf], leaf_features_[leaf].data(),
+                              leaf_coeff_[leaf].data(), static_cast<int>(leaf_coeff_[leaf].size()));
   } else {
     if (num_leaves_ > 1) {
       int leaf = GetLeaf(feature_values);
@@ -689,17 +802,8 @@ inline void Tree::RecomputeLeafDepths(int node, int depth) {
 }
 
 inline int Tree::GetLeaf(const double* feature_values) const {
-  int node = 0;
-  if (num_cat_ > 0) {
-    while (node >= 0) {
-      node = Decision(feature_values[split_feature_[node]], node);
-    }
-  } else {
-    while (node >= 0) {
-      node = NumericalDecision(feature_values[split_feature_[node]], node);
-    }
-  }
-  return ~node;
+  return GetLeaf(feature_values, num_cat_, split_feature_.data(), threshold_.data(), decision_type_.data(),
+                 left_child_.data(), right_child_.data(), cat_boundaries_.data(), cat_threshold_.data());
 }
 
 inline int Tree::GetLeafByMap(const std::unordered_map<int, double>& feature_values) const {
@@ -109,6 +109,13 @@ namespace LightGBM {
 
 		static void ResetCallBack(Callback callback) { GetLogCallBack() = callback; }
 
+		/*!
+		 * \brief If true, no messages are written by the calling thread and fatal errors are only thrown but not reported.
+		 *        This is used for background threads from which the R API must not be called. Their errors are reported by the thread that waits for them
+		 * \param silent True for a silent thread
+		 */
+		static void SetSilentThread(bool silent) { GetSilentThread() = silent; }
+
 		static void Debug(const char* format, ...) {
 			va_list val;
 			va_start(val, format);
@@ -138,14 +145,16 @@ namespace LightGBM {
 			vsnprintf(str_buf, kBufSize, format, val);
 #endif
 			va_end(val);
-			// R code should write back to R's error stream,
-			// otherwise to stderr
+			if (!GetSilentThread()) {
+				// R code should write back to R's error stream,
+				// otherwise to stderr
 #ifndef LGB_R_BUILD
-			fprintf(stderr, "[GPBoost] [Fatal] %s\n", str_buf);
-			fflush(stderr);
+				fprintf(stderr, "[GPBoost] [Fatal] %s\n", str_buf);
+				fflush(stderr);
 #else
-			Rf_error("[GPBoost] [Fatal] %s\n", str_buf);
+				Rf_error("[GPBoost] [Fatal] %s\n", str_buf);
 #endif
+			}
 			throw std::runtime_error(std::string(str_buf));
 		}
 
@@ -179,14 +188,16 @@ namespace LightGBM {
 			vsnprintf(str_buf, kBufSize, format, val);
 #endif
 			va_end(val);
-			// R code should write back to R's error stream,
-			// otherwise to stderr
+			if (!GetSilentThread()) {
+				// R code should write back to R's error stream,
+				// otherwise to stderr
 #ifndef LGB_R_BUILD
-			fprintf(stderr, "[GPBoost] [Fatal] %s\n", str_buf);
-			fflush(stderr);
+				fprintf(stderr, "[GPBoost] [Fatal] %s\n", str_buf);
+				fflush(stderr);
 #else
-			Rf_error("[GPBoost] [Fatal] %s\n", str_buf);
+				Rf_error("[GPBoost] [Fatal] %s\n", str_buf);
 #endif
+			}
 			throw std::runtime_error(std::string(str_buf));
 		}
 
@@ -198,7 +209,7 @@ namespace LightGBM {
 	private:
 		static void Write(LogLevel level, const char* level_str, const char* format,
 			va_list val) {
-			if (level <= GetLevel()) {  // omit the message with low level
+			if (level <= GetLevel() && !GetSilentThread()) {  // omit the message with low level
 			// R code should write back to R's output stream,
 			// otherwise to stdout
 #ifndef LGB_R_BUILD
@@ -227,7 +238,7 @@ namespace LightGBM {
 
 		static void WriteRE(LogLevelRE level, const char* level_str, const char* format,
 			va_list val) {
-			if (level <= GetLevelRE()) {  // omit the message with low level
+			if (level <= GetLevelRE() && !GetSilentThread()) {  // omit the message with low level
 			// R code should write back to R's output stream,
 			// otherwise to stdout
 #ifndef LGB_R_BUILD
@@ -264,6 +275,10 @@ namespace LightGBM {
 			static THREAD_LOCAL Callback callback = nullptr;
 			return callback;
 		}
+		static bool& GetSilentThread() {
+			static THREAD_LOCAL bool silent = false;
+			return silent;
+		}
 	};
 
 }  // namespace LightGBM
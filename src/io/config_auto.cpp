@@ -184,6 +184,7 @@ const std::unordered_set<std::string>& Config::parameter_set() {
   "line_search_step_length",
   "reuse_learning_rates_gp_model",
   "train_gp_model_cov_pars",
+  "lag_gp_model_cov_pars",
   "use_gp_model_for_validation",
   "leaves_newton_update",
   "use_nesterov_acc",
@@ -199,6 +200,8 @@ const std::unordered_set<std::string>& Config::parameter_set() {
   "force_col_wise",
   "force_row_wise",
   "histogram_pool_size",
+  "leaf_reorder_data_ratio",
+  "batched_split_search",
   "max_depth",
   "min_data_in_leaf",
   "min_sum_hessian_in_leaf",
@@ -310,6 +313,10 @@ const std::unordered_set<std::string>& Config::parameter_set() {
   "time_out",
   "machine_list_filename",
   "machines",
+  "network_benchmark",
+  "histogram_reduce_chunks",
+  "histogram_exchange_sparse",
+  "histogram_exchange_single_precision",
   "gpu_platform_id",
   "gpu_device_id",
   "gpu_use_dp",
@@ -340,6 +347,10 @@ void Config::GetMembersFromString(const std::unordered_map<std::string, std::str
 
   GetBool(params, "train_gp_model_cov_pars", &train_gp_model_cov_pars);
 
+  GetInt(params, "lag_gp_model_cov_pars", &lag_gp_model_cov_pars);
+  CHECK_GE(lag_gp_model_cov_pars, 0);
+  CHECK_LE(lag_gp_model_cov_pars, 1);
+
   GetBool(params, "use_gp_model_for_validation", &use_gp_model_for_validation);
 
   GetBool(params, "leaves_newton_update", &leaves_newton_update);
@@ -366,6 +377,12 @@ void Config::GetMembersFromString(const std::unordered_map<std::string, std::str
 
   GetDouble(params, "histogram_pool_size", &histogram_pool_size);
 
+  GetDouble(params, "leaf_reorder_data_ratio", &leaf_reorder_data_ratio);
+  CHECK_GE(leaf_reorder_data_ratio, 0.0);
+  CHECK_LT(leaf_reorder_data_ratio, 1.0);
+
+  GetBool(params, "batched_split_search", &batched_split_search);
+
   GetInt(params, "max_depth", &max_depth);
 
   GetInt(params, "min_data_in_leaf", &min_data_in_leaf);
@@ -656,6 +673,15 @@ void Config::GetMembersFromString(const std::unordered_map<std::string, std::str
 
   GetString(params, "machines", &machines);
 
+  GetBool(params, "network_benchmark", &network_benchmark);
+
+  GetInt(params, "histogram_reduce_chunks", &histogram_reduce_chunks);
+  CHECK_GT(histogram_reduce_chunks, 0);
+
+  GetBool(params, "histogram_exchange_sparse", &histogram_exchange_sparse);
+
+  GetBool(params, "histogram_exchange_single_precision", &histogram_exchange_single_precision);
+
   GetInt(params, "gpu_platform_id", &gpu_platform_id);
 
   GetInt(params, "gpu_device_id", &gpu_device_id);
@@ -676,6 +702,7 @@ std::string Config::SaveMembersToString() const {
   str_buf << "[line_search_step_length: " << line_search_step_length << "]\n";
   str_buf << "[reuse_learning_rates_gp_model: " << reuse_learning_rates_gp_model << "]\n";
   str_buf << "[train_gp_model_cov_pars: " << train_gp_model_cov_pars << "]\n";
+  str_buf << "[lag_gp_model_cov_pars: " << lag_gp_model_cov_pars << "]\n";
   str_buf << "[use_gp_model_for_validation: " << use_gp_model_for_validation << "]\n";
   str_buf << "[leaves_newton_update: " << leaves_newton_update << "]\n";
   str_buf << "[use_nesterov_acc: " << use_nesterov_acc << "]\n";
@@ -688,6 +715,8 @@ std::string Config::SaveMembersToString() const {
   str_buf << "[force_col_wise: " << force_col_wise << "]\n";
   str_buf << "[force_row_wise: " << force_row_wise << "]\n";
   str_buf << "[histogram_pool_size: " << histogram_pool_size << "]\n";
+  str_buf << "[leaf_reorder_data_ratio: " << leaf_reorder_data_ratio << "]\n";
+  str_buf << "[batched_split_search: " << batched_split_search << "]\n";
   str_buf << "[max_depth: " << max_depth << "]\n";
   str_buf << "[min_data_in_leaf: " << min_data_in_leaf << "]\n";
   str_buf << "[min_sum_hessian_in_leaf: " << min_sum_hessian_in_leaf << "]\n";
@@ -780,6 +809,10 @@ std::string Config::SaveMembersToString() const {
   str_buf << "[time_out: " << time_out << "]\n";
   str_buf << "[machine_list_filename: " << machine_list_filename << "]\n";
   str_buf << "[machines: " << machines << "]\n";
+  str_buf << "[network_benchmark: " << network_benchmark << "]\n";
+  str_buf << "[histogram_reduce_chunks: " << histogram_reduce_chunks << "]\n";
+  str_buf << "[histogram_exchange_sparse: " << histogram_exchange_sparse << "]\n";
+  str_buf << "[histogram_exchange_single_precision: " << histogram_exchange_single_precision << "]\n";
   str_buf << "[gpu_platform_id: " << gpu_platform_id << "]\n";
   str_buf << "[gpu_device_id: " << gpu_device_id << "]\n";
   str_buf << "[gpu_use_dp: " << gpu_use_dp << "]\n";
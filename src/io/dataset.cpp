@@ -1176,8 +1176,12 @@ void Dataset::ConstructHistogramsInner(
   global_timer.Start("Dataset::dense_bin_histogram");
   auto ptr_ordered_grad = gradients;
   auto ptr_ordered_hess = hessians;
+  // the copy into ordered gradients only pays off if more than one group reads them,
+  // a single dense group reads gradients[data_indices[i]] directly
+  const bool use_ordered = USE_INDICES &&
+    (num_used_dense_group + (multi_val_groud_id >= 0 ? 1 : 0)) > 1;
   if (num_used_dense_group > 0) {
-    if (USE_INDICES) {
+    if (use_ordered) {
       if (USE_HESSIAN) {
 #pragma omp parallel for schedule(static, 512) if (num_data >= 1024)
         for (data_size_t i = 0; i < num_data; ++i) {
@@ -1204,18 +1208,24 @@ void Dataset::ConstructHistogramsInner(
       std::memset(reinterpret_cast<void*>(data_ptr), 0,
                   num_bin * kHistEntrySize);
       if (USE_HESSIAN) {
-        if (USE_INDICES) {
+        if (use_ordered) {
           feature_groups_[group]->bin_data_->ConstructHistogram(
               data_indices, 0, num_data, ptr_ordered_grad, ptr_ordered_hess,
               data_ptr);
+        } else if (USE_INDICES) {
+          feature_groups_[group]->bin_data_->ConstructHistogramUnordered(
+              data_indices, 0, num_data, gradients, hessians, data_ptr);
         } else {
           feature_groups_[group]->bin_data_->ConstructHistogram(
               0, num_data, ptr_ordered_grad, ptr_ordered_hess, data_ptr);
         }
       } else {
-        if (USE_INDICES) {
+        if (use_ordered) {
           feature_groups_[group]->bin_data_->ConstructHistogram(
               data_indices, 0, num_data, ptr_ordered_grad, data_ptr);
+        } else if (USE_INDICES) {
+          feature_groups_[group]->bin_data_->ConstructHistogramUnordered(
+              data_indices, 0, num_data, gradients, data_ptr);
         } else {
           feature_groups_[group]->bin_data_->ConstructHistogram(
               0, num_data, ptr_ordered_grad, data_ptr);
@@ -1231,7 +1241,7 @@ void Dataset::ConstructHistogramsInner(
   }
   global_timer.Stop("Dataset::dense_bin_histogram");
   if (multi_val_groud_id >= 0) {
-    if (num_used_dense_group > 0) {
+    if (use_ordered) {
       ConstructHistogramsMultiVal<USE_INDICES, true>(
           data_indices, num_data, ptr_ordered_grad, ptr_ordered_hess,
           share_state,
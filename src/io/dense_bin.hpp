@@ -95,7 +95,7 @@ class DenseBin : public Bin {
   BinIterator* GetIterator(uint32_t min_bin, uint32_t max_bin,
                            uint32_t most_freq_bin) const override;
 
-  template <bool USE_INDICES, bool USE_PREFETCH, bool USE_HESSIAN>
+  template <bool USE_INDICES, bool USE_PREFETCH, bool USE_HESSIAN, bool ORDERED = true>
   void ConstructHistogramInner(const data_size_t* data_indices,
                                data_size_t start, data_size_t end,
                                const score_t* ordered_gradients,
@@ -117,12 +117,16 @@ class DenseBin : public Bin {
         } else {
           PREFETCH_T0(data_.data() + pf_idx);
         }
+        if (!ORDERED) {
+          PREFETCH_T0(ordered_gradients + pf_idx);
+        }
         const auto ti = static_cast<uint32_t>(data(idx)) << 1;
+        const auto gi = ORDERED ? i : idx;
         if (USE_HESSIAN) {
-          grad[ti] += ordered_gradients[i];
-          hess[ti] += ordered_hessians[i];
+          grad[ti] += ordered_gradients[gi];
+          hess[ti] += ordered_hessians[gi];
         } else {
-          grad[ti] += ordered_gradients[i];
+          grad[ti] += ordered_gradients[gi];
           ++cnt[ti];
         }
       }
@@ -130,11 +134,12 @@ class DenseBin : public Bin {
     for (; i < end; ++i) {
       const auto idx = USE_INDICES ? data_indices[i] : i;
       const auto ti = static_cast<uint32_t>(data(idx)) << 1;
+      const auto gi = ORDERED ? i : idx;
       if (USE_HESSIAN) {
-        grad[ti] += ordered_gradients[i];
-        hess[ti] += ordered_hessians[i];
+        grad[ti] += ordered_gradients[gi];
+        hess[ti] += ordered_hessians[gi];
       } else {
-        grad[ti] += ordered_gradients[i];
+        grad[ti] += ordered_gradients[gi];
         ++cnt[ti];
       }
     }
@@ -170,6 +175,21 @@ class DenseBin : public Bin {
         nullptr, start, end, ordered_gradients, nullptr, out);
   }
 
+  void ConstructHistogramUnordered(const data_size_t* data_indices, data_size_t start,
+                                   data_size_t end, const score_t* gradients,
+                                   const score_t* hessians,
+                                   hist_t* out) const override {
+    ConstructHistogramInner<true, true, true, false>(
+        data_indices, start, end, gradients, hessians, out);
+  }
+
+  void ConstructHistogramUnordered(const data_size_t* data_indices, data_size_t start,
+                                   data_size_t end, const score_t* gradients,
+                                   hist_t* out) const override {
+    ConstructHistogramInner<true, true, false, false>(
+        data_indices, start, end, gradients, nullptr, out);
+  }
+
 
   template <bool MISS_IS_ZERO, bool MISS_IS_NA, bool MFB_IS_ZERO,
             bool MFB_IS_NA, bool USE_MIN_BIN>
@@ -0,0 +1,310 @@
+/*!
+ * Copyright (c) 2020 Fabio Sigrist. All rights reserved.
+ * Licensed under the Apache License Version 2.0 See LICENSE file in the project root for license information.
+ */
+#include <LightGBM/shared_model.h>
+
+#include <LightGBM/boosting.h>
+#include <LightGBM/config.h>
+#include <LightGBM/objective_function.h>
+#include <LightGBM/tree.h>
+#include <LightGBM/utils/common.h>
+#include <LightGBM/utils/log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LightGBM {
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& filename) {
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    Log::Fatal("Could not open model file %s", filename.c_str());
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+    CloseHandle(file);
+    Log::Fatal("Could not determine the size of model file %s", filename.c_str());
+  }
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL) {
+    CloseHandle(file);
+    Log::Fatal("Could not map model file %s", filename.c_str());
+  }
+  const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == NULL) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    Log::Fatal("Could not map model file %s", filename.c_str());
+  }
+  file_handle_ = file;
+  mapping_handle_ = mapping;
+  data_ = static_cast<const char*>(data);
+  size_ = static_cast<size_t>(size.QuadPart);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_handle_ != nullptr) {
+    CloseHandle(mapping_handle_);
+  }
+  if (file_handle_ != nullptr) {
+    CloseHandle(file_handle_);
+  }
+}
+#else
+MappedFile::MappedFile(const std::string& filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    Log::Fatal("Could not open model file %s", filename.c_str());
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    Log::Fatal("Could not determine the size of model file %s", filename.c_str());
+  }
+  void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after the file descriptor is closed
+  close(fd);
+  if (data == MAP_FAILED) {
+    Log::Fatal("Could not map model file %s", filename.c_str());
+  }
+  data_ = static_cast<const char*>(data);
+  size_ = static_cast<size_t>(st.st_size);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+}
+#endif
+
+const SharedModelHeader* CheckSharedModel(const char* buffer, size_t len) {
+  if (!IsSharedModel(buffer, len) || len < sizeof(SharedModelHeader)) {
+    Log::Fatal("Model is not in the shared model format");
+  }
+  const SharedModelHeader* header = reinterpret_cast<const SharedModelHeader*>(buffer);
+  if (header->version != kSharedModelVersion) {
+    Log::Fatal("Shared model has version %d, but version %d is required", header->version, kSharedModelVersion);
+  }
+  if (header->num_sections != kNumSharedModelSections || header->file_size != static_cast<int64_t>(len) ||
+      header->num_tree_per_iteration <= 0 || header->num_trees < 0 || header->num_trees % header->num_tree_per_iteration != 0 ||
+      header->max_feature_idx < -1) {
+    Log::Fatal("Shared model is truncated or corrupted");
+  }
+  for (int i = 0; i < kNumSharedModelSections; ++i) {
+    const SharedModelSectionEntry& section = header->sections[i];
+    if (!IsValidSharedModelArray(section.offset, section.size, 1, header->file_size)) {
+      Log::Fatal("Shared model is truncated or corrupted");
+    }
+    if (SharedModelChecksum(buffer + section.offset, static_cast<size_t>(section.size)) != section.checksum) {
+      Log::Fatal("Checksum mismatch in section %d of shared model", i);
+    }
+  }
+  const SharedModelSectionEntry& meta_section = header->sections[kSharedModelMetaSection];
+  if (meta_section.size < 1 || buffer[meta_section.offset + meta_section.size - 1] != '\0') {
+    Log::Fatal("Shared model is truncated or corrupted");
+  }
+  if (header->sections[kSharedModelTreeOffsetsSection].size != (static_cast<int64_t>(header->num_trees) + 1) * static_cast<int64_t>(sizeof(int64_t))) {
+    Log::Fatal("Shared model is truncated or corrupted");
+  }
+  const int64_t* tree_offsets = SharedModelTreeOffsets(buffer, header);
+  const int64_t trees_size = header->sections[kSharedModelTreesSection].size;
+  for (int i = 0; i < header->num_trees; ++i) {
+    if (tree_offsets[i] < 0 || tree_offsets[i] % 8 != 0 || tree_offsets[i] > tree_offsets[i + 1] || tree_offsets[i + 1] > trees_size) {
+      Log::Fatal("Shared model is truncated or corrupted");
+    }
+  }
+  return header;
+}
+
+bool IsValidSharedTree(const SharedTreeHeader* tree_header, size_t num_bytes, int num_features) {
+  if (num_bytes < sizeof(SharedTreeHeader)) {
+    return false;
+  }
+  const SharedTreeHeader& tree = *tree_header;
+  const int64_t tree_size = static_cast<int64_t>(num_bytes);
+  auto array = [&tree](int64_t offset) { return reinterpret_cast<const char*>(&tree) + offset; };
+  const int num_leaves = tree.num_leaves;
+  const int num_nodes = num_leaves - 1;
+  if (num_leaves < 1 || tree.num_cat < 0 || (tree.is_linear != 0 && tree.is_linear != 1) ||
+      !IsValidSharedModelArray(tree.split_feature, num_nodes, sizeof(int32_t), tree_size) ||
+      !IsValidSharedModelArray(tree.split_gain, num_nodes, sizeof(float), tree_size) ||
+      !IsValidSharedModelArray(tree.threshold, num_nodes, sizeof(double), tree_size) ||
+      !IsValidSharedModelArray(tree.decision_type, num_nodes, sizeof(int8_t), tree_size) ||
+      !IsValidSharedModelArray(tree.left_child, num_nodes, sizeof(int32_t), tree_size) ||
+      !IsValidSharedModelArray(tree.right_child, num_nodes, sizeof(int32_t), tree_size) ||
+      !IsValidSharedModelArray(tree.leaf_value, num_leaves, sizeof(double), tree_size) ||
+      !IsValidSharedModelArray(tree.internal_value, num_nodes, sizeof(double), tree_size) ||
+      !IsValidSharedModelArray(tree.internal_weight, num_nodes, sizeof(double), tree_size) ||
+      !IsValidSharedModelArray(tree.internal_count, num_nodes, sizeof(int32_t), tree_size)) {
+    return false;
+  }
+  if (tree.has_leaf_stats != 0 &&
+      (!IsValidSharedModelArray(tree.leaf_weight, num_leaves, sizeof(double), tree_size) ||
+       !IsValidSharedModelArray(tree.leaf_count, num_leaves, sizeof(int32_t), tree_size))) {
+    return false;
+  }
+  if (tree.num_cat > 0) {
+    if (!IsValidSharedModelArray(tree.cat_boundaries, static_cast<int64_t>(tree.num_cat) + 1, sizeof(int32_t), tree_size)) {
+      return false;
+    }
+    const int32_t* cat_boundaries = reinterpret_cast<const int32_t*>(array(tree.cat_boundaries));
+    if (cat_boundaries[0] != 0) {
+      return false;
+    }
+    for (int i = 0; i < tree.num_cat; ++i) {
+      if (cat_boundaries[i + 1] < cat_boundaries[i]) {
+        return false;
+      }
+    }
+    if (!IsValidSharedModelArray(tree.cat_threshold, cat_boundaries[tree.num_cat], sizeof(uint32_t), tree_size)) {
+      return false;
+    }
+  }
+  const int32_t* split_feature = reinterpret_cast<const int32_t*>(array(tree.split_feature));
+  const double* threshold = reinterpret_cast<const double*>(array(tree.threshold));
+  const int8_t* decision_type = reinterpret_cast<const int8_t*>(array(tree.decision_type));
+  const int32_t* left_child = reinterpret_cast<const int32_t*>(array(tree.left_child));
+  const int32_t* right_child = reinterpret_cast<const int32_t*>(array(tree.right_child));
+  for (int node = 0; node < num_nodes; ++node) {
+    if (split_feature[node] < 0 || (num_features >= 0 && split_feature[node] >= num_features)) {
+      return false;
+    }
+    if (Tree::GetDecisionType(decision_type[node], kCategoricalMask)) {
+      if (!(threshold[node] >= 0. && threshold[node] < tree.num_cat)) {
+        return false;
+      }
+    }
+    // children are either leaves or internal nodes with a larger index, this guarantees that GetLeaf terminates
+    for (const int32_t child : { left_child[node], right_child[node] }) {
+      if (child >= 0 ? (child <= node || child >= num_nodes) : (~child >= num_leaves)) {
+        return false;
+      }
+    }
+  }
+  if (tree.is_linear != 0) {
+    if (!IsValidSharedModelArray(tree.leaf_const, num_leaves, sizeof(double), tree_size) ||
+        !IsValidSharedModelArray(tree.leaf_features_start, static_cast<int64_t>(num_leaves) + 1, sizeof(int32_t), tree_size)) {
+      return false;
+    }
+    const int32_t* features_start = reinterpret_cast<const int32_t*>(array(tree.leaf_features_start));
+    if (features_start[0] != 0) {
+      return false;
+    }
+    for (int i = 0; i < num_leaves; ++i) {
+      if (features_start[i + 1] < features_start[i]) {
+        return false;
+      }
+    }
+    const int32_t num_leaf_features = features_start[num_leaves];
+    if (!IsValidSharedModelArray(tree.leaf_features, num_leaf_features, sizeof(int32_t), tree_size) ||
+        !IsValidSharedModelArray(tree.leaf_coeff, num_leaf_features, sizeof(double), tree_size)) {
+      return false;
+    }
+    const int32_t* leaf_features = reinterpret_cast<const int32_t*>(array(tree.leaf_features));
+    for (int32_t i = 0; i < num_leaf_features; ++i) {
+      if (leaf_features[i] < 0 || (num_features >= 0 && leaf_features[i] >= num_features)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+SharedModel::SharedModel(const std::string& filename) : file_(filename) {
+  if (!IsSharedModel(file_.data(), file_.size())) {
+    Log::Fatal("File %s is not a shared model file", filename.c_str());
+  }
+  header_ = CheckSharedModel(file_.data(), file_.size());
+  tree_offsets_ = SharedModelTreeOffsets(file_.data(), header_);
+  // all offsets and indices are checked once here such that prediction can access the arrays without checks
+  for (int i = 0; i < header_->num_trees; ++i) {
+    if (!IsValidSharedTree(&Tree(i), static_cast<size_t>(tree_offsets_[i + 1] - tree_offsets_[i]), NumFeatures())) {
+      Log::Fatal("Tree %d of shared model file %s is truncated or corrupted", i, filename.c_str());
+    }
+  }
+  const SharedModelSectionEntry& objective_section = header_->sections[kSharedModelObjectiveSection];
+  if (objective_section.size > 0) {
+    std::string objective(file_.data() + objective_section.offset, static_cast<size_t>(objective_section.size));
+    objective_function_.reset(ObjectiveFunction::CreateObjectiveFunction(ParseObjectiveAlias(objective)));
+  }
+}
+
+SharedModel::~SharedModel() {}
+
+double SharedModel::PredictTree(const SharedTreeHeader& tree, const double* features) const {
+  const double* leaf_value = Array<double>(tree, tree.leaf_value);
+  if (tree.num_leaves <= 1) {
+    return leaf_value[0];
+  }
+  const int leaf = Tree::GetLeaf(features, tree.num_cat, Array<int32_t>(tree, tree.split_feature),
+                                 Array<double>(tree, tree.threshold), Array<int8_t>(tree, tree.decision_type),
+                                 Array<int32_t>(tree, tree.left_child), Array<int32_t>(tree, tree.right_child),
+                                 Array<int32_t>(tree, tree.cat_boundaries), Array<uint32_t>(tree, tree.cat_threshold));
+  if (tree.is_linear == 0) {
+    return leaf_value[leaf];
+  }
+  const int32_t* features_start = Array<int32_t>(tree, tree.leaf_features_start);
+  return Tree::LinearLeafOutput(features, leaf_value[leaf], Array<double>(tree, tree.leaf_const)[leaf],
+                                Array<int32_t>(tree, tree.leaf_features) + features_start[leaf],
+                                Array<double>(tree, tree.leaf_coeff) + features_start[leaf],
+                                features_start[leaf + 1] - features_start[leaf]);
+}
+
+void SharedModel::Predict(const double* features, int start_iteration, int num_iteration,
+                          bool is_raw_score, double* output) const {
+  const int num_tree_per_iteration = header_->num_tree_per_iteration;
+  const int total_iteration = NumberOfIterations();
+  start_iteration = std::max(start_iteration, 0);
+  start_iteration = std::min(start_iteration, total_iteration);
+  if (num_iteration > 0) {
+    num_iteration = std::min(num_iteration, total_iteration - start_iteration);
+  } else {
+    num_iteration = total_iteration - start_iteration;
+  }
+  std::memset(output, 0, sizeof(double) * num_tree_per_iteration);
+  std::vector<double> pred_lag1;  // used for momentum step
+  const int end_iteration = start_iteration + num_iteration;
+  for (int i = start_iteration; i < end_iteration; ++i) {
+    // apply momentum step (same as in GBDT::PredictRaw)
+    if (header_->use_nesterov_acc != 0) {
+      Boosting::PredictionMomentumStep(i, num_tree_per_iteration, header_->momentum_schedule_version,
+                                       header_->nesterov_acc_rate, header_->momentum_offset, output, &pred_lag1);
+    }
+    for (int k = 0; k < num_tree_per_iteration; ++k) {
+      output[k] += PredictTree(Tree(i * num_tree_per_iteration + k), features);
+    }
+  }
+  if (is_raw_score) {
+    return;
+  }
+  if (header_->average_output != 0 && num_iteration > 0) {
+    for (int k = 0; k < num_tree_per_iteration; ++k) {
+      output[k] /= num_iteration;
+    }
+  }
+  if (objective_function_ != nullptr) {
+    objective_function_->ConvertOutput(output, output);
+  }
+}
+
+}  // namespace LightGBM
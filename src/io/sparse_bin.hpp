@@ -98,10 +98,11 @@ class SparseBin : public Bin {
   hist[ti] += g;                            \
   hist[ti + 1] += h;
 
-  void ConstructHistogram(const data_size_t* data_indices, data_size_t start,
-                          data_size_t end, const score_t* ordered_gradients,
-                          const score_t* ordered_hessians,
-                          hist_t* out) const override {
+  template <bool ORDERED>
+  void ConstructHistogramIndicesInner(const data_size_t* data_indices, data_size_t start,
+                                      data_size_t end, const score_t* ordered_gradients,
+                                      const score_t* ordered_hessians,
+                                      hist_t* out) const {
     data_size_t i_delta, cur_pos;
     InitIndex(data_indices[start], &i_delta, &cur_pos);
     data_size_t i = start;
@@ -117,7 +118,8 @@ class SparseBin : public Bin {
         }
       } else {
         const VAL_T bin = vals_[i_delta];
-        ACC_GH(out, bin, ordered_gradients[i], ordered_hessians[i]);
+        const data_size_t gi = ORDERED ? i : cur_pos;
+        ACC_GH(out, bin, ordered_gradients[gi], ordered_hessians[gi]);
         if (++i >= end) {
           break;
         }
@@ -145,9 +147,10 @@ class SparseBin : public Bin {
     }
   }
 
-  void ConstructHistogram(const data_size_t* data_indices, data_size_t start,
-                          data_size_t end, const score_t* ordered_gradients,
-                          hist_t* out) const override {
+  template <bool ORDERED>
+  void ConstructHistogramIndicesInner(const data_size_t* data_indices, data_size_t start,
+                                      data_size_t end, const score_t* ordered_gradients,
+                                      hist_t* out) const {
     data_size_t i_delta, cur_pos;
     InitIndex(data_indices[start], &i_delta, &cur_pos);
     data_size_t i = start;
@@ -165,7 +168,7 @@ class SparseBin : public Bin {
         }
       } else {
         const uint32_t ti = static_cast<uint32_t>(vals_[i_delta]) << 1;
-        grad[ti] += ordered_gradients[i];
+        grad[ti] += ordered_gradients[ORDERED ? i : cur_pos];
         ++cnt[ti];
         if (++i >= end) {
           break;
@@ -195,6 +198,36 @@ class SparseBin : public Bin {
       cur_pos += deltas_[++i_delta];
     }
   }
+
+  void ConstructHistogram(const data_size_t* data_indices, data_size_t start,
+                          data_size_t end, const score_t* ordered_gradients,
+                          const score_t* ordered_hessians,
+                          hist_t* out) const override {
+    ConstructHistogramIndicesInner<true>(data_indices, start, end,
+                                         ordered_gradients, ordered_hessians, out);
+  }
+
+  void ConstructHistogram(const data_size_t* data_indices, data_size_t start,
+                          data_size_t end, const score_t* ordered_gradients,
+                          hist_t* out) const override {
+    ConstructHistogramIndicesInner<true>(data_indices, start, end,
+                                         ordered_gradients, out);
+  }
+
+  void ConstructHistogramUnordered(const data_size_t* data_indices, data_size_t start,
+                                   data_size_t end, const score_t* gradients,
+                                   const score_t* hessians,
+                                   hist_t* out) const override {
+    ConstructHistogramIndicesInner<false>(data_indices, start, end,
+                                          gradients, hessians, out);
+  }
+
+  void ConstructHistogramUnordered(const data_size_t* data_indices, data_size_t start,
+                                   data_size_t end, const score_t* gradients,
+                                   hist_t* out) const override {
+    ConstructHistogramIndicesInner<false>(data_indices, start, end,
+                                          gradients, out);
+  }
 #undef ACC_GH
 
   inline void NextNonzeroFast(data_size_t* i_delta,
@@ -69,12 +69,52 @@ void MultiValBinWrapper::HistMerge(std::vector<hist_t,
   if (is_use_subcol_) {
     dst = hist_buf->data() + hist_buf->size() - 2 * static_cast<size_t>(num_bin_aligned_);
   }
+  if (n_data_block_ <= kMaxDataBlocksFlatHistMerge) {
+    #pragma omp parallel for schedule(static, 1) num_threads(num_threads_)
+    for (int t = 0; t < n_bin_block; ++t) {
+      const int start = t * bin_block_size;
+      const int end = std::min(start + bin_block_size, num_bin_);
+      for (int tid = 1; tid < n_data_block_; ++tid) {
+        auto src_ptr = hist_buf->data() + static_cast<size_t>(num_bin_aligned_) * 2 * (tid - 1);
+        for (int i = start * 2; i < end * 2; ++i) {
+          dst[i] += src_ptr[i];
+        }
+      }
+    }
+    return;
+  }
+  // two-level reduction: neighbouring data blocks (built by neighbouring threads, i.e.,
+  // usually on the same socket) are first reduced into the first block of their group,
+  // and only the group results are then merged into dst
+  const int group_size = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(n_data_block_))));
+  const int n_group = (n_data_block_ + group_size - 1) / group_size;
+  auto block_ptr = [&] (int block_id) {
+    return block_id == 0 ? dst :
+      hist_buf->data() + static_cast<size_t>(num_bin_aligned_) * 2 * (block_id - 1);
+  };
+  // contiguous static scheduling assigns the tasks of a group to the threads that built its blocks
+  #pragma omp parallel for schedule(static) num_threads(num_threads_)
+  for (int task = 0; task < n_group * n_bin_block; ++task) {
+    const int group = task / n_bin_block;
+    const int t = task % n_bin_block;
+    const int start = t * bin_block_size;
+    const int end = std::min(start + bin_block_size, num_bin_);
+    const int block_start = group * group_size;
+    const int block_end = std::min(block_start + group_size, n_data_block_);
+    hist_t* group_dst = block_ptr(block_start);
+    for (int block_id = block_start + 1; block_id < block_end; ++block_id) {
+      const hist_t* src_ptr = block_ptr(block_id);
+      for (int i = start * 2; i < end * 2; ++i) {
+        group_dst[i] += src_ptr[i];
+      }
+    }
+  }
   #pragma omp parallel for schedule(static, 1) num_threads(num_threads_)
   for (int t = 0; t < n_bin_block; ++t) {
     const int start = t * bin_block_size;
     const int end = std::min(start + bin_block_size, num_bin_);
-    for (int tid = 1; tid < n_data_block_; ++tid) {
-      auto src_ptr = hist_buf->data() + static_cast<size_t>(num_bin_aligned_) * 2 * (tid - 1);
+    for (int group = 1; group < n_group; ++group) {
+      const hist_t* src_ptr = block_ptr(group * group_size);
       for (int i = start * 2; i < end * 2; ++i) {
         dst[i] += src_ptr[i];
       }
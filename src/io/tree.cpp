@@ -5,9 +5,12 @@
 #include <LightGBM/tree.h>
 
 #include <LightGBM/dataset.h>
+#include <LightGBM/shared_model.h>
 #include <LightGBM/utils/common.h>
 #include <LightGBM/utils/threading.h>
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
 #include <iomanip>
 #include <sstream>
@@ -406,6 +409,60 @@ std::string Tree::ToString() const {
   return str_buf.str();
 }
 
+void Tree::AppendToSharedModel(std::string* buffer) const {
+  // offsets are relative to the beginning of the tree
+  CHECK(buffer->size() % 8 == 0);
+  const size_t start = buffer->size();
+  SharedTreeHeader header;
+  std::memset(&header, 0, sizeof(header));
+  AppendToSharedModelBuffer(buffer, &header, sizeof(header));
+  auto append = [buffer, start](const void* data, size_t num_bytes) {
+    return AppendToSharedModelBuffer(buffer, data, num_bytes) - static_cast<int64_t>(start);
+  };
+  const size_t num_nodes = static_cast<size_t>(num_leaves_ - 1);
+  const size_t num_leaves = static_cast<size_t>(num_leaves_);
+  header.num_leaves = num_leaves_;
+  header.num_cat = num_cat_;
+  header.is_linear = is_linear_ ? 1 : 0;
+  // trees with a single leaf that are loaded from a text model have no leaf weights and counts
+  header.has_leaf_stats = (leaf_weight_.size() >= num_leaves && leaf_count_.size() >= num_leaves) ? 1 : 0;
+  header.shrinkage = shrinkage_;
+  header.split_feature = append(split_feature_.data(), num_nodes * sizeof(int32_t));
+  header.split_gain = append(split_gain_.data(), num_nodes * sizeof(float));
+  header.threshold = append(threshold_.data(), num_nodes * sizeof(double));
+  header.decision_type = append(decision_type_.data(), num_nodes * sizeof(int8_t));
+  header.left_child = append(left_child_.data(), num_nodes * sizeof(int32_t));
+  header.right_child = append(right_child_.data(), num_nodes * sizeof(int32_t));
+  header.leaf_value = append(leaf_value_.data(), num_leaves * sizeof(double));
+  if (header.has_leaf_stats != 0) {
+    header.leaf_weight = append(leaf_weight_.data(), num_leaves * sizeof(double));
+    header.leaf_count = append(leaf_count_.data(), num_leaves * sizeof(int32_t));
+  }
+  header.internal_value = append(internal_value_.data(), num_nodes * sizeof(double));
+  header.internal_weight = append(internal_weight_.data(), num_nodes * sizeof(double));
+  header.internal_count = append(internal_count_.data(), num_nodes * sizeof(int32_t));
+  if (num_cat_ > 0) {
+    header.cat_boundaries = append(cat_boundaries_.data(), (num_cat_ + 1) * sizeof(int32_t));
+    header.cat_threshold = append(cat_threshold_.data(), cat_threshold_.size() * sizeof(uint32_t));
+  }
+  if (is_linear_) {
+    std::vector<int32_t> features_start(num_leaves + 1, 0);
+    std::vector<int32_t> features;
+    std::vector<double> coeff;
+    for (int i = 0; i < num_leaves_; ++i) {
+      features.insert(features.end(), leaf_features_[i].begin(), leaf_features_[i].end());
+      coeff.insert(coeff.end(), leaf_coeff_[i].begin(), leaf_coeff_[i].end());
+      features_start[i + 1] = static_cast<int32_t>(features.size());
+    }
+    header.leaf_const = append(leaf_const_.data(), num_leaves * sizeof(double));
+    header.leaf_features_start = append(features_start.data(), features_start.size() * sizeof(int32_t));
+    header.leaf_features = append(features.data(), features.size() * sizeof(int32_t));
+    header.leaf_coeff = append(coeff.data(), coeff.size() * sizeof(double));
+  }
+  buffer->resize((buffer->size() + 7) / 8 * 8, '\0');
+  std::memcpy(&(*buffer)[start], &header, sizeof(header));
+}
+
 std::string Tree::ToJSON() const {
   std::stringstream str_buf;
   Common::C_stringstream(str_buf);
@@ -824,6 +881,69 @@ Tree::Tree(const char* str, size_t* used_len) {
   max_depth_ = -1;
 }
 
+/*!
+* \brief Copy an array of a tree in a shared model
+* \param tree Beginning of the tree
+* \param offset Offset of the array relative to the beginning of the tree
+* \param num_elements Number of elements of the array
+* \param[out] out Array
+*/
+template<typename T>
+static void CopySharedTreeArray(const SharedTreeHeader* tree, int64_t offset,
+                                size_t num_elements, std::vector<T>* out) {
+  out->resize(num_elements);
+  if (num_elements > 0) {
+    std::memcpy(out->data(), reinterpret_cast<const char*>(tree) + offset, num_elements * sizeof(T));
+  }
+}
+
+Tree::Tree(const SharedTreeHeader* tree, size_t num_bytes) {
+  if (!IsValidSharedTree(tree, num_bytes, -1)) {
+    Log::Fatal("Tree in shared model is truncated or corrupted");
+  }
+  num_leaves_ = tree->num_leaves;
+  max_leaves_ = num_leaves_;
+  num_cat_ = tree->num_cat;
+  is_linear_ = tree->is_linear != 0;
+  shrinkage_ = tree->shrinkage;
+  track_branch_features_ = false;
+  const size_t num_nodes = static_cast<size_t>(num_leaves_ - 1);
+  const size_t num_leaves = static_cast<size_t>(num_leaves_);
+  CopySharedTreeArray(tree, tree->split_feature, num_nodes, &split_feature_);
+  CopySharedTreeArray(tree, tree->split_gain, num_nodes, &split_gain_);
+  CopySharedTreeArray(tree, tree->threshold, num_nodes, &threshold_);
+  CopySharedTreeArray(tree, tree->decision_type, num_nodes, &decision_type_);
+  CopySharedTreeArray(tree, tree->left_child, num_nodes, &left_child_);
+  CopySharedTreeArray(tree, tree->right_child, num_nodes, &right_child_);
+  CopySharedTreeArray(tree, tree->leaf_value, num_leaves, &leaf_value_);
+  if (tree->has_leaf_stats != 0) {
+    CopySharedTreeArray(tree, tree->leaf_weight, num_leaves, &leaf_weight_);
+    CopySharedTreeArray(tree, tree->leaf_count, num_leaves, &leaf_count_);
+  }
+  CopySharedTreeArray(tree, tree->internal_value, num_nodes, &internal_value_);
+  CopySharedTreeArray(tree, tree->internal_weight, num_nodes, &internal_weight_);
+  CopySharedTreeArray(tree, tree->internal_count, num_nodes, &internal_count_);
+  if (num_cat_ > 0) {
+    CopySharedTreeArray(tree, tree->cat_boundaries, static_cast<size_t>(num_cat_) + 1, &cat_boundaries_);
+    CopySharedTreeArray(tree, tree->cat_threshold, static_cast<size_t>(cat_boundaries_.back()), &cat_threshold_);
+  }
+  if (is_linear_) {
+    CopySharedTreeArray(tree, tree->leaf_const, num_leaves, &leaf_const_);
+    std::vector<int> features_start;
+    CopySharedTreeArray(tree, tree->leaf_features_start, num_leaves + 1, &features_start);
+    const int* features = reinterpret_cast<const int*>(reinterpret_cast<const char*>(tree) + tree->leaf_features);
+    const double* coeff = reinterpret_cast<const double*>(reinterpret_cast<const char*>(tree) + tree->leaf_coeff);
+    leaf_coeff_.resize(num_leaves_);
+    leaf_features_.resize(num_leaves_);
+    leaf_features_inner_.resize(num_leaves_);
+    for (int i = 0; i < num_leaves_; ++i) {
+      leaf_features_[i].assign(features + features_start[i], features + features_start[i + 1]);
+      leaf_coeff_[i].assign(coeff + features_start[i], coeff + features_start[i + 1]);
+    }
+  }
+  max_depth_ = -1;
+}
+
 void Tree::ExtendPath(PathElement *unique_path, int unique_depth,
                       double zero_fraction, double one_fraction, int feature_index) {
   unique_path[unique_depth].feature_index = feature_index;
@@ -997,6 +1117,146 @@ double Tree::ExpectedValue() const {
   return exp_value;
 }
 
+void Tree::InitContribPaths(TreeContribPaths* paths) const {
+  paths->leaf.clear();
+  paths->begin.assign(1, 0);
+  paths->feature.clear();
+  paths->zero_fraction.clear();
+  paths->node_begin.assign(1, 0);
+  paths->nodes.clear();
+  if (num_leaves_ > 1) {
+    std::vector<std::pair<int, int>> path_nodes;
+    InitContribPaths(0, &path_nodes, paths);
+  }
+}
+
+void Tree::InitContribPaths(int node, std::vector<std::pair<int, int>>* path_nodes, TreeContribPaths* paths) const {
+  if (node >= 0) {
+    path_nodes->emplace_back(node, left_child_[node]);
+    InitContribPaths(left_child_[node], path_nodes, paths);
+    path_nodes->back().second = right_child_[node];
+    InitContribPaths(right_child_[node], path_nodes, paths);
+    path_nodes->pop_back();
+    return;
+  }
+  // one path element per distinct split feature (in the order of the first split on the feature)
+  std::vector<int> features;
+  for (const auto& path_node : *path_nodes) {
+    const int feature = split_feature_[path_node.first];
+    if (std::find(features.begin(), features.end(), feature) == features.end()) {
+      features.push_back(feature);
+    }
+  }
+  for (int feature : features) {
+    double zero_fraction = 1;
+    for (const auto& path_node : *path_nodes) {
+      if (split_feature_[path_node.first] == feature) {
+        zero_fraction *= data_count(path_node.second) / static_cast<double>(data_count(path_node.first));
+        paths->nodes.push_back(path_node);
+      }
+    }
+    paths->feature.push_back(feature);
+    paths->zero_fraction.push_back(zero_fraction);
+    paths->node_begin.push_back(static_cast<int>(paths->nodes.size()));
+  }
+  paths->leaf.push_back(~node);
+  paths->begin.push_back(static_cast<int>(paths->feature.size()));
+}
+
+// computation of SHAP values for a block of records using the precomputed paths,
+// this is equivalent to TreeSHAP since the contribution of a leaf only depends on the set of distinct features
+// on its path, their zero fractions, and whether the record follows the path for every feature (one fraction);
+// all inner loops run over the records of the block
+void Tree::PredictContribBlock(const TreeContribPaths& paths, const double* feature_values, int num_rows, int num_features,
+                               double* output, int64_t output_stride) const {
+  const double expected_value = ExpectedValue();
+  for (int r = 0; r < num_rows; ++r) {
+    output[r * output_stride + num_features] += expected_value;
+  }
+  if (num_leaves_ <= 1) {
+    return;
+  }
+  CHECK_EQ(static_cast<int>(paths.leaf.size()), num_leaves_);
+  // child of every internal node which is taken by every record
+  std::vector<int> next_node(static_cast<size_t>(num_leaves_ - 1) * num_rows);
+  for (int node = 0; node < num_leaves_ - 1; ++node) {
+    const int feature = split_feature_[node];
+    int* next = next_node.data() + static_cast<size_t>(node) * num_rows;
+    for (int r = 0; r < num_rows; ++r) {
+      next[r] = Decision(feature_values[static_cast<size_t>(r) * num_features + feature], node);
+    }
+  }
+  int max_path_len = 0;
+  for (int p = 0; p < num_leaves_; ++p) {
+    max_path_len = std::max(max_path_len, paths.begin[p + 1] - paths.begin[p]);
+  }
+  std::vector<double> one_fraction(static_cast<size_t>(max_path_len) * num_rows);
+  std::vector<double> pweight(static_cast<size_t>(max_path_len + 1) * num_rows);
+  std::vector<double> next_one_portion(num_rows);
+  std::vector<double> total(num_rows);
+  for (int p = 0; p < num_leaves_; ++p) {
+    const double leaf_value = leaf_value_[paths.leaf[p]];
+    const int path_begin = paths.begin[p];
+    const int unique_depth = paths.begin[p + 1] - path_begin;
+    // a record has a one fraction of one for a feature if it follows the path at all nodes splitting on this feature
+    for (int e = 0; e < unique_depth; ++e) {
+      double* one = one_fraction.data() + static_cast<size_t>(e) * num_rows;
+      std::fill(one, one + num_rows, 1.0);
+      for (int j = paths.node_begin[path_begin + e]; j < paths.node_begin[path_begin + e + 1]; ++j) {
+        const int* next = next_node.data() + static_cast<size_t>(paths.nodes[j].first) * num_rows;
+        const int child = paths.nodes[j].second;
+#pragma omp simd
+        for (int r = 0; r < num_rows; ++r) {
+          one[r] = (next[r] == child) ? one[r] : 0.0;
+        }
+      }
+    }
+    // extend the path by all elements (see ExtendPath), the element at depth zero is the root
+    std::fill(pweight.begin(), pweight.begin() + num_rows, 1.0);
+    for (int d = 1; d <= unique_depth; ++d) {
+      const double zero_fraction = paths.zero_fraction[path_begin + d - 1];
+      const double* one = one_fraction.data() + static_cast<size_t>(d - 1) * num_rows;
+      std::fill(pweight.begin() + static_cast<size_t>(d) * num_rows, pweight.begin() + static_cast<size_t>(d + 1) * num_rows, 0.0);
+      for (int i = d - 1; i >= 0; --i) {
+        double* pweight_i = pweight.data() + static_cast<size_t>(i) * num_rows;
+        double* pweight_i1 = pweight_i + num_rows;
+        const double one_scale = (i + 1) / static_cast<double>(d + 1);
+        const double zero_scale = zero_fraction * (d - i) / static_cast<double>(d + 1);
+#pragma omp simd
+        for (int r = 0; r < num_rows; ++r) {
+          pweight_i1[r] += one[r] * pweight_i[r] * one_scale;
+          pweight_i[r] *= zero_scale;
+        }
+      }
+    }
+    // contribution of every element (see UnwoundPathSum)
+    const double* pweight_depth = pweight.data() + static_cast<size_t>(unique_depth) * num_rows;
+    for (int e = 0; e < unique_depth; ++e) {
+      const double zero_fraction = paths.zero_fraction[path_begin + e];
+      const double* one = one_fraction.data() + static_cast<size_t>(e) * num_rows;
+      std::copy(pweight_depth, pweight_depth + num_rows, next_one_portion.begin());
+      std::fill(total.begin(), total.end(), 0.0);
+      for (int i = unique_depth - 1; i >= 0; --i) {
+        const double* pweight_i = pweight.data() + static_cast<size_t>(i) * num_rows;
+        const double frac = (unique_depth - i) / static_cast<double>(unique_depth + 1);
+        const double one_scale = (unique_depth + 1) / static_cast<double>(i + 1);
+        const double zero_scale = 1. / (zero_fraction * frac);
+        const double next_scale = zero_fraction * frac;
+#pragma omp simd
+        for (int r = 0; r < num_rows; ++r) {
+          const double tmp = next_one_portion[r] * one_scale;
+          total[r] += (one[r] != 0) ? tmp : pweight_i[r] * zero_scale;
+          next_one_portion[r] = pweight_i[r] - tmp * next_scale;
+        }
+      }
+      const int feature = paths.feature[path_begin + e];
+      for (int r = 0; r < num_rows; ++r) {
+        output[r * output_stride + feature] += total[r] * (one[r] - zero_fraction) * leaf_value;
+      }
+    }
+  }
+}
+
 void Tree::RecomputeMaxDepth() {
   if (num_leaves_ == 1) {
     max_depth_ = 0;
@@ -6,8 +6,12 @@
 
 #include <LightGBM/utils/common.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <sstream>
 
 #include "linkers.h"
 
@@ -25,6 +29,8 @@ THREAD_LOCAL comm_size_t Network::buffer_size_ = 0;
 THREAD_LOCAL std::vector<char> Network::buffer_;
 THREAD_LOCAL ReduceScatterFunction Network::reduce_scatter_ext_fun_ = nullptr;
 THREAD_LOCAL AllgatherFunction Network::allgather_ext_fun_ = nullptr;
+THREAD_LOCAL std::vector<Network::AllreduceAlgorithm> Network::allreduce_algorithm_by_size_;
+THREAD_LOCAL std::vector<Network::AllreduceAlgorithm> Network::reduce_scatter_algorithm_by_size_;
 
 
 void Network::Init(Config config) {
@@ -38,7 +44,12 @@ void Network::Init(Config config) {
     block_len_ = std::vector<comm_size_t>(num_machines_);
     buffer_size_ = 1024 * 1024;
     buffer_.resize(buffer_size_);
+    allreduce_algorithm_by_size_.clear();
+    reduce_scatter_algorithm_by_size_.clear();
     Log::Info("Local rank: %d, total number of machines: %d", rank_, num_machines_);
+    if (config.network_benchmark) {
+      BenchmarkAllreduce();
+    }
   }
 }
 
@@ -53,6 +64,8 @@ void Network::Init(int num_machines, int rank,
     buffer_.resize(buffer_size_);
     reduce_scatter_ext_fun_ = reduce_scatter_ext_fun;
     allgather_ext_fun_ = allgather_ext_fun;
+    allreduce_algorithm_by_size_.clear();
+    reduce_scatter_algorithm_by_size_.clear();
     Log::Info("Local rank: %d, total number of machines: %d", rank_, num_machines_);
   }
 }
@@ -63,6 +76,8 @@ void Network::Dispose() {
   linkers_.reset(new Linkers());
   reduce_scatter_ext_fun_ = nullptr;
   allgather_ext_fun_ = nullptr;
+  allreduce_algorithm_by_size_.clear();
+  reduce_scatter_algorithm_by_size_.clear();
 }
 
 void Network::Allreduce(char* input, comm_size_t input_size, int type_size, char* output, const ReduceFunction& reducer) {
@@ -70,11 +85,40 @@ void Network::Allreduce(char* input, comm_size_t input_size, int type_size, char
     Log::Fatal("Please initilize the network interface first");
   }
   comm_size_t count = input_size / type_size;
-  // if small package or small count , do it by all gather.(reduce the communication times.)
-  if (count < num_machines_ || input_size < 4096) {
+  // blocks of reduce scatter need at least one object
+  if (count < num_machines_) {
+    AllreduceByAllGather(input, input_size, type_size, output, reducer);
+    return;
+  }
+  if (!allreduce_algorithm_by_size_.empty()) {
+    AllreduceWith(BenchmarkedAlgorithm(allreduce_algorithm_by_size_, input_size), input, input_size, type_size, output, reducer);
+    return;
+  }
+  // if small package, do it by all gather.(reduce the communication times.)
+  if (input_size < 4096) {
+    AllreduceByAllGather(input, input_size, type_size, output, reducer);
+    return;
+  }
+  AllreduceWith(AllreduceAlgorithm::kReduceScatter, input, input_size, type_size, output, reducer);
+}
+
+Network::AllreduceAlgorithm Network::BenchmarkedAlgorithm(const std::vector<AllreduceAlgorithm>& algorithm_by_size,
+                                                          comm_size_t input_size) {
+  int size_log2 = 0;
+  while (size_log2 + 1 < static_cast<int>(algorithm_by_size.size())
+         && (static_cast<int64_t>(1) << (size_log2 + 1)) <= input_size) {
+    ++size_log2;
+  }
+  return algorithm_by_size[size_log2];
+}
+
+void Network::AllreduceWith(AllreduceAlgorithm algorithm, char* input, comm_size_t input_size, int type_size,
+                            char* output, const ReduceFunction& reducer) {
+  if (algorithm == AllreduceAlgorithm::kAllGather) {
     AllreduceByAllGather(input, input_size, type_size, output, reducer);
     return;
   }
+  comm_size_t count = input_size / type_size;
   // assign the blocks to every rank.
   comm_size_t step = (count + num_machines_ - 1) / num_machines_;
   if (step < 1) {
@@ -87,11 +131,99 @@ void Network::Allreduce(char* input, comm_size_t input_size, int type_size, char
   }
   block_len_[num_machines_ - 1] = input_size - block_start_[num_machines_ - 1];
   // do reduce scatter
-  ReduceScatter(input, input_size, type_size, block_start_.data(), block_len_.data(), output, input_size, reducer);
+  if (algorithm == AllreduceAlgorithm::kRecursiveHalving) {
+    ReduceScatterRecursiveHalving(input, input_size, type_size, block_start_.data(), block_len_.data(), output, input_size, reducer);
+  } else if (algorithm == AllreduceAlgorithm::kRing) {
+    ReduceScatterRing(input, input_size, type_size, block_start_.data(), block_len_.data(), output, input_size, reducer);
+  } else {
+    ReduceScatter(input, input_size, type_size, block_start_.data(), block_len_.data(), output, input_size, reducer);
+  }
   // do all gather
   Allgather(output, block_start_.data(), block_len_.data(), output, input_size);
 }
 
+void Network::BenchmarkAllreduce() {
+  if (num_machines_ <= 1) {
+    Log::Fatal("Please initilize the network interface first");
+  }
+  if (reduce_scatter_ext_fun_ != nullptr || allgather_ext_fun_ != nullptr) {
+    Log::Warning("Allreduce benchmark is skipped, since external collective functions are used");
+    return;
+  }
+  const int kMinSizeLog2 = 8;
+  const int kMaxSizeLog2 = 24;
+  const int kNumRepeats = 3;
+  // all gather keeps the inputs of all machines in buffer_
+  const int64_t kMaxAllGatherBufferSize = 64 * 1024 * 1024;
+  const AllreduceAlgorithm algorithms[] = {AllreduceAlgorithm::kAllGather, AllreduceAlgorithm::kRecursiveHalving,
+                                           AllreduceAlgorithm::kRing};
+  const char* algorithm_names[] = {"all gather", "recursive halving", "ring"};
+  const ReduceFunction sum_reducer = [](const char* src, char* dst, int type_size, comm_size_t len) {
+    comm_size_t used_size = 0;
+    while (used_size < len) {
+      *reinterpret_cast<double*>(dst) += *reinterpret_cast<const double*>(src);
+      src += type_size;
+      dst += type_size;
+      used_size += type_size;
+    }
+  };
+  allreduce_algorithm_by_size_.clear();
+  reduce_scatter_algorithm_by_size_.clear();
+  std::vector<AllreduceAlgorithm> selected(kMaxSizeLog2 + 1, AllreduceAlgorithm::kAllGather);
+  // reduce scatter only chooses between recursive halving and ring. Both are followed by the same all gather
+  // in the benchmark, i.e., the faster allreduce also has the faster reduce scatter
+  std::vector<AllreduceAlgorithm> selected_reduce_scatter(kMaxSizeLog2 + 1, AllreduceAlgorithm::kRecursiveHalving);
+  std::vector<char> input(static_cast<size_t>(1) << kMaxSizeLog2, 0);
+  std::vector<char> output(static_cast<size_t>(1) << kMaxSizeLog2, 0);
+  for (int size_log2 = kMinSizeLog2; size_log2 <= kMaxSizeLog2; ++size_log2) {
+    const comm_size_t input_size = static_cast<comm_size_t>(1) << size_log2;
+    double best_time = std::numeric_limits<double>::infinity();
+    double best_reduce_scatter_time = std::numeric_limits<double>::infinity();
+    for (int k = 0; k < 3; ++k) {
+      double local_time = std::numeric_limits<double>::infinity();
+      const bool is_feasible = input_size / static_cast<comm_size_t>(sizeof(double)) >= num_machines_
+        && (algorithms[k] != AllreduceAlgorithm::kAllGather
+            || static_cast<int64_t>(input_size) * num_machines_ <= kMaxAllGatherBufferSize);
+      if (!is_feasible) { continue; }
+      // the first run is a warm up
+      for (int i = 0; i <= kNumRepeats; ++i) {
+        auto start_time = std::chrono::steady_clock::now();
+        AllreduceWith(algorithms[k], input.data(), input_size, sizeof(double), output.data(), sum_reducer);
+        std::chrono::duration<double, std::milli> used_time = std::chrono::steady_clock::now() - start_time;
+        if (i > 0) {
+          local_time = std::min(local_time, used_time.count());
+        }
+      }
+      // all machines need to agree on the selection
+      const double time = GlobalSyncUpByMax(local_time);
+      Log::Debug("Allreduce benchmark, %d bytes by %s: %f ms, %f MB/s", input_size, algorithm_names[k], time,
+                 input_size / (time * 1e3));
+      if (time < best_time) {
+        best_time = time;
+        selected[size_log2] = algorithms[k];
+      }
+      if (algorithms[k] != AllreduceAlgorithm::kAllGather && time < best_reduce_scatter_time) {
+        best_reduce_scatter_time = time;
+        selected_reduce_scatter[size_log2] = algorithms[k];
+      }
+    }
+  }
+  for (int size_log2 = 0; size_log2 < kMinSizeLog2; ++size_log2) {
+    selected[size_log2] = selected[kMinSizeLog2];
+    selected_reduce_scatter[size_log2] = selected_reduce_scatter[kMinSizeLog2];
+  }
+  allreduce_algorithm_by_size_ = selected;
+  reduce_scatter_algorithm_by_size_ = selected_reduce_scatter;
+  std::stringstream str_buf;
+  for (int size_log2 = kMinSizeLog2; size_log2 <= kMaxSizeLog2; ++size_log2) {
+    if (size_log2 > kMinSizeLog2) {
+      str_buf << ", ";
+    }
+    str_buf << (1 << size_log2) << "B: " << algorithm_names[static_cast<int>(selected[size_log2])];
+  }
+  Log::Info("Allreduce algorithms selected by benchmark: %s", str_buf.str().c_str());
+}
+
 void Network::AllreduceByAllGather(char* input, comm_size_t input_size, int type_size, char* output, const ReduceFunction& reducer) {
   if (num_machines_ <= 1) {
     Log::Fatal("Please initilize the network interface first");
@@ -238,6 +370,14 @@ void Network::ReduceScatter(char* input, comm_size_t input_size, int type_size,
   if (reduce_scatter_ext_fun_ != nullptr) {
     return reduce_scatter_ext_fun_(input, input_size, type_size, block_start, block_len, num_machines_, output, output_size, reducer);
   }
+  if (!reduce_scatter_algorithm_by_size_.empty()) {
+    if (BenchmarkedAlgorithm(reduce_scatter_algorithm_by_size_, input_size) == AllreduceAlgorithm::kRing) {
+      ReduceScatterRing(input, input_size, type_size, block_start, block_len, output, output_size, reducer);
+    } else {
+      ReduceScatterRecursiveHalving(input, input_size, type_size, block_start, block_len, output, output_size, reducer);
+    }
+    return;
+  }
   const comm_size_t kRingThreshold = 10 * 1024 * 1024;  // 10MB
   if (recursive_halving_map_.is_power_of_2 || input_size < kRingThreshold) {
     ReduceScatterRecursiveHalving(input, input_size, type_size, block_start, block_len, output, output_size, reducer);
@@ -317,6 +457,58 @@ void Network::ReduceScatterRing(char* input, comm_size_t, int type_size,
   std::memcpy(output, input + block_start[rank_], block_len[rank_]);
 }
 
+void Network::ReduceScatterEncoded(char* input, const comm_size_t* block_start, const comm_size_t* block_len,
+                                   const AccumulateFunction& accumulate) {
+  if (num_machines_ <= 1) {
+    Log::Fatal("Please initilize the network interface first");
+  }
+  if (allgather_ext_fun_ != nullptr) {
+    // external functions can only gather, so every machine receives all encoded blocks
+    std::vector<comm_size_t> all_block_start(num_machines_ * num_machines_);
+    std::vector<comm_size_t> all_block_len(num_machines_ * num_machines_);
+    Allgather(reinterpret_cast<char*>(const_cast<comm_size_t*>(block_start)), sizeof(comm_size_t) * num_machines_,
+              reinterpret_cast<char*>(all_block_start.data()));
+    Allgather(reinterpret_cast<char*>(const_cast<comm_size_t*>(block_len)), sizeof(comm_size_t) * num_machines_,
+              reinterpret_cast<char*>(all_block_len.data()));
+    std::vector<comm_size_t> input_start(num_machines_, 0);
+    std::vector<comm_size_t> input_len(num_machines_, 0);
+    comm_size_t all_size = 0;
+    for (int i = 0; i < num_machines_; ++i) {
+      for (int j = 0; j < num_machines_; ++j) {
+        const int k = i * num_machines_ + j;
+        input_len[i] = std::max(input_len[i], all_block_start[k] + all_block_len[k]);
+      }
+      input_start[i] = all_size;
+      all_size += input_len[i];
+    }
+    std::vector<char> all_input(all_size);
+    Allgather(input, input_start.data(), input_len.data(), all_input.data(), all_size);
+    for (int i = 0; i < num_machines_; ++i) {
+      if (i == rank_) { continue; }
+      const int k = i * num_machines_ + rank_;
+      accumulate(all_input.data() + input_start[i] + all_block_start[k], all_block_len[k]);
+    }
+    return;
+  }
+  for (int i = 1; i < num_machines_; ++i) {
+    const int out_rank = (rank_ + i) % num_machines_;
+    const int in_rank = (rank_ - i + num_machines_) % num_machines_;
+    // exchange the encoded sizes first
+    comm_size_t send_len = block_len[out_rank];
+    comm_size_t recv_len = 0;
+    const int size_len = static_cast<int>(sizeof(comm_size_t));
+    linkers_->SendRecv(out_rank, reinterpret_cast<char*>(&send_len), size_len,
+                       in_rank, reinterpret_cast<char*>(&recv_len), size_len);
+    if (recv_len > buffer_size_) {
+      buffer_size_ = recv_len;
+      buffer_.resize(buffer_size_);
+    }
+    linkers_->SendRecv(out_rank, input + block_start[out_rank], send_len,
+                       in_rank, buffer_.data(), recv_len);
+    accumulate(buffer_.data(), recv_len);
+  }
+}
+
 int Network::rank() {
     return rank_;
 }
@@ -325,4 +517,8 @@ int Network::num_machines() {
     return num_machines_;
 }
 
+bool Network::allreduce_benchmarked() {
+    return !allreduce_algorithm_by_size_.empty();
+}
+
 }  // namespace LightGBM
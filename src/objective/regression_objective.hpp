@@ -8,13 +8,17 @@
 
 #include <GPBoost/re_model.h>
 #include <GPBoost/DF_utils.h>
+#include <GPBoost/thread_budget.h>
 
 #include <LightGBM/meta.h>
 #include <LightGBM/objective_function.h>
 #include <LightGBM/utils/array_args.h>
+#include <LightGBM/utils/openmp_wrapper.h>
 
 #include <string>
 #include <algorithm>
+#include <future>
+#include <memory>
 #include <vector>
 
 #include <cmath>
@@ -107,6 +111,7 @@ namespace LightGBM {
 			: deterministic_(config.deterministic) {
 			sqrt_ = config.reg_sqrt;
 			reuse_learning_rates_gp_model_ = config.reuse_learning_rates_gp_model;
+			lag_gp_model_cov_pars_ = config.lag_gp_model_cov_pars;
 		}
 
 		explicit RegressionL2loss(const std::vector<std::string>& strs)
@@ -124,11 +129,17 @@ namespace LightGBM {
 		}
 
 		~RegressionL2loss() {
+			if (lagged_cov_par_estimation_.valid()) {
+				lagged_cov_par_estimation_.wait();
+			}
+			learner_thread_budget_.reset();
 		}
 
 		void Init(const Metadata& metadata, data_size_t num_data) override {
 			num_data_ = num_data;
 			label_ = metadata.label();
+			const_hessians_buffer_ = nullptr;
+			const_hessians_size_ = 0;
 			if (sqrt_) {
 				trans_label_.resize(num_data_);
 #pragma omp parallel for schedule(static)
@@ -148,11 +159,17 @@ namespace LightGBM {
 #pragma omp parallel for schedule(static)
 						for (data_size_t i = 0; i < num_data_; ++i) {
 							gradients[i] = static_cast<score_t>(score[i] - label_[i]);
-							hessians[i] = 1.0f;
 						}
-						if (train_gp_model_cov_pars_) {//also train covariance parameters
+						SetConstantHessians(hessians);
+						if (train_gp_model_cov_pars_ && LagCovParEstimation()) {//covariance parameters are estimated from the residuals of the previous iteration
+							FinishLaggedCovParEstimation();
+							lagged_cov_par_data_.assign(gradients, gradients + num_data_);
+							re_model_->CalcGradient(gradients, nullptr, false);//calc_cov_factor = false since this has already been done in the lagged OptimCovPar()
+						}
+						else if (train_gp_model_cov_pars_) {//also train covariance parameters
 							re_model_->OptimCovPar(gradients, nullptr, true, reuse_learning_rates_gp_model_);
 							re_model_->CalcGradient(gradients, nullptr, false);//calc_cov_factor = false since this has already been done in OptimCovPar()
+							cov_pars_estimated_ = true;
 						}
 						else {//don't train covariance parameters
 							re_model_->CalcGradient(gradients, nullptr, calc_cov_factor_);
@@ -160,13 +177,16 @@ namespace LightGBM {
 						}
 					}//end Gaussian data
 					else {//non-Gaussian data
-#pragma omp parallel for schedule(static)
-						for (data_size_t i = 0; i < num_data_; ++i) {
-							hessians[i] = 1.0f;
+						SetConstantHessians(hessians);
+						if (train_gp_model_cov_pars_ && LagCovParEstimation()) {//covariance parameters are estimated from the score of the previous iteration
+							FinishLaggedCovParEstimation();
+							lagged_cov_par_data_.assign(score, score + num_data_);
+							re_model_->CalcGradient(gradients, score, true);//calc_cov_factor = true since the mode depends on the value of the score
 						}
-						if (train_gp_model_cov_pars_) {//also train covariance parameters
+						else if (train_gp_model_cov_pars_) {//also train covariance parameters
 							re_model_->OptimCovPar(nullptr, score, true, reuse_learning_rates_gp_model_);
 							re_model_->CalcGradient(gradients, score, false);//calc_cov_factor = false since this has already been done in OptimCovPar()
+							cov_pars_estimated_ = true;
 						}
 						else {//don't train covariance parameters
 							re_model_->CalcGradient(gradients, score, true); // calc_cov_factor = true since the "factor" (mode) depends on the value of the score / F_t
@@ -190,6 +210,55 @@ namespace LightGBM {
 			}
 		}//end GetGradients
 
+		void ResetConstantHessians() const override {
+			const_hessians_buffer_ = nullptr;
+			const_hessians_size_ = 0;
+		}
+
+		/*!
+		* \brief The threads of the caller are split: the estimation uses num_threads / 2 threads in the background thread, and the tree learner
+		*		the remaining ones in the calling thread until FinishLaggedCovParEstimation(). With only one thread, the estimation is not started
+		*		in the background but done in FinishLaggedCovParEstimation().
+		*		Note: a thread budget set for the random effects model itself (num_parallel_threads) takes precedence for the estimation, and
+		*		parallel regions of the tree learner with a thread count fixed at initialization (multi-val bin histograms) are not reduced
+		*/
+		void StartLaggedCovParEstimation() const override {
+			if (lagged_cov_par_data_.empty() || lagged_cov_par_estimation_.valid()) {
+				return;
+			}
+			const int num_threads = OMP_NUM_THREADS();
+			if (num_threads < 2) {
+				return;
+			}
+			GPBoost::ThreadBudget re_model_budget;
+			re_model_budget.num_threads = num_threads / 2;
+			GPBoost::ThreadBudget learner_budget;
+			learner_budget.num_threads = num_threads - re_model_budget.num_threads;
+			lagged_cov_par_estimation_ = std::async(std::launch::async, [this, re_model_budget]() {
+				Log::SetSilentThread(true);
+				GPBoost::ScopedThreadBudget thread_scope(re_model_budget);
+				RunLaggedCovParEstimation();
+			});
+			learner_thread_budget_.reset(new GPBoost::ScopedThreadBudget(learner_budget));
+		}
+
+		void FinishLaggedCovParEstimation() const override {
+			if (lagged_cov_par_estimation_.valid()) {
+				learner_thread_budget_.reset();
+				try {
+					lagged_cov_par_estimation_.get();
+				}
+				catch (const std::exception& ex) {
+					// errors are reported here since the background thread is silent
+					Log::REFatal("Lagged estimation of covariance parameters failed: %s", ex.what());
+				}
+			}
+			else if (!lagged_cov_par_data_.empty()) {
+				// the estimation has not been started in the background, e.g., since no tree has been grown in between
+				RunLaggedCovParEstimation();
+			}
+		}
+
 		void LineSearchLearningRate(const double* score,
 			const double* new_score,
 			double& lr) const override {
@@ -311,6 +380,51 @@ namespace LightGBM {
 		const bool deterministic_;
 		/*! \brief Indicates whether the covariance matrix should also be factorized when calling re_model_->CalcGradient(). Only relevant if has_gp_model_ = true and train_gp_model_cov_pars_ = true */
 		mutable bool calc_cov_factor_ = true;
+		/*! \brief Hessian buffer that has been filled with the constant hessians of the GPBoost algorithm (they are not written again into the same buffer until ResetConstantHessians() is called) */
+		mutable const score_t* const_hessians_buffer_ = nullptr;
+		/*! \brief Length of const_hessians_buffer_ */
+		mutable data_size_t const_hessians_size_ = 0;
+		/*! \brief Lag with which the estimated covariance parameters are used (0 = no lag, see config lag_gp_model_cov_pars) */
+		int lag_gp_model_cov_pars_ = 0;
+		/*! \brief True if the covariance parameters have been estimated at least once (the first estimation is never lagged) */
+		mutable bool cov_pars_estimated_ = false;
+		/*! \brief Data for the next lagged estimation of the covariance parameters: residuals (score - label) for Gaussian likelihoods and the score otherwise. Empty if there is nothing to estimate */
+		mutable std::vector<double> lagged_cov_par_data_;
+		/*! \brief Lagged estimation of the covariance parameters running in a background thread */
+		mutable std::future<void> lagged_cov_par_estimation_;
+		/*! \brief Threads left to the tree learner in the calling thread while lagged_cov_par_estimation_ runs */
+		mutable std::unique_ptr<GPBoost::ScopedThreadBudget> learner_thread_budget_;
+
+		bool LagCovParEstimation() const {
+			return(lag_gp_model_cov_pars_ > 0 && cov_pars_estimated_);
+		}
+
+		/*! \brief Estimate the covariance parameters from lagged_cov_par_data_ (this also factorizes the covariance matrix) */
+		void RunLaggedCovParEstimation() const {
+			if (re_model_->GaussLikelihood()) {
+				re_model_->OptimCovPar(lagged_cov_par_data_.data(), nullptr, true, reuse_learning_rates_gp_model_);
+			}
+			else {
+				re_model_->OptimCovPar(nullptr, lagged_cov_par_data_.data(), true, reuse_learning_rates_gp_model_);
+			}
+			lagged_cov_par_data_.clear();
+		}
+
+		/*!
+		* \brief Write the constant unit hessians of the GPBoost algorithm. They are written whenever the buffer or its length differs
+		*		from the last call or ResetConstantHessians() has been called since then
+		* \param[out] hessians Hessian buffer of length num_data_
+		*/
+		void SetConstantHessians(score_t* hessians) const {
+			if (hessians != const_hessians_buffer_ || num_data_ != const_hessians_size_) {
+#pragma omp parallel for schedule(static)
+				for (data_size_t i = 0; i < num_data_; ++i) {
+					hessians[i] = 1.0f;
+				}
+				const_hessians_buffer_ = hessians;
+				const_hessians_size_ = num_data_;
+			}
+		}
 		std::function<bool(label_t)> is_pos_ = [](label_t label) { return label > 0; };
 	};
 
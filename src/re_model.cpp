@@ -13,6 +13,9 @@ using LightGBM::LogLevelRE;
 #include <LightGBM/meta.h>
 using LightGBM::label_t;
 
+#include <limits>
+#include <thread>
+
 namespace GPBoost {
 
 	REModel::REModel() {
@@ -46,6 +49,8 @@ namespace GPBoost {
 		const char* matrix_inversion_method,
 		int seed,
 		int num_parallel_threads) {
+		thread_budget_.num_threads = num_parallel_threads;
+		ScopedThreadBudget thread_scope(thread_budget_);
 		string_t cov_fct_str = "none";
 		if (cov_fct != nullptr) {
 			cov_fct_str = std::string(cov_fct);
@@ -100,8 +105,7 @@ namespace GPBoost {
 				likelihood,
 				likelihood_additional_param,
 				matrix_inversion_method,
-				seed,
-				num_parallel_threads));
+				seed));
 			num_cov_pars_ = re_model_sp_->num_cov_par_;
 		}
 		else if (matrix_format_ == "sp_mat_rm_t") {
@@ -132,8 +136,7 @@ namespace GPBoost {
 				likelihood,
 				likelihood_additional_param,
 				matrix_inversion_method,
-				seed,
-				num_parallel_threads));
+				seed));
 			num_cov_pars_ = re_model_sp_rm_->num_cov_par_;
 		}
 		else {
@@ -164,8 +167,7 @@ namespace GPBoost {
 				likelihood,
 				likelihood_additional_param,
 				matrix_inversion_method,
-				seed,
-				num_parallel_threads));
+				seed));
 			num_cov_pars_ = re_model_den_->num_cov_par_;
 		}
 	}
@@ -199,6 +201,7 @@ namespace GPBoost {
 	}
 
 	void REModel::SetLikelihood(const string_t& likelihood) {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		if (model_has_been_estimated_) {
 			if (GetLikelihood() != likelihood) {
 				Log::REFatal("Cannot change likelihood after a model has been estimated ");
@@ -254,6 +257,151 @@ namespace GPBoost {
 		}
 	}
 
+	void REModel::SetThreadBudget(int num_threads,
+		const int* cpu_ids,
+		int num_cpu_ids) {
+		CHECK(num_cpu_ids >= 0);
+		thread_budget_.num_threads = num_threads;
+		thread_budget_.cpu_ids.clear();
+		if (num_cpu_ids > 0) {
+			CHECK(cpu_ids != nullptr);
+			if (!ThreadBudget::AffinitySupported()) {
+				Log::REWarning("Pinning threads to CPUs is not supported on this platform. 'cpu_ids' are ignored ");
+				return;
+			}
+			int num_cpus_available = (int)std::thread::hardware_concurrency();
+			for (int i = 0; i < num_cpu_ids; ++i) {
+				if (cpu_ids[i] < 0 || (num_cpus_available > 0 && cpu_ids[i] >= num_cpus_available)) {
+					Log::REFatal("Invalid CPU id %d. CPU ids must be between 0 and %d ", cpu_ids[i], num_cpus_available - 1);
+				}
+			}
+			thread_budget_.cpu_ids.assign(cpu_ids, cpu_ids + num_cpu_ids);
+		}
+	}
+
+	MemoryEstimate REModel::EstimateMemory(data_size_t num_data_pred,
+		bool predict_cov_mat) const {
+		if (matrix_format_ == "sp_mat_t") {
+			return(re_model_sp_->EstimateMemory(num_data_pred, predict_cov_mat));
+		}
+		else if (matrix_format_ == "sp_mat_rm_t") {
+			return(re_model_sp_rm_->EstimateMemory(num_data_pred, predict_cov_mat));
+		}
+		else {
+			return(re_model_den_->EstimateMemory(num_data_pred, predict_cov_mat));
+		}
+	}
+
+	MemoryEstimate REModel::EstimateMemory(data_size_t num_data_pred,
+		bool predict_cov_mat,
+		data_size_t fitc_streaming_block_size) const {
+		if (matrix_format_ == "sp_mat_t") {
+			return(re_model_sp_->EstimateMemory(num_data_pred, predict_cov_mat, fitc_streaming_block_size));
+		}
+		else if (matrix_format_ == "sp_mat_rm_t") {
+			return(re_model_sp_rm_->EstimateMemory(num_data_pred, predict_cov_mat, fitc_streaming_block_size));
+		}
+		else {
+			return(re_model_den_->EstimateMemory(num_data_pred, predict_cov_mat, fitc_streaming_block_size));
+		}
+	}
+
+	void REModel::SetMemoryCap(double max_bytes) {
+		memory_cap_ = max_bytes;
+	}
+
+	void REModel::ResetEstimation() {
+		ScopedThreadBudget thread_scope(thread_budget_);
+		ResetCovPars();
+		init_cov_pars_ = vec_t();
+		init_cov_pars_provided_ = false;
+		covariance_matrix_has_been_factorized_ = false;
+		cov_pars_have_been_provided_for_prediction_ = false;
+		std_dev_cov_pars_ = vec_t();
+		num_it_ = 0;
+		coef_ = vec_t();
+		has_covariates_ = false;
+		init_coef_given_ = false;
+		coef_given_or_estimated_ = false;
+		std_dev_coef_ = vec_t();
+		init_aux_pars_ = vec_t();
+		init_aux_pars_given_ = false;
+		model_has_been_estimated_ = false;
+		if (matrix_format_ == "sp_mat_t") {
+			re_model_sp_->ResetEstimation();
+		}
+		else if (matrix_format_ == "sp_mat_rm_t") {
+			re_model_sp_rm_->ResetEstimation();
+		}
+		else {
+			re_model_den_->ResetEstimation();
+		}
+	}
+
+	void REModel::SetVecchiaDistanceCache(const char* policy,
+		double budget_bytes) {
+		ScopedThreadBudget thread_scope(thread_budget_);
+		if (matrix_format_ == "sp_mat_t") {
+			re_model_sp_->SetVecchiaDistanceCache(policy, budget_bytes);
+		}
+		else if (matrix_format_ == "sp_mat_rm_t") {
+			re_model_sp_rm_->SetVecchiaDistanceCache(policy, budget_bytes);
+		}
+		else {
+			re_model_den_->SetVecchiaDistanceCache(policy, budget_bytes);
+		}
+	}
+
+	void REModel::CheckMemoryCap(double mem_bytes,
+		const char* phase) const {
+		if (memory_cap_ > 0. && mem_bytes > memory_cap_) {
+			Log::REFatal("The %s needs approximately %.0f mb of memory which is more than the memory cap of %.0f mb. "
+				"Consider using an approximation that needs less memory (e.g., 'gp_approx' or fewer 'num_neighbors' / 'num_ind_points') or increase the memory cap ",
+				phase, mem_bytes / 1e6, memory_cap_ / 1e6);
+		}
+	}
+
+	void REModel::ApplyMemoryCapEstimation() {
+		if (memory_cap_ <= 0.) {
+			return;
+		}
+		MemoryEstimate mem = EstimateMemory(0, false);
+		if (mem.estimation > memory_cap_ && mem.estimation_per_fitc_streaming_row > 0.) {
+			bool streaming_supported;
+			if (matrix_format_ == "sp_mat_t") {
+				streaming_supported = re_model_sp_->FITCStreamingSupported();
+			}
+			else if (matrix_format_ == "sp_mat_rm_t") {
+				streaming_supported = re_model_sp_rm_->FITCStreamingSupported();
+			}
+			else {
+				streaming_supported = re_model_den_->FITCStreamingSupported();
+			}
+			if (streaming_supported) {
+				// largest block size such that the estimation fits into the cap
+				MemoryEstimate mem_stream = EstimateMemory(0, false, 1);
+				double mem_fixed = mem_stream.estimation - mem_stream.estimation_per_fitc_streaming_row;
+				double block_size = (memory_cap_ - mem_fixed) / mem_stream.estimation_per_fitc_streaming_row;
+				if (block_size >= 1.) {
+					data_size_t fitc_streaming_block_size = (data_size_t)std::min(block_size, (double)std::numeric_limits<data_size_t>::max());
+					if (matrix_format_ == "sp_mat_t") {
+						re_model_sp_->SetFITCStreamingBlockSize(fitc_streaming_block_size);
+					}
+					else if (matrix_format_ == "sp_mat_rm_t") {
+						re_model_sp_rm_->SetFITCStreamingBlockSize(fitc_streaming_block_size);
+					}
+					else {
+						re_model_den_->SetFITCStreamingBlockSize(fitc_streaming_block_size);
+					}
+					Log::REDebug("The cross-covariance matrix is calculated in blocks of %d rows due to the memory cap ", fitc_streaming_block_size);
+					return;
+				}
+				mem = mem_stream;
+			}
+		}
+		CheckMemoryCap(mem.estimation, "parameter estimation");
+	}
+
 	void REModel::SetOptimConfig(double* init_cov_pars,
 		double lr,
 		double acc_rate_cov,
@@ -280,7 +428,8 @@ namespace GPBoost {
 		int seed_rand_vec_trace,
 		int piv_chol_rank,
 		double* init_aux_pars,
-		bool estimate_aux_pars) {
+		bool estimate_aux_pars,
+		int fitc_streaming_block_size) {
 		// Initial covariance parameters
 		if (init_cov_pars != nullptr) {
 			vec_t init_cov_pars_orig = Eigen::Map<const vec_t>(init_cov_pars, num_cov_pars_);
@@ -329,19 +478,19 @@ namespace GPBoost {
 			re_model_sp_->SetOptimConfig(lr, acc_rate_cov, max_iter, delta_rel_conv, use_nesterov_acc, nesterov_schedule_version,
 				optimizer, momentum_offset, convergence_criterion, lr_coef, acc_rate_coef, optimizer_coef,
 				cg_max_num_it, cg_max_num_it_tridiag, cg_delta_conv, num_rand_vec_trace, reuse_rand_vec_trace,
-				cg_preconditioner_type, seed_rand_vec_trace, piv_chol_rank, estimate_aux_pars);
+				cg_preconditioner_type, seed_rand_vec_trace, piv_chol_rank, estimate_aux_pars, fitc_streaming_block_size);
 		}
 		else if (matrix_format_ == "sp_mat_rm_t") {
 			re_model_sp_rm_->SetOptimConfig(lr, acc_rate_cov, max_iter, delta_rel_conv, use_nesterov_acc, nesterov_schedule_version,
 				optimizer, momentum_offset, convergence_criterion, lr_coef, acc_rate_coef, optimizer_coef,
 				cg_max_num_it, cg_max_num_it_tridiag, cg_delta_conv, num_rand_vec_trace, reuse_rand_vec_trace,
-				cg_preconditioner_type, seed_rand_vec_trace, piv_chol_rank, estimate_aux_pars);
+				cg_preconditioner_type, seed_rand_vec_trace, piv_chol_rank, estimate_aux_pars, fitc_streaming_block_size);
 		}
 		else {
 			re_model_den_->SetOptimConfig(lr, acc_rate_cov, max_iter, delta_rel_conv, use_nesterov_acc, nesterov_schedule_version,
 				optimizer, momentum_offset, convergence_criterion, lr_coef, acc_rate_coef, optimizer_coef,
 				cg_max_num_it, cg_max_num_it_tridiag, cg_delta_conv, num_rand_vec_trace, reuse_rand_vec_trace,
-				cg_preconditioner_type, seed_rand_vec_trace, piv_chol_rank, estimate_aux_pars);
+				cg_preconditioner_type, seed_rand_vec_trace, piv_chol_rank, estimate_aux_pars, fitc_streaming_block_size);
 		}
 	}
 
@@ -354,6 +503,8 @@ namespace GPBoost {
 		const double* fixed_effects,
 		bool called_in_GPBoost_algorithm,
 		bool reuse_learning_rates_from_previous_call) {
+		ScopedThreadBudget thread_scope(thread_budget_);
+		ApplyMemoryCapEstimation();
 		if (y_data != nullptr) {
 			InitializeCovParsIfNotDefined(y_data, fixed_effects);
 			// Note: y_data can be null_ptr for non-Gaussian data. For non-Gaussian data, the function 'InitializeCovParsIfNotDefined' is called in 'SetY'
@@ -433,6 +584,8 @@ namespace GPBoost {
 		const double* covariate_data,
 		int num_covariates,
 		const double* fixed_effects) {
+		ScopedThreadBudget thread_scope(thread_budget_);
+		ApplyMemoryCapEstimation();
 		InitializeCovParsIfNotDefined(y_data, fixed_effects);
 		double* coef_ptr;;
 		if (init_coef_given_) {
@@ -518,6 +671,7 @@ namespace GPBoost {
 	}//end OptimLinRegrCoefCovPar
 
 	void REModel::FindInitialValueBoosting(double* init_score) {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		CHECK(cov_pars_initialized_);
 		vec_t covariate_data(GetNumData());
 		covariate_data.setOnes();
@@ -585,6 +739,7 @@ namespace GPBoost {
 		const double* new_score,
 		bool reuse_learning_rates_from_previous_call,
 		double& lr) {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		CHECK(cov_pars_initialized_);
 		if (matrix_format_ == "sp_mat_t") {
 			re_model_sp_->OptimLinRegrCoefCovPar(nullptr,
@@ -651,6 +806,7 @@ namespace GPBoost {
 		const double* fixed_effects,
 		bool InitializeModeCovMat,
 		bool CalcModePostRandEff_already_done) {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		vec_t cov_pars_trafo;
 		if (cov_pars == nullptr) {
 			if (y_data != nullptr) {
@@ -721,6 +877,7 @@ namespace GPBoost {
 	}
 
 	void REModel::CalcGradient(double* y, const double* fixed_effects, bool calc_cov_factor) {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		if (y != nullptr) {
 			InitializeCovParsIfNotDefined(y, fixed_effects);
 		}
@@ -737,6 +894,7 @@ namespace GPBoost {
 	}
 
 	void REModel::SetY(const double* y) const {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		if (matrix_format_ == "sp_mat_t") {
 			re_model_sp_->SetY(y);
 		}
@@ -749,6 +907,7 @@ namespace GPBoost {
 	}
 
 	void REModel::SetY(const float* y) const {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		if (matrix_format_ == "sp_mat_t") {
 			re_model_sp_->SetY(y);
 		}
@@ -785,6 +944,7 @@ namespace GPBoost {
 	}
 
 	void REModel::GetCovPar(double* cov_par, bool calc_std_dev) const {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		if (cov_pars_.size() == 0) {
 			Log::REFatal("Covariance parameters have not been estimated or set");
 		}
@@ -856,6 +1016,7 @@ namespace GPBoost {
 		double cg_delta_conv_pred,
 		int nsim_var_pred,
 		int rank_pred_approx_matrix_lanczos) {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		if (matrix_format_ == "sp_mat_t") {
 			re_model_sp_->SetPredictionData(num_data_pred,
 				cluster_ids_data_pred,
@@ -917,6 +1078,32 @@ namespace GPBoost {
 		const double* fixed_effects,
 		const double* fixed_effects_pred,
 		bool suppress_calc_cov_factor) {
+		ScopedThreadBudget thread_scope(thread_budget_);
+		if (memory_cap_ > 0.) {
+			MemoryEstimate mem = EstimateMemory(num_data_pred, predict_cov_mat);
+			if (mem.prediction > memory_cap_) {
+				bool pointwise;
+				if (matrix_format_ == "sp_mat_t") {
+					pointwise = re_model_sp_->PredictionsArePointwise(predict_var);
+				}
+				else if (matrix_format_ == "sp_mat_rm_t") {
+					pointwise = re_model_sp_rm_->PredictionsArePointwise(predict_var);
+				}
+				else {
+					pointwise = re_model_den_->PredictionsArePointwise(predict_var);
+				}
+				double mem_fixed = mem.prediction - num_data_pred * mem.prediction_per_point;
+				data_size_t chunk_size = (data_size_t)((memory_cap_ - mem_fixed) / mem.prediction_per_point);
+				if (pointwise && !predict_cov_mat && !use_saved_data && re_group_data_pred == nullptr &&
+					re_group_rand_coef_data_pred == nullptr && chunk_size >= 1) {
+					PredictInChunks(y_obs, num_data_pred, out_predict, predict_var, predict_response, cluster_ids_data_pred,
+						gp_coords_data_pred, gp_rand_coef_data_pred, cov_pars_pred, covariate_data_pred, fixed_effects,
+						fixed_effects_pred, suppress_calc_cov_factor, chunk_size);
+					return;
+				}
+				CheckMemoryCap(mem.prediction, "prediction");
+			}
+		}
 		bool calc_cov_factor = true;
 		vec_t cov_pars_pred_trans;
 		if (cov_pars_pred != nullptr) {
@@ -1020,11 +1207,100 @@ namespace GPBoost {
 		}
 	}//end Predict
 
+	void REModel::PredictInChunks(const double* y_obs,
+		data_size_t num_data_pred,
+		double* out_predict,
+		bool predict_var,
+		bool predict_response,
+		const data_size_t* cluster_ids_data_pred,
+		double* gp_coords_data_pred,
+		const double* gp_rand_coef_data_pred,
+		const double* cov_pars_pred,
+		const double* covariate_data_pred,
+		const double* fixed_effects,
+		const double* fixed_effects_pred,
+		bool suppress_calc_cov_factor,
+		data_size_t chunk_size) {
+		int dim_gp_coords, num_gp_rand_coef;
+		if (matrix_format_ == "sp_mat_t") {
+			dim_gp_coords = re_model_sp_->dim_gp_coords_;
+			num_gp_rand_coef = re_model_sp_->num_gp_rand_coef_;
+		}
+		else if (matrix_format_ == "sp_mat_rm_t") {
+			dim_gp_coords = re_model_sp_rm_->dim_gp_coords_;
+			num_gp_rand_coef = re_model_sp_rm_->num_gp_rand_coef_;
+		}
+		else {
+			dim_gp_coords = re_model_den_->dim_gp_coords_;
+			num_gp_rand_coef = re_model_den_->num_gp_rand_coef_;
+		}
+		int num_covariates = has_covariates_ ? (int)coef_.size() : 0;
+		int num_chunks = (int)((num_data_pred + chunk_size - 1) / chunk_size);
+		Log::REDebug("Predictions are made in %d chunks of at most %d points due to the memory cap ", num_chunks, chunk_size);
+		std::vector<double> gp_coords_chunk, gp_rand_coef_chunk, covariate_chunk, out_chunk;
+		// Copy rows [start, start + num_chunk) of a column-major matrix with num_data_pred rows
+		auto copy_rows = [num_data_pred](const double* data, int num_col, data_size_t start, data_size_t num_chunk, std::vector<double>& chunk) {
+			chunk.resize((size_t)num_chunk * num_col);
+			for (int j = 0; j < num_col; ++j) {
+				std::copy(data + (size_t)j * num_data_pred + start, data + (size_t)j * num_data_pred + start + num_chunk, chunk.begin() + (size_t)j * num_chunk);
+			}
+		};
+		// Simulation-based predictive variances use the same random vectors for all chunks such that the results do not depend on the chunking
+		auto set_reuse_rand_vec_pred_var = [this](bool reuse) {
+			if (matrix_format_ == "sp_mat_t") {
+				re_model_sp_->SetReuseRandVecPredVar(reuse);
+			}
+			else if (matrix_format_ == "sp_mat_rm_t") {
+				re_model_sp_rm_->SetReuseRandVecPredVar(reuse);
+			}
+			else {
+				re_model_den_->SetReuseRandVecPredVar(reuse);
+			}
+		};
+		set_reuse_rand_vec_pred_var(true);
+		try {
+			for (data_size_t start = 0; start < num_data_pred; start += chunk_size) {
+				data_size_t num_chunk = std::min(chunk_size, num_data_pred - start);
+				if (gp_coords_data_pred != nullptr) {
+					copy_rows(gp_coords_data_pred, dim_gp_coords, start, num_chunk, gp_coords_chunk);
+				}
+				if (gp_rand_coef_data_pred != nullptr) {
+					copy_rows(gp_rand_coef_data_pred, num_gp_rand_coef, start, num_chunk, gp_rand_coef_chunk);
+				}
+				if (covariate_data_pred != nullptr) {
+					copy_rows(covariate_data_pred, num_covariates, start, num_chunk, covariate_chunk);
+				}
+				out_chunk.resize(2 * (size_t)num_chunk);
+				// The covariance matrix (or the mode) is calculated only for the first chunk
+				Predict(y_obs, num_chunk, out_chunk.data(), false, predict_var, predict_response,
+					cluster_ids_data_pred == nullptr ? nullptr : cluster_ids_data_pred + start,
+					nullptr, nullptr,
+					gp_coords_data_pred == nullptr ? nullptr : gp_coords_chunk.data(),
+					gp_rand_coef_data_pred == nullptr ? nullptr : gp_rand_coef_chunk.data(),
+					cov_pars_pred,
+					covariate_data_pred == nullptr ? nullptr : covariate_chunk.data(),
+					false, fixed_effects,
+					fixed_effects_pred == nullptr ? nullptr : fixed_effects_pred + start,
+					suppress_calc_cov_factor || start > 0);
+				std::copy(out_chunk.begin(), out_chunk.begin() + num_chunk, out_predict + start);
+				if (predict_var) {
+					std::copy(out_chunk.begin() + num_chunk, out_chunk.begin() + 2 * num_chunk, out_predict + num_data_pred + start);
+				}
+			}
+		}
+		catch (...) {
+			set_reuse_rand_vec_pred_var(false);
+			throw;
+		}
+		set_reuse_rand_vec_pred_var(false);
+	}//end PredictInChunks
+
 	void REModel::PredictTrainingDataRandomEffects(const double* cov_pars_pred,
 		const double* y_obs,
 		double* out_predict,
 		const double* fixed_effects,
 		bool calc_var) const {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		bool calc_cov_factor = true;
 		vec_t cov_pars_pred_trans;
 		if (cov_pars_pred != nullptr) {
@@ -1100,6 +1376,7 @@ namespace GPBoost {
 	void REModel::NewtonUpdateLeafValues(const int* data_leaf_index,
 		const int num_leaves,
 		double* leaf_values) const {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		if (matrix_format_ == "sp_mat_t") {
 			re_model_sp_->NewtonUpdateLeafValues(data_leaf_index, num_leaves, leaf_values, cov_pars_[0]);
 		}
@@ -1113,6 +1390,7 @@ namespace GPBoost {
 
 	void REModel::InitializeCovParsIfNotDefined(const double* y_data,
 		const double* fixed_effects) {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		if (!cov_pars_initialized_) {
 			if (init_cov_pars_provided_) {
 				cov_pars_ = init_cov_pars_;
@@ -1206,6 +1484,7 @@ namespace GPBoost {
 		const double* pred_mean,
 		const double* pred_var,
 		const data_size_t num_data) {
+		ScopedThreadBudget thread_scope(thread_budget_);
 		if (GetLikelihood() == "gaussian") {
 			double aux_par = 1. / (std::sqrt(cov_pars_[0]));
 			SetAuxPars(&aux_par);
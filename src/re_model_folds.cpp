@@ -0,0 +1,239 @@
+/*!
+* This file is part of GPBoost a C++ library for combining
+*	boosting with Gaussian process and mixed effects models
+*
+* Copyright (c) 2020 Fabio Sigrist. All rights reserved.
+*
+* Licensed under the Apache License Version 2.0. See LICENSE file in the project root for license information.
+*/
+#include <GPBoost/re_model_folds.h>
+#include <LightGBM/utils/log.h>
+using LightGBM::Log;
+
+namespace GPBoost {
+
+	REModelFolds::REModelFolds(data_size_t num_data,
+		const data_size_t* cluster_ids_data,
+		const char* re_group_data,
+		data_size_t num_re_group,
+		const double* re_group_rand_coef_data,
+		const data_size_t* ind_effect_group_rand_coef,
+		data_size_t num_re_group_rand_coef,
+		const int* drop_intercept_group_rand_effect,
+		data_size_t num_gp,
+		const double* gp_coords_data,
+		int dim_gp_coords,
+		const double* gp_rand_coef_data,
+		data_size_t num_gp_rand_coef,
+		const char* cov_fct,
+		double cov_fct_shape,
+		const char* gp_approx,
+		double cov_fct_taper_range,
+		double cov_fct_taper_shape,
+		int num_neighbors,
+		const char* vecchia_ordering,
+		int num_ind_points,
+		double cover_tree_radius,
+		const char* ind_points_selection,
+		const char* likelihood,
+		double likelihood_additional_param,
+		const char* matrix_inversion_method,
+		int seed,
+		int num_parallel_threads,
+		int num_folds,
+		const int* fold_ids) {
+		if (num_data <= 0) {
+			Log::REFatal("REModelFolds: 'num_data' needs to be larger than 0");
+		}
+		if (num_folds < 2) {
+			Log::REFatal("REModelFolds: 'num_folds' needs to be at least 2");
+		}
+		if (fold_ids == nullptr) {
+			Log::REFatal("REModelFolds: 'fold_ids' is not provided");
+		}
+		num_data_ = num_data;
+		num_folds_ = num_folds;
+		// Assign the data points to the folds
+		train_rows_ = std::vector<std::vector<data_size_t>>(num_folds_);
+		held_out_rows_ = std::vector<std::vector<data_size_t>>(num_folds_);
+		for (data_size_t i = 0; i < num_data_; ++i) {
+			for (int k = 0; k < num_folds_; ++k) {
+				if (fold_ids[i] == k) {
+					held_out_rows_[k].push_back(i);
+				}
+				else {
+					train_rows_[k].push_back(i);
+				}
+			}
+		}
+		for (int k = 0; k < num_folds_; ++k) {
+			if (train_rows_[k].empty() || held_out_rows_[k].empty()) {
+				Log::REFatal("REModelFolds: fold %d has no training or no held-out data points", k);
+			}
+		}
+		train_models_ = std::vector<std::unique_ptr<REModel>>(num_folds_);
+		// Copy data
+		if (cluster_ids_data != nullptr) {
+			cluster_ids_.assign(cluster_ids_data, cluster_ids_data + num_data_);
+		}
+		if (num_re_group > 0) {
+			re_group_levels_ = std::vector<std::vector<std::string>>(num_re_group, std::vector<std::string>(num_data_));
+			const char* level = re_group_data;
+			for (data_size_t j = 0; j < num_re_group; ++j) {
+				for (data_size_t i = 0; i < num_data_; ++i) {
+					re_group_levels_[j][i] = std::string(level);
+					level += re_group_levels_[j][i].size() + 1;
+				}
+			}
+			if (drop_intercept_group_rand_effect != nullptr) {
+				drop_intercept_group_rand_effect_.assign(drop_intercept_group_rand_effect, drop_intercept_group_rand_effect + num_re_group);
+			}
+		}
+		num_re_group_rand_coef_ = num_re_group_rand_coef;
+		if (num_re_group_rand_coef_ > 0) {
+			re_group_rand_coef_.assign(re_group_rand_coef_data, re_group_rand_coef_data + (size_t)num_data_ * num_re_group_rand_coef_);
+			ind_effect_group_rand_coef_.assign(ind_effect_group_rand_coef, ind_effect_group_rand_coef + num_re_group_rand_coef_);
+		}
+		num_gp_ = num_gp;
+		dim_gp_coords_ = dim_gp_coords;
+		if (num_gp_ > 0) {
+			gp_coords_.assign(gp_coords_data, gp_coords_data + (size_t)num_data_ * dim_gp_coords_);
+		}
+		num_gp_rand_coef_ = num_gp_rand_coef;
+		if (num_gp_rand_coef_ > 0) {
+			gp_rand_coef_.assign(gp_rand_coef_data, gp_rand_coef_data + (size_t)num_data_ * num_gp_rand_coef_);
+		}
+		// Copy model parameters
+		cov_fct_.Set(cov_fct);
+		cov_fct_shape_ = cov_fct_shape;
+		gp_approx_.Set(gp_approx);
+		cov_fct_taper_range_ = cov_fct_taper_range;
+		cov_fct_taper_shape_ = cov_fct_taper_shape;
+		num_neighbors_ = num_neighbors;
+		vecchia_ordering_.Set(vecchia_ordering);
+		num_ind_points_ = num_ind_points;
+		cover_tree_radius_ = cover_tree_radius;
+		ind_points_selection_.Set(ind_points_selection);
+		likelihood_.Set(likelihood);
+		likelihood_additional_param_ = likelihood_additional_param;
+		matrix_inversion_method_.Set(matrix_inversion_method);
+		seed_ = seed;
+		num_parallel_threads_ = num_parallel_threads;
+	}
+
+	data_size_t REModelFolds::NumData(int fold,
+		bool held_out) const {
+		CheckFold(fold);
+		return(held_out ? (data_size_t)held_out_rows_[fold].size() : (data_size_t)train_rows_[fold].size());
+	}
+
+	REModel* REModelFolds::GetTrainModel(int fold) {
+		CheckFold(fold);
+		if (train_models_[fold] == nullptr) {
+			RowSubset train;
+			GatherRows(train_rows_[fold], train);
+			train_models_[fold].reset(new REModel(train.num_data,
+				cluster_ids_.empty() ? nullptr : train.cluster_ids.data(),
+				re_group_levels_.empty() ? nullptr : train.re_group.data(),
+				(data_size_t)re_group_levels_.size(),
+				num_re_group_rand_coef_ > 0 ? train.re_group_rand_coef.data() : nullptr,
+				num_re_group_rand_coef_ > 0 ? ind_effect_group_rand_coef_.data() : nullptr,
+				num_re_group_rand_coef_,
+				drop_intercept_group_rand_effect_.empty() ? nullptr : drop_intercept_group_rand_effect_.data(),
+				num_gp_,
+				num_gp_ > 0 ? train.gp_coords.data() : nullptr,
+				dim_gp_coords_,
+				num_gp_rand_coef_ > 0 ? train.gp_rand_coef.data() : nullptr,
+				num_gp_rand_coef_,
+				cov_fct_.c_str(),
+				cov_fct_shape_,
+				gp_approx_.c_str(),
+				cov_fct_taper_range_,
+				cov_fct_taper_shape_,
+				num_neighbors_,
+				vecchia_ordering_.c_str(),
+				num_ind_points_,
+				cover_tree_radius_,
+				ind_points_selection_.c_str(),
+				likelihood_.c_str(),
+				likelihood_additional_param_,
+				matrix_inversion_method_.c_str(),
+				seed_,
+				num_parallel_threads_));
+		}
+		else {
+			train_models_[fold]->ResetEstimation();
+		}
+		return(train_models_[fold].get());
+	}
+
+	void REModelFolds::SetHeldOutPredictionData(int fold,
+		const char* vecchia_pred_type,
+		int num_neighbors_pred,
+		double cg_delta_conv_pred,
+		int nsim_var_pred,
+		int rank_pred_approx_matrix_lanczos) {
+		CheckFold(fold);
+		if (train_models_[fold] == nullptr) {
+			Log::REFatal("REModelFolds: the model for fold %d has not been created yet", fold);
+		}
+		RowSubset held_out;
+		GatherRows(held_out_rows_[fold], held_out);
+		train_models_[fold]->SetPredictionData(held_out.num_data,
+			cluster_ids_.empty() ? nullptr : held_out.cluster_ids.data(),
+			re_group_levels_.empty() ? nullptr : held_out.re_group.data(),
+			num_re_group_rand_coef_ > 0 ? held_out.re_group_rand_coef.data() : nullptr,
+			num_gp_ > 0 ? held_out.gp_coords.data() : nullptr,
+			num_gp_rand_coef_ > 0 ? held_out.gp_rand_coef.data() : nullptr,
+			nullptr,
+			vecchia_pred_type,
+			num_neighbors_pred,
+			cg_delta_conv_pred,
+			nsim_var_pred,
+			rank_pred_approx_matrix_lanczos);
+	}
+
+	void REModelFolds::GatherRows(const std::vector<data_size_t>& rows,
+		RowSubset& subset) const {
+		const data_size_t num_rows = (data_size_t)rows.size();
+		subset.num_data = num_rows;
+		if (!cluster_ids_.empty()) {
+			subset.cluster_ids.resize(num_rows);
+			for (data_size_t i = 0; i < num_rows; ++i) {
+				subset.cluster_ids[i] = cluster_ids_[rows[i]];
+			}
+		}
+		subset.re_group.clear();
+		for (const auto& levels : re_group_levels_) {
+			for (data_size_t i = 0; i < num_rows; ++i) {
+				const std::string& level = levels[rows[i]];
+				subset.re_group.insert(subset.re_group.end(), level.c_str(), level.c_str() + level.size() + 1);
+			}
+		}
+		// Column-major data with num_data_ rows
+		auto gather_columns = [&rows, num_rows, this](const std::vector<double>& data, int num_cols, std::vector<double>& out) {
+			out.resize((size_t)num_rows * num_cols);
+			for (int j = 0; j < num_cols; ++j) {
+				for (data_size_t i = 0; i < num_rows; ++i) {
+					out[(size_t)j * num_rows + i] = data[(size_t)j * num_data_ + rows[i]];
+				}
+			}
+		};
+		if (num_re_group_rand_coef_ > 0) {
+			gather_columns(re_group_rand_coef_, num_re_group_rand_coef_, subset.re_group_rand_coef);
+		}
+		if (num_gp_ > 0) {
+			gather_columns(gp_coords_, dim_gp_coords_, subset.gp_coords);
+		}
+		if (num_gp_rand_coef_ > 0) {
+			gather_columns(gp_rand_coef_, num_gp_rand_coef_, subset.gp_rand_coef);
+		}
+	}
+
+	void REModelFolds::CheckFold(int fold) const {
+		if (fold < 0 || fold >= num_folds_) {
+			Log::REFatal("REModelFolds: 'fold' needs to be between 0 and %d", num_folds_ - 1);
+		}
+	}
+
+}  // namespace GPBoost
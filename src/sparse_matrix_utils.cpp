@@ -7,6 +7,10 @@
 * Licensed under the Apache License Version 2.0. See LICENSE file in the project root for license information.
 */
 #include <GPBoost/sparse_matrix_utils.h>
+#include <LightGBM/utils/openmp_wrapper.h>
+
+#include <algorithm>
+#include <utility>
 
 namespace GPBoost {
 
@@ -318,4 +322,165 @@ namespace GPBoost {
 		//}
 	}
 
+	void CreateIncidenceMatrix(const data_size_t num_data,
+		const data_size_t num_re,
+		const data_size_t* const random_effects_indices_of_data,
+		const double* const values,
+		sp_mat_t& Z) {
+		Z.resize(num_data, num_re);
+		Z.resizeNonZeros(num_data);
+		int* col_ptr = Z.outerIndexPtr();
+		int* row_idx = Z.innerIndexPtr();
+		double* val = Z.valuePtr();
+		// The data points are split into contiguous chunks with separate counts per chunk. This preserves the order of the data points
+		// within a column without sorting, but requires num_chunks * num_re memory which is bounded by a multiple of num_data
+		int num_chunks = omp_get_max_threads();
+		if ((int64_t)num_chunks * num_re > 4 * (int64_t)num_data) {
+			num_chunks = std::max(1, (int)(4 * (int64_t)num_data / std::max(num_re, 1)));
+		}
+		std::vector<int> counts((size_t)num_chunks * num_re, 0);
+#pragma omp parallel for schedule(static, 1)
+		for (int c = 0; c < num_chunks; ++c) {
+			const data_size_t begin = (data_size_t)((int64_t)num_data * c / num_chunks);
+			const data_size_t end = (data_size_t)((int64_t)num_data * (c + 1) / num_chunks);
+			int* counts_chunk = counts.data() + (size_t)c * num_re;
+			for (data_size_t i = begin; i < end; ++i) {
+				counts_chunk[random_effects_indices_of_data[i]]++;
+			}
+		}
+		// Column pointers and start of every chunk within every column
+		int pos = 0;
+		for (data_size_t k = 0; k < num_re; ++k) {
+			col_ptr[k] = pos;
+			for (int c = 0; c < num_chunks; ++c) {
+				const int count = counts[(size_t)c * num_re + k];
+				counts[(size_t)c * num_re + k] = pos;
+				pos += count;
+			}
+		}
+		col_ptr[num_re] = pos;
+#pragma omp parallel for schedule(static, 1)
+		for (int c = 0; c < num_chunks; ++c) {
+			const data_size_t begin = (data_size_t)((int64_t)num_data * c / num_chunks);
+			const data_size_t end = (data_size_t)((int64_t)num_data * (c + 1) / num_chunks);
+			int* next_pos_chunk = counts.data() + (size_t)c * num_re;
+			for (data_size_t i = begin; i < end; ++i) {
+				const int dest = next_pos_chunk[random_effects_indices_of_data[i]]++;
+				row_idx[dest] = i;
+				val[dest] = values == nullptr ? 1. : values[i];
+			}
+		}
+	}//end CreateIncidenceMatrix
+
+	bool CreateZtAndZtZFromIncidenceMatrices(const std::vector<const sp_mat_t*>& Z_comps,
+		sp_mat_t& Zt,
+		sp_mat_t& ZtZ) {
+		const int num_comps = (int)Z_comps.size();
+		CHECK(num_comps > 0);
+		const data_size_t num_data = (data_size_t)Z_comps[0]->rows();
+		std::vector<int> cum_num_re(num_comps + 1, 0);
+		for (int j = 0; j < num_comps; ++j) {
+			if (Z_comps[j]->rows() != num_data || Z_comps[j]->nonZeros() != num_data || !Z_comps[j]->isCompressed()) {
+				return false;
+			}
+			cum_num_re[j + 1] = cum_num_re[j] + (int)Z_comps[j]->cols();
+		}
+		const int num_re = cum_num_re[num_comps];
+		// Random effect (row of Zt) and value of every data point and component
+		std::vector<int> re_of_data((size_t)num_data * num_comps, -1);
+		std::vector<double> value_of_data((size_t)num_data * num_comps);
+		for (int j = 0; j < num_comps; ++j) {
+			const sp_mat_t& Z_j = *Z_comps[j];
+#pragma omp parallel for schedule(static)
+			for (int k = 0; k < (int)Z_j.cols(); ++k) {
+				for (int p = Z_j.outerIndexPtr()[k]; p < Z_j.outerIndexPtr()[k + 1]; ++p) {
+					const size_t ind = (size_t)Z_j.innerIndexPtr()[p] * num_comps + j;
+					re_of_data[ind] = cum_num_re[j] + k;
+					value_of_data[ind] = Z_j.valuePtr()[p];
+				}
+			}
+		}
+		bool one_per_row = true;
+#pragma omp parallel for schedule(static) reduction(&&:one_per_row)
+		for (int64_t ind = 0; ind < (int64_t)re_of_data.size(); ++ind) {
+			one_per_row = one_per_row && (re_of_data[ind] >= 0);
+		}
+		if (!one_per_row) {
+			return false;
+		}
+		// Zt: column i contains the random effects of data point i (sorted since cum_num_re is increasing)
+		Zt.resize(num_re, num_data);
+		Zt.resizeNonZeros((Eigen::Index)num_data * num_comps);
+#pragma omp parallel for schedule(static)
+		for (data_size_t i = 0; i < num_data; ++i) {
+			Zt.outerIndexPtr()[i] = i * num_comps;
+			for (int j = 0; j < num_comps; ++j) {
+				Zt.innerIndexPtr()[(size_t)i * num_comps + j] = re_of_data[(size_t)i * num_comps + j];
+				Zt.valuePtr()[(size_t)i * num_comps + j] = value_of_data[(size_t)i * num_comps + j];
+			}
+		}
+		Zt.outerIndexPtr()[num_data] = num_data * num_comps;
+		// ZtZ: column l (random effect number l) is the sum over all data points i of random effect l of Z(i, l) * Zt.col(i).
+		// The columns are split into contiguous ranges with roughly equal work
+		std::vector<int64_t> cum_work(num_re + 1, 0);
+		for (int j = 0; j < num_comps; ++j) {
+			const int* col_ptr_j = Z_comps[j]->outerIndexPtr();
+			for (int k = 0; k < (int)Z_comps[j]->cols(); ++k) {
+				cum_work[cum_num_re[j] + k + 1] = cum_work[cum_num_re[j] + k] + col_ptr_j[k + 1] - col_ptr_j[k] + 1;
+			}
+		}
+		const int num_chunks = omp_get_max_threads();
+		std::vector<int> col_begin(num_chunks + 1, num_re);
+		col_begin[0] = 0;
+		for (int c = 1; c < num_chunks; ++c) {
+			col_begin[c] = (int)(std::lower_bound(cum_work.begin(), cum_work.end(), cum_work[num_re] * c / num_chunks) - cum_work.begin());
+			col_begin[c] = std::min(std::max(col_begin[c], col_begin[c - 1]), num_re);
+		}
+		std::vector<std::vector<int>> row_idx_chunk(num_chunks);
+		std::vector<std::vector<double>> val_chunk(num_chunks);
+		std::vector<int> nnz_col(num_re + 1, 0);
+#pragma omp parallel for schedule(static, 1)
+		for (int c = 0; c < num_chunks; ++c) {
+			std::vector<std::pair<int, double>> entries;
+			for (int l = col_begin[c]; l < col_begin[c + 1]; ++l) {
+				const int j_l = (int)(std::upper_bound(cum_num_re.begin(), cum_num_re.end(), l) - cum_num_re.begin()) - 1;
+				const sp_mat_t& Z_l = *Z_comps[j_l];
+				const int k_l = l - cum_num_re[j_l];
+				entries.clear();
+				for (int p = Z_l.outerIndexPtr()[k_l]; p < Z_l.outerIndexPtr()[k_l + 1]; ++p) {
+					const size_t i = (size_t)Z_l.innerIndexPtr()[p];
+					const double z_il = Z_l.valuePtr()[p];
+					for (int j = 0; j < num_comps; ++j) {
+						entries.emplace_back(re_of_data[i * num_comps + j], z_il * value_of_data[i * num_comps + j]);
+					}
+				}
+				std::sort(entries.begin(), entries.end(),
+					[](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.first < b.first; });
+				for (size_t e = 0; e < entries.size(); ++e) {
+					if (e == 0 || entries[e].first != entries[e - 1].first) {
+						row_idx_chunk[c].push_back(entries[e].first);
+						val_chunk[c].push_back(entries[e].second);
+						nnz_col[l + 1]++;
+					}
+					else {
+						val_chunk[c].back() += entries[e].second;
+					}
+				}
+			}
+		}
+		for (int l = 0; l < num_re; ++l) {
+			nnz_col[l + 1] += nnz_col[l];
+		}
+		ZtZ.resize(num_re, num_re);
+		ZtZ.resizeNonZeros(nnz_col[num_re]);
+		std::copy(nnz_col.begin(), nnz_col.end(), ZtZ.outerIndexPtr());
+#pragma omp parallel for schedule(static, 1)
+		for (int c = 0; c < num_chunks; ++c) {
+			const int start = nnz_col[col_begin[c]];
+			std::copy(row_idx_chunk[c].begin(), row_idx_chunk[c].end(), ZtZ.innerIndexPtr() + start);
+			std::copy(val_chunk[c].begin(), val_chunk[c].end(), ZtZ.valuePtr() + start);
+		}
+		return true;
+	}//end CreateZtAndZtZFromIncidenceMatrices
+
 }  // namespace GPBoost
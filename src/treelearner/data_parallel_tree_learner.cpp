@@ -2,6 +2,7 @@
  * Copyright (c) 2016 Microsoft Corporation. All rights reserved.
  * Licensed under the MIT License. See LICENSE file in the project root for license information.
  */
+#include <algorithm>
 #include <cstring>
 #include <tuple>
 #include <vector>
@@ -26,6 +27,10 @@ void DataParallelTreeLearner<TREELEARNER_T>::Init(const Dataset* train_data, boo
   // Get local rank and global machine size
   rank_ = Network::rank();
   num_machines_ = Network::num_machines();
+  // the network can be initialized without the benchmark, e.g., by LGBM_NetworkInit
+  if (this->config_->network_benchmark && !Network::allreduce_benchmarked()) {
+    Network::BenchmarkAllreduce();
+  }
 
   auto max_cat_threshold = this->config_->max_cat_threshold;
   // need to be able to hold smaller and larger best splits in SyncUpGlobalBestSplit
@@ -40,9 +45,6 @@ void DataParallelTreeLearner<TREELEARNER_T>::Init(const Dataset* train_data, boo
 
   is_feature_aggregated_.resize(this->num_features_);
 
-  block_start_.resize(num_machines_);
-  block_len_.resize(num_machines_);
-
   buffer_write_start_pos_.resize(this->num_features_);
   buffer_read_start_pos_.resize(this->num_features_);
   global_data_count_in_leaf_.resize(this->config_->num_leaves);
@@ -79,47 +81,52 @@ void DataParallelTreeLearner<TREELEARNER_T>::BeforeTrain() {
     is_feature_aggregated_[fid] = true;
   }
 
-  // get block start and block len for reduce scatter
-  reduce_scatter_size_ = 0;
+  // split the features of every machine into chunks, histograms of one chunk are reduce scattered together
+  size_t max_num_features_distributed = 1;
   for (int i = 0; i < num_machines_; ++i) {
-    block_len_[i] = 0;
-    for (auto fid : feature_distribution[i]) {
-      auto num_bin = this->train_data_->FeatureNumBin(fid);
-      if (this->train_data_->FeatureBinMapper(fid)->GetMostFreqBin() == 0) {
-        num_bin -= 1;
-      }
-      block_len_[i] += num_bin * kHistEntrySize;
-    }
-    reduce_scatter_size_ += block_len_[i];
+    max_num_features_distributed = std::max(max_num_features_distributed, feature_distribution[i].size());
   }
-
-  block_start_[0] = 0;
-  for (int i = 1; i < num_machines_; ++i) {
-    block_start_[i] = block_start_[i - 1] + block_len_[i - 1];
-  }
-
-  // get buffer_write_start_pos_
-  int bin_size = 0;
-  for (int i = 0; i < num_machines_; ++i) {
-    for (auto fid : feature_distribution[i]) {
-      buffer_write_start_pos_[fid] = bin_size;
-      auto num_bin = this->train_data_->FeatureNumBin(fid);
-      if (this->train_data_->FeatureBinMapper(fid)->GetMostFreqBin() == 0) {
-        num_bin -= 1;
+  num_reduce_chunks_ = static_cast<int>(std::min(static_cast<size_t>(this->config_->histogram_reduce_chunks),
+                                                 max_num_features_distributed));
+  block_start_.assign(static_cast<size_t>(num_reduce_chunks_) * num_machines_, 0);
+  block_len_.assign(static_cast<size_t>(num_reduce_chunks_) * num_machines_, 0);
+  chunk_input_start_.resize(num_reduce_chunks_);
+  chunk_output_start_.resize(num_reduce_chunks_);
+  chunk_reduce_scatter_size_.resize(num_reduce_chunks_);
+  chunk_aggregated_features_.assign(num_reduce_chunks_, std::vector<int>());
+
+  // get block start and block len for reduce scatter, buffer_write_start_pos_ and buffer_read_start_pos_
+  reduce_scatter_size_ = 0;
+  comm_size_t read_size = 0;
+  for (int c = 0; c < num_reduce_chunks_; ++c) {
+    chunk_input_start_[c] = reduce_scatter_size_;
+    chunk_output_start_[c] = read_size;
+    comm_size_t chunk_size = 0;
+    for (int i = 0; i < num_machines_; ++i) {
+      const size_t block_idx = static_cast<size_t>(c) * num_machines_ + i;
+      const size_t num_features_distributed = feature_distribution[i].size();
+      const size_t begin = num_features_distributed * c / num_reduce_chunks_;
+      const size_t end = num_features_distributed * (c + 1) / num_reduce_chunks_;
+      block_start_[block_idx] = chunk_size;
+      for (size_t j = begin; j < end; ++j) {
+        const int fid = feature_distribution[i][j];
+        auto num_bin = this->train_data_->FeatureNumBin(fid);
+        if (this->train_data_->FeatureBinMapper(fid)->GetMostFreqBin() == 0) {
+          num_bin -= 1;
+        }
+        const comm_size_t hist_size = num_bin * kHistEntrySize;
+        buffer_write_start_pos_[fid] = reduce_scatter_size_ + chunk_size;
+        if (i == rank_) {
+          buffer_read_start_pos_[fid] = read_size;
+          read_size += hist_size;
+          chunk_aggregated_features_[c].push_back(fid);
+        }
+        block_len_[block_idx] += hist_size;
+        chunk_size += hist_size;
       }
-      bin_size += num_bin * kHistEntrySize;
-    }
-  }
-
-  // get buffer_read_start_pos_
-  bin_size = 0;
-  for (auto fid : feature_distribution[rank_]) {
-    buffer_read_start_pos_[fid] = bin_size;
-    auto num_bin = this->train_data_->FeatureNumBin(fid);
-    if (this->train_data_->FeatureBinMapper(fid)->GetMostFreqBin() == 0) {
-      num_bin -= 1;
     }
-    bin_size += num_bin * kHistEntrySize;
+    chunk_reduce_scatter_size_[c] = chunk_size;
+    reduce_scatter_size_ += chunk_size;
   }
 
   // sync global data sumup info
@@ -165,13 +172,72 @@ void DataParallelTreeLearner<TREELEARNER_T>::FindBestSplits(const Tree* tree) {
                 this->smaller_leaf_histogram_array_[feature_index].RawData(),
                 this->smaller_leaf_histogram_array_[feature_index].SizeOfHistgram());
   }
+  if (num_reduce_chunks_ > 1) {
+    FindBestSplitsPipelined(tree);
+    return;
+  }
   // Reduce scatter for histogram
-  Network::ReduceScatter(input_buffer_.data(), reduce_scatter_size_, sizeof(hist_t), block_start_.data(),
-                         block_len_.data(), output_buffer_.data(), static_cast<comm_size_t>(output_buffer_.size()), &HistogramSumReducer);
+  ReduceScatterHistogramChunk(0);
   this->FindBestSplitsFromHistograms(
       this->col_sampler_.is_feature_used_bytree(), true, tree);
 }
 
+template <typename TREELEARNER_T>
+void DataParallelTreeLearner<TREELEARNER_T>::ReduceScatterHistogramChunk(int chunk) {
+  if (chunk_reduce_scatter_size_[chunk] <= 0) { return; }
+  const size_t block_offset = static_cast<size_t>(chunk) * num_machines_;
+  char* input = input_buffer_.data() + chunk_input_start_[chunk];
+  char* output = output_buffer_.data() + chunk_output_start_[chunk];
+  if (this->config_->histogram_exchange_sparse) {
+    histogram_compressor_.ReduceScatter(input, block_start_.data() + block_offset, block_len_.data() + block_offset,
+                                        output, this->config_->histogram_exchange_single_precision);
+  } else {
+    Network::ReduceScatter(input, chunk_reduce_scatter_size_[chunk], sizeof(hist_t),
+                           block_start_.data() + block_offset, block_len_.data() + block_offset, output,
+                           static_cast<comm_size_t>(output_buffer_.size()) - chunk_output_start_[chunk],
+                           &HistogramSumReducer);
+  }
+}
+
+template <typename TREELEARNER_T>
+void DataParallelTreeLearner<TREELEARNER_T>::FindBestSplitsPipelined(const Tree* tree) {
+  std::vector<SplitInfo> smaller_bests_per_thread(this->share_state_->num_threads);
+  std::vector<SplitInfo> larger_bests_per_thread(this->share_state_->num_threads);
+  std::vector<int8_t> smaller_node_used_features =
+      this->col_sampler_.GetByNode(tree, this->smaller_leaf_splits_->leaf_index());
+  std::vector<int8_t> larger_node_used_features =
+      this->col_sampler_.GetByNode(tree, this->larger_leaf_splits_->leaf_index());
+  double smaller_leaf_parent_output = this->GetParentOutput(tree, this->smaller_leaf_splits_.get());
+  double larger_leaf_parent_output = this->GetParentOutput(tree, this->larger_leaf_splits_.get());
+  OMP_INIT_EX();
+  // the network state is thread local, so the master thread issues all collectives
+  // while the other threads search splits on the chunks that are already reduced
+  #pragma omp parallel num_threads(this->share_state_->num_threads)
+  {
+    #pragma omp master
+    {
+      OMP_LOOP_EX_BEGIN();
+      for (int c = 0; c < num_reduce_chunks_; ++c) {
+        ReduceScatterHistogramChunk(c);
+        for (int feature_index : chunk_aggregated_features_[c]) {
+          #pragma omp task firstprivate(feature_index)
+          {
+            OMP_LOOP_EX_BEGIN();
+            const int tid = omp_get_thread_num();
+            FindBestSplitsForFeature(feature_index, smaller_node_used_features, larger_node_used_features,
+                                     smaller_leaf_parent_output, larger_leaf_parent_output,
+                                     &smaller_bests_per_thread[tid], &larger_bests_per_thread[tid]);
+            OMP_LOOP_EX_END();
+          }
+        }
+      }
+      OMP_LOOP_EX_END();
+    }
+  }
+  OMP_THROW_EX();
+  SyncUpBestSplits(smaller_bests_per_thread, larger_bests_per_thread);
+}
+
 template <typename TREELEARNER_T>
 void DataParallelTreeLearner<TREELEARNER_T>::FindBestSplitsFromHistograms(const std::vector<int8_t>&, bool, const Tree* tree) {
   std::vector<SplitInfo> smaller_bests_per_thread(this->share_state_->num_threads);
@@ -188,41 +254,57 @@ void DataParallelTreeLearner<TREELEARNER_T>::FindBestSplitsFromHistograms(const
     OMP_LOOP_EX_BEGIN();
     if (!is_feature_aggregated_[feature_index]) continue;
     const int tid = omp_get_thread_num();
-    const int real_feature_index = this->train_data_->RealFeatureIndex(feature_index);
-    // restore global histograms from buffer
-    this->smaller_leaf_histogram_array_[feature_index].FromMemory(
-      output_buffer_.data() + buffer_read_start_pos_[feature_index]);
-
-    this->train_data_->FixHistogram(feature_index,
-                                    this->smaller_leaf_splits_->sum_gradients(), this->smaller_leaf_splits_->sum_hessians(),
-                                    this->smaller_leaf_histogram_array_[feature_index].RawData());
-
-    this->ComputeBestSplitForFeature(
-        this->smaller_leaf_histogram_array_, feature_index, real_feature_index,
-        smaller_node_used_features[feature_index],
-        GetGlobalDataCountInLeaf(this->smaller_leaf_splits_->leaf_index()),
-        this->smaller_leaf_splits_.get(),
-        &smaller_bests_per_thread[tid],
-        smaller_leaf_parent_output);
-
-    // only root leaf
-    if (this->larger_leaf_splits_ == nullptr || this->larger_leaf_splits_->leaf_index() < 0) continue;
-
-    // construct histgroms for large leaf, we init larger leaf as the parent, so we can just subtract the smaller leaf's histograms
-    this->larger_leaf_histogram_array_[feature_index].Subtract(
-      this->smaller_leaf_histogram_array_[feature_index]);
-
-    this->ComputeBestSplitForFeature(
-        this->larger_leaf_histogram_array_, feature_index, real_feature_index,
-        larger_node_used_features[feature_index],
-        GetGlobalDataCountInLeaf(this->larger_leaf_splits_->leaf_index()),
-        this->larger_leaf_splits_.get(),
-        &larger_bests_per_thread[tid],
-        larger_leaf_parent_output);
+    FindBestSplitsForFeature(feature_index, smaller_node_used_features, larger_node_used_features,
+                             smaller_leaf_parent_output, larger_leaf_parent_output,
+                             &smaller_bests_per_thread[tid], &larger_bests_per_thread[tid]);
     OMP_LOOP_EX_END();
   }
   OMP_THROW_EX();
+  SyncUpBestSplits(smaller_bests_per_thread, larger_bests_per_thread);
+}
 
+template <typename TREELEARNER_T>
+void DataParallelTreeLearner<TREELEARNER_T>::FindBestSplitsForFeature(
+    int feature_index, const std::vector<int8_t>& smaller_node_used_features,
+    const std::vector<int8_t>& larger_node_used_features,
+    double smaller_leaf_parent_output, double larger_leaf_parent_output,
+    SplitInfo* smaller_best, SplitInfo* larger_best) {
+  const int real_feature_index = this->train_data_->RealFeatureIndex(feature_index);
+  // restore global histograms from buffer
+  this->smaller_leaf_histogram_array_[feature_index].FromMemory(
+    output_buffer_.data() + buffer_read_start_pos_[feature_index]);
+
+  this->train_data_->FixHistogram(feature_index,
+                                  this->smaller_leaf_splits_->sum_gradients(), this->smaller_leaf_splits_->sum_hessians(),
+                                  this->smaller_leaf_histogram_array_[feature_index].RawData());
+
+  this->ComputeBestSplitForFeature(
+      this->smaller_leaf_histogram_array_, feature_index, real_feature_index,
+      smaller_node_used_features[feature_index],
+      GetGlobalDataCountInLeaf(this->smaller_leaf_splits_->leaf_index()),
+      this->smaller_leaf_splits_.get(),
+      smaller_best,
+      smaller_leaf_parent_output);
+
+  // only root leaf
+  if (this->larger_leaf_splits_ == nullptr || this->larger_leaf_splits_->leaf_index() < 0) return;
+
+  // construct histgroms for large leaf, we init larger leaf as the parent, so we can just subtract the smaller leaf's histograms
+  this->larger_leaf_histogram_array_[feature_index].Subtract(
+    this->smaller_leaf_histogram_array_[feature_index]);
+
+  this->ComputeBestSplitForFeature(
+      this->larger_leaf_histogram_array_, feature_index, real_feature_index,
+      larger_node_used_features[feature_index],
+      GetGlobalDataCountInLeaf(this->larger_leaf_splits_->leaf_index()),
+      this->larger_leaf_splits_.get(),
+      larger_best,
+      larger_leaf_parent_output);
+}
+
+template <typename TREELEARNER_T>
+void DataParallelTreeLearner<TREELEARNER_T>::SyncUpBestSplits(const std::vector<SplitInfo>& smaller_bests_per_thread,
+                                                              const std::vector<SplitInfo>& larger_bests_per_thread) {
   auto smaller_best_idx = ArrayArgs<SplitInfo>::ArgMax(smaller_bests_per_thread);
   int leaf = this->smaller_leaf_splits_->leaf_index();
   this->best_split_per_leaf_[leaf] = smaller_bests_per_thread[smaller_best_idx];
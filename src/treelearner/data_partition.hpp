@@ -24,6 +24,7 @@ class DataPartition {
       : num_data_(num_data), num_leaves_(num_leaves), runner_(num_data, 512) {
     leaf_begin_.resize(num_leaves_);
     leaf_count_.resize(num_leaves_);
+    leaf_local_id_.resize(num_leaves_, -1);
     indices_.resize(num_data_);
     used_data_indices_ = nullptr;
   }
@@ -32,6 +33,7 @@ class DataPartition {
     num_leaves_ = num_leaves;
     leaf_begin_.resize(num_leaves_);
     leaf_count_.resize(num_leaves_);
+    leaf_local_id_.resize(num_leaves_);
   }
 
   void ResetNumData(int num_data) {
@@ -49,6 +51,7 @@ class DataPartition {
   void Init() {
     std::fill(leaf_begin_.begin(), leaf_begin_.end(), 0);
     std::fill(leaf_count_.begin(), leaf_count_.end(), 0);
+    std::fill(leaf_local_id_.begin(), leaf_local_id_.end(), -1);
     if (used_data_indices_ == nullptr) {
       // if using all data
       leaf_count_[0] = num_data_;
@@ -65,6 +68,7 @@ class DataPartition {
 
   void ResetByLeafPred(const std::vector<int>& leaf_pred, int num_leaves) {
     ResetLeaves(num_leaves);
+    std::fill(leaf_local_id_.begin(), leaf_local_id_.end(), -1);
     std::vector<std::vector<data_size_t>> indices_per_leaf(num_leaves_);
     for (data_size_t i = 0; i < static_cast<data_size_t>(leaf_pred.size()); ++i) {
       indices_per_leaf[leaf_pred[i]].push_back(i);
@@ -117,6 +121,76 @@ class DataPartition {
     leaf_count_[leaf] = left_cnt;
     leaf_begin_[right_leaf] = left_cnt + begin;
     leaf_count_[right_leaf] = cnt - left_cnt;
+    leaf_local_id_[right_leaf] = -1;
+  }
+
+  /*!
+  * \brief Mark that the data of a leaf has been copied into a leaf-local dataset whose k-th row is the k-th data point of the leaf.
+  *        The leaf and all its descendants then additionally keep indices into this leaf-local dataset
+  * \param leaf index of leaf
+  * \param local_id id of the leaf-local dataset
+  */
+  void SetLeafLocal(int leaf, int local_id) {
+    if (local_indices_.size() < indices_.size()) {
+      local_indices_.resize(indices_.size());
+    }
+    const data_size_t begin = leaf_begin_[leaf];
+    const data_size_t cnt = leaf_count_[leaf];
+#pragma omp parallel for schedule(static, 512) if (cnt >= 1024)
+    for (data_size_t i = 0; i < cnt; ++i) {
+      local_indices_[begin + i] = i;
+    }
+    leaf_local_id_[leaf] = local_id;
+  }
+
+  /*!
+  * \brief Get the id of the leaf-local dataset of a leaf (-1 if there is none)
+  */
+  int leaf_local_id(int leaf) const { return leaf_local_id_[leaf]; }
+
+  /*!
+  * \brief Get the indices into the leaf-local dataset of one leaf
+  * \param leaf index of leaf
+  * \param out_len number of data on this leaf
+  */
+  const data_size_t* GetLocalIndexOnLeaf(int leaf, data_size_t* out_len) const {
+    data_size_t begin = leaf_begin_[leaf];
+    *out_len = leaf_count_[leaf];
+    return local_indices_.data() + begin;
+  }
+
+  /*!
+  * \brief Split the data of a leaf that has a leaf-local dataset, the global indices are updated accordingly
+  * \param leaf index of leaf
+  * \param local_dataset leaf-local dataset
+  * \param local_to_global global data index of every row of local_dataset
+  * \param feature feature used for splitting
+  * \param threshold threshold that want to split
+  * \param right_leaf index of right leaf
+  */
+  void SplitLocal(int leaf, const Dataset* local_dataset, const data_size_t* local_to_global,
+                  int feature, const uint32_t* threshold, int num_threshold, bool default_left,
+                  int right_leaf) {
+    Common::FunctionTimer fun_timer("DataPartition::Split", global_timer);
+    const data_size_t begin = leaf_begin_[leaf];
+    const data_size_t cnt = leaf_count_[leaf];
+    auto left_start = local_indices_.data() + begin;
+    const auto left_cnt = runner_.Run<false>(
+        cnt,
+        [=](int, data_size_t cur_start, data_size_t cur_cnt, data_size_t* left,
+            data_size_t* right) {
+          return local_dataset->Split(feature, threshold, num_threshold, default_left,
+                                      left_start + cur_start, cur_cnt, left, right);
+        },
+        left_start);
+#pragma omp parallel for schedule(static, 512) if (cnt >= 1024)
+    for (data_size_t i = begin; i < begin + cnt; ++i) {
+      indices_[i] = local_to_global[local_indices_[i]];
+    }
+    leaf_count_[leaf] = left_cnt;
+    leaf_begin_[right_leaf] = left_cnt + begin;
+    leaf_count_[right_leaf] = cnt - left_cnt;
+    leaf_local_id_[right_leaf] = leaf_local_id_[leaf];
   }
 
   /*!
@@ -159,6 +233,10 @@ class DataPartition {
   std::vector<data_size_t> leaf_count_;
   /*! \brief Store all data's indices, order by leaf[data_in_leaf0,..,data_leaf1,..] */
   std::vector<data_size_t, Common::AlignmentAllocator<data_size_t, kAlignedSize>> indices_;
+  /*! \brief indices into the leaf-local datasets, same layout as indices_ (only valid for leaves with leaf_local_id_ >= 0) */
+  std::vector<data_size_t, Common::AlignmentAllocator<data_size_t, kAlignedSize>> local_indices_;
+  /*! \brief id of the leaf-local dataset of one leaf, -1 if the leaf uses the full dataset */
+  std::vector<int> leaf_local_id_;
   /*! \brief used data indices, used for bagging */
   const data_size_t* used_data_indices_;
   /*! \brief used data count, used for bagging */
@@ -853,6 +853,120 @@ class FeatureHistogram {
     }
   }
 
+  /*!
+  * \brief Batched version of the reverse scan of FindBestThresholdSequentially for the case
+  *        without monotone constraints, random thresholds, skipped default bin and NA as missing.
+  *        The cumulative sums are computed sequentially in the same order as in
+  *        FindBestThresholdSequentially, the gains of all valid thresholds are then evaluated in
+  *        a vectorizable loop, and the best threshold is selected in a last pass over the gains.
+  *        The result is therefore identical to the one of the sequential scan.
+  */
+  template <bool USE_L1, bool USE_MAX_OUTPUT, bool USE_SMOOTHING>
+  void FindBestThresholdReverseBatched(double sum_gradient, double sum_hessian,
+                                       data_size_t num_data, double min_gain_shift,
+                                       double parent_output, double* best_gain,
+                                       data_size_t* best_left_count,
+                                       double* best_sum_left_gradient,
+                                       double* best_sum_left_hessian,
+                                       uint32_t* best_threshold) {
+    const int8_t offset = meta_->offset;
+    const Config* config = meta_->config;
+    const double cnt_factor = num_data / sum_hessian;
+    const int t_start = meta_->num_bin - 1 - offset;
+    const int t_end = 1 - offset;
+    if (t_start < t_end) {
+      return;
+    }
+    const size_t max_num_threshold = static_cast<size_t>(t_start - t_end + 1);
+    // per-thread scratch buffers, reused across features and leaves
+    static THREAD_LOCAL std::vector<double> sums_buf;
+    static THREAD_LOCAL std::vector<data_size_t> counts_buf;
+    static THREAD_LOCAL std::vector<int> threshold_buf;
+    if (threshold_buf.size() < max_num_threshold) {
+      sums_buf.resize(5 * max_num_threshold);
+      counts_buf.resize(2 * max_num_threshold);
+      threshold_buf.resize(max_num_threshold);
+    }
+    double* left_gradients = sums_buf.data();
+    double* left_hessians = left_gradients + max_num_threshold;
+    double* right_gradients = left_hessians + max_num_threshold;
+    double* right_hessians = right_gradients + max_num_threshold;
+    double* gains = right_hessians + max_num_threshold;
+    data_size_t* left_counts = counts_buf.data();
+    data_size_t* right_counts = left_counts + max_num_threshold;
+    int* thresholds = threshold_buf.data();
+
+    // cumulative sums from right to left, and we don't need data in bin0
+    double sum_right_gradient = 0.0f;
+    double sum_right_hessian = kEpsilon;
+    data_size_t right_count = 0;
+    int num_valid = 0;
+    for (int t = t_start; t >= t_end; --t) {
+      const auto grad = GET_GRAD(data_, t);
+      const auto hess = GET_HESS(data_, t);
+      data_size_t cnt =
+          static_cast<data_size_t>(Common::RoundInt(hess * cnt_factor));
+      sum_right_gradient += grad;
+      sum_right_hessian += hess;
+      right_count += cnt;
+      // if data not enough, or sum hessian too small
+      if (right_count < config->min_data_in_leaf ||
+          sum_right_hessian < config->min_sum_hessian_in_leaf) {
+        continue;
+      }
+      data_size_t left_count = num_data - right_count;
+      // if data not enough
+      if (left_count < config->min_data_in_leaf) {
+        break;
+      }
+      double sum_left_hessian = sum_hessian - sum_right_hessian;
+      // if sum hessian too small
+      if (sum_left_hessian < config->min_sum_hessian_in_leaf) {
+        break;
+      }
+      left_gradients[num_valid] = sum_gradient - sum_right_gradient;
+      left_hessians[num_valid] = sum_left_hessian;
+      right_gradients[num_valid] = sum_right_gradient;
+      right_hessians[num_valid] = sum_right_hessian;
+      left_counts[num_valid] = left_count;
+      right_counts[num_valid] = right_count;
+      thresholds[num_valid] = t;
+      ++num_valid;
+    }
+
+    // split gains of all valid thresholds
+    const double l1 = config->lambda_l1;
+    const double l2 = config->lambda_l2;
+    const double max_delta_step = config->max_delta_step;
+    const double path_smooth = config->path_smooth;
+#pragma omp simd
+    for (int i = 0; i < num_valid; ++i) {
+      gains[i] = GetSplitGains<false, USE_L1, USE_MAX_OUTPUT, USE_SMOOTHING>(
+          left_gradients[i], left_hessians[i], right_gradients[i],
+          right_hessians[i], l1, l2, max_delta_step, nullptr, 0, path_smooth,
+          left_counts[i], right_counts[i], parent_output);
+    }
+
+    // select the first best threshold in scan order
+    for (int i = 0; i < num_valid; ++i) {
+      // gain with split is worse than without split
+      if (gains[i] <= min_gain_shift) {
+        continue;
+      }
+      // mark to is splittable
+      is_splittable_ = true;
+      // better split point
+      if (gains[i] > *best_gain) {
+        *best_left_count = left_counts[i];
+        *best_sum_left_gradient = left_gradients[i];
+        *best_sum_left_hessian = left_hessians[i];
+        // left is <= threshold, right is > threshold.  so this is t-1
+        *best_threshold = static_cast<uint32_t>(thresholds[i] - 1 + offset);
+        *best_gain = gains[i];
+      }
+    }
+  }
+
   template <bool USE_RAND, bool USE_MC, bool USE_L1, bool USE_MAX_OUTPUT, bool USE_SMOOTHING,
             bool REVERSE, bool SKIP_DEFAULT_BIN, bool NA_AS_MISSING>
   void FindBestThresholdSequentially(double sum_gradient, double sum_hessian,
@@ -877,7 +991,13 @@ class FeatureHistogram {
       constraints->InitCumulativeConstraints(REVERSE);
     }
 
-    if (REVERSE) {
+    if (REVERSE && !USE_RAND && !USE_MC && !SKIP_DEFAULT_BIN && !NA_AS_MISSING &&
+        meta_->config->batched_split_search) {
+      FindBestThresholdReverseBatched<USE_L1, USE_MAX_OUTPUT, USE_SMOOTHING>(
+          sum_gradient, sum_hessian, num_data, min_gain_shift, parent_output,
+          &best_gain, &best_left_count, &best_sum_left_gradient,
+          &best_sum_left_hessian, &best_threshold);
+    } else if (REVERSE) {
       double sum_right_gradient = 0.0f;
       double sum_right_hessian = kEpsilon;
       data_size_t right_count = 0;
@@ -0,0 +1,161 @@
+/*!
+* Original work Copyright (c) 2016 Microsoft Corporation. All rights reserved.
+* Modified work Copyright (c) 2020 Fabio Sigrist. All rights reserved.
+* Licensed under the Apache License Version 2.0 See LICENSE file in the project root for license information.
+*/
+#ifndef LIGHTGBM_TREELEARNER_HISTOGRAM_COMPRESSOR_HPP_
+#define LIGHTGBM_TREELEARNER_HISTOGRAM_COMPRESSOR_HPP_
+
+#include <LightGBM/bin.h>
+#include <LightGBM/meta.h>
+#include <LightGBM/network.h>
+#include <LightGBM/utils/openmp_wrapper.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace LightGBM {
+
+/*!
+* \brief Reduce scatter of histograms with a compressed wire format.
+*        Every block is sent either sparse (indices and sums of the non-empty bins) or dense,
+*        whichever is smaller, optionally with single precision sums.
+*        Received sums are always accumulated in double precision.
+*/
+class HistogramCompressor {
+ public:
+  /*!
+  * \brief Reduce scatter histograms, same layout as Network::ReduceScatter with HistogramSumReducer
+  * \param input Local histograms of all machines
+  * \param block_start The block start for different machines
+  * \param block_len The block size for different machines, in bytes of raw histogram entries
+  * \param output Output result, holds block_len[rank] bytes
+  * \param single_precision Send the histogram sums as float
+  */
+  void ReduceScatter(char* input, const comm_size_t* block_start, const comm_size_t* block_len,
+                     char* output, bool single_precision) {
+    if (single_precision) {
+      ReduceScatterInner<float>(input, block_start, block_len, output);
+    } else {
+      ReduceScatterInner<hist_t>(input, block_start, block_len, output);
+    }
+  }
+
+ private:
+  /*! \brief Header of a dense encoded block, otherwise the header is the number of non-empty bins */
+  static const int32_t kDenseBlock = -1;
+
+  template <typename VAL_T>
+  void ReduceScatterInner(char* input, const comm_size_t* block_start, const comm_size_t* block_len,
+                          char* output) {
+    const int rank = Network::rank();
+    const int num_machines = Network::num_machines();
+    // encoded block never exceeds header + dense entries
+    encoded_start_.resize(num_machines);
+    encoded_len_.resize(num_machines);
+    comm_size_t encoded_size = 0;
+    for (int i = 0; i < num_machines; ++i) {
+      encoded_start_[i] = encoded_size;
+      encoded_size += static_cast<comm_size_t>(sizeof(int32_t)) + block_len[i];
+    }
+    if (encoded_.size() < static_cast<size_t>(encoded_size)) {
+      encoded_.resize(encoded_size);
+    }
+    #pragma omp parallel for schedule(static, 1) if (num_machines >= 4)
+    for (int i = 0; i < num_machines; ++i) {
+      if (i == rank) {
+        encoded_len_[i] = 0;
+        continue;
+      }
+      encoded_len_[i] = Encode<VAL_T>(reinterpret_cast<const hist_t*>(input + block_start[i]),
+                                      static_cast<data_size_t>(block_len[i] / kHistEntrySize),
+                                      encoded_.data() + encoded_start_[i]);
+    }
+    // the local part is exact, remote parts are added on top of it
+    std::memcpy(output, input + block_start[rank], block_len[rank]);
+    hist_t* out = reinterpret_cast<hist_t*>(output);
+    const data_size_t num_bin = static_cast<data_size_t>(block_len[rank] / kHistEntrySize);
+    Network::ReduceScatterEncoded(encoded_.data(), encoded_start_.data(), encoded_len_.data(),
+                                  [out, num_bin](const char* src, comm_size_t src_size) {
+      DecodeAdd<VAL_T>(src, src_size, num_bin, out);
+    });
+  }
+
+  template <typename VAL_T>
+  static comm_size_t Encode(const hist_t* hist, data_size_t num_bin, char* out) {
+    int32_t num_non_empty = 0;
+    for (data_size_t i = 0; i < num_bin; ++i) {
+      if (hist[i << 1] != 0.0 || hist[(i << 1) + 1] != 0.0) {
+        ++num_non_empty;
+      }
+    }
+    const size_t sparse_size = static_cast<size_t>(num_non_empty) * (sizeof(int32_t) + 2 * sizeof(VAL_T));
+    const size_t dense_size = static_cast<size_t>(num_bin) * 2 * sizeof(VAL_T);
+    char* pos = out;
+    if (sparse_size < dense_size) {
+      std::memcpy(pos, &num_non_empty, sizeof(int32_t));
+      pos += sizeof(int32_t);
+      for (data_size_t i = 0; i < num_bin; ++i) {
+        if (hist[i << 1] != 0.0 || hist[(i << 1) + 1] != 0.0) {
+          const int32_t bin = static_cast<int32_t>(i);
+          std::memcpy(pos, &bin, sizeof(int32_t));
+          pos += sizeof(int32_t);
+          pos = WriteEntry<VAL_T>(hist + (i << 1), pos);
+        }
+      }
+    } else {
+      const int32_t header = kDenseBlock;
+      std::memcpy(pos, &header, sizeof(int32_t));
+      pos += sizeof(int32_t);
+      for (data_size_t i = 0; i < num_bin; ++i) {
+        pos = WriteEntry<VAL_T>(hist + (i << 1), pos);
+      }
+    }
+    return static_cast<comm_size_t>(pos - out);
+  }
+
+  template <typename VAL_T>
+  static void DecodeAdd(const char* src, comm_size_t src_size, data_size_t num_bin, hist_t* out) {
+    if (src_size <= 0) { return; }
+    int32_t header;
+    std::memcpy(&header, src, sizeof(int32_t));
+    const char* pos = src + sizeof(int32_t);
+    VAL_T entry[2];
+    if (header == kDenseBlock) {
+      for (data_size_t i = 0; i < num_bin; ++i) {
+        std::memcpy(entry, pos, sizeof(entry));
+        pos += sizeof(entry);
+        out[i << 1] += static_cast<hist_t>(entry[0]);
+        out[(i << 1) + 1] += static_cast<hist_t>(entry[1]);
+      }
+    } else {
+      for (int32_t j = 0; j < header; ++j) {
+        int32_t bin;
+        std::memcpy(&bin, pos, sizeof(int32_t));
+        pos += sizeof(int32_t);
+        std::memcpy(entry, pos, sizeof(entry));
+        pos += sizeof(entry);
+        out[bin << 1] += static_cast<hist_t>(entry[0]);
+        out[(bin << 1) + 1] += static_cast<hist_t>(entry[1]);
+      }
+    }
+  }
+
+  template <typename VAL_T>
+  static inline char* WriteEntry(const hist_t* entry, char* pos) {
+    const VAL_T val[2] = {static_cast<VAL_T>(entry[0]), static_cast<VAL_T>(entry[1])};
+    std::memcpy(pos, val, sizeof(val));
+    return pos + sizeof(val);
+  }
+
+  /*! \brief Buffer of the encoded blocks */
+  std::vector<char> encoded_;
+  /*! \brief Encoded block start for different machines */
+  std::vector<comm_size_t> encoded_start_;
+  /*! \brief Encoded block size for different machines */
+  std::vector<comm_size_t> encoded_len_;
+};
+
+}  // namespace LightGBM
+#endif  // LIGHTGBM_TREELEARNER_HISTOGRAM_COMPRESSOR_HPP_
@@ -69,17 +69,26 @@ class LeafSplits {
    * \brief Init splits on the current leaf, it will traverse all data to sum up the results
    * \param gradients
    * \param hessians
+   * \param is_constant_hessian If true, all hessians are equal to hessians[0] and only the gradients are read
    */
-  void Init(const score_t* gradients, const score_t* hessians) {
+  void Init(const score_t* gradients, const score_t* hessians, bool is_constant_hessian = false) {
     num_data_in_leaf_ = num_data_;
     leaf_index_ = 0;
     data_indices_ = nullptr;
     double tmp_sum_gradients = 0.0f;
     double tmp_sum_hessians = 0.0f;
+    if (is_constant_hessian) {
+#pragma omp parallel for schedule(static, 512) reduction(+:tmp_sum_gradients) if (num_data_in_leaf_ >= 1024 && !deterministic_)
+      for (data_size_t i = 0; i < num_data_in_leaf_; ++i) {
+        tmp_sum_gradients += gradients[i];
+      }
+      tmp_sum_hessians = static_cast<double>(hessians[0]) * num_data_in_leaf_;
+    } else {
 #pragma omp parallel for schedule(static, 512) reduction(+:tmp_sum_gradients, tmp_sum_hessians) if (num_data_in_leaf_ >= 1024 && !deterministic_)
-    for (data_size_t i = 0; i < num_data_in_leaf_; ++i) {
-      tmp_sum_gradients += gradients[i];
-      tmp_sum_hessians += hessians[i];
+      for (data_size_t i = 0; i < num_data_in_leaf_; ++i) {
+        tmp_sum_gradients += gradients[i];
+        tmp_sum_hessians += hessians[i];
+      }
     }
     sum_gradients_ = tmp_sum_gradients;
     sum_hessians_ = tmp_sum_hessians;
@@ -91,18 +100,27 @@ class LeafSplits {
    * \param data_partition current data partition
    * \param gradients
    * \param hessians
+   * \param is_constant_hessian If true, all hessians are equal to hessians[0] and only the gradients are read
    */
   void Init(int leaf, const DataPartition* data_partition,
-            const score_t* gradients, const score_t* hessians) {
+            const score_t* gradients, const score_t* hessians, bool is_constant_hessian = false) {
     leaf_index_ = leaf;
     data_indices_ = data_partition->GetIndexOnLeaf(leaf, &num_data_in_leaf_);
     double tmp_sum_gradients = 0.0f;
     double tmp_sum_hessians = 0.0f;
+    if (is_constant_hessian) {
+#pragma omp parallel for schedule(static, 512) reduction(+:tmp_sum_gradients) if (num_data_in_leaf_ >= 1024 && !deterministic_)
+      for (data_size_t i = 0; i < num_data_in_leaf_; ++i) {
+        tmp_sum_gradients += gradients[data_indices_[i]];
+      }
+      tmp_sum_hessians = static_cast<double>(hessians[0]) * num_data_in_leaf_;
+    } else {
 #pragma omp parallel for schedule(static, 512) reduction(+:tmp_sum_gradients, tmp_sum_hessians) if (num_data_in_leaf_ >= 1024 && !deterministic_)
-    for (data_size_t i = 0; i < num_data_in_leaf_; ++i) {
-      const data_size_t idx = data_indices_[i];
-      tmp_sum_gradients += gradients[idx];
-      tmp_sum_hessians += hessians[idx];
+      for (data_size_t i = 0; i < num_data_in_leaf_; ++i) {
+        const data_size_t idx = data_indices_[i];
+        tmp_sum_gradients += gradients[idx];
+        tmp_sum_hessians += hessians[idx];
+      }
     }
     sum_gradients_ = tmp_sum_gradients;
     sum_hessians_ = tmp_sum_hessians;
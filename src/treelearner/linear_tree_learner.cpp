@@ -44,11 +44,11 @@ void LinearTreeLearner::InitLinear(const Dataset* train_data, const int max_leav
   XTHX_.clear();
   XTg_.clear();
   for (int i = 0; i < max_leaves; ++i) {
-    // store only upper triangular half of matrix as an array, in row-major order
-    // this requires (max_num_feat + 1) * (max_num_feat + 2) / 2 entries (including the constant terms of the regression)
+    // store the full matrix in column-major order (only the lower triangle is used),
+    // this requires (max_num_feat + 1) * (max_num_feat + 1) entries (including the constant terms of the regression)
     // we add another 8 to ensure cache lines are not shared among processors
-    XTHX_.push_back(std::vector<float>((max_num_feat + 1) * (max_num_feat + 2) / 2 + 8, 0));
-    XTg_.push_back(std::vector<float>(max_num_feat + 9, 0.0));
+    XTHX_.push_back(std::vector<double>((max_num_feat + 1) * (max_num_feat + 1) + 8, 0));
+    XTg_.push_back(std::vector<double>(max_num_feat + 9, 0.0));
   }
   XTHX_by_thread_.clear();
   XTg_by_thread_.clear();
@@ -223,71 +223,87 @@ void LinearTreeLearner::CalculateLinear(Tree* tree, bool is_refit, const score_t
       max_num_features = numerical_features.size();
     }
   }
+  // split the data of every leaf into tiles of at most kLinearTileRows rows
+  const data_size_t* leaf_indices = data_partition_->indices();
+  std::vector<int> tile_leaf;
+  std::vector<data_size_t> tile_begin;
+  std::vector<data_size_t> tile_end;
+  for (int leaf_num = 0; leaf_num < num_leaves; ++leaf_num) {
+    const data_size_t leaf_begin = data_partition_->leaf_begin(leaf_num);
+    const data_size_t leaf_end = leaf_begin + data_partition_->leaf_count(leaf_num);
+    for (data_size_t begin = leaf_begin; begin < leaf_end; begin += kLinearTileRows) {
+      tile_leaf.push_back(leaf_num);
+      tile_begin.push_back(begin);
+      tile_end.push_back(std::min(begin + static_cast<data_size_t>(kLinearTileRows), leaf_end));
+    }
+  }
+  const int num_tiles = static_cast<int>(tile_leaf.size());
   // clear the coefficient matrices
 #pragma omp parallel for schedule(static)
   for (int i = 0; i < num_threads; ++i) {
     for (int leaf_num = 0; leaf_num < num_leaves; ++leaf_num) {
       size_t num_feat = leaf_features[leaf_num].size();
-      std::fill(XTHX_by_thread_[i][leaf_num].begin(), XTHX_by_thread_[i][leaf_num].begin() + (num_feat + 1) * (num_feat + 2) / 2, 0.0f);
-      std::fill(XTg_by_thread_[i][leaf_num].begin(), XTg_by_thread_[i][leaf_num].begin() + num_feat + 1, 0.0f);
+      std::fill(XTHX_by_thread_[i][leaf_num].begin(), XTHX_by_thread_[i][leaf_num].begin() + (num_feat + 1) * (num_feat + 1), 0.0);
+      std::fill(XTg_by_thread_[i][leaf_num].begin(), XTg_by_thread_[i][leaf_num].begin() + num_feat + 1, 0.0);
     }
   }
-#pragma omp parallel for schedule(static)
-  for (int leaf_num = 0; leaf_num < num_leaves; ++leaf_num) {
-    size_t num_feat = leaf_features[leaf_num].size();
-    std::fill(XTHX_[leaf_num].begin(), XTHX_[leaf_num].begin() + (num_feat + 1) * (num_feat + 2) / 2, 0.0f);
-    std::fill(XTg_[leaf_num].begin(), XTg_[leaf_num].begin() + num_feat + 1, 0.0f);
-  }
   std::vector<std::vector<int>> num_nonzero;
   for (int i = 0; i < num_threads; ++i) {
     if (HAS_NAN) {
       num_nonzero.push_back(std::vector<int>(num_leaves, 0));
     }
   }
+  // accumulate X_T * H * X and X_T * g tile by tile: the rows of a tile are gathered into a dense
+  // column-major matrix, and the tile is then added with a (vectorized) matrix product
   OMP_INIT_EX();
 #pragma omp parallel if (num_data_ > 1024)
   {
-    std::vector<float> curr_row(max_num_features + 1);
+    std::vector<double> X_tile(kLinearTileRows * (max_num_features + 1));
+    std::vector<double> HX_tile(kLinearTileRows * (max_num_features + 1));
+    std::vector<double> g_tile(kLinearTileRows);
     int tid = omp_get_thread_num();
 #pragma omp for schedule(static)
-    for (int i = 0; i < num_data_; ++i) {
+    for (int tile = 0; tile < num_tiles; ++tile) {
       OMP_LOOP_EX_BEGIN();
-      int leaf_num = leaf_map_[i];
-      if (leaf_num < 0) {
-        continue;
-      }
-      bool nan_found = false;
-      int num_feat = leaf_num_features[leaf_num];
-      for (int feat = 0; feat < num_feat; ++feat) {
+      const int leaf_num = tile_leaf[tile];
+      const int num_feat = leaf_num_features[leaf_num];
+      int num_rows = 0;
+      for (data_size_t idx = tile_begin[tile]; idx < tile_end[tile]; ++idx) {
+        const data_size_t i = leaf_indices[idx];
+        bool nan_found = false;
+        for (int feat = 0; feat < num_feat; ++feat) {
+          const float val = raw_data_ptr[leaf_num][feat][i];
+          if (HAS_NAN) {
+            if (std::isnan(val)) {
+              nan_found = true;
+              break;
+            }
+            num_nonzero[tid][leaf_num] += 1;
+          }
+          X_tile[feat * kLinearTileRows + num_rows] = val;
+        }
         if (HAS_NAN) {
-          float val = raw_data_ptr[leaf_num][feat][i];
-          if (std::isnan(val)) {
-            nan_found = true;
-            break;
+          if (nan_found) {
+            continue;
           }
-          num_nonzero[tid][leaf_num] += 1;
-          curr_row[feat] = val;
-        } else {
-          curr_row[feat] = raw_data_ptr[leaf_num][feat][i];
         }
-      }
-      if (HAS_NAN) {
-        if (nan_found) {
-          continue;
+        X_tile[num_feat * kLinearTileRows + num_rows] = 1.0;
+        const double h = hessians[i];
+        for (int feat = 0; feat < num_feat + 1; ++feat) {
+          HX_tile[feat * kLinearTileRows + num_rows] = h * X_tile[feat * kLinearTileRows + num_rows];
         }
+        g_tile[num_rows] = gradients[i];
+        ++num_rows;
       }
-      curr_row[num_feat] = 1.0;
-      float h = static_cast<float>(hessians[i]);
-      float g = static_cast<float>(gradients[i]);
-      int j = 0;
-      for (int feat1 = 0; feat1 < num_feat + 1; ++feat1) {
-        float f1_val = curr_row[feat1];
-        XTg_by_thread_[tid][leaf_num][feat1] += f1_val * g;
-        f1_val *= h;
-        for (int feat2 = feat1; feat2 < num_feat + 1; ++feat2) {
-          XTHX_by_thread_[tid][leaf_num][j] += f1_val * curr_row[feat2];
-          ++j;
-        }
+      if (num_rows > 0) {
+        typedef Eigen::Map<const Eigen::MatrixXd, 0, Eigen::OuterStride<>> TileMap;
+        TileMap X(X_tile.data(), num_rows, num_feat + 1, Eigen::OuterStride<>(kLinearTileRows));
+        TileMap HX(HX_tile.data(), num_rows, num_feat + 1, Eigen::OuterStride<>(kLinearTileRows));
+        Eigen::Map<const Eigen::VectorXd> g(g_tile.data(), num_rows);
+        Eigen::Map<Eigen::MatrixXd> XTHX(XTHX_by_thread_[tid][leaf_num].data(), num_feat + 1, num_feat + 1);
+        Eigen::Map<Eigen::VectorXd> XTg(XTg_by_thread_[tid][leaf_num].data(), num_feat + 1);
+        XTHX.triangularView<Eigen::Lower>() += X.transpose() * HX;
+        XTg.noalias() += X.transpose() * g;
       }
       OMP_LOOP_EX_END();
     }
@@ -295,17 +311,21 @@ void LinearTreeLearner::CalculateLinear(Tree* tree, bool is_refit, const score_t
   OMP_THROW_EX();
   auto total_nonzero = std::vector<int>(tree->num_leaves());
   // aggregate results from different threads
-  for (int tid = 0; tid < num_threads; ++tid) {
 #pragma omp parallel for schedule(static)
-    for (int leaf_num = 0; leaf_num < num_leaves; ++leaf_num) {
-      size_t num_feat = leaf_features[leaf_num].size();
-      for (size_t j = 0; j < (num_feat + 1) * (num_feat + 2) / 2; ++j) {
+  for (int leaf_num = 0; leaf_num < num_leaves; ++leaf_num) {
+    size_t num_feat = leaf_features[leaf_num].size();
+    std::copy(XTHX_by_thread_[0][leaf_num].begin(), XTHX_by_thread_[0][leaf_num].begin() + (num_feat + 1) * (num_feat + 1), XTHX_[leaf_num].begin());
+    std::copy(XTg_by_thread_[0][leaf_num].begin(), XTg_by_thread_[0][leaf_num].begin() + num_feat + 1, XTg_[leaf_num].begin());
+    for (int tid = 1; tid < num_threads; ++tid) {
+      for (size_t j = 0; j < (num_feat + 1) * (num_feat + 1); ++j) {
         XTHX_[leaf_num][j] += XTHX_by_thread_[tid][leaf_num][j];
       }
       for (size_t feat1 = 0; feat1 < num_feat + 1; ++feat1) {
         XTg_[leaf_num][feat1] += XTg_by_thread_[tid][leaf_num][feat1];
       }
-      if (HAS_NAN) {
+    }
+    if (HAS_NAN) {
+      for (int tid = 0; tid < num_threads; ++tid) {
         total_nonzero[leaf_num] += num_nonzero[tid][leaf_num];
       }
     }
@@ -332,21 +352,22 @@ void LinearTreeLearner::CalculateLinear(Tree* tree, bool is_refit, const score_t
       continue;
     }
     size_t num_feat = leaf_features[leaf_num].size();
-    Eigen::MatrixXd XTHX_mat(num_feat + 1, num_feat + 1);
-    Eigen::MatrixXd XTg_mat(num_feat + 1, 1);
-    size_t j = 0;
-    for (size_t feat1 = 0; feat1 < num_feat + 1; ++feat1) {
-      for (size_t feat2 = feat1; feat2 < num_feat + 1; ++feat2) {
-        XTHX_mat(feat1, feat2) = XTHX_[leaf_num][j];
-        XTHX_mat(feat2, feat1) = XTHX_mat(feat1, feat2);
-        if ((feat1 == feat2) && (feat1 < num_feat)) {
-          XTHX_mat(feat1, feat2) += config_->linear_lambda;
-        }
-        ++j;
-      }
-      XTg_mat(feat1) = XTg_[leaf_num][feat1];
+    Eigen::MatrixXd XTHX_mat = Eigen::Map<const Eigen::MatrixXd>(XTHX_[leaf_num].data(), num_feat + 1, num_feat + 1);
+    Eigen::VectorXd XTg_mat = Eigen::Map<const Eigen::VectorXd>(XTg_[leaf_num].data(), num_feat + 1);
+    for (size_t feat1 = 0; feat1 < num_feat; ++feat1) {
+      XTHX_mat(feat1, feat1) += config_->linear_lambda;
+    }
+    // solve with a Cholesky decomposition, and fall back to a (full pivoting) LU decomposition
+    // if the matrix is not numerically positive definite
+    Eigen::VectorXd coeffs;
+    Eigen::LLT<Eigen::MatrixXd, Eigen::Lower> llt(XTHX_mat);
+    if (llt.info() == Eigen::Success) {
+      coeffs = - llt.solve(XTg_mat);
+    }
+    if (llt.info() != Eigen::Success || !coeffs.allFinite()) {
+      XTHX_mat.triangularView<Eigen::StrictlyUpper>() = XTHX_mat.transpose();
+      coeffs = - XTHX_mat.fullPivLu().inverse() * XTg_mat;
     }
-    Eigen::MatrixXd coeffs = - XTHX_mat.fullPivLu().inverse() * XTg_mat;
     std::vector<double> coeffs_vec;
     std::vector<int> features_new;
     std::vector<double> old_coeffs = tree->LeafCoeffs(leaf_num);
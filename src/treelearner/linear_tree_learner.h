@@ -116,11 +116,13 @@ class LinearTreeLearner: public SerialTreeLearner {
   bool any_nan_;
   /*! \brief map dataset to leaves */
   mutable std::vector<int> leaf_map_;
-  /*! \brief temporary storage for calculating linear model coefficients */
-  mutable std::vector<std::vector<float>> XTHX_;
-  mutable std::vector<std::vector<float>> XTg_;
-  mutable std::vector<std::vector<std::vector<float>>> XTHX_by_thread_;
-  mutable std::vector<std::vector<std::vector<float>>> XTg_by_thread_;
+  /*! \brief number of rows of the tiles that are gathered from a leaf when calculating linear model coefficients */
+  static const int kLinearTileRows = 256;
+  /*! \brief temporary storage for calculating linear model coefficients (lower triangle of full column-major matrices, in double precision) */
+  mutable std::vector<std::vector<double>> XTHX_;
+  mutable std::vector<std::vector<double>> XTg_;
+  mutable std::vector<std::vector<std::vector<double>>> XTHX_by_thread_;
+  mutable std::vector<std::vector<std::vector<double>>> XTg_by_thread_;
 };
 
 }  // namespace LightGBM
@@ -14,6 +14,7 @@
 
 #include "cuda_tree_learner.h"
 #include "gpu_tree_learner.h"
+#include "histogram_compressor.hpp"
 #include "serial_tree_learner.h"
 
 namespace LightGBM {
@@ -73,6 +74,23 @@ class DataParallelTreeLearner: public TREELEARNER_T {
   }
 
  private:
+  /*!
+  * \brief Reduce-scatter the histograms chunk by chunk and search splits on every
+  *        reduced chunk while the next one is still being transferred
+  */
+  void FindBestSplitsPipelined(const Tree* tree);
+  /*! \brief Restore the global histogram of one local aggregated feature and find its best splits */
+  void FindBestSplitsForFeature(int feature_index,
+                                const std::vector<int8_t>& smaller_node_used_features,
+                                const std::vector<int8_t>& larger_node_used_features,
+                                double smaller_leaf_parent_output, double larger_leaf_parent_output,
+                                SplitInfo* smaller_best, SplitInfo* larger_best);
+  /*! \brief Reduce scatter the local histograms of one chunk */
+  void ReduceScatterHistogramChunk(int chunk);
+  /*! \brief Reduce the per-thread best splits and sync up the global best splits */
+  void SyncUpBestSplits(const std::vector<SplitInfo>& smaller_bests_per_thread,
+                        const std::vector<SplitInfo>& larger_bests_per_thread);
+
   /*! \brief Rank of local machine */
   int rank_;
   /*! \brief Number of machines of this parallel task */
@@ -84,10 +102,20 @@ class DataParallelTreeLearner: public TREELEARNER_T {
   /*! \brief different machines will aggregate histograms for different features,
        use this to mark local aggregate features*/
   std::vector<bool> is_feature_aggregated_;
-  /*! \brief Block start index for reduce scatter */
+  /*! \brief Number of chunks the histogram reduce scatter is split into */
+  int num_reduce_chunks_;
+  /*! \brief Block start index for reduce scatter, num_machines_ entries per chunk, relative to the chunk start */
   std::vector<comm_size_t> block_start_;
-  /*! \brief Block size for reduce scatter */
+  /*! \brief Block size for reduce scatter, num_machines_ entries per chunk */
   std::vector<comm_size_t> block_len_;
+  /*! \brief Start of every chunk in input_buffer_ */
+  std::vector<comm_size_t> chunk_input_start_;
+  /*! \brief Start of every chunk in output_buffer_ */
+  std::vector<comm_size_t> chunk_output_start_;
+  /*! \brief Size for reduce scatter of every chunk */
+  std::vector<comm_size_t> chunk_reduce_scatter_size_;
+  /*! \brief Local aggregate features of every chunk */
+  std::vector<std::vector<int>> chunk_aggregated_features_;
   /*! \brief Write positions for feature histograms */
   std::vector<comm_size_t> buffer_write_start_pos_;
   /*! \brief Read positions for local feature histograms */
@@ -96,6 +124,8 @@ class DataParallelTreeLearner: public TREELEARNER_T {
   comm_size_t reduce_scatter_size_;
   /*! \brief Store global number of data in leaves  */
   std::vector<data_size_t> global_data_count_in_leaf_;
+  /*! \brief Compressed histogram exchange */
+  HistogramCompressor histogram_compressor_;
 };
 
 /*!
@@ -181,6 +211,8 @@ class VotingParallelTreeLearner: public TREELEARNER_T {
   std::unique_ptr<FeatureHistogram[]> smaller_leaf_histogram_array_global_;
   /*! \brief Store global histogram for larger leaf  */
   std::unique_ptr<FeatureHistogram[]> larger_leaf_histogram_array_global_;
+  /*! \brief Compressed histogram exchange */
+  HistogramCompressor histogram_compressor_;
 
   std::vector<hist_t> smaller_leaf_histogram_data_;
   std::vector<hist_t> larger_leaf_histogram_data_;
@@ -107,6 +107,9 @@ void SerialTreeLearner::ResetTrainingDataInner(const Dataset* train_data,
   if (reset_multi_val_bin) {
     col_sampler_.SetTrainingData(train_data_);
     GetShareStates(train_data_, is_constant_hessian, false);
+    // the leaf-local datasets have the feature mappers of the previous training data
+    leaf_local_data_.clear();
+    num_leaf_local_data_ = 0;
   }
 
   // initialize ordered gradients and hessians
@@ -206,6 +209,9 @@ Tree* SerialTreeLearner::Train(const score_t* gradients, const score_t *hessians
   }
 
   Log::Debug("Trained a tree with leaves = %d and max_depth = %d", tree->num_leaves(), cur_depth);
+  // the data partition keeps global indices, the leaf-local copies are not needed anymore
+  // (their datasets and buffers are reused for the next tree)
+  num_leaf_local_data_ = 0;
   return tree.release();
 }
 
@@ -259,6 +265,14 @@ void SerialTreeLearner::BeforeTrain() {
   train_data_->InitTrain(col_sampler_.is_feature_used_bytree(), share_state_.get());
   // initialize data partition
   data_partition_->Init();
+  num_leaf_local_data_ = 0;
+  use_leaf_reorder_ = config_->leaf_reorder_data_ratio > 0.0 && config_->tree_learner == std::string("serial") &&
+    config_->device_type == std::string("cpu") && share_state_->is_col_wise;
+  for (int group = 0; use_leaf_reorder_ && group < train_data_->num_feature_groups(); ++group) {
+    if (train_data_->IsMultiGroup(group)) {
+      use_leaf_reorder_ = false;
+    }
+  }
 
   constraints_->Reset();
 
@@ -270,11 +284,11 @@ void SerialTreeLearner::BeforeTrain() {
   // Sumup for root
   if (data_partition_->leaf_count(0) == num_data_) {
     // use all data
-    smaller_leaf_splits_->Init(gradients_, hessians_);
+    smaller_leaf_splits_->Init(gradients_, hessians_, share_state_->is_constant_hessian);
 
   } else {
     // use bagging, only use part of data
-    smaller_leaf_splits_->Init(0, data_partition_.get(), gradients_, hessians_);
+    smaller_leaf_splits_->Init(0, data_partition_.get(), gradients_, hessians_, share_state_->is_constant_hessian);
   }
 
   larger_leaf_splits_->Init();
@@ -355,20 +369,98 @@ void SerialTreeLearner::ConstructHistograms(
   // construct smaller leaf
   hist_t* ptr_smaller_leaf_hist_data =
       smaller_leaf_histogram_array_[0].RawData() - kHistOffset;
-  train_data_->ConstructHistograms(
-      is_feature_used, smaller_leaf_splits_->data_indices(),
-      smaller_leaf_splits_->num_data_in_leaf(), gradients_, hessians_,
-      ordered_gradients_.data(), ordered_hessians_.data(), share_state_.get(),
-      ptr_smaller_leaf_hist_data);
+  ConstructLeafHistograms(is_feature_used, smaller_leaf_splits_.get(),
+                          ptr_smaller_leaf_hist_data);
   if (larger_leaf_histogram_array_ != nullptr && !use_subtract) {
     // construct larger leaf
     hist_t* ptr_larger_leaf_hist_data =
         larger_leaf_histogram_array_[0].RawData() - kHistOffset;
-    train_data_->ConstructHistograms(
-        is_feature_used, larger_leaf_splits_->data_indices(),
-        larger_leaf_splits_->num_data_in_leaf(), gradients_, hessians_,
-        ordered_gradients_.data(), ordered_hessians_.data(), share_state_.get(),
-        ptr_larger_leaf_hist_data);
+    ConstructLeafHistograms(is_feature_used, larger_leaf_splits_.get(),
+                            ptr_larger_leaf_hist_data);
+  }
+}
+
+void SerialTreeLearner::ConstructLeafHistograms(
+    const std::vector<int8_t>& is_feature_used, const LeafSplits* leaf_splits,
+    hist_t* hist_data) {
+  const int leaf = leaf_splits->leaf_index();
+  if (use_leaf_reorder_ && leaf >= 0) {
+    ReorderLeafIfSmall(leaf);
+    const int local_id = data_partition_->leaf_local_id(leaf);
+    if (local_id >= 0) {
+      const LeafLocalData& local = leaf_local_data_[local_id];
+      data_size_t cnt = 0;
+      const data_size_t* local_indices = data_partition_->GetLocalIndexOnLeaf(leaf, &cnt);
+      local.data->ConstructHistograms(
+          is_feature_used, local_indices, cnt, local.gradients.data(),
+          local.hessians.data(), ordered_gradients_.data(),
+          ordered_hessians_.data(), share_state_.get(), hist_data);
+      return;
+    }
+  }
+  train_data_->ConstructHistograms(
+      is_feature_used, leaf_splits->data_indices(),
+      leaf_splits->num_data_in_leaf(), gradients_, hessians_,
+      ordered_gradients_.data(), ordered_hessians_.data(), share_state_.get(),
+      hist_data);
+}
+
+void SerialTreeLearner::ReorderLeafIfSmall(int leaf) {
+  if (data_partition_->leaf_local_id(leaf) >= 0) {
+    return;
+  }
+  data_size_t cnt = 0;
+  const data_size_t* indices = data_partition_->GetIndexOnLeaf(leaf, &cnt);
+  // leaves with less than 2 * min_data_in_leaf data cannot be split further, copying them does not pay off
+  if (cnt > config_->leaf_reorder_data_ratio * num_data_ ||
+      cnt < static_cast<data_size_t>(config_->min_data_in_leaf * 2)) {
+    return;
+  }
+  Common::FunctionTimer fun_timer("SerialTreeLearner::ReorderLeaf", global_timer);
+  if (num_leaf_local_data_ == static_cast<int>(leaf_local_data_.size())) {
+    leaf_local_data_.emplace_back();
+  }
+  LeafLocalData& local = leaf_local_data_[num_leaf_local_data_];
+  local.global_indices.assign(indices, indices + cnt);
+  if (local.data == nullptr) {
+    local.data.reset(new Dataset(cnt));
+    local.data->CopyFeatureMapperFrom(train_data_);
+  } else {
+    local.data->ReSize(cnt);
+  }
+  local.data->CopySubrow(train_data_, indices, cnt, false);
+  local.gradients.resize(cnt);
+  if (share_state_->is_constant_hessian) {
+    // histograms only read the first of the constant hessians
+    local.hessians.assign(1, hessians_[0]);
+    #pragma omp parallel for schedule(static, 512) if (cnt >= 1024)
+    for (data_size_t i = 0; i < cnt; ++i) {
+      local.gradients[i] = gradients_[indices[i]];
+    }
+  } else {
+    local.hessians.resize(cnt);
+    #pragma omp parallel for schedule(static, 512) if (cnt >= 1024)
+    for (data_size_t i = 0; i < cnt; ++i) {
+      local.gradients[i] = gradients_[indices[i]];
+      local.hessians[i] = hessians_[indices[i]];
+    }
+  }
+  data_partition_->SetLeafLocal(leaf, num_leaf_local_data_);
+  ++num_leaf_local_data_;
+}
+
+void SerialTreeLearner::PartitionLeaf(int leaf, int inner_feature_index,
+                                      const uint32_t* threshold, int num_threshold,
+                                      bool default_left, int right_leaf) {
+  const int local_id = data_partition_->leaf_local_id(leaf);
+  if (local_id >= 0) {
+    const LeafLocalData& local = leaf_local_data_[local_id];
+    data_partition_->SplitLocal(leaf, local.data.get(), local.global_indices.data(),
+                                inner_feature_index, threshold, num_threshold,
+                                default_left, right_leaf);
+  } else {
+    data_partition_->Split(leaf, train_data_, inner_feature_index, threshold,
+                           num_threshold, default_left, right_leaf);
   }
 }
 
@@ -585,9 +677,8 @@ void SerialTreeLearner::SplitInner(Tree* tree, int best_leaf, int* left_leaf,
   if (is_numerical_split) {
     auto threshold_double = train_data_->RealThreshold(
         inner_feature_index, best_split_info.threshold);
-    data_partition_->Split(best_leaf, train_data_, inner_feature_index,
-                           &best_split_info.threshold, 1,
-                           best_split_info.default_left, next_leaf_id);
+    PartitionLeaf(best_leaf, inner_feature_index, &best_split_info.threshold, 1,
+                  best_split_info.default_left, next_leaf_id);
     if (update_cnt) {
       // don't need to update this in data-based parallel model
       best_split_info.left_count = data_partition_->leaf_count(*left_leaf);
@@ -619,10 +710,9 @@ void SerialTreeLearner::SplitInner(Tree* tree, int best_leaf, int* left_leaf,
     std::vector<uint32_t> cat_bitset = Common::ConstructBitset(
         threshold_int.data(), best_split_info.num_cat_threshold);
 
-    data_partition_->Split(best_leaf, train_data_, inner_feature_index,
-                           cat_bitset_inner.data(),
-                           static_cast<int>(cat_bitset_inner.size()),
-                           best_split_info.default_left, next_leaf_id);
+    PartitionLeaf(best_leaf, inner_feature_index, cat_bitset_inner.data(),
+                  static_cast<int>(cat_bitset_inner.size()),
+                  best_split_info.default_left, next_leaf_id);
 
     if (update_cnt) {
       // don't need to update this in data-based parallel model
@@ -146,6 +146,27 @@ class SerialTreeLearner: public TreeLearner {
 
   virtual void ConstructHistograms(const std::vector<int8_t>& is_feature_used, bool use_subtract);
 
+  /*!
+  * \brief Construct the histograms of one leaf, using its leaf-local dataset if there is one
+  * \param is_feature_used Indicates whether a feature is used
+  * \param leaf_splits Leaf for which the histograms are constructed
+  * \param hist_data Output histograms
+  */
+  void ConstructLeafHistograms(const std::vector<int8_t>& is_feature_used,
+                               const LeafSplits* leaf_splits, hist_t* hist_data);
+
+  /*!
+  * \brief Copy the data of a leaf into a contiguous leaf-local dataset if the leaf is small enough (see leaf_reorder_data_ratio)
+  * \param leaf The index of the leaf
+  */
+  void ReorderLeafIfSmall(int leaf);
+
+  /*!
+  * \brief Partition the data of a leaf according to a split
+  */
+  void PartitionLeaf(int leaf, int inner_feature_index, const uint32_t* threshold,
+                     int num_threshold, bool default_left, int right_leaf);
+
   virtual void FindBestSplitsFromHistograms(const std::vector<int8_t>& is_feature_used, bool use_subtract, const Tree*);
 
   /*!
@@ -227,6 +248,21 @@ class SerialTreeLearner: public TreeLearner {
   const Json* forced_split_json_;
   std::unique_ptr<TrainingShareStates> share_state_;
   std::unique_ptr<CostEfficientGradientBoosting> cegb_;
+  /*! \brief Contiguous copy of the data of one leaf */
+  struct LeafLocalData {
+    /*! \brief feature bins of the data in the leaf */
+    std::unique_ptr<Dataset> data;
+    /*! \brief global data index of every row of data */
+    std::vector<data_size_t> global_indices;
+    std::vector<score_t, Common::AlignmentAllocator<score_t, kAlignedSize>> gradients;
+    std::vector<score_t, Common::AlignmentAllocator<score_t, kAlignedSize>> hessians;
+  };
+  /*! \brief leaf-local datasets, the first num_leaf_local_data_ belong to the current tree and the others are kept for reuse */
+  std::vector<LeafLocalData> leaf_local_data_;
+  /*! \brief number of leaf-local datasets used by the current tree */
+  int num_leaf_local_data_ = 0;
+  /*! \brief true if small leaves are copied into leaf-local datasets (leaf_reorder_data_ratio > 0) */
+  bool use_leaf_reorder_ = false;
 };
 
 inline data_size_t SerialTreeLearner::GetGlobalDataCountInLeaf(int leaf_idx) const {
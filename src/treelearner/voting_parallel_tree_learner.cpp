@@ -23,6 +23,10 @@ void VotingParallelTreeLearner<TREELEARNER_T>::Init(const Dataset* train_data, b
   TREELEARNER_T::Init(train_data, is_constant_hessian);
   rank_ = Network::rank();
   num_machines_ = Network::num_machines();
+  // the network can be initialized without the benchmark, e.g., by LGBM_NetworkInit
+  if (this->config_->network_benchmark && !Network::allreduce_benchmarked()) {
+    Network::BenchmarkAllreduce();
+  }
 
   // limit top k
   if (top_k_ > this->num_features_) {
@@ -342,8 +346,13 @@ void VotingParallelTreeLearner<TREELEARNER_T>::FindBestSplits(const Tree* tree)
   CopyLocalHistogram(smaller_top_features, larger_top_features);
 
   // Reduce scatter for histogram
-  Network::ReduceScatter(input_buffer_.data(), reduce_scatter_size_, sizeof(hist_t), block_start_.data(), block_len_.data(),
-                         output_buffer_.data(), static_cast<comm_size_t>(output_buffer_.size()), &HistogramSumReducer);
+  if (this->config_->histogram_exchange_sparse) {
+    histogram_compressor_.ReduceScatter(input_buffer_.data(), block_start_.data(), block_len_.data(),
+                                        output_buffer_.data(), this->config_->histogram_exchange_single_precision);
+  } else {
+    Network::ReduceScatter(input_buffer_.data(), reduce_scatter_size_, sizeof(hist_t), block_start_.data(), block_len_.data(),
+                           output_buffer_.data(), static_cast<comm_size_t>(output_buffer_.size()), &HistogramSumReducer);
+  }
 
   this->FindBestSplitsFromHistograms(is_feature_used, false, tree);
 }